@@ -0,0 +1,174 @@
+"""
+TempDownloader - 设备端报警设置与事件监视
+
+设置设备端报警（上下限、变化率、探头故障），并打印设备主动上报的报警事件。
+报警在设备每次测量时判断，状态变化时立即上报，不依赖上位机轮询；
+设置不保存到参数，设备重新上电后需重新设置。
+
+用法示例:
+    python alarm.py /tmp/vtm02                                      读取报警设置与状态
+    python alarm.py COM5 --high 80 --low 70 --hyst 0.2 --monitor    上下限报警并监视事件
+    python alarm.py COM5 --rate 0.5 --rate-hyst 0.1 --probe --fault probe
+                                                                    变化率与探头报警，探头故障时输出3.6mA
+    python alarm.py COM5 --off                                      关闭全部报警
+
+版本: V1.0
+日期: 2026-10-16
+"""
+
+import argparse
+import sys
+import time
+from datetime import datetime
+from loguru import logger
+
+from src.protocol.protocol import Protocol
+from src.protocol.commands import (Commands, DeviceAPI, ALARM_NAMES, ALARM_HIGH, ALARM_LOW,
+                                   ALARM_RATE, ALARM_PROBE, ALARM_FAULT_CURRENT_DEFAULT,
+                                   PROBE_STATUS_NAMES, alarm_bit_names, parse_alarm_event)
+
+
+def parse_bits(text: str) -> int:
+    """解析逗号分隔的报警名称（或all）为报警位"""
+    if text == 'all':
+        return (1 << len(ALARM_NAMES)) - 1
+    bits = 0
+    for name in text.split(','):
+        if name not in ALARM_NAMES:
+            raise argparse.ArgumentTypeError(f"未知报警 {name}，可选 {', '.join(ALARM_NAMES)}")
+        bits |= 1 << ALARM_NAMES.index(name)
+    return bits
+
+
+def format_names(bits: int) -> str:
+    """报警位显示为名称"""
+    return ','.join(alarm_bit_names(bits)) or '-'
+
+
+def print_status(alarm: dict):
+    """打印报警设置与状态"""
+    enable = alarm['enable']
+    print(f"启用 {format_names(enable)}  故障电流 {format_names(alarm['fault'])} -> "
+          f"{alarm['fault_mA']:.2f} mA")
+    if enable & ALARM_HIGH:
+        print(f"  上限 {alarm['high_K']:.3f} K（低于 {alarm['high_K'] - alarm['hyst_K']:.3f} K 解除）")
+    if enable & ALARM_LOW:
+        print(f"  下限 {alarm['low_K']:.3f} K（高于 {alarm['low_K'] + alarm['hyst_K']:.3f} K 解除）")
+    if enable & ALARM_RATE:
+        print(f"  变化率 ±{alarm['rate_limit_K_s']:.4f} K/s"
+              f"（低于 {alarm['rate_limit_K_s'] - alarm['rate_hyst_K_s']:.4f} K/s 解除）")
+    trips = '  '.join(f"{name} {count}" for name, count in alarm['trips'].items())
+    print(f"当前报警 {format_names(alarm['active'])}  "
+          f"输出{'故障电流' if alarm['output_fault'] else '正常'}  "
+          f"变化率 {alarm['rate_K_s']:+.4f} K/s  事件 {alarm['event_seq']}  触发次数: {trips}")
+
+
+def print_event(event: dict):
+    """打印一条报警事件"""
+    probe = event['probe_status']
+    probe_name = PROBE_STATUS_NAMES[probe] if probe < len(PROBE_STATUS_NAMES) else str(probe)
+    change = []
+    if event['raised']:
+        change.append('触发 ' + ','.join(event['raised']))
+    if event['cleared']:
+        change.append('解除 ' + ','.join(event['cleared']))
+    print(f"{datetime.now().strftime('%H:%M:%S.%f')[:-3]}  #{event['seq']}  "
+          f"设备 {event['time_ms'] / 1000.0:.3f} s  {'  '.join(change)}  "
+          f"当前 {format_names(event['active'])}  {event['temperature_K']:.4f} K  "
+          f"{event['rate_K_s']:+.4f} K/s  探头 {probe_name}", flush=True)
+
+
+def main():
+    """主函数"""
+    parser = argparse.ArgumentParser(description='Ultra-TM02 设备端报警设置与事件监视')
+    parser.add_argument('port', help='串口或伪终端路径')
+    parser.add_argument('--baud', type=int, default=115200, help='波特率')
+    parser.add_argument('--high', type=float, help='温度上限 (K)')
+    parser.add_argument('--low', type=float, help='温度下限 (K)')
+    parser.add_argument('--hyst', type=float, default=0.0, help='上下限回差 (K)')
+    parser.add_argument('--rate', type=float, help='变化率上限 (K/s，按绝对值)')
+    parser.add_argument('--rate-hyst', type=float, default=0.0, help='变化率回差 (K/s)')
+    parser.add_argument('--probe', action='store_true', help='探头断开/短路/超量程报警')
+    parser.add_argument('--fault', type=parse_bits, default=0,
+                        help='触发时强制输出故障电流的报警，如 high,probe 或 all')
+    parser.add_argument('--fault-mA', type=float, default=ALARM_FAULT_CURRENT_DEFAULT,
+                        help='故障电流 (mA，3.6~21.0)')
+    parser.add_argument('--off', action='store_true', help='关闭全部报警')
+    parser.add_argument('--clear-trips', action='store_true', help='清零触发次数')
+    parser.add_argument('--monitor', action='store_true', help='持续打印报警事件 (Ctrl+C结束)')
+    parser.add_argument('--duration', type=float, help='监视时长 (s)，默认直到Ctrl+C')
+    args = parser.parse_args()
+    
+    enable = 0
+    if args.high is not None:
+        enable |= ALARM_HIGH
+    if args.low is not None:
+        enable |= ALARM_LOW
+    if args.rate is not None:
+        enable |= ALARM_RATE
+    if args.probe:
+        enable |= ALARM_PROBE
+    
+    logger.remove()
+    logger.add(sys.stderr, level='WARNING')
+    
+    protocol = Protocol()
+    if not protocol.connect(args.port, args.baud):
+        return 2
+    api = DeviceAPI(protocol)
+    
+    # 设备检测到端口打开前的请求可能没有响应
+    for _ in range(10):
+        if protocol.send_command(Commands.GET_DEVICE_ID) is not None:
+            break
+    else:
+        print(f"{args.port}: 设备无响应", file=sys.stderr)
+        return 2
+    
+    try:
+        alarm = api.get_alarm()
+        if alarm is None:
+            print("设备不支持报警", file=sys.stderr)
+            return 2
+        if enable or args.off:
+            alarm = api.set_alarm(enable, args.fault & enable, args.high or 0.0, args.low or 0.0,
+                                  args.hyst, args.rate or 0.0, args.rate_hyst, args.fault_mA)
+            if alarm is None:
+                print("设置报警失败（参数无效？）", file=sys.stderr)
+                return 2
+        if args.clear_trips:
+            alarm = api.clear_alarm_trips() or alarm
+        print_status(alarm)
+        
+        # 事件序号不连续说明期间有事件未收到（如USB断开）；
+        # 设置时上报的解除事件在响应之前，序号小于状态中的下一个序号
+        next_seq = alarm['event_seq']
+        end = None if args.duration is None else time.monotonic() + args.duration
+        if args.monitor:
+            print("监视报警事件...", file=sys.stderr)
+        try:
+            while True:
+                for frame in protocol.poll_events(0.2 if args.monitor else 0.0):
+                    event = parse_alarm_event(frame)
+                    if event is None:
+                        continue
+                    if event['seq'] > next_seq:
+                        print(f"事件 {next_seq}~{event['seq'] - 1} 未收到", file=sys.stderr)
+                    next_seq = max(next_seq, event['seq'] + 1)
+                    print_event(event)
+                if not args.monitor or (end is not None and time.monotonic() >= end):
+                    break
+        except KeyboardInterrupt:
+            pass
+        
+        if args.monitor:
+            alarm = api.get_alarm()
+            if alarm is not None:
+                print_status(alarm)
+    finally:
+        protocol.disconnect()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,116 @@
+"""
+TempDownloader - 突发采集
+
+布防设备的突发采集，等待电平、温度变化率或命令触发，采集完成后整块读出并保存为CSV。
+采集期间滤波测量与4-20mA输出照常进行，需先开始测量。
+
+用法示例:
+    python burst.py /tmp/vtm02 --now -o burst.csv            立即命令触发
+    python burst.py COM5 --falling 480 --pre 1024 --post 3072 -o burst.csv
+                                                             电压降到480mV以下时触发
+    python burst.py COM5 --rate 2 -w 600 -o burst.csv        温度变化超过2K/s时触发，最多等10分钟
+
+版本: V1.0
+日期: 2026-10-16
+"""
+
+import argparse
+import sys
+import time
+from loguru import logger
+
+from src.protocol.protocol import Protocol
+from src.protocol.commands import (Commands, DeviceAPI, BURST_EDGE_RISING,
+                                   BURST_EDGE_FALLING)
+from src.utils.burst_export import save_burst_csv
+
+
+def main():
+    """主函数"""
+    parser = argparse.ArgumentParser(description='Ultra-TM02 突发采集')
+    parser.add_argument('port', help='串口或伪终端路径')
+    parser.add_argument('--baud', type=int, default=115200, help='波特率')
+    parser.add_argument('--pre', type=int, default=1024, help='触发前样本数')
+    parser.add_argument('--post', type=int, default=3072, help='触发后样本数（含触发样本）')
+    parser.add_argument('--rising', type=float, metavar='MV', help='电压上升越过该值时触发 (mV)')
+    parser.add_argument('--falling', type=float, metavar='MV', help='电压下降越过该值时触发 (mV)')
+    parser.add_argument('--rate', type=float, default=0.0, help='温度变化率超过该值时触发 (K/s)')
+    parser.add_argument('--now', action='store_true', help='布防后立即命令触发')
+    parser.add_argument('-w', '--wait', type=float, default=60.0, help='等待触发的最长时间 (s)')
+    parser.add_argument('-o', '--output', default='burst.csv', help='输出CSV文件')
+    args = parser.parse_args()
+    
+    if args.rising is not None and args.falling is not None and args.rising != args.falling:
+        parser.error('上升沿与下降沿需使用同一阈值')
+    edge = 0
+    level = 0.0
+    if args.rising is not None:
+        edge |= BURST_EDGE_RISING
+        level = args.rising
+    if args.falling is not None:
+        edge |= BURST_EDGE_FALLING
+        level = args.falling
+    
+    logger.remove()
+    logger.add(sys.stderr, level='WARNING')
+    
+    protocol = Protocol()
+    if not protocol.connect(args.port, args.baud):
+        return 2
+    api = DeviceAPI(protocol)
+    
+    # 设备检测到端口打开前的请求可能没有响应
+    for _ in range(10):
+        if protocol.send_command(Commands.GET_DEVICE_ID) is not None:
+            break
+    else:
+        print(f"{args.port}: 设备无响应", file=sys.stderr)
+        return 2
+    
+    try:
+        status = api.burst_arm(args.pre, args.post, edge, level, args.rate)
+        if status is None:
+            print("布防失败（参数无效？）", file=sys.stderr)
+            return 2
+        print(f"已布防: 触发前 {args.pre}  触发后 {args.post}  容量 {status['capacity']}",
+              file=sys.stderr)
+        
+        if args.now and api.burst_trigger() is None:
+            print("命令触发失败", file=sys.stderr)
+            return 2
+        
+        deadline = time.monotonic() + args.wait
+        while True:
+            status = api.burst_status()
+            if status is not None and status['state'] == 'done':
+                break
+            if time.monotonic() > deadline:
+                print("等待触发超时，已取消", file=sys.stderr)
+                api.burst_abort()
+                return 1
+            time.sleep(0.1)
+        
+        def progress(current, total):
+            print(f"\r读出 {current}/{total}", end='', file=sys.stderr, flush=True)
+        
+        start = time.monotonic()
+        samples = api.burst_read_all(status, progress)
+        print(file=sys.stderr)
+        if samples is None:
+            print("读出失败", file=sys.stderr)
+            return 2
+        elapsed = time.monotonic() - start
+    finally:
+        protocol.disconnect()
+    
+    save_burst_csv(args.output, status, samples)
+    print(f"触发源 {status['source']}  样本 {len(samples)} "
+          f"(触发前 {status['pre_count']})  平均间隔 {status['interval_ns'] / 1000:.1f} μs  "
+          f"最大间隔 {status['max_interval_ns'] / 1000:.1f} μs")
+    print(f"读出 {elapsed:.2f} s ({len(samples) * 3 / max(elapsed, 1e-6) / 1024:.1f} KiB/s)  "
+          f"-> {args.output}")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
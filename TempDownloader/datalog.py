@@ -0,0 +1,128 @@
+"""
+TempDownloader - 长期数据日志读出
+
+读出设备Flash中的长期数据日志（每个统计周期的最低/平均/最高温度），按页序号
+增量追加到CSV。设备断开或掉电期间照常记录，定期运行本工具即可补齐；
+默认先校时，使之后写入的页带有UNIX时间。
+
+用法示例:
+    python datalog.py /tmp/vtm02 -o datalog.csv              增量读出并校时
+    python datalog.py COM5 --interval 30                     统计周期改为30s并保存参数
+    python datalog.py COM5 --flush -o datalog.csv            先写入RAM页，读出全部记录
+    python datalog.py COM5 -o datalog.csv --erase            读出后擦除日志区域
+
+版本: V1.0
+日期: 2026-10-16
+"""
+
+import argparse
+import sys
+import time
+from loguru import logger
+
+from src.protocol.protocol import Protocol
+from src.protocol.commands import Commands, DeviceAPI
+from src.utils.datalog import DatalogWriter, decode_page
+
+
+def main():
+    """主函数"""
+    parser = argparse.ArgumentParser(description='Ultra-TM02 长期数据日志读出')
+    parser.add_argument('port', help='串口或伪终端路径')
+    parser.add_argument('--baud', type=int, default=115200, help='波特率')
+    parser.add_argument('-o', '--output', default='datalog.csv', help='输出CSV文件（已存在时追加）')
+    parser.add_argument('--interval', type=int, help='设置统计周期 (s，1~3600) 并保存参数')
+    parser.add_argument('--flush', action='store_true',
+                        help='读出前将RAM页写入Flash（占用一整页）')
+    parser.add_argument('--erase', action='store_true', help='读出并保存后擦除日志区域')
+    parser.add_argument('--no-sync', action='store_true', help='不校时')
+    args = parser.parse_args()
+    
+    logger.remove()
+    logger.add(sys.stderr, level='WARNING')
+    
+    protocol = Protocol()
+    if not protocol.connect(args.port, args.baud):
+        return 2
+    api = DeviceAPI(protocol)
+    
+    # 设备检测到端口打开前的请求可能没有响应
+    for _ in range(10):
+        if protocol.send_command(Commands.GET_DEVICE_ID) is not None:
+            break
+    else:
+        print(f"{args.port}: 设备无响应", file=sys.stderr)
+        return 2
+    
+    writer = DatalogWriter(args.output)
+    try:
+        status = api.datalog_status()
+        if status is None:
+            print("设备不支持数据日志", file=sys.stderr)
+            return 2
+        if not args.no_sync:
+            status = api.datalog_set_time(int(time.time())) or status
+        if args.interval is not None:
+            status = api.datalog_set_interval(args.interval)
+            if status is None or not api.save_param():
+                print("设置统计周期失败（参数无效？）", file=sys.stderr)
+                return 2
+        if args.flush:
+            status = api.datalog_flush()
+            if status is None:
+                print("写入RAM页失败", file=sys.stderr)
+                return 2
+        
+        # 设备日志被擦除且重启后页序号从0开始
+        start_seq = writer.next_seq
+        if start_seq > status['next_seq']:
+            print(f"设备页序号 {status['next_seq']} 小于文件中的 {start_seq}，从头读出",
+                  file=sys.stderr)
+            start_seq = 0
+        if start_seq < status['oldest_seq']:
+            print(f"页 {start_seq}~{status['oldest_seq'] - 1} 已被擦除", file=sys.stderr)
+        
+        def progress(current, total):
+            print(f"\r读出 {current}/{total} 字节", end='', file=sys.stderr, flush=True)
+        
+        start = time.monotonic()
+        pages = api.datalog_read_pages(status, start_seq, progress)
+        print(file=sys.stderr)
+        if pages is None:
+            print("读出失败", file=sys.stderr)
+            return 2
+        elapsed = time.monotonic() - start
+        
+        # 最后一项为尚在RAM中的页，下次写入Flash后再保存
+        bad = 0
+        for data in pages[:-1]:
+            page = decode_page(data)
+            if page is None:
+                bad += 1
+                continue
+            writer.write_page(page)
+        pending = decode_page(pages[-1])
+        
+        if args.erase:
+            if api.datalog_erase() is None:
+                print("擦除失败", file=sys.stderr)
+                return 2
+    finally:
+        writer.close()
+        protocol.disconnect()
+    
+    used = status['used_pages']
+    print(f"已用 {used}/{status['page_count']} 页  周期 {status['interval_s']} s  "
+          f"启动序号 {status['boot']}  {'已校时' if status['time_synced'] else '未校时'}  "
+          f"丢弃 {status['lost']} 条")
+    print(f"读出 {len(pages) - 1} 页 {elapsed:.2f} s  写入 {writer.written} 条  "
+          f"CRC错误 {bad} 页  -> {args.output}")
+    if pending is not None and pending['entries']:
+        t, low, avg, high = pending['entries'][-1]
+        print(f"RAM页 {len(pending['entries'])} 条未写入Flash，最近一条: "
+              f"{low:.3f} / {avg:.3f} / {high:.3f} K")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,134 @@
+"""
+TempDownloader - 协议负载与延迟测试
+
+按命令组合和目标速率向设备发送请求，报告延迟分位数、吞吐量、CRC错误与重新同步次数。
+可连接真实串口，也可连接虚拟TM02（Ultra_TM02/Host/build/vtm02）的伪终端。
+
+用法示例:
+    python loadgen.py /tmp/vtm02 -d 10                       闭环，默认只读命令组合
+    python loadgen.py COM5 -r 200 -w 4 -d 30                 200次/s，最多4条在途
+    python loadgen.py /tmp/vtm02 -m GET_STATUS=1,GET_TRACE:00=1 --corrupt 0.01
+    python loadgen.py /tmp/vtm02 -j new.json -b base.json -t 10
+                                                             与基线比较，p99或吞吐量
+                                                             变差超过10%时返回1
+
+版本: V1.0
+日期: 2026-10-16
+"""
+
+import argparse
+import json
+import sys
+from loguru import logger
+
+from src.protocol.protocol import Protocol
+from src.protocol.commands import Commands
+from src.protocol.loadgen import (DEFAULT_MIX, LoadGenerator, parse_mix, summarize,
+                                  format_summary)
+
+
+def compare_baseline(summary: dict, baseline: dict, tolerance: float) -> list:
+    """
+    与基线结果比较
+    
+    Args:
+        summary: 本次结果
+        baseline: 基线结果（本工具-j输出的JSON）
+        tolerance: 允许变差的百分比
+    
+    Returns:
+        超出容差的项目说明列表
+    """
+    failures = []
+    limit = 1.0 + tolerance / 100.0
+    if baseline['p99_ms'] and summary['p99_ms'] > baseline['p99_ms'] * limit:
+        failures.append(f"p99 {summary['p99_ms']:.3f} ms > 基线 {baseline['p99_ms']:.3f} ms")
+    if summary['throughput'] * limit < baseline['throughput']:
+        failures.append(f"吞吐 {summary['throughput']:.1f} 次/s < 基线 {baseline['throughput']:.1f} 次/s")
+    for key in ('timeouts', 'unexpected', 'crc_errors'):
+        if summary[key] > baseline.get(key, 0):
+            failures.append(f"{key} {summary[key]} > 基线 {baseline.get(key, 0)}")
+    return failures
+
+
+def main():
+    """主函数"""
+    parser = argparse.ArgumentParser(description='Ultra-TM02 协议负载与延迟测试')
+    parser.add_argument('port', help='串口或伪终端路径')
+    parser.add_argument('--baud', type=int, default=115200, help='波特率')
+    parser.add_argument('-m', '--mix', default=DEFAULT_MIX,
+                        help='命令组合: 名称[:十六进制数据]=权重,... (默认只读命令)')
+    parser.add_argument('-r', '--rate', type=float, default=0.0,
+                        help='目标速率 (次/s)，0=闭环尽快发送')
+    parser.add_argument('-w', '--window', type=int, default=1, help='最大在途请求数')
+    parser.add_argument('-d', '--duration', type=float, default=10.0, help='持续时间 (s)')
+    parser.add_argument('-n', '--count', type=int, default=0, help='请求总数，覆盖-d')
+    parser.add_argument('--timeout', type=float, default=1.0, help='单条请求超时 (s)')
+    parser.add_argument('--corrupt', type=float, default=0.0,
+                        help='故意损坏CRC的请求比例 (0~1)')
+    parser.add_argument('--seed', type=int, default=1, help='随机数种子')
+    parser.add_argument('-j', '--json', help='结果写入JSON文件')
+    parser.add_argument('-b', '--baseline', help='基线JSON文件')
+    parser.add_argument('-t', '--tolerance', type=float, default=10.0,
+                        help='与基线比较的容差 (%%)')
+    parser.add_argument('-q', '--quiet', action='store_true', help='不打印每秒进度')
+    args = parser.parse_args()
+    
+    # 逐帧的调试日志会拖慢发送，只保留警告
+    logger.remove()
+    logger.add(sys.stderr, level='WARNING')
+    
+    try:
+        mix = parse_mix(args.mix)
+    except ValueError as e:
+        parser.error(str(e))
+    
+    protocol = Protocol()
+    if not protocol.connect(args.port, args.baud):
+        return 2
+    
+    # 设备检测到端口打开前的请求可能没有响应，先确认连通再开始计时
+    for _ in range(10):
+        if protocol.send_command(Commands.GET_DEVICE_ID) is not None:
+            break
+    else:
+        print(f"{args.port}: 设备无响应", file=sys.stderr)
+        return 2
+    protocol.serial.reset_input_buffer()
+    protocol.rx_buffer.clear()
+    
+    def progress(result):
+        print(f"\r{result.elapsed:6.1f} s  发送 {result.sent}  完成 {result.completed}  "
+              f"超时 {result.timeouts}", end='', file=sys.stderr, flush=True)
+    
+    gen = LoadGenerator(protocol, mix, rate=args.rate, window=args.window,
+                        timeout=args.timeout, corrupt=args.corrupt, seed=args.seed)
+    result = gen.run(duration=args.duration, count=args.count,
+                     progress=None if args.quiet else progress)
+    protocol.disconnect()
+    if not args.quiet:
+        print(file=sys.stderr)
+    
+    summary = summarize(result)
+    summary['config'] = {'mix': args.mix, 'rate': args.rate, 'window': args.window,
+                         'corrupt': args.corrupt}
+    print(format_summary(summary, args.rate))
+    
+    if args.json:
+        with open(args.json, 'w', encoding='utf-8') as f:
+            json.dump(summary, f, ensure_ascii=False, indent=2)
+    
+    if args.baseline:
+        with open(args.baseline, encoding='utf-8') as f:
+            baseline = json.load(f)
+        failures = compare_baseline(summary, baseline, args.tolerance)
+        for line in failures:
+            print(f"回归: {line}")
+        if failures:
+            return 1
+    
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -5,10 +5,92 @@
 """
 
 import struct
+import zlib
 from typing import Optional, Tuple
 from .protocol import Protocol, Frame
 
 
+# 固件任务表中的任务名（按任务编号顺序，见app_sched.h）
+SCHED_TASK_NAMES = ('temp', 'output', 'comm', 'flash', 'lcd', 'led', 'power')
+
+# 固件性能探针名（按探针编号顺序，见bsp_prof.h）
+PROF_PROBE_NAMES = ('median', 'table_lookup', 'lcd_update', 'usb_tx', 'loop', 'sample_to_out')
+
+# 性能探针log2直方图格数
+PROF_HIST_BINS = 24
+
+# 固件事件跟踪编号 -> (名称, 所在线程)，见bsp_trace.h
+TRACE_EVENTS = {
+    1:  ('DRDY', 'irq'),
+    2:  ('USART6', 'irq'),
+    3:  ('USART6 RX DMA', 'irq'),
+    4:  ('USART6 TX DMA', 'irq'),
+    5:  ('USB', 'irq'),
+    6:  ('task', 'main'),
+    7:  ('sample', 'main'),
+    8:  ('filter', 'main'),
+    9:  ('lookup', 'main'),
+    10: ('command', 'main'),
+    11: ('DAC1 load', 'main'),
+    12: ('DAC2 load', 'main'),
+    13: ('LCD update', 'main'),
+    14: ('sample timer', 'irq'),
+    15: ('sleep', 'main'),
+}
+
+# 固件时钟档位名（按档位编号顺序，见bsp_power.h）
+POWER_PROFILE_NAMES = ('full', 'balanced', 'low')
+
+# 固件热路径自测的函数名与执行方式名（按编号顺序，见app_bench.h）
+BENCH_FUNC_NAMES = ('median', 'moving_avg', 'table_lookup', 'table_sweep', 'format_float',
+                    'crc16_256')
+BENCH_MODE_NAMES = ('ram', 'flash', 'flash_noaccel')
+
+# 固件启动阶段名（按阶段编号顺序，见app_boot.h）
+BOOT_STAGE_NAMES = ('app_init', 'output_safe', 'acq_start', 'init_done',
+                    'first_sample', 'first_reading', 'lcd_ready', 'usb_ready')
+
+# 复位原因标志位名称（见app_boot.h BOOT_RESET_xxx）
+RESET_FLAG_NAMES = ('BOR', 'PIN', 'POR', 'SOFT', 'IWDG', 'WWDG', 'LPWR')
+
+# 事件跟踪每帧读出条数
+TRACE_ENTRIES_PER_FRAME = 30
+
+# 原始采样录制每帧最多读出条数（每条3字节码值 + 3字节间隔）
+CAPTURE_RECORDS_PER_FRAME = 41
+
+# 突发采集每帧最多读出样本数（每个3字节码值）
+BURST_SAMPLES_PER_FRAME = 84
+
+# 突发采集状态与触发源名称（见svc_adc.h ADCBurstState_t / ADCBurstSource_t）
+BURST_STATE_NAMES = ('idle', 'armed', 'triggered', 'done')
+BURST_SOURCE_NAMES = ('none', 'level', 'rate', 'command')
+
+# 突发采集电平触发沿
+BURST_EDGE_RISING = 0x01
+BURST_EDGE_FALLING = 0x02
+
+# 历史记录每帧最多读出条数（每条13字节）
+HISTORY_RECORDS_PER_FRAME = 18
+
+# 数据日志每帧最多读出字节数
+DATALOG_BYTES_PER_FRAME = 240
+
+# 报警位名称（按位顺序，见app_alarm.h）与探头状态名称（见app_temp.h ProbeStatus_t）
+ALARM_NAMES = ('high', 'low', 'rate', 'probe')
+ALARM_HIGH = 0x01
+ALARM_LOW = 0x02
+ALARM_RATE = 0x04
+ALARM_PROBE = 0x08
+PROBE_STATUS_NAMES = ('ok', 'open', 'short', 'range')
+
+# 默认故障电流 (mA)，NAMUR NE43下限故障电流
+ALARM_FAULT_CURRENT_DEFAULT = 3.6
+
+# 分度表每包点数：帧长度字段为1字节，2字节包序号 + 30点×8字节 = 242字节
+TABLE_POINTS_PER_PACKET = 30
+
+
 class Commands:
     """命令码定义"""
     
@@ -42,10 +124,69 @@ class Commands:
     LOAD_PARAM          = 0x51      # 加载参数
     RESET_DEFAULT       = 0x52      # 恢复默认
     
+    # 诊断命令
+    GET_TASK_STATS      = 0x60      # 任务调度统计
+    GET_PROFILE         = 0x61      # 性能探针统计
+    GET_TRACE           = 0x62      # 事件跟踪缓冲区
+    GET_BOOT_INFO       = 0x63      # 复位原因与启动计时
+    SAMPLE_TIMING       = 0x64      # 采样周期设置与间隔抖动统计
+    POWER               = 0x65      # 时钟档位设置与CPU负载统计
+    BENCH               = 0x66      # 热路径RAM/Flash执行周期自测
+    CAPTURE             = 0x67      # 原始采样录制与读出
+    GET_FLASH_STATS     = 0x68      # Flash擦写停顿/采样间隔统计
+    BURST               = 0x69      # 突发采集布防、触发与数据块读出
+    HISTORY             = 0x6A      # 测量历史记录状态、设置与按序号读出
+    DATALOG             = 0x6B      # 长期数据日志状态、设置与按页批量读出
+    STATS               = 0x6C      # 温度窗口统计与Allan偏差
+    ALARM               = 0x6D      # 报警设置与状态
+    
     # 响应
     ACK                 = 0x80      # 确认响应
     NACK                = 0x81      # 否定响应
     DATA_REPORT         = 0xF0      # 数据上报
+    ALARM_EVENT         = 0xF1      # 报警事件上报
+
+
+def alarm_bit_names(bits: int) -> list:
+    """
+    报警位转换为名称列表
+    
+    Args:
+        bits: 报警位
+    
+    Returns:
+        名称列表，如 ['high', 'probe']
+    """
+    return [name for i, name in enumerate(ALARM_NAMES) if bits & (1 << i)]
+
+
+def parse_alarm_event(frame: Frame) -> Optional[dict]:
+    """
+    解析报警事件帧（Protocol.poll_events()取得的帧）
+    
+    Args:
+        frame: 事件帧
+    
+    Returns:
+        {'seq', 'active', 'changed', 'raised', 'cleared', 'probe_status', 'time_ms',
+        'temperature_K', 'rate_K_s'}，active/changed为报警位，raised/cleared为名称列表；
+        不是报警事件返回None
+    """
+    if frame.cmd != Commands.ALARM_EVENT or len(frame.data) < 20:
+        return None
+    seq, active, changed, probe_status, _rsv, time_ms, temperature_K, rate_K_s = \
+        struct.unpack('<IBBBBIff', frame.data[:20])
+    return {
+        'seq': seq,
+        'active': active,
+        'changed': changed,
+        'raised': alarm_bit_names(changed & active),
+        'cleared': alarm_bit_names(changed & ~active),
+        'probe_status': probe_status,
+        'time_ms': time_ms,
+        'temperature_K': temperature_K,
+        'rate_K_s': rate_K_s,
+    }
 
 
 class StatusCode:
@@ -257,6 +398,878 @@ class DeviceAPI:
         response = self.protocol.send_command(Commands.RESET_DEFAULT)
         return self._check_ack(response)
     
+    def get_flash_stats(self, reset: bool = False) -> Optional[dict]:
+        """
+        获取Flash擦写停顿与DRDY采样间隔统计
+        
+        Args:
+            reset: 读取后是否清零统计
+            
+        Returns:
+            统计字典（时间单位μs），失败返回None
+        """
+        data = bytes([1 if reset else 0])
+        response = self.protocol.send_command(Commands.GET_FLASH_STATS, data)
+        if response and response.cmd == Commands.GET_FLASH_STATS and len(response.data) >= 40:
+            values = struct.unpack('<10I', response.data[:40])
+            keys = ('erase_count', 'erase_max_us', 'program_words', 'program_chunk_max_us',
+                    'sample_count', 'overflow_count', 'deferred_count',
+                    'max_gap_us', 'max_gap_flash_us', 'max_latency_us')
+            return dict(zip(keys, values))
+        return None
+    
+    def get_task_stats(self, reset: bool = False) -> Optional[list]:
+        """
+        获取任务调度统计
+        
+        Args:
+            reset: 读取后是否清零统计
+            
+        Returns:
+            每个任务一个字典（按任务编号顺序），失败返回None
+        """
+        data = bytes([1 if reset else 0])
+        response = self.protocol.send_command(Commands.GET_TASK_STATS, data)
+        if not response or response.cmd != Commands.GET_TASK_STATS or len(response.data) < 1:
+            return None
+        
+        count = response.data[0]
+        if len(response.data) < 1 + count * 20:
+            return None
+        
+        tasks = []
+        for i in range(count):
+            values = struct.unpack('<HH4I', response.data[1 + i * 20:21 + i * 20])
+            name = SCHED_TASK_NAMES[i] if i < len(SCHED_TASK_NAMES) else f'task{i}'
+            keys = ('period_ms', 'budget_us', 'run_count', 'overrun_count',
+                    'max_exec_us', 'max_late_ms')
+            tasks.append(dict(name=name, **dict(zip(keys, values))))
+        return tasks
+    
+    def get_profile(self, probe: int, reset: bool = False) -> Optional[dict]:
+        """
+        获取一个性能探针的统计
+        
+        Args:
+            probe: 探针编号
+            reset: 读取后是否清零该探针
+            
+        Returns:
+            统计字典（周期数及按设备主频换算的μs），失败返回None
+        """
+        data = bytes([probe, 1 if reset else 0])
+        response = self.protocol.send_command(Commands.GET_PROFILE, data)
+        if (not response or response.cmd != Commands.GET_PROFILE or
+                len(response.data) < 26 + PROF_HIST_BINS * 2):
+            return None
+        
+        probe_id, probe_count = response.data[0], response.data[1]
+        count, min_cycles, max_cycles, sum_cycles, clock = struct.unpack(
+            '<IIIQI', response.data[2:26])
+        hist = list(struct.unpack(f'<{PROF_HIST_BINS}H', response.data[26:26 + PROF_HIST_BINS * 2]))
+        
+        mhz = clock / 1e6 if clock else 1.0
+        name = PROF_PROBE_NAMES[probe_id] if probe_id < len(PROF_PROBE_NAMES) else f'probe{probe_id}'
+        return {
+            'id': probe_id,
+            'name': name,
+            'probe_count': probe_count,
+            'clock_hz': clock,
+            'count': count,
+            'min_cycles': min_cycles if count else 0,
+            'max_cycles': max_cycles,
+            'sum_cycles': sum_cycles,
+            'hist': hist,
+            'min_us': (min_cycles if count else 0) / mhz,
+            'max_us': max_cycles / mhz,
+            'mean_us': (sum_cycles / count / mhz) if count else 0.0,
+        }
+    
+    def get_profiles(self, reset: bool = False) -> Optional[list]:
+        """
+        获取全部性能探针的统计
+        
+        Args:
+            reset: 读取后是否清零
+            
+        Returns:
+            每个探针一个字典（按探针编号顺序），失败返回None
+        """
+        first = self.get_profile(0, reset)
+        if first is None:
+            return None
+        
+        profiles = [first]
+        for i in range(1, first['probe_count']):
+            profile = self.get_profile(i, reset)
+            if profile is None:
+                return None
+            profiles.append(profile)
+        return profiles
+    
+    def get_boot_info(self) -> Optional[dict]:
+        """
+        获取复位原因与启动计时
+        
+        Returns:
+            {'reset': [复位原因名称], 'stages': {阶段名: 相对复位的时刻ms或None}}，
+            失败返回None
+        """
+        response = self.protocol.send_command(Commands.GET_BOOT_INFO)
+        if not response or response.cmd != Commands.GET_BOOT_INFO or len(response.data) < 2:
+            return None
+        
+        flags, count = response.data[0], response.data[1]
+        if len(response.data) < 2 + count * 4:
+            return None
+        
+        stages = {}
+        for i, us in enumerate(struct.unpack(f'<{count}I', response.data[2:2 + count * 4])):
+            name = BOOT_STAGE_NAMES[i] if i < len(BOOT_STAGE_NAMES) else f'stage{i}'
+            stages[name] = None if us == 0xFFFFFFFF else us / 1000.0
+        reset = [n for i, n in enumerate(RESET_FLAG_NAMES) if flags & (1 << i)]
+        return {'reset': reset, 'stages': stages}
+    
+    def get_sample_timing(self, reset: bool = False,
+                          period_us: Optional[int] = None) -> Optional[dict]:
+        """
+        获取定时器触发采样的间隔抖动统计，可同时设置采样周期
+        
+        抖动为相邻两次启动转换的间隔与设定周期之差的绝对值
+        
+        Args:
+            reset: 读取后是否清零统计
+            period_us: 新的采样周期 (μs)，None表示不修改；设置后统计清零
+            
+        Returns:
+            统计字典（时间单位μs），失败返回None
+        """
+        if period_us is not None:
+            data = bytes([2]) + struct.pack('<I', period_us)
+        else:
+            data = bytes([1 if reset else 0])
+        response = self.protocol.send_command(Commands.SAMPLE_TIMING, data)
+        if not response or response.cmd != Commands.SAMPLE_TIMING or len(response.data) < 52:
+            return None
+        
+        (period, clock, count, min_c, max_c, max_jitter, sum_jitter, sum_sq,
+         overrun, deferred, max_delay) = struct.unpack('<6I2Q3I', response.data[:52])
+        mhz = clock / 1e6
+        return {
+            'period_us': period,
+            'count': count,
+            'min_us': min_c / mhz,
+            'max_us': max_c / mhz,
+            'max_jitter_us': max_jitter / mhz,
+            'mean_jitter_us': sum_jitter / count / mhz if count else 0.0,
+            'rms_jitter_us': (sum_sq / count) ** 0.5 / mhz if count else 0.0,
+            'overrun_count': overrun,
+            'deferred_count': deferred,
+            'max_delay_us': max_delay / mhz,
+        }
+    
+    def get_power_stats(self, reset: bool = False) -> Optional[dict]:
+        """
+        获取当前时钟档位和CPU负载统计
+        
+        负载按空闲睡眠时长计算，每约100ms一个统计窗口
+        
+        Args:
+            reset: 读取后是否清零统计
+            
+        Returns:
+            统计字典（负载单位%），失败返回None
+        """
+        return self._power_command(bytes([1 if reset else 0]))
+    
+    def set_clock_profile(self, profile: int) -> Optional[dict]:
+        """
+        切换时钟档位
+        
+        档位同时写入参数，保存参数后下次上电生效；切换后负载统计清零
+        
+        Args:
+            profile: 档位编号 (0=全速, 1=均衡, 2=低功耗)
+            
+        Returns:
+            切换后的统计字典，失败返回None
+        """
+        return self._power_command(bytes([2, profile]))
+    
+    def run_bench(self) -> Optional[dict]:
+        """
+        运行热路径自测
+        
+        设备将每个计算内核分别从SRAM、Flash(ART加速器开)和Flash(加速器关)
+        执行若干次，返回各自的最小/最大/平均周期数；只能在停止采集时运行
+        
+        Returns:
+            {'clock_hz', 'latency', 'prefetch', 'icache', 'dcache',
+             'funcs': [{'name', 'modes': {方式名: (min, max, avg)}}]}，
+            采集中（设备回复忙）或失败返回None；
+            未测的项（如分度表无效时的查表、格式化/CRC的RAM方式）为(0, 0, 0)
+        """
+        response = self.protocol.send_command(Commands.BENCH)
+        if not response or response.cmd != Commands.BENCH or len(response.data) < 8:
+            return None
+        
+        func_count, mode_count, accel, latency, clock = struct.unpack('<BBBBI', response.data[:8])
+        items = func_count * mode_count
+        if items == 0 or len(response.data) < 8 + items * 8:
+            return None
+        
+        # 旧固件每项只有[最小][最大]，平均值按最小值显示
+        item_size = 12 if len(response.data) >= 8 + items * 12 else 8
+        funcs = []
+        offset = 8
+        for f in range(func_count):
+            modes = {}
+            for m in range(mode_count):
+                name = BENCH_MODE_NAMES[m] if m < len(BENCH_MODE_NAMES) else f'mode{m}'
+                min_c, max_c = struct.unpack('<II', response.data[offset:offset + 8])
+                avg_c = (struct.unpack('<I', response.data[offset + 8:offset + 12])[0]
+                         if item_size == 12 else min_c)
+                modes[name] = (min_c, max_c, avg_c)
+                offset += item_size
+            name = BENCH_FUNC_NAMES[f] if f < len(BENCH_FUNC_NAMES) else f'func{f}'
+            funcs.append({'name': name, 'modes': modes})
+        
+        return {
+            'clock_hz': clock,
+            'latency': latency,
+            'prefetch': bool(accel & 0x01),
+            'icache': bool(accel & 0x02),
+            'dcache': bool(accel & 0x04),
+            'funcs': funcs,
+        }
+    
+    def _power_command(self, data: bytes) -> Optional[dict]:
+        """发送时钟档位命令并解析响应"""
+        response = self.protocol.send_command(Commands.POWER, data)
+        if not response or response.cmd != Commands.POWER or len(response.data) < 20:
+            return None
+        
+        (profile, profile_count, load_avg, load_peak, load_last,
+         hclk, sleep_count, elapsed_ms) = struct.unpack('<BBHHHIII', response.data[:20])
+        if profile < len(POWER_PROFILE_NAMES):
+            name = POWER_PROFILE_NAMES[profile]
+        else:
+            name = f'profile{profile}'
+        return {
+            'profile': profile,
+            'profile_name': name,
+            'profile_count': profile_count,
+            'hclk_hz': hclk,
+            'load_avg': load_avg / 10.0,
+            'load_peak': load_peak / 10.0,
+            'load_last': load_last / 10.0,
+            'sleep_count': sleep_count,
+            'elapsed_ms': elapsed_ms,
+        }
+    
+    def get_trace(self, restart: bool = True) -> Optional[dict]:
+        """
+        读出事件跟踪缓冲区
+        
+        设备先停止记录，再按帧分段读出全部记录（最旧在前）
+        
+        Args:
+            restart: 读出后是否清空并重新开始记录
+            
+        Returns:
+            {'clock_hz', 'lost', 'entries': [(周期计数, 类型, 事件编号, 参数), ...]}，
+            类型为 0=瞬时 1=开始 2=结束；失败返回None
+        """
+        response = self.protocol.send_command(Commands.GET_TRACE, bytes([0]))
+        if not response or response.cmd != Commands.GET_TRACE or len(response.data) < 12:
+            return None
+        count, _capacity, lost, clock = struct.unpack('<HHII', response.data[:12])
+        
+        entries = []
+        while len(entries) < count:
+            data = bytes([1]) + struct.pack('<H', len(entries))
+            response = self.protocol.send_command(Commands.GET_TRACE, data)
+            if not response or response.cmd != Commands.GET_TRACE or len(response.data) < 3:
+                return None
+            n = response.data[2]
+            if n == 0 or len(response.data) < 3 + n * 8:
+                return None
+            for i in range(n):
+                cycles, event, arg = struct.unpack('<IHH', response.data[3 + i * 8:11 + i * 8])
+                entries.append((cycles, event >> 12, event & 0x0FFF, arg))
+        
+        if restart:
+            self.protocol.send_command(Commands.GET_TRACE, bytes([2]))
+        
+        return {'clock_hz': clock, 'lost': lost, 'entries': entries}
+    
+    def _capture_command(self, op: int) -> Optional[dict]:
+        """录制状态类子命令（0=查询 1=开始 2=停止），返回录制状态与测量设置"""
+        response = self.protocol.send_command(Commands.CAPTURE, bytes([op]))
+        if not response or response.cmd != Commands.CAPTURE or len(response.data) < 40:
+            return None
+        
+        (active, current_src, _rsv, period_us, gain, vref, temp_4mA, temp_20mA,
+         table_points, capacity, buffered, _rsv2, recorded,
+         lost) = struct.unpack('<BBHIffffHHHHII', response.data[:40])
+        return {
+            'active': bool(active),
+            'current_source': current_src,
+            'sample_period_us': period_us,
+            'gain': gain,
+            'vref': vref,
+            'temp_4mA': temp_4mA,
+            'temp_20mA': temp_20mA,
+            'table_points': table_points,
+            'capacity': capacity,
+            'buffered': buffered,
+            'recorded': recorded,
+            'lost': lost,
+        }
+    
+    def capture_status(self) -> Optional[dict]:
+        """
+        查询原始采样录制状态
+        
+        Returns:
+            {'active', 'current_source', 'sample_period_us', 'gain', 'vref',
+             'temp_4mA', 'temp_20mA', 'table_points', 'capacity', 'buffered',
+             'recorded', 'lost'}，失败返回None
+        """
+        return self._capture_command(0)
+    
+    def capture_start(self) -> Optional[dict]:
+        """
+        开始录制原始采样（清空设备缓冲区）
+        
+        Returns:
+            开始时的录制状态与测量设置（写入录制文件头），失败返回None
+        """
+        return self._capture_command(1)
+    
+    def capture_stop(self) -> Optional[dict]:
+        """
+        停止录制，缓冲区中剩余的记录仍可用capture_read()读出
+        
+        Returns:
+            停止后的录制状态，失败返回None
+        """
+        return self._capture_command(2)
+    
+    def capture_read(self, max_count: int = CAPTURE_RECORDS_PER_FRAME
+                     ) -> Optional[Tuple[int, list]]:
+        """
+        读出并移除设备缓冲区中最旧的录制记录
+        
+        Args:
+            max_count: 最多读出条数（不超过CAPTURE_RECORDS_PER_FRAME）
+            
+        Returns:
+            (第一条记录的序号, [(24位码值, 相对上一条的间隔μs), ...])，失败返回None
+        """
+        count = min(max_count, CAPTURE_RECORDS_PER_FRAME)
+        response = self.protocol.send_command(Commands.CAPTURE, bytes([3, count]))
+        if not response or response.cmd != Commands.CAPTURE or len(response.data) < 5:
+            return None
+        
+        first_seq, n = struct.unpack('<IB', response.data[:5])
+        if len(response.data) < 5 + n * 6:
+            return None
+        records = []
+        for i in range(n):
+            item = response.data[5 + i * 6:11 + i * 6]
+            records.append((int.from_bytes(item[:3], 'little'),
+                            int.from_bytes(item[3:], 'little')))
+        return first_seq, records
+    
+    def _burst_command(self, op: int, payload: bytes = b'') -> Optional[dict]:
+        """突发采集状态类子命令（0=查询 1=布防 2=触发 3=取消），返回采集状态"""
+        response = self.protocol.send_command(Commands.BURST, bytes([op]) + payload)
+        if not response or response.cmd != Commands.BURST or len(response.data) < 40:
+            return None
+        
+        (state, source, edge, _rsv, pre_samples, post_samples, pre_count, post_count,
+         capacity, _rsv2, level_mV, rate_limit, interval_ns, max_interval_ns, gain,
+         vref) = struct.unpack('<BBBBHHHHHHffIIff', response.data[:40])
+        return {
+            'state': BURST_STATE_NAMES[state] if state < len(BURST_STATE_NAMES) else str(state),
+            'source': BURST_SOURCE_NAMES[source] if source < len(BURST_SOURCE_NAMES) else str(source),
+            'edge': edge,
+            'pre_samples': pre_samples,
+            'post_samples': post_samples,
+            'pre_count': pre_count,
+            'post_count': post_count,
+            'capacity': capacity,
+            'level_mV': level_mV,
+            'rate_limit': rate_limit,
+            'interval_ns': interval_ns,
+            'max_interval_ns': max_interval_ns,
+            'gain': gain,
+            'vref': vref,
+        }
+    
+    def burst_status(self) -> Optional[dict]:
+        """
+        查询突发采集状态
+        
+        Returns:
+            {'state', 'source', 'edge', 'pre_samples', 'post_samples', 'pre_count',
+             'post_count', 'capacity', 'level_mV', 'rate_limit', 'interval_ns',
+             'max_interval_ns', 'gain', 'vref'}，失败返回None
+        """
+        return self._burst_command(0)
+    
+    def burst_arm(self, pre_samples: int, post_samples: int, edge: int = 0,
+                  level_mV: float = 0.0, rate_limit: float = 0.0) -> Optional[dict]:
+        """
+        布防突发采集（丢弃上一个数据块）
+        
+        Args:
+            pre_samples: 触发前样本数
+            post_samples: 触发后样本数（含触发样本，至少1），与触发前之和不超过缓冲区容量
+            edge: 电平触发沿 BURST_EDGE_RISING/BURST_EDGE_FALLING 的组合，0=不使用
+            level_mV: 电平触发阈值 (mV)
+            rate_limit: 温度变化率触发阈值 (K/s)，0=不使用
+            
+        Returns:
+            布防后的采集状态，参数无效或失败返回None
+        """
+        payload = struct.pack('<BHHff', edge, pre_samples, post_samples, level_mV, rate_limit)
+        return self._burst_command(1, payload)
+    
+    def burst_trigger(self) -> Optional[dict]:
+        """
+        命令触发突发采集
+        
+        Returns:
+            触发后的采集状态，未布防或失败返回None
+        """
+        return self._burst_command(2)
+    
+    def burst_abort(self) -> Optional[dict]:
+        """
+        取消突发采集并丢弃数据块
+        
+        Returns:
+            取消后的采集状态，失败返回None
+        """
+        return self._burst_command(3)
+    
+    def burst_read(self, offset: int, max_count: int = BURST_SAMPLES_PER_FRAME
+                   ) -> Optional[list]:
+        """
+        读出突发采集数据块的一段（采集完成后有效）
+        
+        Args:
+            offset: 起始位置（0=最早的触发前样本）
+            max_count: 最多读出个数（不超过BURST_SAMPLES_PER_FRAME）
+            
+        Returns:
+            24位码值列表，超出数据块时为空列表，未完成或失败返回None
+        """
+        count = min(max_count, BURST_SAMPLES_PER_FRAME)
+        response = self.protocol.send_command(Commands.BURST, struct.pack('<BHB', 4, offset, count))
+        if not response or response.cmd != Commands.BURST or len(response.data) < 3:
+            return None
+        
+        _offset, n = struct.unpack('<HB', response.data[:3])
+        if len(response.data) < 3 + n * 3:
+            return None
+        return [int.from_bytes(response.data[3 + i * 3:6 + i * 3], 'little') for i in range(n)]
+    
+    def burst_read_all(self, status: dict, progress_callback=None) -> Optional[list]:
+        """
+        读出完整的突发采集数据块
+        
+        Args:
+            status: 采集完成后的burst_status()返回值
+            progress_callback: 进度回调 (已读出, 总数)
+            
+        Returns:
+            24位码值列表（前pre_count个为触发前样本），失败返回None
+        """
+        total = status['pre_count'] + status['post_count']
+        samples = []
+        while len(samples) < total:
+            chunk = self.burst_read(len(samples))
+            if not chunk:
+                return None
+            samples.extend(chunk)
+            if progress_callback:
+                progress_callback(len(samples), total)
+        return samples
+    
+    def _history_command(self, op: int, payload: bytes = b'') -> Optional[dict]:
+        """历史记录状态类子命令（0=查询 1=设置抽取比 2=清空），返回历史状态"""
+        response = self.protocol.send_command(Commands.HISTORY, bytes([op]) + payload)
+        if not response or response.cmd != Commands.HISTORY or len(response.data) < 16:
+            return None
+        
+        capacity, decimation, count, _rsv, next_seq, now_ms = struct.unpack(
+            '<HHHHII', response.data[:16])
+        return {
+            'capacity': capacity,
+            'decimation': decimation,
+            'count': count,
+            'next_seq': next_seq,
+            'now_ms': now_ms,
+        }
+    
+    def history_status(self) -> Optional[dict]:
+        """
+        查询测量历史记录状态
+        
+        Returns:
+            {'capacity', 'decimation', 'count', 'next_seq', 'now_ms'}，
+            next_seq为下一条记录的序号，now_ms为设备当前时刻；失败返回None
+        """
+        return self._history_command(0)
+    
+    def history_set_decimation(self, decimation: int) -> Optional[dict]:
+        """
+        设置历史记录抽取比（每N次测量保存一条），需save_param()才能掉电保存
+        
+        Args:
+            decimation: 抽取比 1~60000
+            
+        Returns:
+            设置后的历史状态，参数无效或失败返回None
+        """
+        return self._history_command(1, struct.pack('<H', decimation))
+    
+    def history_clear(self) -> Optional[dict]:
+        """
+        清空历史记录（序号继续递增）
+        
+        Returns:
+            清空后的历史状态，失败返回None
+        """
+        return self._history_command(2)
+    
+    def history_read(self, seq: int, max_count: int = HISTORY_RECORDS_PER_FRAME
+                     ) -> Optional[Tuple[int, list]]:
+        """
+        按序号读出历史记录（不移除）
+        
+        Args:
+            seq: 起始序号，已被覆盖时设备从最旧的记录开始
+            max_count: 最多读出条数（不超过HISTORY_RECORDS_PER_FRAME）
+            
+        Returns:
+            (第一条记录的序号, [(时间戳ms, 温度K, 电压mV, 探头状态), ...])，失败返回None
+        """
+        count = min(max_count, HISTORY_RECORDS_PER_FRAME)
+        response = self.protocol.send_command(Commands.HISTORY,
+                                              struct.pack('<BIB', 3, seq & 0xFFFFFFFF, count))
+        if not response or response.cmd != Commands.HISTORY or len(response.data) < 5:
+            return None
+        
+        first_seq, n = struct.unpack('<IB', response.data[:5])
+        if len(response.data) < 5 + n * 13:
+            return None
+        records = [struct.unpack('<IffB', response.data[5 + i * 13:18 + i * 13]) for i in range(n)]
+        return first_seq, records
+    
+    def _datalog_command(self, op: int, payload: bytes = b'', timeout: float = 1.0) -> Optional[dict]:
+        """数据日志状态类子命令（0=查询 1=设置周期 2=校时 3=写入RAM页 4=擦除），返回日志状态"""
+        response = self.protocol.send_command(Commands.DATALOG, bytes([op]) + payload, timeout=timeout)
+        if not response or response.cmd != Commands.DATALOG or len(response.data) < 28:
+            return None
+        
+        (page_size, page_count, used_pages, interval_s, oldest_seq, next_seq, boot, flags,
+         pending_count, time_s, lost) = struct.unpack('<HHHHIIHBBII', response.data[:28])
+        return {
+            'page_size': page_size,
+            'page_count': page_count,
+            'used_pages': used_pages,
+            'interval_s': interval_s,
+            'oldest_seq': oldest_seq,
+            'next_seq': next_seq,
+            'boot': boot,
+            'time_synced': bool(flags & 0x01),
+            'pending_count': pending_count,
+            'time_s': time_s,
+            'lost': lost,
+        }
+    
+    def datalog_status(self) -> Optional[dict]:
+        """
+        查询长期数据日志状态
+        
+        Returns:
+            {'page_size', 'page_count', 'used_pages', 'interval_s', 'oldest_seq', 'next_seq',
+             'boot', 'time_synced', 'pending_count', 'time_s', 'lost'}，
+            oldest_seq为Flash中第一页的序号，next_seq为RAM页的序号，失败返回None
+        """
+        return self._datalog_command(0)
+    
+    def datalog_set_interval(self, interval_s: int) -> Optional[dict]:
+        """
+        设置统计周期（先写入RAM页中的记录），需save_param()才能掉电保存
+        
+        Args:
+            interval_s: 统计周期 1~3600 s
+            
+        Returns:
+            设置后的日志状态，参数无效或失败返回None
+        """
+        return self._datalog_command(1, struct.pack('<H', interval_s))
+    
+    def datalog_set_time(self, unix_s: int) -> Optional[dict]:
+        """
+        校时，本次上电期间写入的页使用UNIX时间
+        
+        Args:
+            unix_s: 当前UNIX时间 (s)
+            
+        Returns:
+            校时后的日志状态，失败返回None
+        """
+        return self._datalog_command(2, struct.pack('<I', unix_s & 0xFFFFFFFF))
+    
+    def datalog_flush(self) -> Optional[dict]:
+        """
+        立即将RAM页写入Flash（未写满的页也占用一整页）
+        
+        Returns:
+            写入后的日志状态，失败返回None
+        """
+        return self._datalog_command(3)
+    
+    def datalog_erase(self) -> Optional[dict]:
+        """
+        擦除全部数据日志（设备阻塞1~2s，页序号继续递增）
+        
+        Returns:
+            擦除后的日志状态，失败返回None
+        """
+        return self._datalog_command(4, timeout=5.0)
+    
+    def datalog_read(self, offset: int, pending: bool = False,
+                     length: int = DATALOG_BYTES_PER_FRAME) -> Optional[bytes]:
+        """
+        读出日志数据
+        
+        Args:
+            offset: Flash日志区域内的偏移，pending为True时为RAM页内的偏移
+            pending: 读RAM页（尚未写入Flash的记录）
+            length: 最多读出字节数（不超过DATALOG_BYTES_PER_FRAME）
+            
+        Returns:
+            数据，已用页（或RAM页有效长度）之外为空，失败返回None
+        """
+        length = min(length, DATALOG_BYTES_PER_FRAME)
+        response = self.protocol.send_command(
+            Commands.DATALOG, struct.pack('<BIB', 6 if pending else 5, offset, length))
+        if not response or response.cmd != Commands.DATALOG or len(response.data) < 5:
+            return None
+        
+        _offset, n = struct.unpack('<IB', response.data[:5])
+        if len(response.data) < 5 + n:
+            return None
+        return response.data[5:5 + n]
+    
+    def datalog_read_pages(self, status: dict, start_seq: int = 0,
+                           progress_callback=None) -> Optional[list]:
+        """
+        读出Flash中的日志页和RAM页
+        
+        Args:
+            status: datalog_status()返回值
+            start_seq: 只读出序号不小于此值的页（已保存过的页不再读）
+            progress_callback: 进度回调 (已读字节, 总字节)
+            
+        Returns:
+            按序号排列的页数据列表（最后一项为RAM页），失败返回None
+        """
+        page_size = status['page_size']
+        first = max(0, min(start_seq - status['oldest_seq'], status['used_pages']))
+        offset = first * page_size
+        end = status['used_pages'] * page_size
+        data = bytearray()
+        while offset < end:
+            chunk = self.datalog_read(offset)
+            if not chunk:
+                return None
+            data += chunk
+            offset += len(chunk)
+            if progress_callback:
+                progress_callback(offset - first * page_size, end - first * page_size)
+        pages = [bytes(data[i:i + page_size]) for i in range(0, len(data), page_size)]
+        
+        # RAM页可能在两帧之间追加记录或写入Flash，长度与页头不符时重读
+        for _ in range(3):
+            pending = bytearray()
+            while True:
+                chunk = self.datalog_read(len(pending), pending=True)
+                if chunk is None:
+                    return None
+                if not chunk:
+                    break
+                pending += chunk
+            if len(pending) >= 24 and len(pending) == 24 + struct.unpack_from('<H', pending, 20)[0]:
+                pages.append(bytes(pending))
+                return pages
+        return None
+    
+    def _stats_command(self, op: int, payload: bytes = b'') -> Optional[dict]:
+        """统计子命令（0=读取 1=设置窗口 2=清空 3=Allan偏差开关），返回全部统计"""
+        response = self.protocol.send_command(Commands.STATS, bytes([op]) + payload)
+        if not response or response.cmd != Commands.STATS or len(response.data) < 8:
+            return None
+        
+        data = response.data
+        skipped, windows, levels, adev_enabled, _rsv = struct.unpack('<IBBBB', data[:8])
+        if len(data) < 8 + windows * 56 + 8 + levels * 4:
+            return None
+        
+        def result(pos):
+            count, mean, std, low, high, p2p = struct.unpack('<Ifffff', data[pos:pos + 24])
+            return {'count': count, 'mean': mean, 'std': std, 'min': low, 'max': high,
+                    'p2p': p2p}
+        
+        window_list = []
+        pos = 8
+        for _ in range(windows):
+            length, completed = struct.unpack('<II', data[pos:pos + 8])
+            window_list.append({'length': length, 'completed': completed,
+                                'current': result(pos + 8), 'last': result(pos + 32)})
+            pos += 56
+        
+        samples, elapsed_ms = struct.unpack('<II', data[pos:pos + 8])
+        values = struct.unpack(f'<{levels}f', data[pos + 8:pos + 8 + levels * 4])
+        tau0 = elapsed_ms / 1000.0 / (samples - 1) if samples > 1 else 0.0
+        adev = []
+        for j, value in enumerate(values):
+            pairs = samples // (1 << j) - 1
+            if pairs > 0:
+                adev.append({'tau': tau0 * (1 << j), 'adev': value, 'pairs': pairs})
+        
+        return {
+            'skipped': skipped,
+            'windows': window_list,
+            'adev_enabled': bool(adev_enabled),
+            'adev_samples': samples,
+            'tau0': tau0,
+            'adev': adev,
+        }
+    
+    def get_stats(self) -> Optional[dict]:
+        """
+        读取设备端温度统计（覆盖每一次测量，一次读出全部窗口与Allan偏差；
+        按未经滑动平均的单次测量温度累计，σ与小τ的Allan偏差反映真实噪声）
+        
+        Returns:
+            {'skipped', 'windows', 'adev_enabled', 'adev_samples', 'tau0', 'adev'}，
+            windows每项为 {'length', 'completed', 'current', 'last'}，current/last为
+            {'count', 'mean', 'std', 'min', 'max', 'p2p'}（K）；
+            adev为 [{'tau'(s), 'adev'(K), 'pairs'}, ...]，只列出已有差分的层；失败返回None
+        """
+        return self._stats_command(0)
+    
+    def set_stats_window(self, index: int, length: int) -> Optional[dict]:
+        """
+        设置统计窗口长度（清空该窗口，不保存到参数）
+        
+        Args:
+            index: 窗口编号
+            length: 窗口长度（测量次数），0=自清空起累计
+            
+        Returns:
+            设置后的统计，编号无效或失败返回None
+        """
+        return self._stats_command(1, struct.pack('<BI', index, length))
+    
+    def reset_stats(self) -> Optional[dict]:
+        """
+        清空全部统计窗口与Allan偏差累计
+        
+        Returns:
+            清空后的统计，失败返回None
+        """
+        return self._stats_command(2)
+    
+    def enable_adev(self, enable: bool = True) -> Optional[dict]:
+        """
+        开始（先清空）或停止Allan偏差累计
+        
+        Args:
+            enable: True=开始, False=停止并保留结果
+            
+        Returns:
+            设置后的统计，失败返回None
+        """
+        return self._stats_command(3, bytes([1 if enable else 0]))
+    
+    def _alarm_command(self, op: int, payload: bytes = b'') -> Optional[dict]:
+        """报警子命令（0=读取 1=设置 2=清零触发次数），返回设置与状态"""
+        response = self.protocol.send_command(Commands.ALARM, bytes([op]) + payload)
+        if not response or response.cmd != Commands.ALARM or len(response.data) < 44:
+            return None
+        
+        (active, enable, fault, output_fault, event_seq, rate_K_s, *trips) = \
+            struct.unpack('<BBBBIf4H', response.data[:20])
+        high_K, low_K, hyst_K, rate_limit, rate_hyst, fault_mA = \
+            struct.unpack('<6f', response.data[20:44])
+        return {
+            'active': active,
+            'enable': enable,
+            'fault': fault,
+            'output_fault': bool(output_fault),
+            'event_seq': event_seq,
+            'rate_K_s': rate_K_s,
+            'trips': dict(zip(ALARM_NAMES, trips)),
+            'high_K': high_K,
+            'low_K': low_K,
+            'hyst_K': hyst_K,
+            'rate_limit_K_s': rate_limit,
+            'rate_hyst_K_s': rate_hyst,
+            'fault_mA': fault_mA,
+        }
+    
+    def get_alarm(self) -> Optional[dict]:
+        """
+        读取报警设置与状态
+        
+        Returns:
+            {'active', 'enable', 'fault', 'output_fault', 'event_seq', 'rate_K_s', 'trips',
+            'high_K', 'low_K', 'hyst_K', 'rate_limit_K_s', 'rate_hyst_K_s', 'fault_mA'}，
+            active/enable/fault为报警位 (ALARM_xxx)，trips为 {名称: 触发次数}；失败返回None
+        """
+        return self._alarm_command(0)
+    
+    def set_alarm(self, enable: int, fault: int = 0, high_K: float = 0.0, low_K: float = 0.0,
+                  hyst_K: float = 0.0, rate_K_s: float = 0.0, rate_hyst_K_s: float = 0.0,
+                  fault_mA: float = ALARM_FAULT_CURRENT_DEFAULT) -> Optional[dict]:
+        """
+        设置报警（清除当前报警，下一次测量重新判断；不保存到参数）
+        
+        Args:
+            enable: 启用的报警位 (ALARM_xxx)，0=全部关闭
+            fault: 触发时强制输出故障电流的报警位
+            high_K: 上限 (K)，超过时触发，低于 上限-回差 时解除
+            low_K: 下限 (K)，低于时触发，高于 下限+回差 时解除
+            hyst_K: 上下限回差 (K)
+            rate_K_s: 变化率上限 (K/s，按绝对值)
+            rate_hyst_K_s: 变化率回差 (K/s)，需小于变化率上限
+            fault_mA: 故障电流 (mA)，3.6~21.0
+        
+        Returns:
+            设置后的状态，参数无效或失败返回None
+        """
+        payload = struct.pack('<BB6f', enable, fault, high_K, low_K, hyst_K,
+                              rate_K_s, rate_hyst_K_s, fault_mA)
+        return self._alarm_command(1, payload)
+    
+    def clear_alarm_trips(self) -> Optional[dict]:
+        """
+        清零各报警的触发次数
+        
+        Returns:
+            清零后的状态，失败返回None
+        """
+        return self._alarm_command(2)
+    
     def load_table_start(self, point_count: int) -> bool:
         """
         分度表下载开始
@@ -286,14 +1299,18 @@ class DeviceAPI:
         response = self.protocol.send_command(Commands.LOAD_TABLE_DATA, data)
         return self._check_ack(response)
     
-    def load_table_end(self) -> bool:
+    def load_table_end(self, crc: Optional[int] = None) -> bool:
         """
         分度表下载结束
         
+        Args:
+            crc: 全部数据点的CRC32（与设备写入后回读计算的值比对），None表示不校验
+            
         Returns:
             是否成功
         """
-        response = self.protocol.send_command(Commands.LOAD_TABLE_END)
+        data = struct.pack('<I', crc) if crc is not None else b''
+        response = self.protocol.send_command(Commands.LOAD_TABLE_END, data)
         return self._check_ack(response)
     
     def download_table(self, table_parser, progress_callback=None) -> Tuple[bool, str]:
@@ -320,29 +1337,29 @@ class DeviceAPI:
         logger.info(f"开始下载分度表，共{point_count}个数据点")
         
         # 2. 分包发送数据
-        packets = table_parser.get_packets(points_per_packet=32)
+        packets = table_parser.get_packets(points_per_packet=TABLE_POINTS_PER_PACKET)
         total_packets = len(packets)
         
         for i, (packet_index, packet_data) in enumerate(packets):
-            if not self.load_table_data(packet_index, packet_data):
+            # get_packets()的数据已含包序号，这里只取数据点
+            if not self.load_table_data(packet_index, packet_data[2:]):
                 return False, f"发送数据包{packet_index}失败"
             
             # 进度回调
             if progress_callback:
                 progress_callback(i + 1, total_packets)
         
-        # 3. 发送结束命令
-        if not self.load_table_end():
+        # 3. 发送结束命令，附带数据点CRC32（跳过8字节表头）
+        crc = zlib.crc32(table_parser.to_binary()[8:])
+        if not self.load_table_end(crc):
             return False, "发送结束命令失败"
         
         logger.info(f"分度表下载完成，共发送{total_packets}个数据包")
         return True, f"下载成功，共{point_count}个数据点"
     
     def _check_ack(self, response: Optional[Frame]) -> bool:
-        """检查响应是否成功"""
-        if response and response.cmd == Commands.ACK:
-            if len(response.data) >= 2:
-                status = response.data[1]
-                return status == StatusCode.OK
+        """检查响应是否成功（固件ACK为[状态]，模拟设备为[命令, 状态]，均取最后一字节）"""
+        if response and response.cmd == Commands.ACK and response.data:
+            return response.data[-1] == StatusCode.OK
         return False
 
@@ -0,0 +1,340 @@
+"""
+协议负载生成模块
+
+按给定的命令组合和目标速率向设备（真实串口或vtm02的伪终端）发送请求，
+统计往返延迟分位数、吞吐量、CRC错误与重新同步次数，用于检查协议与帧解析
+修改前后的性能回归
+
+- 目标速率为0时闭环运行：窗口内的请求一收到响应就发下一条
+- 指定速率时按固定间隔开环发送，窗口已满则等待；此时另给出从计划发送时刻
+  算起的延迟，发送被积压的时间也计入（避免只统计实际发出的请求而低估排队）
+- 窗口大于1时多条请求同时在途，响应按发送顺序匹配；
+  固件的ACK帧不含原命令码，按最早的在途请求匹配
+"""
+
+import random
+import time
+import unicodedata
+from collections import deque
+from dataclasses import dataclass, field
+from typing import Dict, List, Optional, Tuple
+
+from .protocol import Protocol, Frame
+from .commands import Commands, StatusCode
+
+
+# 默认命令组合：只读命令，不改变设备状态
+DEFAULT_MIX = 'GET_TEMPERATURE=4,GET_VOLTAGE=2,GET_CURRENT=2,GET_STATUS=1,GET_DEVICE_ID=1'
+
+# 故意损坏CRC的请求的统计名称
+CORRUPT_NAME = 'corrupt'
+
+
+@dataclass
+class MixEntry:
+    """命令组合中的一项"""
+    name: str               # 显示名称
+    cmd: int                # 命令码
+    data: bytes             # 命令数据
+    weight: float           # 权重
+
+
+@dataclass
+class CommandStats:
+    """单个命令的统计"""
+    sent: int = 0
+    ok: int = 0
+    nack: int = 0
+    timeouts: int = 0
+    latencies: List[float] = field(default_factory=list)    # 往返延迟 (s)
+
+
+@dataclass
+class LoadResult:
+    """负载测试结果"""
+    elapsed: float = 0.0
+    sent: int = 0
+    completed: int = 0
+    timeouts: int = 0
+    unexpected: int = 0
+    crc_errors: int = 0
+    resync_count: int = 0
+    resync_bytes: int = 0
+    latencies: List[float] = field(default_factory=list)
+    sched_latencies: List[float] = field(default_factory=list)
+    commands: Dict[str, CommandStats] = field(default_factory=dict)
+
+
+def parse_mix(spec: str) -> List[MixEntry]:
+    """
+    解析命令组合
+    
+    Args:
+        spec: 逗号分隔的 名称[:十六进制数据]=权重，名称为Commands中的常量名或
+              0x开头的命令码，例如 "GET_TEMPERATURE=4,GET_TRACE:00=1,0x64:00=1"
+    
+    Returns:
+        命令组合列表
+    
+    Raises:
+        ValueError: 格式错误或命令名未知
+    """
+    entries = []
+    for item in spec.split(','):
+        item = item.strip()
+        if not item:
+            continue
+        name, _, weight = item.partition('=')
+        name, _, data = name.partition(':')
+        if name.lower().startswith('0x'):
+            cmd = int(name, 16)
+        elif hasattr(Commands, name.upper()):
+            cmd = getattr(Commands, name.upper())
+        else:
+            raise ValueError(f'未知命令: {name}')
+        label = name.upper() + (f':{data}' if data else '')
+        entries.append(MixEntry(label, cmd, bytes.fromhex(data), float(weight or 1)))
+    if not entries:
+        raise ValueError('命令组合为空')
+    return entries
+
+
+def percentile(sorted_values: List[float], p: float) -> float:
+    """
+    分位数（最近秩法）
+    
+    Args:
+        sorted_values: 已排序的数据
+        p: 百分位 (0~100)
+    
+    Returns:
+        分位数，无数据时返回0
+    """
+    if not sorted_values:
+        return 0.0
+    rank = int(len(sorted_values) * p / 100.0 + 0.999999) - 1
+    return sorted_values[min(max(rank, 0), len(sorted_values) - 1)]
+
+
+class LoadGenerator:
+    """协议负载生成器"""
+    
+    def __init__(self, protocol: Protocol, mix: List[MixEntry], rate: float = 0.0,
+                 window: int = 1, timeout: float = 1.0, corrupt: float = 0.0,
+                 seed: int = 1):
+        """
+        Args:
+            protocol: 已连接的协议实例
+            mix: 命令组合
+            rate: 目标速率 (请求/s)，0=闭环尽快发送
+            window: 最大在途请求数
+            timeout: 单条请求超时 (s)
+            corrupt: 故意损坏CRC的请求比例 (0~1)，检查设备解析器的出错恢复
+            seed: 随机数种子（命令选择与损坏位置可复现）
+        """
+        self.protocol = protocol
+        self.mix = mix
+        self.rate = rate
+        self.window = max(1, window)
+        self.timeout = timeout
+        self.corrupt = corrupt
+        self.rng = random.Random(seed)
+    
+    def _next_request(self) -> Tuple[str, int, bytes, bool]:
+        """选择下一条请求，返回 (名称, 命令码, 帧字节, 是否损坏)"""
+        entry = self.rng.choices(self.mix, weights=[e.weight for e in self.mix])[0]
+        raw = bytearray(Frame(cmd=entry.cmd, data=entry.data).to_bytes())
+        if self.corrupt and self.rng.random() < self.corrupt:
+            # 损坏CRC低字节，设备应回复CRC错误并继续解析后续帧
+            raw[-3] ^= 0xFF
+            return CORRUPT_NAME, entry.cmd, bytes(raw), True
+        return entry.name, entry.cmd, bytes(raw), False
+    
+    def run(self, duration: float = 10.0, count: int = 0,
+            progress=None) -> LoadResult:
+        """
+        运行负载测试
+        
+        Args:
+            duration: 持续时间 (s)，count非0时忽略
+            count: 请求总数，0=按时间
+            progress: 每秒回调一次 progress(result)，可为None
+        
+        Returns:
+            测试结果
+        """
+        proto = self.protocol
+        result = LoadResult()
+        base_crc = proto.crc_errors
+        base_resync = proto.resync_count
+        base_resync_bytes = proto.resync_bytes
+        
+        # 在途请求: (名称, 命令码, 是否损坏, 计划时刻, 发送时刻)
+        pending = deque()
+        interval = 1.0 / self.rate if self.rate > 0 else 0.0
+        start = time.perf_counter()
+        next_send = start
+        next_progress = start + 1.0
+        end = start + duration
+        
+        def stats(name: str) -> CommandStats:
+            return result.commands.setdefault(name, CommandStats())
+        
+        def done_sending(now: float) -> bool:
+            return (result.sent >= count) if count else (now >= end)
+        
+        while True:
+            now = time.perf_counter()
+            
+            # 发送：窗口未满且到了计划时刻
+            while (len(pending) < self.window and not done_sending(now) and
+                   (interval == 0.0 or now >= next_send)):
+                name, cmd, raw, corrupted = self._next_request()
+                proto.serial.write(raw)
+                sent_at = time.perf_counter()
+                sched = next_send if interval else sent_at
+                pending.append((name, cmd, corrupted, sched, sent_at))
+                stats(name).sent += 1
+                result.sent += 1
+                next_send += interval
+                now = sent_at
+            
+            if not pending:
+                if done_sending(now):
+                    break
+                time.sleep(max(0.0, next_send - now))
+                continue
+            
+            # 接收：最多等到下一次计划发送或最早在途请求超时
+            wait = pending[0][4] + self.timeout - now
+            if interval and len(pending) < self.window and not done_sending(now):
+                wait = min(wait, next_send - now)
+            frame = proto.receive_frame(timeout=max(wait, 0.0005))
+            now = time.perf_counter()
+            
+            if frame is not None:
+                self._match(frame, pending, result, now)
+            else:
+                while pending and now - pending[0][4] >= self.timeout:
+                    result.commands[pending.popleft()[0]].timeouts += 1
+                    result.timeouts += 1
+            
+            if progress and now >= next_progress:
+                next_progress += 1.0
+                result.elapsed = now - start
+                progress(result)
+        
+        result.elapsed = time.perf_counter() - start
+        result.crc_errors = proto.crc_errors - base_crc
+        result.resync_count = proto.resync_count - base_resync
+        result.resync_bytes = proto.resync_bytes - base_resync_bytes
+        return result
+    
+    def _match(self, frame: Frame, pending: deque, result: LoadResult, now: float):
+        """按发送顺序把响应匹配到在途请求"""
+        is_ack = frame.cmd == Commands.ACK
+        index = None
+        for i, (_name, cmd, corrupted, _sched, _sent) in enumerate(pending):
+            if is_ack or (frame.cmd == cmd and not corrupted):
+                index = i
+                break
+        if index is None:
+            result.unexpected += 1
+            return
+        
+        # 排在前面却没有响应的请求已丢失
+        for _ in range(index):
+            result.commands[pending.popleft()[0]].timeouts += 1
+            result.timeouts += 1
+        
+        name, _cmd, corrupted, sched, sent_at = pending.popleft()
+        st = result.commands[name]
+        status = frame.data[-1] if is_ack and frame.data else StatusCode.OK
+        expected = StatusCode.CRC_ERROR if corrupted else StatusCode.OK
+        if status != expected:
+            st.nack += 1
+            return
+        
+        st.ok += 1
+        st.latencies.append(now - sent_at)
+        result.completed += 1
+        result.latencies.append(now - sent_at)
+        result.sched_latencies.append(now - sched)
+
+
+def summarize(result: LoadResult) -> dict:
+    """
+    汇总测试结果（延迟单位ms）
+    
+    Returns:
+        可直接json.dump的字典
+    """
+    lat = sorted(result.latencies)
+    sched = sorted(result.sched_latencies)
+    summary = {
+        'elapsed_s': round(result.elapsed, 3),
+        'sent': result.sent,
+        'completed': result.completed,
+        'throughput': round(result.completed / result.elapsed, 1) if result.elapsed else 0.0,
+        'timeouts': result.timeouts,
+        'unexpected': result.unexpected,
+        'crc_errors': result.crc_errors,
+        'resync_count': result.resync_count,
+        'resync_bytes': result.resync_bytes,
+        'p50_ms': round(percentile(lat, 50) * 1e3, 3),
+        'p99_ms': round(percentile(lat, 99) * 1e3, 3),
+        'p999_ms': round(percentile(lat, 99.9) * 1e3, 3),
+        'max_ms': round(lat[-1] * 1e3, 3) if lat else 0.0,
+        'sched_p99_ms': round(percentile(sched, 99) * 1e3, 3),
+        'sched_p999_ms': round(percentile(sched, 99.9) * 1e3, 3),
+        'commands': {},
+    }
+    for name, st in sorted(result.commands.items()):
+        values = sorted(st.latencies)
+        summary['commands'][name] = {
+            'sent': st.sent,
+            'ok': st.ok,
+            'nack': st.nack,
+            'timeouts': st.timeouts,
+            'p50_ms': round(percentile(values, 50) * 1e3, 3),
+            'p99_ms': round(percentile(values, 99) * 1e3, 3),
+            'max_ms': round(values[-1] * 1e3, 3) if values else 0.0,
+        }
+    return summary
+
+
+def _pad(text: str, width: int, right: bool = False) -> str:
+    """按终端显示宽度补齐（中文字符占2列）"""
+    cols = sum(2 if unicodedata.east_asian_width(c) in 'WF' else 1 for c in text)
+    fill = ' ' * max(width - cols, 0)
+    return fill + text if right else text + fill
+
+
+def format_summary(summary: dict, rate: float = 0.0) -> str:
+    """
+    格式化为文本表格
+    
+    Args:
+        summary: summarize()的返回值
+        rate: 目标速率，非0时显示从计划时刻算起的延迟
+    """
+    lines = [
+        f"{summary['sent']} 请求, {summary['completed']} 完成, "
+        f"{summary['elapsed_s']:.1f} s, 吞吐 {summary['throughput']:.1f} 次/s",
+        f"延迟 p50 {summary['p50_ms']:.3f} ms  p99 {summary['p99_ms']:.3f} ms  "
+        f"p99.9 {summary['p999_ms']:.3f} ms  最大 {summary['max_ms']:.3f} ms",
+    ]
+    if rate:
+        lines.append(f"按计划时刻 p99 {summary['sched_p99_ms']:.3f} ms  "
+                     f"p99.9 {summary['sched_p999_ms']:.3f} ms")
+    lines.append(f"超时 {summary['timeouts']}  意外响应 {summary['unexpected']}  "
+                 f"CRC错误 {summary['crc_errors']}  重新同步 {summary['resync_count']} 次"
+                 f"（丢弃 {summary['resync_bytes']} 字节）")
+    lines.append('')
+    lines.append(_pad('命令', 24) + _pad('发送', 8, True) + _pad('成功', 8, True) +
+                 _pad('NACK', 6, True) + _pad('超时', 6, True) + _pad('p50 ms', 10, True) +
+                 _pad('p99 ms', 10, True) + _pad('最大 ms', 10, True))
+    for name, st in summary['commands'].items():
+        lines.append(f"{name:<24}{st['sent']:>8}{st['ok']:>8}{st['nack']:>6}{st['timeouts']:>6}"
+                     f"{st['p50_ms']:>10.3f}{st['p99_ms']:>10.3f}{st['max_ms']:>10.3f}")
+    return '\n'.join(lines)
@@ -5,8 +5,9 @@
 """
 
 import struct
+from collections import deque
 from dataclasses import dataclass
-from typing import Optional, List
+from typing import Callable, Optional, List
 import serial
 import serial.tools.list_ports
 from loguru import logger
@@ -16,6 +17,12 @@ from loguru import logger
 FRAME_HEAD = 0xAA
 FRAME_TAIL = 0x55
 
+# 命令码不小于此值的帧为设备主动上报（事件），不作为命令响应
+EVENT_CMD_MIN = 0xF0
+
+# 未取走的事件最多保留条数
+EVENT_QUEUE_SIZE = 256
+
 
 @dataclass
 class Frame:
@@ -75,6 +82,15 @@ class Protocol:
         self.connected = False
         self.rx_buffer = bytearray()
         
+        # 接收统计：CRC错误帧数、为重新同步丢弃字节的次数及字节数
+        self.crc_errors = 0
+        self.resync_count = 0
+        self.resync_bytes = 0
+        
+        # 主动上报的事件帧：等待响应时收到的事件存入队列并调用回调
+        self.events = deque(maxlen=EVENT_QUEUE_SIZE)
+        self.event_callback: Optional[Callable[[Frame], None]] = None
+    
     @staticmethod
     def crc16(data: bytes) -> int:
         """
@@ -182,39 +198,143 @@ class Protocol:
         self.serial.timeout = timeout
         
         try:
-            # 读取数据
             while True:
-                byte = self.serial.read(1)
-                if not byte:
-                    break
-                    
-                self.rx_buffer.append(byte[0])
-                
-                # 查找帧头
-                while len(self.rx_buffer) > 0 and self.rx_buffer[0] != FRAME_HEAD:
-                    self.rx_buffer.pop(0)
+                # 上次读入的数据中可能已有完整帧
+                frame = self._extract_frame()
+                if frame:
+                    if frame.cmd >= EVENT_CMD_MIN:
+                        self._dispatch_event(frame)
+                        continue
+                    return frame
                 
-                # 检查帧完整性
-                if len(self.rx_buffer) >= 6:
-                    length = self.rx_buffer[2] if len(self.rx_buffer) > 2 else 0
-                    frame_len = 6 + length
-                    
-                    if len(self.rx_buffer) >= frame_len:
-                        frame_data = bytes(self.rx_buffer[:frame_len])
-                        self.rx_buffer = self.rx_buffer[frame_len:]
-                        
-                        frame = Frame.from_bytes(frame_data)
-                        if frame:
-                            logger.debug(f"接收: {frame_data.hex().upper()}")
-                            return frame
-                            
+                # 读取已到达的全部数据，无数据时等待1字节
+                data = self.serial.read(max(1, self.serial.in_waiting))
+                if not data:
+                    break
+                self.rx_buffer.extend(data)
+        
         except Exception as e:
             logger.error(f"接收失败: {e}")
+        
+        return None
+    
+    def poll_events(self, timeout: float = 0.0) -> List[Frame]:
+        """
+        读入已到达的数据并取走全部事件帧
+        
+        空闲时（不在等待命令响应）定时调用；此时收到的非事件帧为迟到的响应，丢弃
+        
+        Args:
+            timeout: 无数据时最多等待的时间(秒)，0为不等待
+        
+        Returns:
+            事件帧列表（含等待命令响应期间收到的），按接收顺序
+        """
+        if self.connected and self.serial:
+            self.serial.timeout = timeout
+            try:
+                data = self.serial.read(max(1, self.serial.in_waiting))
+                self.rx_buffer.extend(data)
+            except Exception as e:
+                logger.error(f"接收失败: {e}")
             
+            while True:
+                frame = self._extract_frame()
+                if frame is None:
+                    break
+                if frame.cmd >= EVENT_CMD_MIN:
+                    self._dispatch_event(frame)
+                else:
+                    logger.debug(f"丢弃迟到的响应: 0x{frame.cmd:02X}")
+        
+        events = list(self.events)
+        self.events.clear()
+        return events
+    
+    def _dispatch_event(self, frame: Frame):
+        """
+        保存事件帧并调用回调
+        
+        Args:
+            frame: 事件帧
+        """
+        self.events.append(frame)
+        if self.event_callback is not None:
+            try:
+                self.event_callback(frame)
+            except Exception as e:
+                logger.error(f"事件回调失败: {e}")
+    
+    def _extract_frame(self) -> Optional[Frame]:
+        """
+        从接收缓冲区取出一个完整帧
+        
+        帧尾或CRC错误时只丢弃帧头字节，从下一个0xAA重新同步，
+        避免数据中的0xAA被误认为帧头时连带丢掉后面的正确帧
+        
+        Returns:
+            帧，缓冲区中没有完整帧时返回None
+        """
+        while True:
+            # 查找帧头
+            skip = 0
+            while skip < len(self.rx_buffer) and self.rx_buffer[skip] != FRAME_HEAD:
+                skip += 1
+            if skip:
+                del self.rx_buffer[:skip]
+                self.resync_count += 1
+                self.resync_bytes += skip
+            
+            # 检查帧完整性：不完整时若后面已有完整的正确帧，说明当前帧头是误判
+            if len(self.rx_buffer) < 6:
+                return None
+            frame_len = 6 + self.rx_buffer[2]
+            if len(self.rx_buffer) < frame_len:
+                skip = self._find_valid_frame(1)
+                if skip is None:
+                    return None
+                del self.rx_buffer[:skip]
+                self.resync_count += 1
+                self.resync_bytes += skip
+                continue
+            
+            frame_data = bytes(self.rx_buffer[:frame_len])
+            if frame_data[-1] == FRAME_TAIL:
+                frame = Frame.from_bytes(frame_data)
+                if frame:
+                    del self.rx_buffer[:frame_len]
+                    logger.debug(f"接收: {frame_data.hex().upper()}")
+                    return frame
+                self.crc_errors += 1
+            
+            # 丢弃帧头，重新同步
+            del self.rx_buffer[:1]
+            self.resync_count += 1
+            self.resync_bytes += 1
+    
+    def _find_valid_frame(self, start: int) -> Optional[int]:
+        """
+        在接收缓冲区中查找完整且CRC正确的帧
+        
+        Args:
+            start: 开始查找的位置
+            
+        Returns:
+            帧头位置，未找到返回None
+        """
+        buf = self.rx_buffer
+        pos = buf.find(FRAME_HEAD, start)
+        while pos >= 0 and pos + 6 <= len(buf):
+            end = pos + 6 + buf[pos + 2]
+            if end <= len(buf) and buf[end - 1] == FRAME_TAIL:
+                crc = struct.unpack('<H', buf[end - 3:end - 1])[0]
+                if crc == Protocol.crc16(buf[pos + 1:end - 3]):
+                    return pos
+            pos = buf.find(FRAME_HEAD, pos + 1)
         return None
     
     def send_command(self, cmd: int, data: bytes = b'', 
-                     wait_response: bool = True) -> Optional[Frame]:
+                     wait_response: bool = True, timeout: float = 1.0) -> Optional[Frame]:
         """
         发送命令并等待响应
         
@@ -222,6 +342,7 @@ class Protocol:
             cmd: 命令码
             data: 命令数据
             wait_response: 是否等待响应
+            timeout: 等待响应的超时时间(秒)，设备阻塞执行的命令需加长
             
         Returns:
             响应帧，不等待响应或超时返回None
@@ -232,7 +353,7 @@ class Protocol:
             return None
             
         if wait_response:
-            return self.receive_frame()
+            return self.receive_frame(timeout)
             
         return None
 
@@ -11,7 +11,11 @@ from typing import Optional, List
 from loguru import logger
 
 from .protocol import Protocol, Frame, FRAME_HEAD, FRAME_TAIL
-from .commands import Commands, StatusCode
+from .commands import (Commands, StatusCode, PROF_PROBE_NAMES, PROF_HIST_BINS,
+                       BOOT_STAGE_NAMES, POWER_PROFILE_NAMES, BENCH_FUNC_NAMES,
+                       BENCH_MODE_NAMES, ALARM_NAMES, ALARM_HIGH, ALARM_LOW, ALARM_RATE,
+                       ALARM_FAULT_CURRENT_DEFAULT)
+from ..utils.datalog import encode_page, DATALOG_PAGE_SIZE
 
 
 class SimulatorProtocol(Protocol):
@@ -32,6 +36,36 @@ class SimulatorProtocol(Protocol):
         self.sim_adj_17 = 0.0                   # 17μA调整值
         self.sim_temp_4ma = -271.0              # 4mA温度点
         self.sim_temp_20ma = 227.0              # 20mA温度点
+        self.sim_sample_period_us = 10000       # 采样周期 (μs)
+        self.sim_clock_profile = 0              # 时钟档位 (0=全速)
+        self.sim_capture_active = False         # 原始采样录制中
+        self.sim_capture_time = 0.0             # 上次生成录制记录的时刻
+        self.sim_capture_buf = []               # 未读出的录制记录
+        self.sim_capture_seq = 0                # 下一条读出记录的序号
+        self.sim_capture_recorded = 0           # 已记录条数
+        self.sim_capture_lost = 0               # 缓冲区满丢弃条数
+        self.sim_burst_state = 0                # 突发采集状态 (0=空闲 1=布防 3=完成)
+        self.sim_burst_config = (0, 0, 0, 0.0, 0.0)  # (沿, 触发前, 触发后, 电平mV, 变化率)
+        self.sim_burst_block = []               # 突发采集数据块
+        self.sim_boot_time = time.monotonic()   # 模拟设备上电时刻
+        self.sim_history_decimation = 20        # 历史记录抽取比
+        self.sim_history_base = (0, self.sim_boot_time)  # 抽取比生效时的 (序号, 时刻)
+        self.sim_history_cleared = 0            # 清空时的序号
+        self.sim_datalog_interval = 60          # 数据日志统计周期 (s)
+        self.sim_datalog_synced = False         # 已校时
+        self.sim_datalog_pages = []             # Flash中的日志页
+        self.sim_datalog_pending = b''          # RAM页
+        self.sim_datalog_oldest = 0             # Flash中第一页的序号
+        self._make_datalog()
+        self.sim_stats_windows = [20, 1200]     # 统计窗口长度
+        self.sim_stats_base = time.monotonic()  # 统计清空时刻
+        self.sim_adev_base = None               # Allan偏差开始时刻，None=未累计
+        self.sim_alarm_config = (0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, ALARM_FAULT_CURRENT_DEFAULT)
+        self.sim_alarm_active = 0               # 当前报警位
+        self.sim_alarm_seq = 0                  # 下一个报警事件的序号
+        self.sim_alarm_trips = [0] * len(ALARM_NAMES)  # 各报警触发次数
+        self.sim_alarm_last = None              # 上一次测量 (时刻, K)，用于变化率
+        self.sim_alarm_rate = 0.0               # 最近的变化率 (K/s)
         
         logger.info("模拟设备协议已初始化")
     
@@ -90,6 +124,7 @@ class SimulatorProtocol(Protocol):
             # 返回温度值（添加随机波动）
             if self.sim_running:
                 self.sim_temperature += random.uniform(-0.5, 0.5)
+                self._check_alarm()
             temp_data = struct.pack('<f', self.sim_temperature)
             return Frame(cmd=cmd, data=temp_data)
         
@@ -198,10 +233,452 @@ class SimulatorProtocol(Protocol):
             logger.info("模拟: 已恢复默认参数")
             return self._make_ack(cmd, StatusCode.OK)
         
+        elif cmd == Commands.GET_PROFILE:
+            # 返回模拟的性能探针统计（96MHz，各探针典型周期数）
+            probe = data[0] if data else 0
+            if probe >= len(PROF_PROBE_NAMES):
+                return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+            typical = (2400, 900, 36000, 5000, 7200, 90000)[probe]
+            samples = [int(typical * random.uniform(0.8, 2.0)) for _ in range(200)]
+            hist = [0] * PROF_HIST_BINS
+            for c in samples:
+                hist[min(c.bit_length() - 1, PROF_HIST_BINS - 1)] += 1
+            prof_data = bytes([probe, len(PROF_PROBE_NAMES)])
+            prof_data += struct.pack('<IIIQI', len(samples), min(samples), max(samples),
+                                     sum(samples), 96000000)
+            prof_data += struct.pack(f'<{PROF_HIST_BINS}H', *hist)
+            return Frame(cmd=cmd, data=prof_data)
+        
+        elif cmd == Commands.GET_BOOT_INFO:
+            # 返回模拟的启动计时（上电复位）
+            stages = (42100, 42300, 53900, 54200, 54800, 60100, 1055000, 480000)
+            boot_data = bytes([0x05, len(BOOT_STAGE_NAMES)]) + struct.pack('<8I', *stages)
+            return Frame(cmd=cmd, data=boot_data)
+        
+        elif cmd == Commands.SAMPLE_TIMING:
+            # 返回模拟的采样间隔抖动统计（96MHz）
+            op = data[0] if data else 0
+            if op == 2:
+                if len(data) < 5:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                period = struct.unpack('<I', data[1:5])[0]
+                self.sim_sample_period_us = min(max(period, 100), 10000000)
+            period_cycles = self.sim_sample_period_us * 96
+            count = 1000 if self.sim_running else 0
+            timing_data = struct.pack('<6I2Q3I', self.sim_sample_period_us, 96000000, count,
+                                      period_cycles - 180 if count else 0, period_cycles + 210,
+                                      210, count * 35, count * 35 * 35 * 2, 0, 3, 260)
+            return Frame(cmd=cmd, data=timing_data)
+        
+        elif cmd == Commands.POWER:
+            # 返回模拟的时钟档位与CPU负载（档位越低负载越高）
+            op = data[0] if data else 0
+            if op == 2:
+                if len(data) < 2 or data[1] >= len(POWER_PROFILE_NAMES):
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                self.sim_clock_profile = data[1]
+            hclk = 96000000 >> self.sim_clock_profile
+            base = (60 if self.sim_running else 15) << self.sim_clock_profile
+            power_data = struct.pack('<BBHHHIII', self.sim_clock_profile, len(POWER_PROFILE_NAMES),
+                                     base, base * 3, base + random.randint(0, base // 2),
+                                     hclk, 12000, 12000)
+            return Frame(cmd=cmd, data=power_data)
+        
+        elif cmd == Commands.BENCH:
+            # 返回模拟的热路径自测结果（96MHz，3个等待周期，加速器全开），采集中回复忙
+            if self.sim_running:
+                return self._make_ack(cmd, StatusCode.BUSY)
+            typical = ((160, 175, 420), (40, 44, 95), (260, 300, 980), (250, 290, 960),
+                       (0, 520, 1400), (0, 9300, 21000))
+            bench_data = struct.pack('<BBBBI', len(BENCH_FUNC_NAMES), len(BENCH_MODE_NAMES),
+                                     0x07, 3, 96000000)
+            for func in typical:
+                for cycles in func:
+                    if cycles == 0:
+                        bench_data += struct.pack('<III', 0, 0, 0)
+                        continue
+                    bench_data += struct.pack('<III', cycles, cycles + random.randint(20, 120),
+                                              cycles + random.randint(0, 20))
+            return Frame(cmd=cmd, data=bench_data)
+        
+        elif cmd == Commands.CAPTURE:
+            # 按经过的时间生成原始码值（增益1、参考电压2.5V，电压在模拟值附近抖动）
+            op = data[0] if data else 0
+            self._fill_capture()
+            if op == 3:
+                limit = data[1] if len(data) >= 2 and 0 < data[1] < 41 else 41
+                chunk = self.sim_capture_buf[:limit]
+                del self.sim_capture_buf[:limit]
+                cap_data = struct.pack('<IB', self.sim_capture_seq, len(chunk))
+                for raw, dt_us in chunk:
+                    cap_data += raw.to_bytes(3, 'little') + dt_us.to_bytes(3, 'little')
+                self.sim_capture_seq += len(chunk)
+                return Frame(cmd=cmd, data=cap_data)
+            if op == 1:
+                self.sim_capture_active = True
+                self.sim_capture_time = time.monotonic()
+                self.sim_capture_buf = []
+                self.sim_capture_seq = 0
+                self.sim_capture_recorded = 0
+                self.sim_capture_lost = 0
+            elif op == 2:
+                self.sim_capture_active = False
+            elif op != 0:
+                return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+            cap_data = struct.pack('<BBHIffffHHHHII', int(self.sim_capture_active),
+                                   self.sim_current_source, 0, self.sim_sample_period_us,
+                                   1.0, 2.5, self.sim_temp_4ma, self.sim_temp_20ma, 0,
+                                   511, len(self.sim_capture_buf), 0,
+                                   self.sim_capture_recorded, self.sim_capture_lost)
+            return Frame(cmd=cmd, data=cap_data)
+        
+        elif cmd == Commands.BURST:
+            # 只模拟命令触发：触发时生成完整数据块（2kHz，触发处电压阶跃-5mV）
+            op = data[0] if data else 0
+            if op == 4:
+                if self.sim_burst_state != 3:
+                    return self._make_ack(cmd, StatusCode.BUSY)
+                if len(data) < 3:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                offset = struct.unpack('<H', data[1:3])[0]
+                limit = data[3] if len(data) >= 4 and 0 < data[3] < 84 else 84
+                chunk = self.sim_burst_block[offset:offset + limit]
+                burst_data = struct.pack('<HB', offset, len(chunk))
+                for raw in chunk:
+                    burst_data += raw.to_bytes(3, 'little')
+                return Frame(cmd=cmd, data=burst_data)
+            if op == 1:
+                if len(data) < 14:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                config = struct.unpack('<BHHff', data[1:14])
+                if config[2] == 0 or config[1] + config[2] > 4096 or config[4] < 0:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                self.sim_burst_config = config
+                self.sim_burst_state = 1
+                self.sim_burst_block = []
+            elif op == 2:
+                if self.sim_burst_state != 1:
+                    return self._make_ack(cmd, StatusCode.BUSY)
+                _edge, pre, post, _level, _rate = self.sim_burst_config
+                for i in range(pre + post):
+                    voltage = self.sim_voltage + random.gauss(0.0, 0.02) - (5.0 if i >= pre else 0.0)
+                    self.sim_burst_block.append((0x800000 + int(voltage / 1250.0 * 0x800000)) & 0xFFFFFF)
+                self.sim_burst_state = 3
+            elif op == 3:
+                self.sim_burst_state = 0
+                self.sim_burst_block = []
+            elif op != 0:
+                return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+            edge, pre, post, level, rate = self.sim_burst_config
+            done = self.sim_burst_state == 3
+            burst_data = struct.pack('<BBBBHHHHHHffIIff', self.sim_burst_state,
+                                     3 if done else 0, edge, 0, pre, post,
+                                     pre if done else 0, post if done else 0, 4096, 0,
+                                     level, rate, 500000 if done else 0,
+                                     500000 if done else 0, 1.0, 2.5)
+            return Frame(cmd=cmd, data=burst_data)
+        
+        elif cmd == Commands.HISTORY:
+            # 每次测量5个采样周期，每抽取比次测量产生一条记录
+            op = data[0] if data else 0
+            next_seq = self._history_next_seq()
+            now_ms = int((time.monotonic() - self.sim_boot_time) * 1000)
+            oldest = max(next_seq - 1024, self.sim_history_cleared)
+            if op == 3:
+                if len(data) < 5:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                seq = max(struct.unpack('<I', data[1:5])[0], oldest)
+                limit = data[5] if len(data) >= 6 and 0 < data[5] < 18 else 18
+                interval_ms = self._history_interval() * 1000
+                hist_data = bytearray()
+                count = 0
+                while count < limit and seq + count < next_seq:
+                    time_ms = int(now_ms - (next_seq - 1 - seq - count) * interval_ms)
+                    temp_k = self.sim_temperature + 273.15 + random.gauss(0.0, 0.01)
+                    hist_data += struct.pack('<IffB', time_ms & 0xFFFFFFFF, temp_k,
+                                             self.sim_voltage, 0)
+                    count += 1
+                return Frame(cmd=cmd, data=struct.pack('<IB', seq, count) + hist_data)
+            if op == 1:
+                if len(data) < 3:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                decimation = struct.unpack('<H', data[1:3])[0]
+                if not 1 <= decimation <= 60000:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                self.sim_history_base = (next_seq, time.monotonic())
+                self.sim_history_decimation = decimation
+            elif op == 2:
+                self.sim_history_cleared = next_seq
+                oldest = next_seq
+            elif op != 0:
+                return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+            return Frame(cmd=cmd, data=struct.pack('<HHHHII', 1024, self.sim_history_decimation,
+                                                   next_seq - oldest, 0, next_seq, now_ms))
+        
+        elif cmd == Commands.DATALOG:
+            op = data[0] if data else 0
+            if op in (5, 6):
+                if len(data) < 5:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                offset = struct.unpack('<I', data[1:5])[0]
+                limit = data[5] if len(data) >= 6 and 0 < data[5] < 240 else 240
+                source = b''.join(self.sim_datalog_pages) if op == 5 else self.sim_datalog_pending
+                chunk = source[offset:offset + limit]
+                return Frame(cmd=cmd, data=struct.pack('<IB', offset, len(chunk)) + chunk)
+            if op == 1:
+                if len(data) < 3:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                interval = struct.unpack('<H', data[1:3])[0]
+                if not 1 <= interval <= 3600:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                self._flush_datalog()
+                self.sim_datalog_interval = interval
+            elif op == 2:
+                if len(data) < 5:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                self.sim_datalog_synced = True
+            elif op == 3:
+                self._flush_datalog()
+            elif op == 4:
+                self.sim_datalog_oldest += len(self.sim_datalog_pages)
+                self.sim_datalog_pages = []
+            elif op != 0:
+                return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+            next_seq = self.sim_datalog_oldest + len(self.sim_datalog_pages)
+            pending_count = self.sim_datalog_pending[2] if self.sim_datalog_pending else 0
+            uptime = int(time.monotonic() - self.sim_boot_time)
+            return Frame(cmd=cmd, data=struct.pack(
+                '<HHHHIIHBBII', DATALOG_PAGE_SIZE, 512, len(self.sim_datalog_pages),
+                self.sim_datalog_interval, self.sim_datalog_oldest, next_seq, 3,
+                1 if self.sim_datalog_synced else 0, pending_count,
+                int(time.time()) if self.sim_datalog_synced else uptime, 0))
+        
+        elif cmd == Commands.STATS:
+            op = data[0] if data else 0
+            if op == 1:
+                if len(data) < 6 or data[1] >= len(self.sim_stats_windows):
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                self.sim_stats_windows[data[1]] = struct.unpack('<I', data[2:6])[0]
+            elif op == 2:
+                self.sim_stats_base = time.monotonic()
+                if self.sim_adev_base is not None:
+                    self.sim_adev_base = self.sim_stats_base
+            elif op == 3 and len(data) >= 2:
+                self.sim_adev_base = time.monotonic() if data[1] else None
+            elif op != 0:
+                return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+            return Frame(cmd=cmd, data=self._make_stats())
+        
+        elif cmd == Commands.ALARM:
+            op = data[0] if data else 0
+            if op == 1:
+                if len(data) < 27:
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                config = struct.unpack('<BB6f', data[1:27])
+                enable, fault, high, low, hyst, rate, rate_hyst, fault_mA = config
+                # 与固件相同按float比较故障电流范围
+                fault_min = struct.unpack('<f', struct.pack('<f', 3.6))[0]
+                if ((enable | fault) & ~0x0F or hyst < 0 or rate_hyst < 0
+                        or not fault_min <= fault_mA <= 21.0
+                        or (enable & ALARM_RATE and not rate_hyst < rate)
+                        or (enable & ALARM_HIGH and enable & ALARM_LOW and not low < high)):
+                    return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+                self.sim_alarm_config = config
+                self.sim_alarm_last = None
+                self.sim_alarm_rate = 0.0
+                if self.sim_alarm_active:
+                    changed = self.sim_alarm_active
+                    self.sim_alarm_active = 0
+                    self._send_alarm_event(changed)
+            elif op == 2:
+                self.sim_alarm_trips = [0] * len(ALARM_NAMES)
+            elif op != 0:
+                return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+            enable, fault = self.sim_alarm_config[:2]
+            return Frame(cmd=cmd, data=struct.pack(
+                '<BBBBIf4H6f', self.sim_alarm_active, enable, fault,
+                1 if self.sim_alarm_active & fault else 0, self.sim_alarm_seq,
+                self.sim_alarm_rate, *self.sim_alarm_trips, *self.sim_alarm_config[2:]))
+        
+        elif cmd == Commands.GET_TRACE:
+            # 返回模拟的事件跟踪记录
+            op = data[0] if data else 0
+            if op == 0:
+                self.sim_trace = self._make_trace()
+                return Frame(cmd=cmd, data=struct.pack('<HHII', len(self.sim_trace), 512, 0, 96000000))
+            elif op == 1 and len(data) >= 3:
+                index = struct.unpack('<H', data[1:3])[0]
+                chunk = getattr(self, 'sim_trace', [])[index:index + 30]
+                trace_data = struct.pack('<HB', index, len(chunk))
+                for entry in chunk:
+                    trace_data += struct.pack('<IHH', *entry)
+                return Frame(cmd=cmd, data=trace_data)
+            elif op == 2:
+                return self._make_ack(cmd, StatusCode.OK)
+            return self._make_ack(cmd, StatusCode.INVALID_PARAM)
+        
         else:
             logger.warning(f"模拟: 未知命令 0x{cmd:02X}")
             return self._make_ack(cmd, StatusCode.INVALID_CMD)
     
+    def _history_interval(self) -> float:
+        """历史记录间隔 (s)"""
+        return self.sim_history_decimation * 5 * self.sim_sample_period_us / 1e6
+    
+    def _history_next_seq(self) -> int:
+        """按经过的时间计算下一条历史记录的序号"""
+        base_seq, base_time = self.sim_history_base
+        return base_seq + int((time.monotonic() - base_time) / self._history_interval())
+    
+    def _make_stats(self) -> bytes:
+        """按经过的测量次数生成统计：白噪声σ=2mK，Allan偏差按τ^-1/2下降"""
+        period = 5 * self.sim_sample_period_us / 1e6
+        total = int((time.monotonic() - self.sim_stats_base) / period)
+        temp_k = self.sim_temperature + 273.15
+        
+        def result(count):
+            if not count:
+                return struct.pack('<Ifffff', 0, 0.0, 0.0, 0.0, 0.0, 0.0)
+            return struct.pack('<Ifffff', count, temp_k, 0.002 if count > 1 else 0.0,
+                               temp_k - 0.006, temp_k + 0.006, 0.012)
+        
+        out = struct.pack('<IBBBB', 0, len(self.sim_stats_windows), 16,
+                          1 if self.sim_adev_base is not None else 0, 0)
+        for length in self.sim_stats_windows:
+            completed = total // length if length else 0
+            current = total - completed * length if length else total
+            out += struct.pack('<II', length, completed)
+            out += result(current) + result(length if completed else 0)
+        
+        samples = 0
+        if self.sim_adev_base is not None:
+            samples = int((time.monotonic() - self.sim_adev_base) / period)
+        adev = [0.002 / (1 << j) ** 0.5 if samples // (1 << j) > 1 else 0.0 for j in range(16)]
+        out += struct.pack('<II', samples, int(max(samples - 1, 0) * period * 1000))
+        return out + struct.pack('<16f', *adev)
+    
+    def _make_datalog(self):
+        """生成约3天的日志页：每天一次升降温，中间有一段探头断开"""
+        interval = self.sim_datalog_interval
+        count = 3 * 86400 // interval
+        start = int(time.time()) - count * interval
+        intervals = []
+        for i in range(count):
+            if 1500 <= i < 1530:
+                intervals.append(None)
+                continue
+            phase = (i * interval) % 86400 / 86400
+            avg = int((4.2 + 290.0 * max(0.0, 1.0 - abs(phase - 0.5) * 4)) * 1000)
+            spread = random.randint(1, 5)
+            intervals.append((avg - spread, avg, avg + random.randint(1, 5)))
+        
+        base = 0
+        pos = 0
+        while pos < len(intervals):
+            seq = self.sim_datalog_oldest + len(self.sim_datalog_pages)
+            page, used, base = encode_page(seq, 3, start + pos * interval, True, interval,
+                                           base, intervals[pos:])
+            pos += used
+            if pos < len(intervals):
+                self.sim_datalog_pages.append(page.ljust(DATALOG_PAGE_SIZE, b'\xff'))
+            else:
+                self.sim_datalog_pending = page
+    
+    def _flush_datalog(self):
+        """RAM页写入Flash，新RAM页为空"""
+        if self.sim_datalog_pending and self.sim_datalog_pending[2] > 0:
+            self.sim_datalog_pages.append(self.sim_datalog_pending.ljust(DATALOG_PAGE_SIZE, b'\xff'))
+            seq = self.sim_datalog_oldest + len(self.sim_datalog_pages)
+            self.sim_datalog_pending, _used, _base = encode_page(
+                seq, 3, int(time.time()), True, self.sim_datalog_interval, 0, [])
+    
+    def _fill_capture(self):
+        """录制中按采样周期补齐自上次调用以来的录制记录"""
+        if not self.sim_capture_active:
+            return
+        period = self.sim_sample_period_us / 1e6
+        now = time.monotonic()
+        while self.sim_capture_time + period <= now:
+            self.sim_capture_time += period
+            if len(self.sim_capture_buf) >= 511:
+                self.sim_capture_lost += 1
+                continue
+            voltage = self.sim_voltage + random.gauss(0.0, 0.02)
+            raw = 0x800000 + int(voltage / 1250.0 * 0x800000)
+            dt_us = 0 if self.sim_capture_recorded == 0 else self.sim_sample_period_us
+            self.sim_capture_buf.append((raw & 0xFFFFFF, dt_us))
+            self.sim_capture_recorded += 1
+    
+    def _make_trace(self) -> list:
+        """生成模拟事件跟踪：每个样本一次DRDY中断和取样，每10个样本滤波/查表/输出"""
+        entries = []
+        t = random.randint(0, 0xFFFFFFFF)
+        
+        def log(phase, event_id, arg=0, dt=0):
+            nonlocal t
+            t = (t + dt) & 0xFFFFFFFF
+            entries.append((t, (phase << 12) | event_id, arg))
+        
+        for i in range(40):
+            log(1, 1, 0, 96000)
+            log(2, 1, 0, 400)
+            log(1, 6, 0, 300)
+            log(0, 7, i % 10, 200)
+            log(2, 6, 0, 600)
+            if i % 10 == 9:
+                log(1, 6, 0, 500)
+                log(1, 8, 0, 100)
+                log(2, 8, 0, 2400)
+                log(1, 9, 0, 200)
+                log(2, 9, 0, 900)
+                log(0, 12, random.randint(12000, 14000), 3000)
+                log(2, 6, 0, 100)
+                log(1, 6, 4, 2000)
+                log(1, 13, 0x07, 100)
+                log(2, 13, 0, random.randint(30000, 600000))
+                log(2, 6, 4, 100)
+        return entries
+    
+    def _check_alarm(self):
+        """按模拟温度判断报警，状态变化时上报事件（每次读取温度视为一次测量）"""
+        enable, _fault, high, low, hyst, rate_limit, rate_hyst, _mA = self.sim_alarm_config
+        now = time.monotonic()
+        value = self.sim_temperature + 273.15
+        active = self.sim_alarm_active
+        
+        if value > high:
+            active |= ALARM_HIGH
+        elif value < high - hyst:
+            active &= ~ALARM_HIGH
+        if value < low:
+            active |= ALARM_LOW
+        elif value > low + hyst:
+            active &= ~ALARM_LOW
+        if self.sim_alarm_last is not None and now > self.sim_alarm_last[0]:
+            self.sim_alarm_rate = (value - self.sim_alarm_last[1]) / (now - self.sim_alarm_last[0])
+            if abs(self.sim_alarm_rate) > rate_limit:
+                active |= ALARM_RATE
+            elif abs(self.sim_alarm_rate) < rate_limit - rate_hyst:
+                active &= ~ALARM_RATE
+        self.sim_alarm_last = (now, value)
+        
+        active &= enable
+        changed = active ^ self.sim_alarm_active
+        if changed:
+            for i in range(len(ALARM_NAMES)):
+                if changed & active & (1 << i):
+                    self.sim_alarm_trips[i] += 1
+            self.sim_alarm_active = active
+            self._send_alarm_event(changed)
+    
+    def _send_alarm_event(self, changed: int):
+        """上报报警事件"""
+        uptime_ms = int((time.monotonic() - self.sim_boot_time) * 1000) & 0xFFFFFFFF
+        event = struct.pack('<IBBBBIff', self.sim_alarm_seq, self.sim_alarm_active, changed, 0, 0,
+                            uptime_ms, self.sim_temperature + 273.15, self.sim_alarm_rate)
+        self.sim_alarm_seq += 1
+        self._dispatch_event(Frame(cmd=Commands.ALARM_EVENT, data=event))
+    
     def _make_ack(self, cmd: int, status: int) -> Frame:
         """生成ACK响应"""
         return Frame(cmd=Commands.ACK, data=bytes([cmd, status]))
@@ -214,6 +691,8 @@ class SimulatorProtocol(Protocol):
             self.sim_current = 4.0 + ratio * 16.0
             # 限幅
             self.sim_current = max(4.0, min(20.0, self.sim_current))
+        if self.sim_alarm_active & self.sim_alarm_config[1]:
+            self.sim_current = self.sim_alarm_config[7]
     
     def _reset_defaults(self):
         """恢复默认参数"""
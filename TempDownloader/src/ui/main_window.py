@@ -4,6 +4,8 @@
 Ultra-TM02超低温温度测量模块上位机软件主界面
 """
 
+import html
+
 from PyQt5.QtWidgets import (
     QMainWindow, QWidget, QVBoxLayout, QHBoxLayout,
     QGroupBox, QLabel, QComboBox, QPushButton, QLineEdit,
@@ -14,8 +16,13 @@ from PyQt5.QtCore import Qt, QTimer
 from PyQt5.QtGui import QFont, QDoubleValidator
 
 from ..protocol.simulator import SimulatorProtocol
-from ..protocol.commands import DeviceAPI
+from ..protocol.commands import DeviceAPI, alarm_bit_names, parse_alarm_event
 from ..utils.table_parser import TableParser
+from ..utils.profile_format import (format_profiles, format_boot_info, format_sample_timing,
+                                    format_power_stats, format_bench, format_stats)
+from ..utils.trace_export import save_chrome_trace
+from ..utils.capture_file import CaptureWriter
+from ..utils.history_log import HistoryLogger
 
 
 class MainWindow(QMainWindow):
@@ -33,6 +40,20 @@ class MainWindow(QMainWindow):
         self.refresh_timer = QTimer()
         self.refresh_timer.timeout.connect(self.on_refresh_timer)
         
+        # 原始采样录制：定时读走设备缓冲区（100Hz采样时约5s写满）
+        self.capture_timer = QTimer()
+        self.capture_timer.timeout.connect(self.on_capture_timer)
+        self.capture_writer = None
+        
+        # 测量历史记录：定时补读设备历史缓冲区，断开后保留序号，重新连接时补齐
+        self.history_timer = QTimer()
+        self.history_timer.timeout.connect(self.on_history_timer)
+        self.history_logger = None
+        
+        # 报警事件：设备主动上报，空闲时定时取走（等待命令响应期间收到的也在队列中）
+        self.event_timer = QTimer()
+        self.event_timer.timeout.connect(self.on_event_timer)
+        
         # 初始化UI
         self.init_ui()
         
@@ -219,6 +240,47 @@ class MainWindow(QMainWindow):
         self.save_param_btn.setEnabled(False)
         layout.addWidget(self.save_param_btn)
         
+        # 时钟档位
+        self.clock_combo = QComboBox()
+        self.clock_combo.addItems(["全速 96MHz", "均衡 48MHz", "低功耗 24MHz"])
+        self.clock_combo.setEnabled(False)
+        layout.addWidget(self.clock_combo)
+        
+        self.clock_btn = QPushButton("切换时钟")
+        self.clock_btn.clicked.connect(self.on_set_clock_profile)
+        self.clock_btn.setEnabled(False)
+        layout.addWidget(self.clock_btn)
+        
+        # 性能统计
+        self.profile_btn = QPushButton("性能统计")
+        self.profile_btn.clicked.connect(self.on_show_profile)
+        self.profile_btn.setEnabled(False)
+        layout.addWidget(self.profile_btn)
+        
+        # 温度稳定性统计
+        self.stats_btn = QPushButton("稳定性统计")
+        self.stats_btn.clicked.connect(self.on_show_stats)
+        self.stats_btn.setEnabled(False)
+        layout.addWidget(self.stats_btn)
+        
+        # 导出事件跟踪
+        self.trace_btn = QPushButton("导出跟踪")
+        self.trace_btn.clicked.connect(self.on_export_trace)
+        self.trace_btn.setEnabled(False)
+        layout.addWidget(self.trace_btn)
+        
+        # 录制原始采样
+        self.capture_btn = QPushButton("录制原始数据")
+        self.capture_btn.clicked.connect(self.on_capture_clicked)
+        self.capture_btn.setEnabled(False)
+        layout.addWidget(self.capture_btn)
+        
+        # 测量历史记录
+        self.history_btn = QPushButton("记录历史")
+        self.history_btn.clicked.connect(self.on_history_clicked)
+        self.history_btn.setEnabled(False)
+        layout.addWidget(self.history_btn)
+        
         return group
     
     def create_data_group(self) -> QGroupBox:
@@ -250,6 +312,11 @@ class MainWindow(QMainWindow):
         self.status_label = QLabel("未连接")
         layout.addWidget(self.status_label, 3, 1)
         
+        # 设备端报警显示
+        layout.addWidget(QLabel("报警:"), 4, 0)
+        self.alarm_label = QLabel("---")
+        layout.addWidget(self.alarm_label, 4, 1)
+        
         return group
     
     def refresh_ports(self):
@@ -268,12 +335,16 @@ class MainWindow(QMainWindow):
         if self.protocol.connected:
             # 断开连接
             self.refresh_timer.stop()
+            self.history_timer.stop()
+            self.event_timer.stop()
+            self.stop_capture()
             self.protocol.disconnect()
             self.connect_btn.setText("连接")
             self.set_controls_enabled(False)
             self.statusBar.showMessage("已断开连接")
             self.device_id_edit.clear()
             self.status_label.setText("未连接")
+            self.alarm_label.setText("---")
         else:
             # 连接
             port = self.port_combo.currentText()
@@ -286,6 +357,13 @@ class MainWindow(QMainWindow):
                 self.set_controls_enabled(True)
                 self.statusBar.showMessage(f"已连接到 {port}")
                 self.status_label.setText("已连接")
+                alarm = self.api.get_alarm()
+                if alarm is not None:
+                    self.show_alarm(alarm['active'])
+                self.event_timer.start(100)
+                if self.history_logger is not None:
+                    self.on_history_timer()
+                    self.history_timer.start(5000)
             else:
                 QMessageBox.critical(self, "错误", f"无法连接到 {port}")
     
@@ -298,6 +376,13 @@ class MainWindow(QMainWindow):
         self.stop_btn.setEnabled(enabled)
         self.load_table_btn.setEnabled(enabled)
         self.save_param_btn.setEnabled(enabled)
+        self.clock_combo.setEnabled(enabled)
+        self.clock_btn.setEnabled(enabled)
+        self.profile_btn.setEnabled(enabled)
+        self.stats_btn.setEnabled(enabled)
+        self.trace_btn.setEnabled(enabled)
+        self.capture_btn.setEnabled(enabled)
+        self.history_btn.setEnabled(enabled)
     
     def on_get_device_id(self):
         """获取设备ID"""
@@ -434,6 +519,197 @@ class MainWindow(QMainWindow):
         else:
             QMessageBox.warning(self, "警告", "参数保存失败")
     
+    def on_set_clock_profile(self):
+        """切换时钟档位（需存储参数才在下次上电生效）"""
+        power = self.api.set_clock_profile(self.clock_combo.currentIndex())
+        if power:
+            self.statusBar.showMessage(f"时钟已切换: HCLK {power['hclk_hz'] / 1e6:.0f} MHz")
+        else:
+            QMessageBox.warning(self, "警告", "时钟档位切换失败")
+    
+    def on_show_profile(self):
+        """读取并显示性能探针统计（读取后清零，下次显示的是本次以来的统计）"""
+        profiles = self.api.get_profiles(reset=True)
+        if not profiles:
+            QMessageBox.warning(self, "警告", "读取性能统计失败")
+            return
+        
+        text = format_profiles(profiles)
+        timing = self.api.get_sample_timing(reset=True)
+        if timing:
+            text = format_sample_timing(timing) + '\n\n' + text
+        bench = self.api.run_bench()
+        if bench:
+            text = format_bench(bench) + '\n\n' + text
+        else:
+            text = "热路径自测: 未运行（需先停止采集）\n\n" + text
+        power = self.api.get_power_stats(reset=True)
+        if power:
+            text = format_power_stats(power) + '\n\n' + text
+        boot_info = self.api.get_boot_info()
+        if boot_info:
+            text = format_boot_info(boot_info) + '\n\n' + text
+        
+        box = QMessageBox(self)
+        box.setWindowTitle("性能统计")
+        box.setText(f"<pre>{html.escape(text)}</pre>")
+        box.exec_()
+    
+    def on_show_stats(self):
+        """读取并显示设备端温度统计，Allan偏差未累计时从此刻开始累计"""
+        stats = self.api.get_stats()
+        if not stats:
+            QMessageBox.warning(self, "警告", "读取温度统计失败")
+            return
+        if not stats['adev_enabled']:
+            stats = self.api.enable_adev(True) or stats
+        
+        box = QMessageBox(self)
+        box.setWindowTitle("稳定性统计")
+        box.setText(f"<pre>{html.escape(format_stats(stats))}</pre>")
+        box.exec_()
+    
+    def on_export_trace(self):
+        """读出事件跟踪并保存为Chrome trace-event JSON"""
+        filename, _ = QFileDialog.getSaveFileName(
+            self, "保存事件跟踪", "trace.json", "JSON文件 (*.json);;所有文件 (*)"
+        )
+        if not filename:
+            return
+        
+        trace = self.api.get_trace()
+        if trace is None:
+            QMessageBox.warning(self, "警告", "读取事件跟踪失败")
+            return
+        
+        save_chrome_trace(trace, filename)
+        self.statusBar.showMessage(
+            f"已导出 {len(trace['entries'])} 条跟踪记录（覆盖 {trace['lost']} 条）: {filename}")
+    
+    def on_capture_clicked(self):
+        """开始/停止录制原始采样"""
+        if self.capture_writer is not None:
+            self.stop_capture()
+            return
+        
+        filename, _ = QFileDialog.getSaveFileName(
+            self, "保存原始采样", "capture.tmc", "录制文件 (*.tmc);;所有文件 (*)"
+        )
+        if not filename:
+            return
+        
+        status = self.api.capture_start()
+        if status is None:
+            QMessageBox.warning(self, "警告", "开始录制失败")
+            return
+        
+        self.capture_writer = CaptureWriter(filename, status)
+        self.capture_timer.start(200)
+        self.capture_btn.setText("停止录制")
+        self.statusBar.showMessage(f"正在录制原始采样: {filename}")
+    
+    def on_capture_timer(self):
+        """录制定时器回调：读走设备缓冲区中的全部记录"""
+        if not self.drain_capture():
+            self.stop_capture()
+            QMessageBox.warning(self, "警告", "读取录制数据失败，已停止录制")
+    
+    def drain_capture(self) -> bool:
+        """读走设备缓冲区中的全部记录并写入文件，通讯失败返回False"""
+        while True:
+            result = self.api.capture_read()
+            if result is None:
+                return False
+            _first_seq, records = result
+            if not records:
+                return True
+            self.capture_writer.write(records)
+    
+    def stop_capture(self):
+        """停止录制，读出剩余记录并关闭文件"""
+        if self.capture_writer is None:
+            return
+        
+        self.capture_timer.stop()
+        status = self.api.capture_stop()
+        if status is not None:
+            self.drain_capture()
+        
+        lost = status['lost'] if status else 0
+        self.capture_writer.close(lost)
+        self.statusBar.showMessage(
+            f"录制结束，共 {self.capture_writer.count} 条（丢弃 {lost} 条）")
+        self.capture_writer = None
+        self.capture_btn.setText("录制原始数据")
+    
+    def on_history_clicked(self):
+        """开始/停止记录测量历史"""
+        if self.history_logger is not None:
+            self.history_timer.stop()
+            self.history_logger.close()
+            self.statusBar.showMessage(
+                f"历史记录结束，共 {self.history_logger.written} 条（丢失 {self.history_logger.lost} 条）")
+            self.history_logger = None
+            self.history_btn.setText("记录历史")
+            return
+        
+        # 选择已有文件时追加，从文件中最后的序号继续
+        filename, _ = QFileDialog.getSaveFileName(
+            self, "保存测量历史", "history.csv", "CSV文件 (*.csv);;所有文件 (*)",
+            options=QFileDialog.DontConfirmOverwrite
+        )
+        if not filename:
+            return
+        
+        self.history_logger = HistoryLogger(filename)
+        self.history_btn.setText("停止历史")
+        self.on_history_timer()
+        self.history_timer.start(5000)
+    
+    def on_history_timer(self):
+        """历史定时器回调：补读设备历史缓冲区中的新记录"""
+        result = self.history_logger.sync(self.api)
+        if result is None:
+            self.statusBar.showMessage("读取历史记录失败，下次继续")
+            return
+        
+        message = f"历史记录 {self.history_logger.written} 条"
+        if result['rebooted']:
+            message += "（设备已重启）"
+        if self.history_logger.lost:
+            message += f"，丢失 {self.history_logger.lost} 条"
+        self.statusBar.showMessage(message)
+    
+    def on_event_timer(self):
+        """事件定时器回调：显示设备上报的报警事件"""
+        for frame in self.protocol.poll_events():
+            event = parse_alarm_event(frame)
+            if event is None:
+                continue
+            self.show_alarm(event['active'])
+            change = []
+            if event['raised']:
+                change.append('触发 ' + ','.join(event['raised']))
+            if event['cleared']:
+                change.append('解除 ' + ','.join(event['cleared']))
+            self.statusBar.showMessage(
+                f"报警{'，'.join(change)}: {event['temperature_K']:.3f} K, "
+                f"{event['rate_K_s']:+.4f} K/s")
+    
+    def show_alarm(self, active: int):
+        """
+        显示当前报警
+        
+        Args:
+            active: 报警位
+        """
+        if active:
+            self.alarm_label.setText(','.join(alarm_bit_names(active)))
+            self.alarm_label.setStyleSheet("color: #CC0000; font-weight: bold;")
+        else:
+            self.alarm_label.setText("无")
+            self.alarm_label.setStyleSheet("")
+    
     def on_refresh_timer(self):
         """刷新定时器回调"""
         # 获取温度
@@ -454,7 +730,14 @@ class MainWindow(QMainWindow):
     def closeEvent(self, event):
         """关闭窗口事件"""
         self.refresh_timer.stop()
+        self.history_timer.stop()
+        self.event_timer.stop()
         if self.protocol.connected:
+            self.stop_capture()
+            if self.history_logger is not None:
+                self.history_logger.sync(self.api)
             self.protocol.disconnect()
+        if self.history_logger is not None:
+            self.history_logger.close()
         event.accept()
 
@@ -3,6 +3,17 @@
 """
 
 from .table_parser import TableParser
+from .profile_format import (format_profile, format_profiles, format_boot_info,
+                             format_sample_timing, format_power_stats, format_bench,
+                             format_stats)
+from .trace_export import to_chrome_trace, save_chrome_trace
+from .capture_file import CaptureWriter, read_capture
+from .burst_export import save_burst_csv
+from .history_log import HistoryLogger
+from .datalog import DatalogWriter, decode_page
 
-__all__ = ['TableParser']
+__all__ = ['TableParser', 'format_profile', 'format_profiles', 'format_boot_info',
+           'format_sample_timing', 'format_power_stats', 'format_bench', 'format_stats',
+           'to_chrome_trace', 'save_chrome_trace', 'CaptureWriter', 'read_capture',
+           'save_burst_csv', 'HistoryLogger', 'DatalogWriter', 'decode_page']
 
@@ -0,0 +1,62 @@
+"""
+突发采集导出模块
+
+将DeviceAPI.burst_read_all()读出的码值按设备状态中的增益、参考电压和平均采样间隔
+换算为电压并写入CSV，时间以触发样本为0，触发前样本为负
+"""
+
+import csv
+
+# 24位码值中点（差分输入零点）
+_CODE_MID = 0x800000
+
+
+def raw_to_voltage(raw: int, gain: float, vref: float) -> float:
+    """
+    码值换算为电压，与固件SVC_ADC_RawToVoltage()相同
+    
+    Args:
+        raw: 24位码值
+        gain: ADC增益
+        vref: 参考电压 (V)
+    
+    Returns:
+        电压 (mV)
+    """
+    return (raw - _CODE_MID) / _CODE_MID * (vref / 2.0) * 1000.0 / gain
+
+
+def burst_rows(status: dict, samples: list) -> list:
+    """
+    生成导出行
+    
+    Args:
+        status: 采集完成后的burst_status()返回值
+        samples: burst_read_all()的返回值
+    
+    Returns:
+        [(序号, 相对触发时间μs, 码值, 电压mV), ...]，序号以触发样本为0
+    """
+    interval_us = status['interval_ns'] / 1000.0
+    rows = []
+    for i, raw in enumerate(samples):
+        index = i - status['pre_count']
+        rows.append((index, index * interval_us, raw,
+                     raw_to_voltage(raw, status['gain'], status['vref'])))
+    return rows
+
+
+def save_burst_csv(path: str, status: dict, samples: list):
+    """
+    保存为CSV
+    
+    Args:
+        path: 文件路径
+        status: 采集完成后的burst_status()返回值
+        samples: burst_read_all()的返回值
+    """
+    with open(path, 'w', newline='', encoding='utf-8') as f:
+        writer = csv.writer(f)
+        writer.writerow(['index', 'time_us', 'raw', 'voltage_mV'])
+        for index, time_us, raw, voltage in burst_rows(status, samples):
+            writer.writerow([index, f'{time_us:.1f}', f'0x{raw:06X}', f'{voltage:.4f}'])
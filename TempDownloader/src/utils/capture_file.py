@@ -0,0 +1,121 @@
+"""
+原始采样录制文件模块
+
+保存DeviceAPI.capture_read()读出的ADC码值，供固件仓库中的主机端回放工具
+(Ultra_TM02/Host/build/adc_replay) 送入同一份测量流水线
+
+文件格式（小端）：
+    48字节文件头 [魔数"TMCP"][版本 u16][头长度 u16][采样周期μs u32][增益 f32]
+                 [参考电压V f32][4mA温度℃ f32][20mA温度℃ f32][分度表点数 u16]
+                 [电流源 u8][保留 u8][记录数 u32][丢弃数 u32][开始时间 u32][保留 u32]
+    随后每条记录6字节 [码值 u24][相对上一条的间隔μs u24]
+记录数在关闭文件时回填，录制中断时为0，回放工具按文件长度计算
+"""
+
+import struct
+import time
+from typing import Optional
+
+CAPTURE_MAGIC = b'TMCP'
+CAPTURE_VERSION = 1
+CAPTURE_HEADER_SIZE = 48
+
+_HEADER_FORMAT = '<4sHHIffffHBBIIII'
+
+
+class CaptureWriter:
+    """录制文件写入器"""
+    
+    def __init__(self, path: str, status: dict):
+        """
+        创建录制文件并写入文件头
+        
+        Args:
+            path: 文件路径
+            status: DeviceAPI.capture_start()的返回值（测量设置）
+        """
+        self.status = status
+        self.count = 0
+        self.lost = 0
+        self.start_time = int(time.time())
+        self.file = open(path, 'wb')
+        self.file.write(self._header())
+    
+    def _header(self) -> bytes:
+        s = self.status
+        return struct.pack(_HEADER_FORMAT, CAPTURE_MAGIC, CAPTURE_VERSION, CAPTURE_HEADER_SIZE,
+                           s['sample_period_us'], s['gain'], s['vref'],
+                           s['temp_4mA'], s['temp_20mA'], s['table_points'],
+                           s['current_source'], 0, self.count, self.lost,
+                           self.start_time, 0)
+    
+    def write(self, records: list):
+        """
+        追加记录
+        
+        Args:
+            records: [(24位码值, 间隔μs), ...]
+        """
+        data = bytearray()
+        for raw, dt_us in records:
+            data += (raw & 0xFFFFFF).to_bytes(3, 'little')
+            data += min(dt_us, 0xFFFFFF).to_bytes(3, 'little')
+        self.file.write(data)
+        self.count += len(records)
+    
+    def close(self, lost: int = 0):
+        """
+        回填记录数与丢弃数并关闭文件
+        
+        Args:
+            lost: 设备报告的丢弃条数
+        """
+        if self.file.closed:
+            return
+        self.lost = lost
+        self.file.seek(0)
+        self.file.write(self._header())
+        self.file.close()
+
+
+def read_capture(path: str) -> Optional[dict]:
+    """
+    读取录制文件
+    
+    Args:
+        path: 文件路径
+    
+    Returns:
+        文件头各字段与 'records': [(码值, 间隔μs), ...]，格式不符返回None
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+    if len(data) < CAPTURE_HEADER_SIZE:
+        return None
+    
+    (magic, version, header_size, period_us, gain, vref, temp_4mA, temp_20mA,
+     table_points, current_src, _rsv, count, lost, start_time,
+     _rsv2) = struct.unpack(_HEADER_FORMAT, data[:CAPTURE_HEADER_SIZE])
+    if magic != CAPTURE_MAGIC or version != CAPTURE_VERSION:
+        return None
+    
+    available = (len(data) - header_size) // 6
+    if count == 0 or count > available:
+        count = available
+    records = []
+    for i in range(count):
+        item = data[header_size + i * 6:header_size + i * 6 + 6]
+        records.append((int.from_bytes(item[:3], 'little'), int.from_bytes(item[3:], 'little')))
+    
+    return {
+        'sample_period_us': period_us,
+        'gain': gain,
+        'vref': vref,
+        'temp_4mA': temp_4mA,
+        'temp_20mA': temp_20mA,
+        'table_points': table_points,
+        'current_source': current_src,
+        'lost': lost,
+        'start_time': start_time,
+        'records': records,
+    }
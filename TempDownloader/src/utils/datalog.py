@@ -0,0 +1,202 @@
+"""
+长期数据日志模块
+
+解码设备Flash数据日志页（DeviceAPI.datalog_read_pages()），并按页序号增量保存为CSV。
+
+页格式（256字节，小端，见固件app_datalog.h）：
+    24字节页头 [魔数"DL" u16][条数 u8][标志 u8][页序号 u32][起始时间s u32][周期s u16]
+               [启动序号 u16][基准值mK i32][数据长度 u16][CRC16 u16]
+    随后为连续周期的记录，每个值为无符号LEB128变长整数：
+        有数据: [zigzag(平均值 - 上一平均值) << 1][平均值 - 最小值][最大值 - 平均值]
+        无数据: [(周期数 << 1) | 1]
+标志bit0置位时起始时间为UNIX时间，否则为设备上电以来的秒数
+
+CSV列: seq, boot, time, device_s, min_K, avg_K, max_K
+    time为周期起点的本地时间，未校时的页为空；无数据的周期不写入
+"""
+
+import csv
+import os
+import struct
+from datetime import datetime
+from typing import Optional
+
+from ..protocol.protocol import Protocol
+
+DATALOG_MAGIC = 0x4C44
+DATALOG_PAGE_SIZE = 256
+DATALOG_HEADER_SIZE = 24
+DATALOG_FLAG_TIME_SYNCED = 0x01
+
+_HEADER_FORMAT = '<HBBIIHHiHH'
+
+_CSV_HEADER = ['seq', 'boot', 'time', 'device_s', 'min_K', 'avg_K', 'max_K']
+
+
+def _read_varint(data: bytes, pos: int):
+    """读出一个LEB128变长整数，返回 (数值, 下一位置)"""
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError('数据截断')
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if byte < 0x80:
+            return value, pos
+        shift += 7
+
+
+def _write_varint(value: int) -> bytes:
+    """LEB128编码"""
+    out = bytearray()
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+    return bytes(out)
+
+
+def decode_page(data: bytes) -> Optional[dict]:
+    """
+    解码一页
+    
+    Args:
+        data: 页数据（Flash中的整页或RAM页的有效部分）
+    
+    Returns:
+        {'seq', 'boot', 'time_s', 'synced', 'interval_s', 'entries'}，
+        entries为 [(周期起点s, 最小K, 平均K, 最大K), ...]（无数据的周期不列出）；
+        空白页、CRC错误或格式不符返回None
+    """
+    if len(data) < DATALOG_HEADER_SIZE:
+        return None
+    (magic, count, flags, seq, time_s, interval_s, boot, base_mK, length,
+     crc) = struct.unpack(_HEADER_FORMAT, data[:DATALOG_HEADER_SIZE])
+    if magic != DATALOG_MAGIC or len(data) < DATALOG_HEADER_SIZE + length:
+        return None
+    body = bytearray(data[:DATALOG_HEADER_SIZE + length])
+    body[22:24] = b'\x00\x00'
+    if Protocol.crc16(bytes(body)) != crc:
+        return None
+    
+    entries = []
+    payload = data[DATALOG_HEADER_SIZE:DATALOG_HEADER_SIZE + length]
+    pos = 0
+    avg = base_mK
+    t = time_s
+    try:
+        for _ in range(count):
+            value, pos = _read_varint(payload, pos)
+            if value & 1:
+                t += (value >> 1) * interval_s
+                continue
+            zigzag = value >> 1
+            avg += (zigzag >> 1) ^ -(zigzag & 1)
+            low, pos = _read_varint(payload, pos)
+            high, pos = _read_varint(payload, pos)
+            entries.append((t, (avg - low) / 1000.0, avg / 1000.0, (avg + high) / 1000.0))
+            t += interval_s
+    except ValueError:
+        return None
+    
+    return {
+        'seq': seq,
+        'boot': boot,
+        'time_s': time_s,
+        'synced': bool(flags & DATALOG_FLAG_TIME_SYNCED),
+        'interval_s': interval_s,
+        'entries': entries,
+    }
+
+
+def encode_page(seq: int, boot: int, time_s: int, synced: bool, interval_s: int,
+                base_mK: int, intervals: list) -> tuple:
+    """
+    按固件格式编码一页（供模拟设备使用）
+    
+    Args:
+        seq, boot, time_s, synced, interval_s: 页头字段
+        base_mK: 基准值 (mK)
+        intervals: [(最小mK, 平均mK, 最大mK) 或 None(无数据), ...]
+    
+    Returns:
+        (页数据（不含末尾空白）, 编入的周期数, 最后一个平均值mK)
+    """
+    payload = bytearray()
+    avg_prev = base_mK
+    count = 0
+    used = 0
+    while used < len(intervals):
+        item = intervals[used]
+        if item is None:
+            gap = 1
+            while used + gap < len(intervals) and intervals[used + gap] is None:
+                gap += 1
+            entry = _write_varint((gap << 1) | 1)
+            step = gap
+        else:
+            low, avg, high = item
+            delta = avg - avg_prev
+            entry = (_write_varint((((delta << 1) ^ (delta >> 31)) & 0xFFFFFFFF) << 1)
+                     + _write_varint(avg - low) + _write_varint(high - avg))
+            step = 1
+        if len(payload) + len(entry) > DATALOG_PAGE_SIZE - DATALOG_HEADER_SIZE or count == 0xFF:
+            break
+        payload += entry
+        count += 1
+        used += step
+        if item is not None:
+            avg_prev = item[1]
+    
+    header = struct.pack(_HEADER_FORMAT, DATALOG_MAGIC, count,
+                         DATALOG_FLAG_TIME_SYNCED if synced else 0, seq, time_s & 0xFFFFFFFF,
+                         interval_s, boot, base_mK, len(payload), 0)
+    crc = Protocol.crc16(header + bytes(payload))
+    return header[:22] + struct.pack('<H', crc) + bytes(payload), used, avg_prev
+
+
+class DatalogWriter:
+    """数据日志按页序号增量保存"""
+    
+    def __init__(self, path: str):
+        """
+        打开CSV文件，已存在时追加并从最后一页的下一页继续
+        
+        Args:
+            path: 文件路径
+        """
+        self.next_seq = 0           # 下一页要读的序号
+        self.written = 0            # 本次打开后写入的条数
+        
+        exists = os.path.exists(path) and os.path.getsize(path) > 0
+        if exists:
+            with open(path, newline='', encoding='utf-8') as f:
+                for row in csv.reader(f):
+                    if row and row[0].isdigit():
+                        self.next_seq = max(self.next_seq, int(row[0]) + 1)
+        self.file = open(path, 'a', newline='', encoding='utf-8')
+        self.writer = csv.writer(self.file)
+        if not exists:
+            self.writer.writerow(_CSV_HEADER)
+    
+    def write_page(self, page: dict):
+        """
+        写入一页的全部记录
+        
+        Args:
+            page: decode_page()的返回值
+        """
+        for t, low, avg, high in page['entries']:
+            stamp = datetime.fromtimestamp(t).isoformat(sep=' ') if page['synced'] else ''
+            device_s = '' if page['synced'] else t
+            self.writer.writerow([page['seq'], page['boot'], stamp, device_s,
+                                  f'{low:.3f}', f'{avg:.3f}', f'{high:.3f}'])
+            self.written += 1
+        self.next_seq = page['seq'] + 1
+    
+    def close(self):
+        """关闭文件"""
+        if not self.file.closed:
+            self.file.close()
@@ -0,0 +1,114 @@
+"""
+测量历史记录模块
+
+按序号把设备SRAM中的历史记录（DeviceAPI.history_read()）增量追加到CSV文件。
+断开期间设备继续记录，重新连接后从上次的序号补读，轮询间隔只需小于缓冲区
+覆盖时间（容量 × 抽取比 × 每次测量时间）即不丢数据。
+
+CSV列: seq, time, device_ms, temp_K, temp_C, voltage_mV, probe
+    time为按设备时刻与主机时钟换算的本地时间，设备重启后序号从0重新开始
+"""
+
+import csv
+import os
+import time
+from datetime import datetime
+from typing import Optional
+
+# 探头状态名称（见app_temp.h ProbeStatus_t）
+PROBE_STATUS_NAMES = ('ok', 'open', 'short', 'range')
+
+_HEADER = ['seq', 'time', 'device_ms', 'temp_K', 'temp_C', 'voltage_mV', 'probe']
+
+
+class HistoryLogger:
+    """历史记录增量保存"""
+    
+    def __init__(self, path: str):
+        """
+        打开CSV文件，已存在时追加并从最后一行的序号继续
+        
+        Args:
+            path: 文件路径
+        """
+        self.next_seq = 0           # 下一条要读的序号
+        self.last_ms = 0            # 最后一条记录的设备时刻
+        self.written = 0            # 本次打开后写入的条数
+        self.lost = 0               # 已被设备覆盖而未能读到的条数
+        
+        exists = os.path.exists(path) and os.path.getsize(path) > 0
+        if exists:
+            self._resume(path)
+        self.file = open(path, 'a', newline='', encoding='utf-8')
+        self.writer = csv.writer(self.file)
+        if not exists:
+            self.writer.writerow(_HEADER)
+    
+    def _resume(self, path: str):
+        """从已有文件的最后一行恢复序号"""
+        last = None
+        with open(path, newline='', encoding='utf-8') as f:
+            for row in csv.reader(f):
+                if row and row[0].isdigit():
+                    last = row
+        if last is not None:
+            self.next_seq = int(last[0]) + 1
+            self.last_ms = int(last[2])
+    
+    def sync(self, api) -> Optional[dict]:
+        """
+        读出自上次以来的全部新记录并写入文件
+        
+        Args:
+            api: DeviceAPI
+        
+        Returns:
+            {'written': 本次写入条数, 'lost': 本次丢失条数, 'rebooted': 是否检测到设备重启}，
+            通信失败返回None（已写入的记录保留，下次从断点继续）
+        """
+        status = api.history_status()
+        if status is None:
+            return None
+        host_now = time.time()
+        
+        # 设备时刻或序号倒退：设备已重启，从新的第一条开始
+        rebooted = status['next_seq'] < self.next_seq or status['now_ms'] < self.last_ms
+        if rebooted:
+            self.next_seq = 0
+            self.last_ms = 0
+        
+        written = 0
+        lost = 0
+        while self.next_seq < status['next_seq']:
+            result = api.history_read(self.next_seq)
+            if result is None:
+                self.file.flush()
+                return None
+            first_seq, records = result
+            if first_seq > self.next_seq:
+                lost += first_seq - self.next_seq
+                self.next_seq = first_seq
+            if not records:
+                break
+            
+            for i, (time_ms, temp_k, voltage, probe) in enumerate(records):
+                wall = host_now - ((status['now_ms'] - time_ms) & 0xFFFFFFFF) / 1000.0
+                self.writer.writerow([
+                    first_seq + i,
+                    datetime.fromtimestamp(wall).isoformat(sep=' ', timespec='milliseconds'),
+                    time_ms, f'{temp_k:.4f}', f'{temp_k - 273.15:.4f}', f'{voltage:.4f}',
+                    PROBE_STATUS_NAMES[probe] if probe < len(PROBE_STATUS_NAMES) else probe,
+                ])
+            self.next_seq = first_seq + len(records)
+            self.last_ms = records[-1][0]
+            written += len(records)
+        
+        self.file.flush()
+        self.written += written
+        self.lost += lost
+        return {'written': written, 'lost': lost, 'rebooted': rebooted}
+    
+    def close(self):
+        """关闭文件"""
+        if not self.file.closed:
+            self.file.close()
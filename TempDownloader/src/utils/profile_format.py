@@ -0,0 +1,177 @@
+"""
+性能探针统计格式化模块
+
+将DeviceAPI.get_profiles()的结果整理为便于阅读的文本
+"""
+
+from typing import List
+
+# 直方图条形最大宽度（字符）
+BAR_WIDTH = 30
+
+
+def _format_cycles(cycles: int, clock_hz: int) -> str:
+    """将周期数格式化为带单位的时间"""
+    us = cycles / (clock_hz / 1e6) if clock_hz else float(cycles)
+    if us >= 1000.0:
+        return f'{us / 1000.0:.2f}ms'
+    return f'{us:.2f}us'
+
+
+def format_profile(profile: dict) -> str:
+    """
+    格式化单个探针统计
+    
+    Args:
+        profile: DeviceAPI.get_profile()返回的字典
+        
+    Returns:
+        多行文本：汇总行 + 非空直方图格
+    """
+    lines = [f"{profile['name']:<12} n={profile['count']:<8} "
+             f"min={profile['min_us']:.2f}us  mean={profile['mean_us']:.2f}us  "
+             f"max={profile['max_us']:.2f}us"]
+    
+    hist = profile['hist']
+    peak = max(hist) if hist else 0
+    if peak == 0:
+        return lines[0]
+    
+    clock = profile['clock_hz']
+    last = len(hist) - 1
+    for i, n in enumerate(hist):
+        if n == 0:
+            continue
+        low = _format_cycles(1 << i if i else 0, clock)
+        high = '...' if i == last else _format_cycles(1 << (i + 1), clock)
+        bar = '#' * max(1, n * BAR_WIDTH // peak)
+        lines.append(f"  [{low:>9}, {high:>9})  {n:>6}  {bar}")
+    
+    return '\n'.join(lines)
+
+
+def format_boot_info(info: dict) -> str:
+    """
+    格式化启动计时
+    
+    Args:
+        info: DeviceAPI.get_boot_info()返回的字典
+        
+    Returns:
+        多行文本：复位原因 + 各阶段时刻
+    """
+    lines = [f"复位原因: {' '.join(info['reset']) or '-'}"]
+    for name, ms in info['stages'].items():
+        lines.append(f"  {name:<14} {'未到达' if ms is None else f'{ms:10.3f} ms'}")
+    return '\n'.join(lines)
+
+
+def format_sample_timing(timing: dict) -> str:
+    """
+    格式化采样间隔抖动统计
+    
+    Args:
+        timing: DeviceAPI.get_sample_timing()返回的字典
+        
+    Returns:
+        多行文本：设定周期 + 间隔范围 + 抖动
+    """
+    return '\n'.join([
+        f"采样周期 {timing['period_us'] / 1000.0:.3f} ms  间隔数={timing['count']}",
+        f"  间隔 min={timing['min_us']:.2f}us  max={timing['max_us']:.2f}us",
+        f"  抖动 mean={timing['mean_jitter_us']:.2f}us  rms={timing['rms_jitter_us']:.2f}us  "
+        f"max={timing['max_jitter_us']:.2f}us",
+        f"  跳过={timing['overrun_count']}  延后={timing['deferred_count']}  "
+        f"最大启动延迟={timing['max_delay_us']:.2f}us",
+    ])
+
+
+def format_power_stats(power: dict) -> str:
+    """
+    格式化时钟档位与CPU负载统计
+    
+    Args:
+        power: DeviceAPI.get_power_stats()返回的字典
+        
+    Returns:
+        多行文本：档位与HCLK + 负载
+    """
+    return '\n'.join([
+        f"时钟档位 {power['profile_name']}  HCLK {power['hclk_hz'] / 1e6:.0f} MHz",
+        f"  CPU负载 avg={power['load_avg']:.1f}%  peak={power['load_peak']:.1f}%  "
+        f"last={power['load_last']:.1f}%",
+        f"  睡眠次数={power['sleep_count']}  统计时长={power['elapsed_ms'] / 1000.0:.1f}s",
+    ])
+
+
+def format_bench(bench: dict) -> str:
+    """
+    格式化热路径自测结果
+    
+    Args:
+        bench: DeviceAPI.run_bench()返回的字典
+        
+    Returns:
+        多行文本：加速器配置 + 每个函数在各执行方式下的最小/平均/最大周期
+    """
+    accel = '/'.join(name for name, on in (('预取', bench['prefetch']),
+                                           ('指令缓存', bench['icache']),
+                                           ('数据缓存', bench['dcache'])) if on)
+    lines = [f"热路径自测  Flash等待周期={bench['latency']}  加速器={accel or '关闭'}"]
+    for func in bench['funcs']:
+        parts = []
+        for mode, (min_c, max_c, avg_c) in func['modes'].items():
+            parts.append(f"{mode}={min_c}/{avg_c}/{max_c}" if max_c else f"{mode}=--")
+        lines.append(f"  {func['name']:<14s}" + '  '.join(parts))
+    lines.append("  (周期数 最小/平均/最大)")
+    return '\n'.join(lines)
+
+
+def format_profiles(profiles: List[dict]) -> str:
+    """
+    格式化全部探针统计
+    
+    Args:
+        profiles: DeviceAPI.get_profiles()返回的列表
+        
+    Returns:
+        多行文本
+    """
+    if not profiles:
+        return ''
+    
+    header = f"CPU {profiles[0]['clock_hz'] / 1e6:.0f} MHz"
+    return '\n\n'.join([header] + [format_profile(p) for p in profiles])
+
+
+def format_stats(stats: dict) -> str:
+    """
+    格式化设备端温度统计
+    
+    Args:
+        stats: DeviceAPI.get_stats()返回的字典
+        
+    Returns:
+        多行文本：每个窗口的当前与最近完整窗口 + Allan偏差
+    """
+    lines = [f"温度统计  跳过无效测量 {stats['skipped']} 次"]
+    for i, window in enumerate(stats['windows']):
+        length = f"{window['length']}次" if window['length'] else "累计"
+        lines.append(f"  窗口{i} ({length})  已结束 {window['completed']} 个")
+        for name in ('current', 'last'):
+            r = window[name]
+            if not r['count']:
+                continue
+            lines.append(f"    {'当前' if name == 'current' else '上一'} n={r['count']:<6d}"
+                         f"mean={r['mean']:.4f}K  σ={r['std'] * 1000:.3f}mK  "
+                         f"min={r['min']:.4f}K  max={r['max']:.4f}K  "
+                         f"p-p={r['p2p'] * 1000:.3f}mK")
+    if stats['adev']:
+        lines.append(f"  Allan偏差 ({stats['adev_samples']}次, τ0={stats['tau0'] * 1000:.1f}ms"
+                     f"{'' if stats['adev_enabled'] else ', 已停止'})")
+        for item in stats['adev']:
+            lines.append(f"    τ={item['tau']:9.2f}s  σ={item['adev'] * 1000:.4f}mK  "
+                         f"(差分 {item['pairs']})")
+    elif stats['adev_enabled']:
+        lines.append("  Allan偏差: 累计中，数据不足")
+    return '\n'.join(lines)
@@ -0,0 +1,88 @@
+"""
+事件跟踪导出模块
+
+将DeviceAPI.get_trace()读出的记录转换为Chrome trace-event JSON，
+可在 chrome://tracing 或 https://ui.perfetto.dev 中按时间线查看
+"""
+
+import json
+from typing import Optional
+
+from ..protocol.commands import TRACE_EVENTS, SCHED_TASK_NAMES, Commands
+
+# 线程编号：中断与主循环各占一行
+_THREAD_IDS = {'irq': 1, 'main': 2}
+
+# 记录类型 -> trace-event的ph字段
+_PHASES = {0: 'i', 1: 'B', 2: 'E'}
+
+# 命令码 -> 名称
+_COMMAND_NAMES = {v: k for k, v in vars(Commands).items() if k.isupper()}
+
+
+def _event_name(event_id: int, arg: int) -> str:
+    """按事件编号和参数生成显示名称"""
+    name = TRACE_EVENTS.get(event_id, (f'event{event_id}', 'main'))[0]
+    if name == 'task' and arg < len(SCHED_TASK_NAMES):
+        return f'task {SCHED_TASK_NAMES[arg]}'
+    if name == 'command':
+        return f"cmd {_COMMAND_NAMES.get(arg, f'0x{arg:02X}')}"
+    return name
+
+
+def to_chrome_trace(trace: dict) -> dict:
+    """
+    转换为Chrome trace-event格式
+    
+    周期计数按相邻记录间隔不超过一次32位回绕展开，时间以第一条记录为0
+    
+    Args:
+        trace: DeviceAPI.get_trace()的返回值
+        
+    Returns:
+        可直接json.dump的字典
+    """
+    us_per_cycle = 1e6 / trace['clock_hz'] if trace['clock_hz'] else 1.0
+    events = [
+        {'name': 'process_name', 'ph': 'M', 'pid': 1, 'args': {'name': 'Ultra-TM02'}},
+        {'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': 1, 'args': {'name': 'interrupt'}},
+        {'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': 2, 'args': {'name': 'main loop'}},
+    ]
+    
+    prev: Optional[int] = None
+    elapsed = 0
+    for cycles, phase, event_id, arg in trace['entries']:
+        if prev is not None:
+            elapsed += (cycles - prev) & 0xFFFFFFFF
+        prev = cycles
+        
+        thread = TRACE_EVENTS.get(event_id, ('', 'main'))[1]
+        event = {
+            'name': _event_name(event_id, arg),
+            'ph': _PHASES.get(phase, 'i'),
+            'ts': elapsed * us_per_cycle,
+            'pid': 1,
+            'tid': _THREAD_IDS[thread],
+            'args': {'arg': arg},
+        }
+        if event['ph'] == 'i':
+            event['s'] = 't'
+        events.append(event)
+    
+    return {
+        'traceEvents': events,
+        'displayTimeUnit': 'ns',
+        'otherData': {'clock_hz': trace['clock_hz'], 'lost': trace['lost']},
+    }
+
+
+def save_chrome_trace(trace: dict, file_path: str):
+    """
+    保存为Chrome trace-event JSON文件
+    
+    Args:
+        trace: DeviceAPI.get_trace()的返回值
+        file_path: 输出文件路径
+    """
+    with open(file_path, 'w', encoding='utf-8') as f:
+        json.dump(to_chrome_trace(trace), f, ensure_ascii=False)
@@ -0,0 +1,128 @@
+/**
+ * @file    app_alarm.h
+ * @brief   温度报警应用层头文件
+ * @details 在温度任务的测量流程中对每次测量结果判断报警条件，
+ *          报警状态变化时立即主动上报事件帧，无需上位机轮询：
+ *          - 上限/下限：带回差，超过上限（低于下限）触发，回到限值内回差以上解除
+ *          - 变化率：相邻两次有效测量的|dT/dt|，带回差
+ *          - 探头故障：探头断开、短路或超量程
+ *          报警可选择强制4-20mA输出为故障电流（NAMUR NE43: ≤3.6mA或≥21mA），
+ *          全部解除后恢复按温度输出。检测延迟为一次测量（默认50ms）
+ *
+ *          事件帧 CMD_ALARM_EVENT 数据（小端，20字节）：
+ *          [事件序号 u32][报警位 u8][变化位 u8][探头状态 u8][保留 u8]
+ *          [时间ms u32][温度K f32][变化率K/s f32]
+ *          事件序号从上电起连续递增，上位机可据此发现未收到的事件
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __APP_ALARM_H
+#define __APP_ALARM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 报警位 */
+#define ALARM_HIGH                  0x01    /* 温度上限 */
+#define ALARM_LOW                   0x02    /* 温度下限 */
+#define ALARM_RATE                  0x04    /* 温度变化率 */
+#define ALARM_PROBE                 0x08    /* 探头故障 */
+#define ALARM_ALL                   0x0F
+#define ALARM_COUNT                 4
+
+/* 默认故障电流 (mA)，NAMUR NE43下限故障电流 */
+#define ALARM_FAULT_CURRENT_DEFAULT 3.6f
+
+/* 事件帧数据长度 */
+#define ALARM_EVENT_LEN             20
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 报警设置 */
+typedef struct {
+    uint8_t enable;             /* 启用的报警 (ALARM_xxx位) */
+    uint8_t fault;              /* 触发时强制输出故障电流的报警 (ALARM_xxx位) */
+    float high_K;               /* 上限 (K) */
+    float low_K;                /* 下限 (K) */
+    float hyst_K;               /* 上下限回差 (K) */
+    float rate_K_s;             /* 变化率上限 (K/s，按绝对值) */
+    float rate_hyst_K_s;        /* 变化率回差 (K/s)，小于变化率上限 */
+    float fault_mA;             /* 故障电流 (mA)，OUTPUT_FAULT_MIN_CURRENT ~ OUTPUT_FAULT_MAX_CURRENT */
+} AlarmConfig_t;
+
+/* 报警状态 */
+typedef struct {
+    uint8_t active;             /* 当前报警位 */
+    uint8_t output_fault;       /* 1=输出已被强制为故障电流 */
+    uint32_t event_seq;         /* 下一个事件的序号（即已产生的事件数） */
+    float rate_K_s;             /* 最近一次测量的变化率 (K/s)，无效时为0 */
+    uint16_t trips[ALARM_COUNT]; /* 各报警的触发次数（按报警位顺序） */
+} AlarmStatus_t;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  报警模块初始化
+ * @note   全部报警关闭；设置不保存到参数，上电后由上位机重新设置
+ * @retval 无
+ */
+void APP_Alarm_Init(void);
+
+/**
+ * @brief  以一次测量结果判断报警（温度任务中调用）
+ * @param  temperature_K: 温度 (K)，探头异常时不使用
+ * @param  sample_tick: 测量对应采样时刻 (ms，SVC_ADC_GetLastSampleTick)
+ * @param  probe_status: 探头状态 (ProbeStatus_t)
+ * @note   需在更新4-20mA输出之前调用；报警状态变化时同步发送事件帧
+ * @retval 当前报警位
+ */
+uint8_t APP_Alarm_Check(float temperature_K, uint32_t sample_tick, uint8_t probe_status);
+
+/**
+ * @brief  重新开始变化率计算
+ * @note   测量重新启动或时钟档位切换后调用，下一次有效测量只作为变化率的起点
+ * @retval 无
+ */
+void APP_Alarm_ResetRate(void);
+
+/**
+ * @brief  设置报警
+ * @param  config: 报警设置
+ * @note   清除当前报警（有报警时上报解除事件并恢复输出），下一次测量重新判断
+ * @retval 0=成功, -1=参数无效
+ */
+int APP_Alarm_SetConfig(const AlarmConfig_t *config);
+
+/**
+ * @brief  获取报警设置
+ * @param  config: 输出设置结构体指针
+ * @retval 无
+ */
+void APP_Alarm_GetConfig(AlarmConfig_t *config);
+
+/**
+ * @brief  获取报警状态
+ * @param  status: 输出状态结构体指针
+ * @retval 无
+ */
+void APP_Alarm_GetStatus(AlarmStatus_t *status);
+
+/**
+ * @brief  清零触发次数
+ * @retval 无
+ */
+void APP_Alarm_ClearTrips(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APP_ALARM_H */
@@ -0,0 +1,89 @@
+/**
+ * @file    app_bench.h
+ * @brief   热路径自测基准头文件
+ * @details 对每个样本都要执行的计算内核（app_temp_calc.h），分别测量：
+ *          - 从SRAM取指（与app_temp.c中RAMFUNC版本相同的代码）
+ *          - 从Flash取指，ART加速器按当前配置
+ *          - 从Flash取指，关闭预取和指令/数据缓存
+ *          每种方式连续执行BENCH_REPEAT次，每次单独关中断计时，记录最小/最大/平均周期数；
+ *          计时代码位于RAM中，三种方式的调用开销相同。
+ *          另测分度表全表扫描查表、浮点格式化和帧CRC，后两者为普通Flash函数，不测RAM方式。
+ *          测量期间ART加速器配置被临时改变，只在停止采集时运行
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __APP_BENCH_H
+#define __APP_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 每个函数每种方式的执行次数 */
+#define BENCH_REPEAT            16
+
+/* 全表扫描查表的电压点数（在分度表电压范围内均匀分布，每点执行一次） */
+#define BENCH_SWEEP_POINTS      64
+
+/* CRC测量的数据长度（最大帧） */
+#define BENCH_CRC_LEN           256
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 基准函数（上位机按此编号显示名称） */
+typedef enum {
+    BENCH_FUNC_MEDIAN = 0,      /* 中值滤波（逆序输入，交换次数最多） */
+    BENCH_FUNC_MOVING_AVG,      /* 滑动平均 */
+    BENCH_FUNC_LOOKUP,          /* 分度表查表（分度表中点，分度表无效时不测） */
+    BENCH_FUNC_LOOKUP_SWEEP,    /* 分度表全表扫描查表（分度表无效时不测） */
+    BENCH_FUNC_FORMAT,          /* 浮点格式化（温度显示格式，3位小数） */
+    BENCH_FUNC_CRC16,           /* 帧CRC16 (BENCH_CRC_LEN字节) */
+    BENCH_FUNC_COUNT
+} BenchFunc_t;
+
+/* 执行方式 */
+typedef enum {
+    BENCH_MODE_RAM = 0,         /* SRAM取指 */
+    BENCH_MODE_FLASH,           /* Flash取指，加速器按当前配置 */
+    BENCH_MODE_FLASH_NOACCEL,   /* Flash取指，关闭加速器 */
+    BENCH_MODE_COUNT
+} BenchMode_t;
+
+/* 单项结果 (CPU周期，含约10周期的调用与计时开销；未测时为0) */
+typedef struct {
+    uint32_t min_cycles;        /* 最小值（缓存已预热） */
+    uint32_t max_cycles;        /* 最大值（通常为首次执行） */
+    uint32_t avg_cycles;        /* 平均值 */
+} BenchResult_t;
+
+/* 基准报告 */
+typedef struct {
+    BenchResult_t result[BENCH_FUNC_COUNT][BENCH_MODE_COUNT];
+    uint32_t accel;             /* 测量时的加速器配置 (FLASH_ACCEL_xxx组合) */
+    uint32_t latency;           /* Flash等待周期 */
+    uint32_t hclk;              /* HCLK (Hz) */
+} BenchReport_t;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  运行热路径基准
+ * @param  report: 输出报告指针
+ * @note   在主循环中调用，总耗时约数ms；每次执行期间关中断（最长数十μs）。
+ *         调用者须确认采集已停止(APP_Temp_Stop)
+ * @retval 无
+ */
+void APP_Bench_Run(BenchReport_t *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APP_BENCH_H */
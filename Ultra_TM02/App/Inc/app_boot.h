@@ -0,0 +1,94 @@
+/**
+ * @file    app_boot.h
+ * @brief   启动过程计时应用层头文件
+ * @details 记录复位原因和启动各阶段相对复位的时刻，用于确认上电/掉电复位后
+ *          4-20mA输出恢复有效值所需的时间：
+ *          - 时刻以HAL时基起点（HAL_Init，复位后约数十μs）为0，单位μs
+ *          - 每个阶段只记录第一次到达的时刻，未到达为BOOT_TIME_NONE
+ *          - LCD和USB在后台完成启动，由APP_Boot_Poll()检测就绪
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __APP_BOOT_H
+#define __APP_BOOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 阶段未到达 */
+#define BOOT_TIME_NONE          0xFFFFFFFFU
+
+/* 复位原因（RCC->CSR复位标志，按位） */
+#define BOOT_RESET_BOR          0x01U       /* 欠压复位（上电时同时置位） */
+#define BOOT_RESET_PIN          0x02U       /* NRST引脚复位 */
+#define BOOT_RESET_POR          0x04U       /* 上电/掉电复位 */
+#define BOOT_RESET_SOFT         0x08U       /* 软件复位 */
+#define BOOT_RESET_IWDG         0x10U       /* 独立看门狗复位 */
+#define BOOT_RESET_WWDG         0x20U       /* 窗口看门狗复位 */
+#define BOOT_RESET_LPWR         0x40U       /* 低功耗复位 */
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 启动阶段（上位机按此顺序显示名称） */
+typedef enum {
+    BOOT_STAGE_APP_INIT = 0,    /* 应用层初始化开始 */
+    BOOT_STAGE_OUTPUT_SAFE,     /* DAC初始化完成，输出4mA */
+    BOOT_STAGE_ACQ_START,       /* ADC连续转换启动 */
+    BOOT_STAGE_INIT_DONE,       /* 初始化完成，进入调度 */
+    BOOT_STAGE_FIRST_SAMPLE,    /* 取出第一个ADC样本 */
+    BOOT_STAGE_FIRST_READING,   /* 第一个有效温度及4-20mA输出 */
+    BOOT_STAGE_LCD_READY,       /* 串口屏完成上电复位 */
+    BOOT_STAGE_USB_READY,       /* USB完成枚举 */
+    BOOT_STAGE_COUNT
+} BootStage_t;
+
+/* 启动信息 */
+typedef struct {
+    uint8_t reset_flags;                    /* 复位原因 BOOT_RESET_xxx */
+    uint32_t stage_us[BOOT_STAGE_COUNT];    /* 各阶段时刻 (μs) */
+} BootInfo_t;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  启动计时初始化
+ * @note   在BSP_DWT_Init()之后尽早调用；读取并清除复位标志，记录应用层初始化开始
+ * @retval 无
+ */
+void APP_Boot_Init(void);
+
+/**
+ * @brief  记录到达启动阶段
+ * @param  stage: 启动阶段
+ * @note   只记录第一次，之后调用直接返回
+ * @retval 无
+ */
+void APP_Boot_Mark(uint8_t stage);
+
+/**
+ * @brief  检测后台启动的外设是否就绪（主循环中调用）
+ * @note   全部阶段记录完成后只做一次标志判断
+ * @retval 无
+ */
+void APP_Boot_Poll(void);
+
+/**
+ * @brief  获取启动信息
+ * @param  info: 输出启动信息指针
+ * @retval 无
+ */
+void APP_Boot_GetInfo(BootInfo_t *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APP_BOOT_H */
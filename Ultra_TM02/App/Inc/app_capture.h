@@ -0,0 +1,94 @@
+/**
+ * @file    app_capture.h
+ * @brief   原始采样录制应用层头文件
+ * @details 录制测量流水线实际使用的ADC原始码值及其采集时刻，由上位机通过
+ *          CMD_CAPTURE分帧读走并保存为文件，可在主机上送入同一份app_temp.c回放：
+ *          - 温度任务每取出一个样本调用APP_Capture_Record()，只在录制中记录
+ *          - 每条记录为24位码值和相对上一条记录的间隔 (μs)，间隔按启动转换时刻计算
+ *          - 缓冲区满时丢弃新样本并计数，下一条记录的间隔包含被丢弃的时段，
+ *            回放时时间轴保持连续
+ *          - 记录与读出都在主循环中进行，无需关中断
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __APP_CAPTURE_H
+#define __APP_CAPTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 录制缓冲区条数（2的幂，100Hz采样时约5s） */
+#define CAPTURE_BUF_SIZE        512
+
+/* 记录间隔上限 (μs)，24位 */
+#define CAPTURE_DT_MAX_US       0xFFFFFFU
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 录制记录 */
+typedef struct {
+    uint32_t raw;               /* 24位ADC原始值 */
+    uint32_t dt_us;             /* 相对上一条记录的间隔 (μs)，首条为0 */
+} CaptureRecord_t;
+
+/* 录制状态 */
+typedef struct {
+    uint8_t active;             /* 1=录制中 */
+    uint16_t buffered;          /* 缓冲区中未读出的条数 */
+    uint32_t recorded;          /* 本次录制已记录的条数 */
+    uint32_t lost;              /* 缓冲区满而丢弃的条数 */
+} CaptureStatus_t;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  开始录制
+ * @note   清空缓冲区和计数
+ * @retval 无
+ */
+void APP_Capture_Start(void);
+
+/**
+ * @brief  停止录制
+ * @note   缓冲区中的记录仍可读出
+ * @retval 无
+ */
+void APP_Capture_Stop(void);
+
+/**
+ * @brief  记录一个样本（温度任务中调用）
+ * @param  raw: 24位ADC原始值
+ * @param  cycles: 样本启动转换时的CPU周期计数
+ * @retval 无
+ */
+void APP_Capture_Record(uint32_t raw, uint32_t cycles);
+
+/**
+ * @brief  读出并移除缓冲区中最旧的记录
+ * @param  records: 输出记录数组
+ * @param  max_count: 最多读出条数
+ * @param  first_seq: 输出第一条记录的序号（本次录制从0开始，不含丢弃的样本）
+ * @retval 读出的条数
+ */
+uint16_t APP_Capture_Read(CaptureRecord_t *records, uint16_t max_count, uint32_t *first_seq);
+
+/**
+ * @brief  获取录制状态
+ * @param  status: 输出状态结构体指针
+ * @retval 无
+ */
+void APP_Capture_GetStatus(CaptureStatus_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APP_CAPTURE_H */
@@ -43,9 +43,24 @@ extern "C" {
 #define CMD_SAVE_PARAM          0x50        /* 保存参数 */
 #define CMD_LOAD_PARAM          0x51        /* 加载参数 */
 #define CMD_RESET_DEFAULT       0x52        /* 恢复默认 */
+#define CMD_GET_TASK_STATS      0x60        /* 获取任务调度统计 */
+#define CMD_GET_PROFILE         0x61        /* 获取性能探针统计 */
+#define CMD_GET_TRACE           0x62        /* 读取事件跟踪缓冲区 */
+#define CMD_GET_BOOT_INFO       0x63        /* 获取复位原因与启动计时 */
+#define CMD_SAMPLE_TIMING       0x64        /* 采样周期设置与间隔抖动统计 */
+#define CMD_POWER               0x65        /* 时钟档位设置与CPU负载统计 */
+#define CMD_BENCH               0x66        /* 热路径RAM/Flash执行周期自测 */
+#define CMD_CAPTURE             0x67        /* 原始采样录制与读出 */
+#define CMD_GET_FLASH_STATS     0x68        /* 获取Flash擦写停顿/采样间隔统计 */
+#define CMD_BURST               0x69        /* 突发采集布防、触发与数据块读出 */
+#define CMD_HISTORY             0x6A        /* 测量历史记录状态、设置与按序号读出 */
+#define CMD_DATALOG             0x6B        /* 长期数据日志状态、设置与按页批量读出 */
+#define CMD_STATS               0x6C        /* 温度窗口统计与Allan偏差 */
+#define CMD_ALARM               0x6D        /* 报警设置与状态 */
 #define CMD_ACK                 0x80        /* 确认响应 */
 #define CMD_NACK                0x81        /* 否定响应 */
 #define CMD_DATA_REPORT         0xF0        /* 数据主动上报 */
+#define CMD_ALARM_EVENT         0xF1        /* 报警事件主动上报 */
 
 /* 状态码定义 */
 #define STATUS_OK               0x00        /* 成功 */
@@ -0,0 +1,185 @@
+/**
+ * @file    app_datalog.h
+ * @brief   长期数据日志应用层头文件
+ * @details 在Flash数据日志区域(Sector 5)中保存每个统计周期的温度最小值/平均值/
+ *          最大值，上位机长时间断开或设备掉电重启后仍可读出数天的记录：
+ *          - 温度任务每完成一次测量调用APP_DataLog_Record()，周期结束时生成一条记录
+ *          - 记录差分编码后暂存在RAM页中，页写满后一次写入Flash，减少擦写次数
+ *          - 区域写满时由Flash任务(APP_DataLog_Process)回收：最新的
+ *            DATALOG_KEEP_PAGES页暂存到RAM，擦除扇区后写回区域开头，其余较旧的
+ *            记录丢失；擦除不在温度任务的测量流程中进行
+ *          - 每页自带时间、周期和基准值，可独立解码；掉电丢失RAM中未写入的一页
+ *          - 固件映像超出程序代码区域时（BSP_Flash_LogAvailable）数据日志不启用
+ *
+ *          页格式（256字节，小端）：
+ *          [魔数 u16 "DL"][条数 u8][标志 u8][页序号 u32][起始时间s u32]
+ *          [周期s u16][启动序号 u16][基准值mK i32][数据长度 u16][CRC16 u16] + 数据
+ *          CRC16计算范围为页头（CRC字段按0计）与数据，起始时间为页内第一条记录的
+ *          周期起点，标志bit0置位时为上位机校时后的UNIX时间，否则为上电以来的秒数
+ *
+ *          数据为连续周期的记录，每个值为无符号LEB128变长整数：
+ *          - 有数据: [zigzag(平均值 - 上一平均值) << 1][平均值 - 最小值][最大值 - 平均值]
+ *          - 无数据: [(连续无有效测量的周期数 << 1) | 1]
+ *          温度单位为mK，页内第一条的"上一平均值"为页头基准值
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __APP_DATALOG_H
+#define __APP_DATALOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+#include "bsp_flash.h"
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 页大小与页数（每页一次编程，约1ms） */
+#define DATALOG_PAGE_SIZE           256
+#define DATALOG_PAGE_COUNT          (FLASH_LOG_SIZE / DATALOG_PAGE_SIZE)
+#define DATALOG_HEADER_SIZE         24
+#define DATALOG_PAYLOAD_SIZE        (DATALOG_PAGE_SIZE - DATALOG_HEADER_SIZE)
+
+/* 页魔数 ("DL") */
+#define DATALOG_MAGIC               0x4C44
+
+/* 页标志 */
+#define DATALOG_FLAG_TIME_SYNCED    0x01
+
+/* 回收时保留的最新页数（RAM暂存8KB，默认周期下约1.7天） */
+#define DATALOG_KEEP_PAGES          32
+
+/* 统计周期 (s)：温度平稳时每条约3字节，默认周期下整个区域约保存27天 */
+#define DATALOG_INTERVAL_DEFAULT    60
+#define DATALOG_INTERVAL_MAX        3600
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 页头 */
+typedef struct {
+    uint16_t magic;             /* 魔数 DATALOG_MAGIC */
+    uint8_t count;              /* 记录条数 */
+    uint8_t flags;              /* 标志 (DATALOG_FLAG_xxx) */
+    uint32_t seq;               /* 页序号（擦除和重启后继续递增） */
+    uint32_t time_s;            /* 第一条记录的周期起点 */
+    uint16_t interval_s;        /* 统计周期 (s) */
+    uint16_t boot;              /* 启动序号（每次上电加1） */
+    int32_t base_mK;            /* 基准值 (mK) */
+    uint16_t len;               /* 数据长度 (字节) */
+    uint16_t crc;               /* CRC16校验 */
+} DataLogHeader_t;
+
+/* 数据日志状态 */
+typedef struct {
+    uint16_t interval_s;        /* 统计周期 (s) */
+    uint16_t page_count;        /* 区域总页数，数据日志不可用时为0 */
+    uint16_t used_pages;        /* Flash中已写入的页数 */
+    uint16_t boot;              /* 本次启动序号 */
+    uint8_t time_synced;        /* 1=已校时 */
+    uint8_t pending_count;      /* RAM页中尚未写入的记录条数 */
+    uint32_t oldest_seq;        /* Flash中最旧一页的序号 */
+    uint32_t next_seq;          /* RAM页的序号（即下一个写入的页） */
+    uint32_t time_s;            /* 当前时间（格式同页头起始时间） */
+    uint32_t lost;              /* Flash写入失败而丢弃的记录条数 */
+} DataLogStatus_t;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  数据日志初始化
+ * @note   扫描数据日志区域确定写入位置和页序号，统计周期取自参数，
+ *         需在APP_Param_Init()之后调用
+ * @retval 无
+ */
+void APP_DataLog_Init(void);
+
+/**
+ * @brief  记录一次测量结果（温度任务中调用）
+ * @param  temperature_K: 温度 (K)
+ * @param  valid: 1=探头正常, 0=本次测量无效（不计入统计）
+ * @note   RAM页写满时同步写入Flash（约1ms）；区域回收的擦除不在此进行
+ * @retval 无
+ */
+void APP_DataLog_Record(float temperature_K, uint8_t valid);
+
+/**
+ * @brief  数据日志区域回收（Flash任务中调用）
+ * @note   区域写满时擦除扇区（1~2s）并写回最新的DATALOG_KEEP_PAGES页；
+ *         擦除期间Flash取指停顿，DRDY中断采样继续存入ADC FIFO。
+ *         擦除与写回之间掉电时暂存的页丢失
+ * @retval 无
+ */
+void APP_DataLog_Process(void);
+
+/**
+ * @brief  检查是否有待回收的区域
+ * @retval 1=有, 0=无
+ */
+uint8_t APP_DataLog_HasWork(void);
+
+/**
+ * @brief  设置统计周期
+ * @param  interval_s: 统计周期 (s)，1 ~ DATALOG_INTERVAL_MAX
+ * @note   先写入RAM页中的已有记录，丢弃当前未结束周期的统计
+ * @retval 0=成功, -1=参数无效, -2=Flash写入失败
+ */
+int APP_DataLog_SetInterval(uint16_t interval_s);
+
+/**
+ * @brief  校时
+ * @param  unix_s: 当前UNIX时间 (s)
+ * @note   本次上电期间有效；之后写入的页（含尚在RAM中的记录）使用UNIX时间
+ * @retval 无
+ */
+void APP_DataLog_SetTime(uint32_t unix_s);
+
+/**
+ * @brief  立即将RAM页中的记录写入Flash
+ * @note   未写满的页也占用一整页，频繁调用会缩短保存时长
+ * @retval 0=成功或无记录, -1=Flash写入失败
+ */
+int APP_DataLog_Flush(void);
+
+/**
+ * @brief  擦除全部数据日志
+ * @note   阻塞1~2s；RAM页中的记录保留，页序号继续递增
+ * @retval 0=成功, -1=擦除失败或数据日志不可用
+ */
+int APP_DataLog_Erase(void);
+
+/**
+ * @brief  读出Flash中的日志页
+ * @param  offset: 数据日志区域内的偏移（页按序号从旧到新排列）
+ * @param  data: 输出缓冲区
+ * @param  max_len: 最多读出字节数
+ * @retval 读出的字节数（已用页之外为0），-1=Flash读取失败
+ */
+int APP_DataLog_ReadFlash(uint32_t offset, uint8_t *data, uint16_t max_len);
+
+/**
+ * @brief  读出RAM页（尚未写入Flash的记录）
+ * @param  offset: 页内偏移
+ * @param  data: 输出缓冲区
+ * @param  max_len: 最多读出字节数
+ * @note   页头按当前状态填写（含CRC），格式与Flash中的页相同
+ * @retval 读出的字节数，超出页头与数据长度的部分不读出
+ */
+uint16_t APP_DataLog_ReadPending(uint16_t offset, uint8_t *data, uint16_t max_len);
+
+/**
+ * @brief  获取数据日志状态
+ * @param  status: 输出状态结构体指针
+ * @retval 无
+ */
+void APP_DataLog_GetStatus(DataLogStatus_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APP_DATALOG_H */
@@ -0,0 +1,107 @@
+/**
+ * @file    app_history.h
+ * @brief   测量历史记录应用层头文件
+ * @details 在SRAM环形缓冲区中保存抽取后的测量结果，上位机断开或轮询较慢时
+ *          可按序号补读期间的全部记录：
+ *          - 温度任务每完成一次测量调用APP_History_Record()，每N次保存一条
+ *          - 每条记录含时间戳 (ms)、温度、电压和探头状态，序号从上电起连续递增
+ *          - 缓冲区满时覆盖最旧记录，读出不移除记录，多个上位机可各自补读
+ *          - 记录与读出都在主循环中进行，无需关中断
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __APP_HISTORY_H
+#define __APP_HISTORY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 历史缓冲区条数（2的幂，默认抽取比下约17分钟） */
+#define HISTORY_BUF_SIZE            1024
+
+/* 抽取比：每N次测量保存一条（默认采样周期下每次测量50ms，即每秒1条） */
+#define HISTORY_DECIMATION_DEFAULT  20
+#define HISTORY_DECIMATION_MAX      60000
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 历史记录 */
+typedef struct {
+    uint32_t time_ms;           /* 时间戳（上电以来的ms，HAL_GetTick） */
+    float temperature_K;        /* 温度 (K)，探头异常时为最后一次有效值 */
+    float voltage;              /* 滤波后电压 (mV) */
+    uint8_t probe_status;       /* 探头状态 (ProbeStatus_t) */
+    uint8_t reserved[3];        /* 保留 */
+} HistoryRecord_t;
+
+/* 历史状态 */
+typedef struct {
+    uint16_t decimation;        /* 抽取比 */
+    uint16_t count;             /* 缓冲区中的条数 */
+    uint32_t next_seq;          /* 下一条记录的序号（即已保存的总条数） */
+} HistoryStatus_t;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  历史记录初始化
+ * @note   抽取比取自参数，需在APP_Param_Init()之后调用
+ * @retval 无
+ */
+void APP_History_Init(void);
+
+/**
+ * @brief  记录一次测量结果（温度任务中调用）
+ * @param  temperature_K: 温度 (K)
+ * @param  voltage: 滤波后电压 (mV)
+ * @param  probe_status: 探头状态
+ * @retval 无
+ */
+void APP_History_Record(float temperature_K, float voltage, uint8_t probe_status);
+
+/**
+ * @brief  按序号读出记录
+ * @param  seq: 起始序号
+ * @param  records: 输出记录数组
+ * @param  max_count: 最多读出条数
+ * @param  first_seq: 输出第一条记录的实际序号（早于缓冲区中最旧记录时从最旧记录开始）
+ * @retval 读出的条数
+ */
+uint16_t APP_History_Read(uint32_t seq, HistoryRecord_t *records, uint16_t max_count,
+                          uint32_t *first_seq);
+
+/**
+ * @brief  设置抽取比
+ * @param  decimation: 每N次测量保存一条，1 ~ HISTORY_DECIMATION_MAX
+ * @note   不清空已有记录
+ * @retval 0=成功, -1=参数无效
+ */
+int APP_History_SetDecimation(uint16_t decimation);
+
+/**
+ * @brief  清空历史记录
+ * @note   序号继续递增，上位机据此判断记录被清空
+ * @retval 无
+ */
+void APP_History_Clear(void);
+
+/**
+ * @brief  获取历史状态
+ * @param  status: 输出状态结构体指针
+ * @retval 无
+ */
+void APP_History_GetStatus(HistoryStatus_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APP_HISTORY_H */
@@ -23,6 +23,13 @@ extern "C" {
 #define OUTPUT_MIN_CURRENT      4.0f        /* 最小输出电流 (mA) */
 #define OUTPUT_MAX_CURRENT      20.0f       /* 最大输出电流 (mA) */
 
+/* 故障电流范围（NAMUR NE43） */
+#define OUTPUT_FAULT_MIN_CURRENT    3.6f    /* 下限故障电流 (mA) */
+#define OUTPUT_FAULT_MAX_CURRENT    21.0f   /* 上限故障电流 (mA) */
+
+/* 输出更新最小间隔 (ms)，即最大更新速率的倒数 */
+#define OUTPUT_MIN_UPDATE_INTERVAL  100
+
 /* 默认温度范围 */
 #define OUTPUT_DEFAULT_TEMP_4MA     -200.0f /* 4mA默认对应温度 (℃) */
 #define OUTPUT_DEFAULT_TEMP_20MA    100.0f  /* 20mA默认对应温度 (℃) */
@@ -45,12 +52,41 @@ typedef struct {
 void APP_Output_Init(void);
 
 /**
- * @brief  根据温度更新输出电流
+ * @brief  根据温度更新输出电流（新测量值事件）
  * @param  temperature: 温度值 (℃)
+ * @note   仅在产生新测量值时调用；DAC码值不变时不写DAC也不刷新LCD，
+ *         距上次写入不足最小间隔时暂存，由APP_Output_Process()补发
  * @retval 无
  */
 void APP_Output_UpdateCurrent(float temperature);
 
+/**
+ * @brief  输出处理（主循环中调用）
+ * @note   仅在有被限速暂存的输出值且间隔已满足时才写DAC
+ * @retval 无
+ */
+void APP_Output_Process(void);
+
+/**
+ * @brief  检查是否有到期待补发的输出值
+ * @note   与APP_Output_Process()的写入条件相同，供调度器判断就绪
+ * @retval 1=到期, 0=无
+ */
+uint8_t APP_Output_IsDue(void);
+
+/**
+ * @brief  设置输出更新最小间隔
+ * @param  interval_ms: 最小间隔 (ms)，0表示不限速
+ * @retval 无
+ */
+void APP_Output_SetMinInterval(uint32_t interval_ms);
+
+/**
+ * @brief  获取输出更新最小间隔
+ * @retval 最小间隔 (ms)
+ */
+uint32_t APP_Output_GetMinInterval(void);
+
 /**
  * @brief  直接设置输出电流
  * @param  current_mA: 电流值 (mA)
@@ -64,6 +100,27 @@ void APP_Output_SetCurrent(float current_mA);
  */
 float APP_Output_GetCurrent(void);
 
+/**
+ * @brief  强制输出故障电流
+ * @param  current_mA: 故障电流 (mA)，超出故障电流范围时限幅
+ * @note   立即写入，不受最小间隔限制；保持期间的测量值和手动设置
+ *         只记录不输出，APP_Output_ClearFault()后恢复
+ * @retval 无
+ */
+void APP_Output_SetFault(float current_mA);
+
+/**
+ * @brief  解除故障电流，恢复为最近一次应输出的电流
+ * @retval 无
+ */
+void APP_Output_ClearFault(void);
+
+/**
+ * @brief  检查输出是否被强制为故障电流
+ * @retval 1=故障电流, 0=正常输出
+ */
+uint8_t APP_Output_IsFault(void);
+
 /**
  * @brief  设置4mA对应温度点
  * @param  temp: 温度值 (℃)
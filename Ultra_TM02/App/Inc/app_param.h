@@ -2,6 +2,8 @@
  * @file    app_param.h
  * @brief   参数管理应用层头文件
  * @details 提供参数存储、加载、管理功能
+ *          参数以追加写日志形式保存在Flash参数扇区中：每次保存追加一条
+ *          带CRC的记录，扇区写满后才擦除，加载时取最新的有效记录
  * @author  Ultra-TM02 开发团队
  * @version V1.0
  * @date    2025-12-18
@@ -16,6 +18,8 @@ extern "C" {
 
 /* 包含头文件 ----------------------------------------------------------------*/
 #include "main.h"
+#include "bsp_flash.h"
+#include "bsp_power.h"
 
 /* 宏定义 --------------------------------------------------------------------*/
 
@@ -25,12 +29,21 @@ extern "C" {
 /* 参数版本 */
 #define PARAM_VERSION           0x0100      /* V1.0 */
 
+/* 参数日志记录大小（即UserParam_t大小，4字节对齐） */
+#define PARAM_RECORD_SIZE       sizeof(UserParam_t)
+
+/* 参数日志容量（记录数） */
+#define PARAM_LOG_CAPACITY      (FLASH_PARAM_SIZE / PARAM_RECORD_SIZE)
+
 /* 默认参数值 */
 #define DEFAULT_CURRENT_SOURCE  0           /* 默认10μA */
 #define DEFAULT_CURRENT_ADJ_10  0.0f        /* 10μA调整值 */
 #define DEFAULT_CURRENT_ADJ_17  0.0f        /* 17μA调整值 */
 #define DEFAULT_TEMP_4MA        (-200.0f)   /* 4mA对应温度 */
 #define DEFAULT_TEMP_20MA       100.0f      /* 20mA对应温度 */
+#define DEFAULT_CLOCK_PROFILE   POWER_PROFILE_FULL  /* 全速 */
+#define DEFAULT_HISTORY_DECIMATION  0       /* 0=使用HISTORY_DECIMATION_DEFAULT */
+#define DEFAULT_DATALOG_INTERVAL    0       /* 0=使用DATALOG_INTERVAL_DEFAULT */
 
 /* 类型定义 ------------------------------------------------------------------*/
 
@@ -38,9 +51,10 @@ extern "C" {
 typedef struct {
     uint32_t magic;             /* 魔数 0x544D5032 ("TMP2") */
     uint16_t version;           /* 参数版本 */
-    uint16_t reserved;          /* 保留 */
+    uint16_t history_decimation; /* 历史记录抽取比（旧记录为0即默认值） */
     uint8_t current_source;     /* 电流源选择 (0:10μA, 1:17μA) */
-    uint8_t padding[3];         /* 对齐填充 */
+    uint8_t clock_profile;      /* 时钟档位 (POWER_PROFILE_xxx，旧记录为0即全速) */
+    uint16_t datalog_interval;  /* 数据日志统计周期 (s，旧记录为0即默认值) */
     float current_adj_10uA;     /* 10μA调整值 (μA) */
     float current_adj_17uA;     /* 17μA调整值 (μA) */
     float temp_4mA;             /* 4mA对应温度 (℃) */
@@ -65,10 +79,17 @@ int APP_Param_Load(void);
 
 /**
  * @brief  保存参数
+ * @note   与最新记录相同时不写Flash；否则追加一条记录，扇区写满时先擦除
  * @retval 0=成功, -1=失败
  */
 int APP_Param_Save(void);
 
+/**
+ * @brief  获取参数日志已使用的记录数
+ * @retval 已使用记录数 (0 ~ PARAM_LOG_CAPACITY)
+ */
+uint16_t APP_Param_GetLogUsed(void);
+
 /**
  * @brief  恢复默认参数
  * @retval 无
@@ -140,6 +161,45 @@ float APP_Param_Get20mATemp(void);
  */
 void APP_Param_Set20mATemp(float temp);
 
+/**
+ * @brief  获取时钟档位
+ * @retval 时钟档位 (POWER_PROFILE_xxx)
+ */
+uint8_t APP_Param_GetClockProfile(void);
+
+/**
+ * @brief  设置时钟档位
+ * @param  profile: 时钟档位 (POWER_PROFILE_xxx)
+ * @retval 无
+ */
+void APP_Param_SetClockProfile(uint8_t profile);
+
+/**
+ * @brief  获取历史记录抽取比
+ * @retval 抽取比，0=默认
+ */
+uint16_t APP_Param_GetHistoryDecimation(void);
+
+/**
+ * @brief  设置历史记录抽取比
+ * @param  decimation: 抽取比
+ * @retval 无
+ */
+void APP_Param_SetHistoryDecimation(uint16_t decimation);
+
+/**
+ * @brief  获取数据日志统计周期
+ * @retval 统计周期 (s)，0=默认
+ */
+uint16_t APP_Param_GetDatalogInterval(void);
+
+/**
+ * @brief  设置数据日志统计周期
+ * @param  interval_s: 统计周期 (s)
+ * @retval 无
+ */
+void APP_Param_SetDatalogInterval(uint16_t interval_s);
+
 /**
  * @brief  获取参数结构体指针
  * @retval 参数结构体指针
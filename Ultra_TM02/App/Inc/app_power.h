@@ -0,0 +1,91 @@
+/**
+ * @file    app_power.h
+ * @brief   空闲睡眠与时钟档位应用层头文件
+ * @details 主循环无就绪任务时进入WFI睡眠，由DRDY、采样定时器、USB、串口和
+ *          SysTick(1ms)中断唤醒；按睡眠时长统计CPU负载：
+ *          - 负载 = 1 - 睡眠时间 / 经过时间，中断服务时间计为忙
+ *          - 每个统计窗口（调度任务周期，约100ms）得到一个窗口负载，
+ *            记录最近值和最大值，平均值按全部窗口累计
+ *          - 切换时钟档位后重新同步串口波特率和采样定时器，并清零负载统计
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __APP_POWER_H
+#define __APP_POWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+#include "bsp_power.h"
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* CPU负载统计 */
+typedef struct {
+    uint16_t load_avg;          /* 平均负载 (‰) */
+    uint16_t load_peak;         /* 最大窗口负载 (‰) */
+    uint16_t load_last;         /* 最近窗口负载 (‰) */
+    uint32_t sleep_count;       /* 进入睡眠次数 */
+    uint32_t elapsed_ms;        /* 统计时长 (ms) */
+} PowerStats_t;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  电源管理初始化
+ * @note   在APP_Param_Init()之后调用，切换到参数中保存的时钟档位
+ * @retval 无
+ */
+void APP_Power_Init(void);
+
+/**
+ * @brief  切换时钟档位
+ * @param  profile: 时钟档位 (POWER_PROFILE_xxx)
+ * @note   等待串口发送完成并占用SPI总线后切换，随后重新同步外设时钟
+ * @retval 0=成功, -1=档位无效或切换失败
+ */
+int APP_Power_SetProfile(uint8_t profile);
+
+/**
+ * @brief  获取当前时钟档位
+ * @retval 时钟档位
+ */
+uint8_t APP_Power_GetProfile(void);
+
+/**
+ * @brief  空闲处理（主循环中无就绪任务时调用）
+ * @note   关中断后再次确认无就绪任务才进入睡眠，唤醒后开中断执行中断服务
+ * @retval 无
+ */
+void APP_Power_Idle(void);
+
+/**
+ * @brief  负载统计处理（周期调度任务）
+ * @note   结束当前统计窗口并开始下一个
+ * @retval 无
+ */
+void APP_Power_Process(void);
+
+/**
+ * @brief  获取CPU负载统计
+ * @param  stats: 输出统计结构体指针
+ * @retval 无
+ */
+void APP_Power_GetStats(PowerStats_t *stats);
+
+/**
+ * @brief  清零CPU负载统计
+ * @retval 无
+ */
+void APP_Power_ResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APP_POWER_H */
@@ -0,0 +1,104 @@
+/**
+ * @file    app_sched.h
+ * @brief   协作式任务调度应用层头文件
+ * @details 以静态任务表取代固定顺序的主循环：
+ *          - 每个任务为周期触发或事件触发（就绪判断函数），并带优先级与执行预算
+ *          - 每次调度只运行当前最高优先级的就绪任务，运行完后重新从最高优先级检查，
+ *            采集与输出任务始终先于显示和后台任务
+ *          - 任务不可抢占，执行时间超过预算记为超限
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __APP_SCHED_H
+#define __APP_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 任务编号（与任务表顺序一致，上位机按此顺序解析统计数据） */
+typedef enum {
+    SCHED_TASK_TEMP = 0,        /* 温度测量 */
+    SCHED_TASK_OUTPUT,          /* 4-20mA输出补发 */
+    SCHED_TASK_COMM,            /* USB通讯 */
+    SCHED_TASK_FLASH,           /* Flash分步编程 */
+    SCHED_TASK_LCD,             /* LCD显示刷新 */
+    SCHED_TASK_LED,             /* 运行指示灯 */
+    SCHED_TASK_POWER,           /* CPU负载统计 */
+    SCHED_TASK_COUNT
+} SchedTaskId_t;
+
+/* 任务描述（静态常量） */
+typedef struct {
+    const char *name;           /* 任务名 */
+    void (*func)(void);         /* 任务函数 */
+    uint8_t (*ready)(void);     /* 事件就绪判断，NULL表示周期任务 */
+    uint16_t period_ms;         /* 周期 (ms)，事件任务为0 */
+    uint16_t budget_us;         /* 单次执行预算 (μs) */
+    uint8_t priority;           /* 优先级，数值越小越优先 */
+} SchedTask_t;
+
+/* 任务运行统计 */
+typedef struct {
+    uint32_t run_count;         /* 执行次数 */
+    uint32_t overrun_count;     /* 执行时间超过预算的次数 */
+    uint32_t max_exec_us;       /* 最长单次执行时间 (μs) */
+    uint32_t max_late_ms;       /* 周期任务相对释放时刻的最大延迟 (ms) */
+} SchedStats_t;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  调度器初始化
+ * @note   按优先级排列任务表，周期任务从当前时刻开始计时
+ * @retval 无
+ */
+void APP_Sched_Init(void);
+
+/**
+ * @brief  调度一次（主循环中调用）
+ * @note   运行最高优先级的一个就绪任务后返回，无就绪任务时直接返回
+ * @retval 1=运行了任务, 0=无就绪任务
+ */
+uint8_t APP_Sched_Run(void);
+
+/**
+ * @brief  检查是否有就绪任务
+ * @note   空闲睡眠前在关中断状态下调用，避免检查与睡眠之间漏掉新到的事件
+ * @retval 1=有就绪任务, 0=无
+ */
+uint8_t APP_Sched_HasReady(void);
+
+/**
+ * @brief  获取任务描述
+ * @param  id: 任务编号
+ * @retval 任务描述指针，编号无效时为NULL
+ */
+const SchedTask_t *APP_Sched_GetTask(uint8_t id);
+
+/**
+ * @brief  获取任务运行统计
+ * @param  id: 任务编号
+ * @param  stats: 输出统计结构体指针
+ * @retval 无
+ */
+void APP_Sched_GetStats(uint8_t id, SchedStats_t *stats);
+
+/**
+ * @brief  清零全部任务运行统计
+ * @retval 无
+ */
+void APP_Sched_ResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APP_SCHED_H */
@@ -34,6 +34,15 @@ extern "C" {
 /* 分度表魔数 */
 #define TEMP_TABLE_MAGIC        0x004C4254  /* "TBL\0" */
 
+/* 统计窗口数与默认长度（测量次数，默认采样周期下每次测量50ms，即1s与1min）；
+ * 统计与Allan偏差按每次测量的中值查表温度累计，不经滑动平均 */
+#define TEMP_STATS_WINDOWS      2
+#define TEMP_STATS_WINDOW_0     20
+#define TEMP_STATS_WINDOW_1     1200
+
+/* Allan偏差层数：第j层τ = 2^j × 测量周期（默认采样周期下最大约27分钟） */
+#define TEMP_ADEV_LEVELS        16
+
 /* 类型定义 ------------------------------------------------------------------*/
 
 /* 测量状态 */
@@ -65,6 +74,8 @@ typedef struct {
     float temperature_K;        /* 温度值 (K) */
     float temperature_C;        /* 温度值 (℃) */
     uint32_t sample_count;      /* 采样计数 */
+    uint32_t sample_cycles;     /* 最近样本的采集时刻 (CPU周期) */
+    uint32_t sample_tick;       /* 最近样本的采集时刻 (ms) */
 } TempMeasure_t;
 
 /* 分度表数据点 */
@@ -80,6 +91,40 @@ typedef struct {
     uint16_t reserved;          /* 保留 */
 } TempTableHeader_t;
 
+/* 突发采集配置 */
+typedef struct {
+    uint16_t pre_samples;       /* 触发前样本数 */
+    uint16_t post_samples;      /* 触发后样本数（含触发样本） */
+    uint8_t edge;               /* 电平触发沿 (ADC_BURST_EDGE_x)，0=不使用电平触发 */
+    float level_mV;             /* 电平触发阈值 (mV) */
+    float rate_limit;           /* 温度变化率触发阈值 (K/s)，0=不使用 */
+} TempBurstConfig_t;
+
+/* 统计结果 */
+typedef struct {
+    uint32_t count;             /* 测量次数 */
+    float mean;                 /* 平均值 (K) */
+    float stddev;               /* 标准差 (K，样本标准差，count<2时为0) */
+    float min;                  /* 最小值 (K) */
+    float max;                  /* 最大值 (K) */
+} TempStatsResult_t;
+
+/* 统计窗口 */
+typedef struct {
+    uint32_t length;            /* 窗口长度 (测量次数)，0=自复位起累计不分窗口 */
+    uint32_t completed;         /* 已结束的窗口数 */
+    TempStatsResult_t current;  /* 当前（未满）窗口 */
+    TempStatsResult_t last;     /* 最近一个完整窗口 */
+} TempStatsWindow_t;
+
+/* Allan偏差 */
+typedef struct {
+    uint8_t enabled;            /* 1=累计中 */
+    uint32_t samples;           /* 累计的测量次数 */
+    uint32_t elapsed_ms;        /* 第一次到最近一次测量的时间 (ms) */
+    float adev[TEMP_ADEV_LEVELS];   /* 第j层的Allan偏差 (K)，数据不足时为0 */
+} TempAdev_t;
+
 /* 函数声明 ------------------------------------------------------------------*/
 
 /**
@@ -142,6 +187,13 @@ TempState_t APP_Temp_GetState(void);
  */
 uint8_t APP_Temp_IsRunning(void);
 
+/**
+ * @brief  检查测量任务是否有待处理的工作
+ * @note   采样状态下FIFO有新样本，或处于滤波/计算/输出步骤时为真，供调度器判断就绪
+ * @retval 1=有工作, 0=无
+ */
+uint8_t APP_Temp_HasWork(void);
+
 /**
  * @brief  设置电流源
  * @param  src: 电流源选择 (0:10μA, 1:17μA)
@@ -158,6 +210,7 @@ uint8_t APP_Temp_GetCurrentSource(void);
 /**
  * @brief  分度表查表
  * @param  voltage: 电压值 (mV)
+ * @note   位于RAM中，计算内核见app_temp_calc.h
  * @retval 温度值 (K)
  */
 float APP_Temp_TableLookup(float voltage);
@@ -168,12 +221,118 @@ float APP_Temp_TableLookup(float voltage);
  */
 int APP_Temp_TableVerify(void);
 
+/**
+ * @brief  获取分度表数据点数
+ * @retval 数据点数，分度表无效时为0
+ */
+uint16_t APP_Temp_GetTablePoints(void);
+
+/**
+ * @brief  开始下载分度表
+ * @param  point_count: 数据点数 (1 ~ TEMP_TABLE_MAX_POINTS)
+ * @note   擦除分度表扇区（约1~2s），下载完成前分度表无效
+ * @retval 0=成功, -1=参数错误, -2=Flash错误
+ */
+int APP_Temp_TableLoadStart(uint16_t point_count);
+
+/**
+ * @brief  写入一包分度表数据
+ * @param  packet_index: 包序号（从0开始连续递增）
+ * @param  data: 数据点 (TempTablePoint_t数组，小端)
+ * @param  len: 数据长度（字节数，sizeof(TempTablePoint_t)的整数倍）
+ * @note   重复收到上一包（主机未收到ACK而重发）时直接返回成功
+ * @retval 0=成功, -1=序号/长度错误, -2=Flash错误
+ */
+int APP_Temp_TableLoadData(uint16_t packet_index, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  结束下载分度表
+ * @param  expected_crc: 主机计算的全部数据点CRC32，NULL表示不比对
+ * @note   点数与CRC均正确后才写入表头，表头写入即表示分度表生效
+ * @retval 0=成功, -1=点数或CRC不符, -2=Flash错误
+ */
+int APP_Temp_TableLoadEnd(const uint32_t *expected_crc);
+
 /**
  * @brief  获取采样计数
  * @retval 采样计数
  */
 uint32_t APP_Temp_GetSampleCount(void);
 
+/**
+ * @brief  布防突发采集
+ * @param  config: 采集配置
+ * @note   布防期间ADC以最高速率连续转换，全部码值写入RAM环形缓冲区；滤波测量与
+ *         4-20mA输出仍按采样周期进行。电平阈值按布防时的增益换算为码值，
+ *         变化率按每次滤波后的温度判断
+ * @retval 0=成功, -1=参数无效
+ */
+int APP_Temp_BurstArm(const TempBurstConfig_t *config);
+
+/**
+ * @brief  命令触发突发采集
+ * @retval 1=已触发, 0=未处于布防状态
+ */
+uint8_t APP_Temp_BurstTrigger(void);
+
+/**
+ * @brief  取消突发采集
+ * @retval 无
+ */
+void APP_Temp_BurstAbort(void);
+
+/**
+ * @brief  获取突发采集配置
+ * @param  config: 输出配置结构体指针
+ * @retval 无
+ */
+void APP_Temp_GetBurstConfig(TempBurstConfig_t *config);
+
+/**
+ * @brief  设置统计窗口长度
+ * @param  index: 窗口编号 (0 ~ TEMP_STATS_WINDOWS-1)
+ * @param  length: 窗口长度 (测量次数)，0=累计不分窗口
+ * @note   清空该窗口；不保存到参数，上电恢复默认长度
+ * @retval 0=成功, -1=参数无效
+ */
+int APP_Temp_StatsSetWindow(uint8_t index, uint32_t length);
+
+/**
+ * @brief  清空全部统计窗口与Allan偏差累计
+ * @retval 无
+ */
+void APP_Temp_StatsReset(void);
+
+/**
+ * @brief  开始或停止Allan偏差累计
+ * @param  enable: 1=清空后开始累计, 0=停止（保留已有结果）
+ * @retval 无
+ */
+void APP_Temp_AdevEnable(uint8_t enable);
+
+/**
+ * @brief  获取统计窗口
+ * @param  index: 窗口编号
+ * @param  window: 输出窗口结构体指针
+ * @retval 0=成功, -1=编号无效
+ */
+int APP_Temp_GetStats(uint8_t index, TempStatsWindow_t *window);
+
+/**
+ * @brief  获取Allan偏差
+ * @param  adev: 输出结构体指针
+ * @note   非重叠估计，第j层由相邻两个2^(j-1)块求平均逐级得到；τ0取
+ *         elapsed_ms / (samples - 1)，第j层的差分个数为 samples / 2^j - 1
+ * @retval 无
+ */
+void APP_Temp_GetAdev(TempAdev_t *adev);
+
+/**
+ * @brief  获取统计中跳过的无效测量次数（探头异常）
+ * @retval 次数
+ */
+uint32_t APP_Temp_GetStatsSkipped(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,165 @@
+/**
+ * @file    app_temp_calc.h
+ * @brief   温度计算内核头文件
+ * @details 每个样本都要执行的滤波与查表计算，以强制内联函数提供：
+ *          - app_temp.c在RAMFUNC函数中展开，热路径从SRAM取指
+ *          - app_bench.c分别在RAMFUNC和FLASHFUNC函数中展开同一份代码，
+ *            对比两种存储区的执行周期
+ *          内核不调用其他函数（浮点运算由FPU完成），展开后不会跳回Flash
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __APP_TEMP_CALC_H
+#define __APP_TEMP_CALC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "app_temp.h"
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 滑动平均滤波器 */
+typedef struct {
+    float buffer[TEMP_FILTER_SIZE];     /* 窗口数据 */
+    float sum;                          /* 窗口内数据之和 */
+    uint8_t index;                      /* 下一个写入位置 */
+    uint8_t count;                      /* 窗口内有效数据个数 */
+} MovingAvg_t;
+
+/* 计算内核 ------------------------------------------------------------------*/
+
+/**
+ * @brief  中值滤波
+ * @param  data: 数据数组
+ * @param  len: 数据长度 (1 ~ TEMP_SAMPLE_COUNT)
+ * @retval 中值
+ */
+static inline ALWAYS_INLINE float TempCalc_Median(const float *data, uint8_t len)
+{
+    float temp[TEMP_SAMPLE_COUNT];
+    float t;
+    uint8_t i, j;
+    
+    /* 复制数据 */
+    for (i = 0; i < len && i < TEMP_SAMPLE_COUNT; i++)
+    {
+        temp[i] = data[i];
+    }
+    
+    /* 冒泡排序 */
+    for (i = 0; i < len - 1; i++)
+    {
+        for (j = 0; j < len - 1 - i; j++)
+        {
+            if (temp[j] > temp[j + 1])
+            {
+                t = temp[j];
+                temp[j] = temp[j + 1];
+                temp[j + 1] = t;
+            }
+        }
+    }
+    
+    /* 返回中值 */
+    return temp[len / 2];
+}
+
+/**
+ * @brief  滑动平均滤波
+ * @param  filter: 滤波器
+ * @param  value: 新数据
+ * @retval 滤波后的值
+ */
+static inline ALWAYS_INLINE float TempCalc_MovingAvg(MovingAvg_t *filter, float value)
+{
+    /* 减去旧值 */
+    filter->sum -= filter->buffer[filter->index];
+    
+    /* 添加新值 */
+    filter->buffer[filter->index] = value;
+    filter->sum += value;
+    
+    /* 更新索引 */
+    filter->index = (filter->index + 1) % TEMP_FILTER_SIZE;
+    
+    /* 更新计数 */
+    if (filter->count < TEMP_FILTER_SIZE)
+    {
+        filter->count++;
+    }
+    
+    /* 返回平均值 */
+    return filter->sum / filter->count;
+}
+
+/**
+ * @brief  检查分度表头部
+ * @param  header: 分度表头部
+ * @retval 1=有效, 0=无效
+ */
+static inline ALWAYS_INLINE uint8_t TempCalc_TableValid(const TempTableHeader_t *header)
+{
+    return (header->magic == TEMP_TABLE_MAGIC) &&
+           (header->point_count != 0) &&
+           (header->point_count <= TEMP_TABLE_MAX_POINTS);
+}
+
+/**
+ * @brief  分度表查表（二分查找+线性插值）
+ * @param  points: 分度表数据点（电压递减排列）
+ * @param  count: 数据点数 (>=1)
+ * @param  voltage: 电压值 (mV)
+ * @retval 温度值 (K)
+ */
+static inline ALWAYS_INLINE float TempCalc_Lookup(const TempTablePoint_t *points, uint16_t count,
+                                                  float voltage)
+{
+    int low = 0;
+    int high = count - 1;
+    int mid;
+    float v0, v1, t0, t1;
+    
+    /* 边界检查 */
+    if (voltage >= points[0].voltage)
+    {
+        return points[0].temperature;
+    }
+    if (voltage <= points[high].voltage)
+    {
+        return points[high].temperature;
+    }
+    
+    /* 二分查找 */
+    while (high - low > 1)
+    {
+        mid = (low + high) / 2;
+        
+        if (voltage > points[mid].voltage)
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid;
+        }
+    }
+    
+    /* 线性插值 */
+    v0 = points[low].voltage;
+    v1 = points[high].voltage;
+    t0 = points[low].temperature;
+    t1 = points[high].temperature;
+    
+    return t0 + (voltage - v0) * (t1 - t0) / (v1 - v0);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APP_TEMP_CALC_H */
@@ -0,0 +1,283 @@
+/**
+ * @file    app_alarm.c
+ * @brief   温度报警应用层源文件
+ * @details 实现上下限、变化率和探头故障报警的判断、事件上报与故障电流输出
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "app_alarm.h"
+#include "app_comm.h"
+#include "app_output.h"
+#include "app_temp.h"
+#include <string.h>
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 报警设置 */
+static AlarmConfig_t alarm_config = {
+    .enable = 0,
+    .fault = 0,
+    .fault_mA = ALARM_FAULT_CURRENT_DEFAULT
+};
+
+/* 报警状态 */
+static uint8_t alarm_active = 0;
+static uint32_t alarm_event_seq = 0;
+static uint16_t alarm_trips[ALARM_COUNT];
+
+/* 变化率：上一次有效测量 */
+static float rate_last_K = 0.0f;
+static uint32_t rate_last_tick = 0;
+static uint8_t rate_last_valid = 0;
+static float rate_K_s = 0.0f;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static void UpdateOutput(void);
+static void SendEvent(uint8_t changed, uint8_t probe_status, float temperature_K);
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  按当前报警位强制或恢复4-20mA输出
+ * @retval 无
+ */
+static void UpdateOutput(void)
+{
+    if (alarm_active & alarm_config.fault)
+    {
+        APP_Output_SetFault(alarm_config.fault_mA);
+    }
+    else
+    {
+        APP_Output_ClearFault();
+    }
+}
+
+/**
+ * @brief  发送报警事件帧
+ * @param  changed: 变化的报警位
+ * @param  probe_status: 探头状态
+ * @param  temperature_K: 温度 (K)
+ * @note   USB未连接时事件丢失，序号照常递增
+ * @retval 无
+ */
+static void SendEvent(uint8_t changed, uint8_t probe_status, float temperature_K)
+{
+    uint8_t data[ALARM_EVENT_LEN];
+    uint32_t time_ms = HAL_GetTick();
+    
+    memcpy(&data[0], &alarm_event_seq, 4);
+    data[4] = alarm_active;
+    data[5] = changed;
+    data[6] = probe_status;
+    data[7] = 0;
+    memcpy(&data[8], &time_ms, 4);
+    memcpy(&data[12], &temperature_K, 4);
+    memcpy(&data[16], &rate_K_s, 4);
+    
+    alarm_event_seq++;
+    APP_Comm_SendData(CMD_ALARM_EVENT, data, ALARM_EVENT_LEN);
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  报警模块初始化
+ * @retval 无
+ */
+void APP_Alarm_Init(void)
+{
+    memset(&alarm_config, 0, sizeof(alarm_config));
+    alarm_config.fault_mA = ALARM_FAULT_CURRENT_DEFAULT;
+    alarm_active = 0;
+    alarm_event_seq = 0;
+    APP_Alarm_ResetRate();
+    APP_Alarm_ClearTrips();
+}
+
+/**
+ * @brief  以一次测量结果判断报警
+ * @param  temperature_K: 温度 (K)
+ * @param  sample_tick: 测量对应采样时刻 (ms)
+ * @param  probe_status: 探头状态
+ * @note   探头异常期间上下限报警保持原状态，变化率从下一次有效测量重新计算
+ * @retval 当前报警位
+ */
+uint8_t APP_Alarm_Check(float temperature_K, uint32_t sample_tick, uint8_t probe_status)
+{
+    uint8_t active = alarm_active;
+    uint8_t changed;
+    uint8_t i;
+    float dt;
+    float rate;
+    
+    if (probe_status == PROBE_STATUS_OK)
+    {
+        active &= ~ALARM_PROBE;
+        
+        /* 上下限：回差范围内保持原状态 */
+        if (temperature_K > alarm_config.high_K)
+        {
+            active |= ALARM_HIGH;
+        }
+        else if (temperature_K < alarm_config.high_K - alarm_config.hyst_K)
+        {
+            active &= ~ALARM_HIGH;
+        }
+        if (temperature_K < alarm_config.low_K)
+        {
+            active |= ALARM_LOW;
+        }
+        else if (temperature_K > alarm_config.low_K + alarm_config.hyst_K)
+        {
+            active &= ~ALARM_LOW;
+        }
+        
+        /* 变化率：相邻两次有效测量，按采样时刻的ms时基计算间隔（DWT周期差会回绕） */
+        if (rate_last_valid)
+        {
+            dt = (float)(sample_tick - rate_last_tick) * 0.001f;
+            if (dt > 0.0f)
+            {
+                rate_K_s = (temperature_K - rate_last_K) / dt;
+                rate = (rate_K_s < 0.0f) ? -rate_K_s : rate_K_s;
+                if (rate > alarm_config.rate_K_s)
+                {
+                    active |= ALARM_RATE;
+                }
+                else if (rate < alarm_config.rate_K_s - alarm_config.rate_hyst_K_s)
+                {
+                    active &= ~ALARM_RATE;
+                }
+            }
+        }
+        rate_last_K = temperature_K;
+        rate_last_tick = sample_tick;
+        rate_last_valid = 1;
+    }
+    else
+    {
+        active |= ALARM_PROBE;
+        rate_last_valid = 0;
+        rate_K_s = 0.0f;
+    }
+    
+    active &= alarm_config.enable;
+    changed = active ^ alarm_active;
+    if (changed == 0)
+    {
+        return alarm_active;
+    }
+    
+    /* 统计新触发的报警 */
+    for (i = 0; i < ALARM_COUNT; i++)
+    {
+        if ((changed & active & (1U << i)) && alarm_trips[i] != 0xFFFF)
+        {
+            alarm_trips[i]++;
+        }
+    }
+    
+    alarm_active = active;
+    UpdateOutput();
+    SendEvent(changed, probe_status, temperature_K);
+    
+    return alarm_active;
+}
+
+/**
+ * @brief  重新开始变化率计算
+ * @retval 无
+ */
+void APP_Alarm_ResetRate(void)
+{
+    rate_last_valid = 0;
+    rate_K_s = 0.0f;
+}
+
+/**
+ * @brief  设置报警
+ * @param  config: 报警设置
+ * @note   启用上下限时要求下限低于上限；启用变化率时要求上限大于0且大于回差
+ * @retval 0=成功, -1=参数无效
+ */
+int APP_Alarm_SetConfig(const AlarmConfig_t *config)
+{
+    uint8_t changed;
+    
+    /* 比较式写法同时排除NaN */
+    if ((config->enable & ~ALARM_ALL) || (config->fault & ~ALARM_ALL) ||
+        !(config->hyst_K >= 0.0f) || !(config->rate_hyst_K_s >= 0.0f) ||
+        !(config->fault_mA >= OUTPUT_FAULT_MIN_CURRENT && config->fault_mA <= OUTPUT_FAULT_MAX_CURRENT))
+    {
+        return -1;
+    }
+    if ((config->enable & ALARM_HIGH) && !(config->high_K > 0.0f))
+    {
+        return -1;
+    }
+    if ((config->enable & ALARM_LOW) && !(config->low_K >= 0.0f))
+    {
+        return -1;
+    }
+    if ((config->enable & (ALARM_HIGH | ALARM_LOW)) == (ALARM_HIGH | ALARM_LOW) &&
+        !(config->low_K < config->high_K))
+    {
+        return -1;
+    }
+    if ((config->enable & ALARM_RATE) &&
+        !(config->rate_K_s > 0.0f && config->rate_hyst_K_s < config->rate_K_s))
+    {
+        return -1;
+    }
+    
+    alarm_config = *config;
+    APP_Alarm_ResetRate();
+    
+    /* 清除当前报警，下一次测量按新设置重新判断 */
+    changed = alarm_active;
+    alarm_active = 0;
+    UpdateOutput();
+    if (changed != 0)
+    {
+        SendEvent(changed, (uint8_t)APP_Temp_GetProbeStatus(), APP_Temp_GetValueK());
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  获取报警设置
+ * @param  config: 输出设置结构体指针
+ * @retval 无
+ */
+void APP_Alarm_GetConfig(AlarmConfig_t *config)
+{
+    *config = alarm_config;
+}
+
+/**
+ * @brief  获取报警状态
+ * @param  status: 输出状态结构体指针
+ * @retval 无
+ */
+void APP_Alarm_GetStatus(AlarmStatus_t *status)
+{
+    status->active = alarm_active;
+    status->output_fault = APP_Output_IsFault();
+    status->event_seq = alarm_event_seq;
+    status->rate_K_s = rate_K_s;
+    memcpy(status->trips, alarm_trips, sizeof(alarm_trips));
+}
+
+/**
+ * @brief  清零触发次数
+ * @retval 无
+ */
+void APP_Alarm_ClearTrips(void)
+{
+    memset(alarm_trips, 0, sizeof(alarm_trips));
+}
@@ -0,0 +1,291 @@
+/**
+ * @file    app_bench.c
+ * @brief   热路径自测基准源文件
+ * @details 将计算内核分别展开到RAM函数和Flash函数中，测量执行周期；
+ *          格式化与CRC直接调用Service/App层中的函数
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "app_bench.h"
+#include "app_temp_calc.h"
+#include "app_comm.h"
+#include "svc_fmt.h"
+#include "bsp_flash.h"
+#include "bsp_dwt.h"
+#include <string.h>
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/* 基准函数（输入取自本文件的私有变量，index为本次执行的序号） */
+typedef float (*BenchFn_t)(uint16_t index);
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 中值滤波输入：逆序排列 */
+static float bench_samples[TEMP_SAMPLE_COUNT];
+
+/* 滑动平均滤波器（与测量通道的滤波器相互独立） */
+static MovingAvg_t bench_filter;
+
+/* 查表输入（指向Flash中的分度表） */
+static const TempTableHeader_t *bench_header = (const TempTableHeader_t *)TEMP_TABLE_FLASH_ADDR;
+static const TempTablePoint_t *bench_points =
+    (const TempTablePoint_t *)(TEMP_TABLE_FLASH_ADDR + sizeof(TempTableHeader_t));
+static float bench_voltage;
+
+/* 全表扫描查表的输入电压 */
+static float bench_sweep[BENCH_SWEEP_POINTS];
+
+/* 格式化输出缓冲区 */
+static char bench_text[16];
+
+/* CRC输入 */
+static uint8_t bench_frame[BENCH_CRC_LEN];
+
+/* 结果写入volatile变量，防止计算被优化掉 */
+static volatile float bench_sink;
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  中值滤波（RAM取指）
+ * @param  index: 未使用
+ * @retval 计算结果
+ */
+static RAMFUNC float Bench_MedianRam(uint16_t index)
+{
+    (void)index;
+    return TempCalc_Median(bench_samples, TEMP_SAMPLE_COUNT);
+}
+
+/**
+ * @brief  中值滤波（Flash取指）
+ * @param  index: 未使用
+ * @retval 计算结果
+ */
+static FLASHFUNC float Bench_MedianFlash(uint16_t index)
+{
+    (void)index;
+    return TempCalc_Median(bench_samples, TEMP_SAMPLE_COUNT);
+}
+
+/**
+ * @brief  滑动平均（RAM取指）
+ * @param  index: 未使用
+ * @retval 计算结果
+ */
+static RAMFUNC float Bench_MovingAvgRam(uint16_t index)
+{
+    (void)index;
+    return TempCalc_MovingAvg(&bench_filter, bench_voltage);
+}
+
+/**
+ * @brief  滑动平均（Flash取指）
+ * @param  index: 未使用
+ * @retval 计算结果
+ */
+static FLASHFUNC float Bench_MovingAvgFlash(uint16_t index)
+{
+    (void)index;
+    return TempCalc_MovingAvg(&bench_filter, bench_voltage);
+}
+
+/**
+ * @brief  分度表查表（RAM取指）
+ * @param  index: 未使用
+ * @retval 计算结果
+ */
+static RAMFUNC float Bench_LookupRam(uint16_t index)
+{
+    (void)index;
+    return TempCalc_Lookup(bench_points, bench_header->point_count, bench_voltage);
+}
+
+/**
+ * @brief  分度表查表（Flash取指）
+ * @param  index: 未使用
+ * @retval 计算结果
+ */
+static FLASHFUNC float Bench_LookupFlash(uint16_t index)
+{
+    (void)index;
+    return TempCalc_Lookup(bench_points, bench_header->point_count, bench_voltage);
+}
+
+/**
+ * @brief  全表扫描查表（RAM取指）
+ * @param  index: 扫描点序号
+ * @retval 计算结果
+ */
+static RAMFUNC float Bench_SweepRam(uint16_t index)
+{
+    return TempCalc_Lookup(bench_points, bench_header->point_count,
+                           bench_sweep[index % BENCH_SWEEP_POINTS]);
+}
+
+/**
+ * @brief  全表扫描查表（Flash取指）
+ * @param  index: 扫描点序号
+ * @retval 计算结果
+ */
+static FLASHFUNC float Bench_SweepFlash(uint16_t index)
+{
+    return TempCalc_Lookup(bench_points, bench_header->point_count,
+                           bench_sweep[index % BENCH_SWEEP_POINTS]);
+}
+
+/**
+ * @brief  浮点格式化
+ * @param  index: 未使用
+ * @retval 输出字符数
+ */
+static float Bench_Format(uint16_t index)
+{
+    (void)index;
+    return (float)SVC_FMT_Float(bench_text, sizeof(bench_text), -196.1234f, 3);
+}
+
+/**
+ * @brief  帧CRC16
+ * @param  index: 未使用
+ * @retval CRC值
+ */
+static float Bench_Crc16(uint16_t index)
+{
+    (void)index;
+    return (float)APP_Comm_CRC16(bench_frame, BENCH_CRC_LEN);
+}
+
+/* 按BenchFunc_t编号排列：[RAM版本, Flash版本]，无RAM版本的为NULL */
+static const BenchFn_t bench_table[BENCH_FUNC_COUNT][2] = {
+    [BENCH_FUNC_MEDIAN]       = { Bench_MedianRam, Bench_MedianFlash },
+    [BENCH_FUNC_MOVING_AVG]   = { Bench_MovingAvgRam, Bench_MovingAvgFlash },
+    [BENCH_FUNC_LOOKUP]       = { Bench_LookupRam, Bench_LookupFlash },
+    [BENCH_FUNC_LOOKUP_SWEEP] = { Bench_SweepRam, Bench_SweepFlash },
+    [BENCH_FUNC_FORMAT]       = { NULL, Bench_Format },
+    [BENCH_FUNC_CRC16]        = { NULL, Bench_Crc16 },
+};
+
+/**
+ * @brief  测量一个函数
+ * @param  fn: 基准函数
+ * @param  accel: 测量期间的加速器配置 (FLASH_ACCEL_xxx组合)
+ * @param  repeat: 执行次数
+ * @param  result: 输出结果
+ * @note   位于RAM中，计时窗口内的取指不受加速器配置影响
+ * @retval 无
+ */
+static RAMFUNC void Bench_Measure(BenchFn_t fn, uint32_t accel, uint16_t repeat,
+                                  BenchResult_t *result)
+{
+    uint32_t primask;
+    uint32_t old_accel;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t total = 0;
+    uint16_t i;
+    
+    result->min_cycles = UINT32_MAX;
+    result->max_cycles = 0;
+    
+    for (i = 0; i < repeat; i++)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        old_accel = BSP_Flash_SetAccel(accel);
+        
+        start = BSP_DWT_GetCycles();
+        bench_sink = fn(i);
+        cycles = BSP_DWT_GetCycles() - start;
+        
+        BSP_Flash_SetAccel(old_accel);
+        __set_PRIMASK(primask);
+        
+        if (cycles < result->min_cycles)
+        {
+            result->min_cycles = cycles;
+        }
+        if (cycles > result->max_cycles)
+        {
+            result->max_cycles = cycles;
+        }
+        total += cycles;
+    }
+    
+    result->avg_cycles = total / repeat;
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  运行热路径基准
+ * @param  report: 输出报告指针
+ * @retval 无
+ */
+void APP_Bench_Run(BenchReport_t *report)
+{
+    uint32_t accel = BSP_Flash_GetAccel();
+    uint16_t repeat;
+    uint16_t count;
+    float v_first, v_last;
+    uint8_t func;
+    uint16_t i;
+    
+    memset(report, 0, sizeof(*report));
+    report->accel = accel;
+    report->latency = __HAL_FLASH_GET_LATENCY();
+    report->hclk = SystemCoreClock;
+    
+    /* 准备输入 */
+    for (i = 0; i < TEMP_SAMPLE_COUNT; i++)
+    {
+        bench_samples[i] = 900.0f - 100.0f * i;
+    }
+    memset(&bench_filter, 0, sizeof(bench_filter));
+    bench_voltage = 500.0f;
+    for (i = 0; i < BENCH_CRC_LEN; i++)
+    {
+        bench_frame[i] = (uint8_t)(i * 37U);
+    }
+    
+    for (func = 0; func < BENCH_FUNC_COUNT; func++)
+    {
+        repeat = BENCH_REPEAT;
+        
+        if (func == BENCH_FUNC_LOOKUP || func == BENCH_FUNC_LOOKUP_SWEEP)
+        {
+            if (!TempCalc_TableValid(bench_header))
+            {
+                continue;
+            }
+            count = bench_header->point_count;
+            v_first = bench_points[0].voltage;
+            v_last = bench_points[count - 1].voltage;
+            bench_voltage = (v_first + v_last) / 2.0f;
+            
+            /* 扫描点覆盖首末数据点之间的整个范围 */
+            if (func == BENCH_FUNC_LOOKUP_SWEEP)
+            {
+                for (i = 0; i < BENCH_SWEEP_POINTS; i++)
+                {
+                    bench_sweep[i] = v_first + (v_last - v_first) * i / (BENCH_SWEEP_POINTS - 1);
+                }
+                repeat = BENCH_SWEEP_POINTS;
+            }
+        }
+        
+        if (bench_table[func][0] != NULL)
+        {
+            Bench_Measure(bench_table[func][0], accel, repeat,
+                          &report->result[func][BENCH_MODE_RAM]);
+        }
+        Bench_Measure(bench_table[func][1], accel, repeat,
+                      &report->result[func][BENCH_MODE_FLASH]);
+        Bench_Measure(bench_table[func][1], 0, repeat,
+                      &report->result[func][BENCH_MODE_FLASH_NOACCEL]);
+    }
+}
@@ -0,0 +1,125 @@
+/**
+ * @file    app_boot.c
+ * @brief   启动过程计时应用层源文件
+ * @details 实现复位原因读取和启动阶段计时
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "app_boot.h"
+#include "bsp_dwt.h"
+#include "svc_lcd.h"
+#include "svc_usb.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* 超过此时间改用ms时基计时，避免32位周期计数回绕 (ms) */
+#define BOOT_CYCLES_LIMIT_MS    30000U
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 启动信息 */
+static BootInfo_t boot_info;
+
+/* 计时基准：APP_Boot_Init()时的HAL时基与周期计数 */
+static uint32_t base_tick = 0;
+static uint32_t base_cycles = 0;
+
+/* 后台启动的阶段全部记录完成 */
+static uint8_t poll_done = 0;
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  启动计时初始化
+ * @retval 无
+ */
+void APP_Boot_Init(void)
+{
+    uint8_t i;
+    
+    base_cycles = BSP_DWT_GetCycles();
+    base_tick = HAL_GetTick();
+    
+    for (i = 0; i < BOOT_STAGE_COUNT; i++)
+    {
+        boot_info.stage_us[i] = BOOT_TIME_NONE;
+    }
+    
+    /* 复位标志在下次复位前一直保持，读取后清除 */
+    boot_info.reset_flags = 0;
+    if (__HAL_RCC_GET_FLAG(RCC_FLAG_BORRST))  boot_info.reset_flags |= BOOT_RESET_BOR;
+    if (__HAL_RCC_GET_FLAG(RCC_FLAG_PINRST))  boot_info.reset_flags |= BOOT_RESET_PIN;
+    if (__HAL_RCC_GET_FLAG(RCC_FLAG_PORRST))  boot_info.reset_flags |= BOOT_RESET_POR;
+    if (__HAL_RCC_GET_FLAG(RCC_FLAG_SFTRST))  boot_info.reset_flags |= BOOT_RESET_SOFT;
+    if (__HAL_RCC_GET_FLAG(RCC_FLAG_IWDGRST)) boot_info.reset_flags |= BOOT_RESET_IWDG;
+    if (__HAL_RCC_GET_FLAG(RCC_FLAG_WWDGRST)) boot_info.reset_flags |= BOOT_RESET_WWDG;
+    if (__HAL_RCC_GET_FLAG(RCC_FLAG_LPWRRST)) boot_info.reset_flags |= BOOT_RESET_LPWR;
+    __HAL_RCC_CLEAR_RESET_FLAGS();
+    
+    poll_done = 0;
+    APP_Boot_Mark(BOOT_STAGE_APP_INIT);
+}
+
+/**
+ * @brief  记录到达启动阶段
+ * @param  stage: 启动阶段
+ * @retval 无
+ */
+void APP_Boot_Mark(uint8_t stage)
+{
+    uint32_t elapsed_ms;
+    
+    if (stage >= BOOT_STAGE_COUNT || boot_info.stage_us[stage] != BOOT_TIME_NONE)
+    {
+        return;
+    }
+    
+    /* 基准之前的时间（时钟配置、外设初始化）只有ms精度 */
+    elapsed_ms = HAL_GetTick() - base_tick;
+    if (elapsed_ms < BOOT_CYCLES_LIMIT_MS)
+    {
+        boot_info.stage_us[stage] = base_tick * 1000U +
+                                    BSP_DWT_CyclesToUs(BSP_DWT_GetCycles() - base_cycles);
+    }
+    else
+    {
+        boot_info.stage_us[stage] = (base_tick + elapsed_ms) * 1000U;
+    }
+}
+
+/**
+ * @brief  检测后台启动的外设是否就绪
+ * @retval 无
+ */
+void APP_Boot_Poll(void)
+{
+    if (poll_done)
+    {
+        return;
+    }
+    
+    if (SVC_LCD_IsReady())
+    {
+        APP_Boot_Mark(BOOT_STAGE_LCD_READY);
+    }
+    if (SVC_USB_IsReady())
+    {
+        APP_Boot_Mark(BOOT_STAGE_USB_READY);
+    }
+    
+    poll_done = (boot_info.stage_us[BOOT_STAGE_LCD_READY] != BOOT_TIME_NONE &&
+                 boot_info.stage_us[BOOT_STAGE_USB_READY] != BOOT_TIME_NONE) ? 1 : 0;
+}
+
+/**
+ * @brief  获取启动信息
+ * @param  info: 输出启动信息指针
+ * @retval 无
+ */
+void APP_Boot_GetInfo(BootInfo_t *info)
+{
+    *info = boot_info;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file    app_capture.c
+ * @brief   原始采样录制应用层源文件
+ * @details 实现录制缓冲区的写入、读出和状态统计
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "app_capture.h"
+#include "bsp_dwt.h"
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 录制缓冲区 */
+static CaptureRecord_t capture_buf[CAPTURE_BUF_SIZE];
+static uint16_t capture_head = 0;           /* 写入位置 */
+static uint16_t capture_tail = 0;           /* 读出位置 */
+
+/* 录制状态 */
+static uint8_t capture_active = 0;
+static uint32_t capture_recorded = 0;
+static uint32_t capture_lost = 0;
+static uint32_t capture_read_seq = 0;       /* 下一条读出记录的序号 */
+
+/* 上一条记录的采集时刻 */
+static uint32_t last_cycles = 0;
+static uint8_t last_valid = 0;
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  开始录制
+ * @retval 无
+ */
+void APP_Capture_Start(void)
+{
+    capture_head = 0;
+    capture_tail = 0;
+    capture_recorded = 0;
+    capture_lost = 0;
+    capture_read_seq = 0;
+    last_valid = 0;
+    capture_active = 1;
+}
+
+/**
+ * @brief  停止录制
+ * @retval 无
+ */
+void APP_Capture_Stop(void)
+{
+    capture_active = 0;
+}
+
+/**
+ * @brief  记录一个样本
+ * @param  raw: 24位ADC原始值
+ * @param  cycles: 样本启动转换时的CPU周期计数
+ * @retval 无
+ */
+void APP_Capture_Record(uint32_t raw, uint32_t cycles)
+{
+    uint16_t next;
+    uint32_t dt_us = 0;
+    
+    if (!capture_active)
+    {
+        return;
+    }
+    
+    /* 缓冲区满：丢弃本样本，间隔仍从上一条已存记录算起 */
+    next = (capture_head + 1) & (CAPTURE_BUF_SIZE - 1);
+    if (next == capture_tail)
+    {
+        capture_lost++;
+        return;
+    }
+    
+    if (last_valid)
+    {
+        dt_us = BSP_DWT_CyclesToUs(cycles - last_cycles);
+        if (dt_us > CAPTURE_DT_MAX_US)
+        {
+            dt_us = CAPTURE_DT_MAX_US;
+        }
+    }
+    last_cycles = cycles;
+    last_valid = 1;
+    
+    capture_buf[capture_head].raw = raw & 0xFFFFFF;
+    capture_buf[capture_head].dt_us = dt_us;
+    capture_head = next;
+    capture_recorded++;
+}
+
+/**
+ * @brief  读出并移除缓冲区中最旧的记录
+ * @param  records: 输出记录数组
+ * @param  max_count: 最多读出条数
+ * @param  first_seq: 输出第一条记录的序号
+ * @retval 读出的条数
+ */
+uint16_t APP_Capture_Read(CaptureRecord_t *records, uint16_t max_count, uint32_t *first_seq)
+{
+    uint16_t count = 0;
+    
+    *first_seq = capture_read_seq;
+    
+    while (count < max_count && capture_tail != capture_head)
+    {
+        records[count++] = capture_buf[capture_tail];
+        capture_tail = (capture_tail + 1) & (CAPTURE_BUF_SIZE - 1);
+    }
+    capture_read_seq += count;
+    
+    return count;
+}
+
+/**
+ * @brief  获取录制状态
+ * @param  status: 输出状态结构体指针
+ * @retval 无
+ */
+void APP_Capture_GetStatus(CaptureStatus_t *status)
+{
+    status->active = capture_active;
+    status->buffered = (capture_head - capture_tail) & (CAPTURE_BUF_SIZE - 1);
+    status->recorded = capture_recorded;
+    status->lost = capture_lost;
+}
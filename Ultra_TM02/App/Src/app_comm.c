@@ -12,10 +12,39 @@
 #include "app_temp.h"
 #include "app_output.h"
 #include "app_param.h"
+#include "app_sched.h"
+#include "app_boot.h"
+#include "app_power.h"
+#include "app_bench.h"
+#include "app_capture.h"
+#include "app_history.h"
+#include "app_datalog.h"
+#include "app_alarm.h"
 #include "svc_usb.h"
 #include "svc_dac.h"
+#include "svc_adc.h"
+#include "bsp_flash.h"
+#include "bsp_prof.h"
+#include "bsp_trace.h"
 #include <string.h>
 
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* 事件跟踪每帧读出条数（3字节头 + 30×8字节，不超过帧长度上限255） */
+#define CMD_TRACE_ENTRIES_PER_FRAME     30
+
+/* 原始采样每帧读出条数（5字节头 + 41×6字节） */
+#define CMD_CAPTURE_RECORDS_PER_FRAME   41
+
+/* 突发采集每帧读出样本数（3字节头 + 84×3字节） */
+#define CMD_BURST_SAMPLES_PER_FRAME     84
+
+/* 历史记录每帧读出条数（5字节头 + 18×13字节） */
+#define CMD_HISTORY_RECORDS_PER_FRAME   18
+
+/* 数据日志每帧读出字节数（5字节头 + 240字节） */
+#define CMD_DATALOG_BYTES_PER_FRAME     240
+
 /* 私有变量 ------------------------------------------------------------------*/
 
 /* 解析状态 */
@@ -170,6 +199,62 @@ static void ProcessFrame(Frame_t *frame)
             APP_Comm_SendAck(frame->cmd, STATUS_OK);
             break;
             
+        /* 分度表下载开始: [点数uint16] */
+        case CMD_LOAD_TABLE_START:
+            if (frame->len >= 2)
+            {
+                uint16_t count;
+                int ret;
+                
+                memcpy(&count, frame->data, 2);
+                ret = APP_Temp_TableLoadStart(count);
+                APP_Comm_SendAck(frame->cmd, (ret == 0) ? STATUS_OK :
+                                 (ret == -1) ? STATUS_INVALID_PARAM : STATUS_FLASH_ERROR);
+            }
+            else
+            {
+                APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+            }
+            break;
+            
+        /* 分度表数据包: [包序号uint16][数据点...] */
+        case CMD_LOAD_TABLE_DATA:
+            if (frame->len > 2)
+            {
+                uint16_t index;
+                int ret;
+                
+                memcpy(&index, frame->data, 2);
+                ret = APP_Temp_TableLoadData(index, &frame->data[2], frame->len - 2);
+                APP_Comm_SendAck(frame->cmd, (ret == 0) ? STATUS_OK :
+                                 (ret == -1) ? STATUS_TABLE_ERROR : STATUS_FLASH_ERROR);
+            }
+            else
+            {
+                APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+            }
+            break;
+            
+        /* 分度表下载结束: [数据点CRC32，可选] */
+        case CMD_LOAD_TABLE_END:
+            {
+                uint32_t crc;
+                int ret;
+                
+                if (frame->len >= 4)
+                {
+                    memcpy(&crc, frame->data, 4);
+                    ret = APP_Temp_TableLoadEnd(&crc);
+                }
+                else
+                {
+                    ret = APP_Temp_TableLoadEnd(NULL);
+                }
+                APP_Comm_SendAck(frame->cmd, (ret == 0) ? STATUS_OK :
+                                 (ret == -1) ? STATUS_TABLE_ERROR : STATUS_FLASH_ERROR);
+            }
+            break;
+            
         /* 保存参数 */
         case CMD_SAVE_PARAM:
             if (APP_Param_Save() == 0)
@@ -200,6 +285,807 @@ static void ProcessFrame(Frame_t *frame)
             APP_Comm_SendAck(frame->cmd, STATUS_OK);
             break;
             
+        /* 获取任务调度统计，data[0]=1时读取后清零
+         * 格式: [任务数] + 每任务20字节 {周期ms u16, 预算us u16, 执行次数, 超限次数,
+         *       最长执行us, 最大延迟ms (u32)}，按任务编号排列 */
+        case CMD_GET_TASK_STATS:
+            {
+                uint8_t task_data[1 + SCHED_TASK_COUNT * 20];
+                const SchedTask_t *task;
+                SchedStats_t tstats;
+                uint8_t *p = &task_data[1];
+                uint8_t i;
+                
+                task_data[0] = SCHED_TASK_COUNT;
+                for (i = 0; i < SCHED_TASK_COUNT; i++)
+                {
+                    task = APP_Sched_GetTask(i);
+                    APP_Sched_GetStats(i, &tstats);
+                    memcpy(p, &task->period_ms, 2);
+                    memcpy(p + 2, &task->budget_us, 2);
+                    memcpy(p + 4, &tstats, sizeof(SchedStats_t));
+                    p += 20;
+                }
+                APP_Comm_SendData(CMD_GET_TASK_STATS, task_data, sizeof(task_data));
+                
+                if (frame->len >= 1 && frame->data[0] == 1)
+                {
+                    APP_Sched_ResetStats();
+                }
+            }
+            break;
+            
+        /* 获取复位原因与启动计时
+         * 格式: [复位原因 u8][阶段数 u8] + 各阶段相对复位的时刻 (μs, u32)，
+         *       未到达的阶段为0xFFFFFFFF */
+        case CMD_GET_BOOT_INFO:
+            {
+                uint8_t boot_data[2 + BOOT_STAGE_COUNT * 4];
+                BootInfo_t binfo;
+                
+                APP_Boot_GetInfo(&binfo);
+                boot_data[0] = binfo.reset_flags;
+                boot_data[1] = BOOT_STAGE_COUNT;
+                memcpy(&boot_data[2], binfo.stage_us, BOOT_STAGE_COUNT * 4);
+                APP_Comm_SendData(CMD_GET_BOOT_INFO, boot_data, sizeof(boot_data));
+            }
+            break;
+            
+        /* 采样周期设置与间隔抖动统计
+         * 请求: data[0]=0读取, 1读取后清零, 2设置周期 (data[1..4]=周期μs u32) 后读取
+         * 格式: [周期μs][CPU主频Hz][间隔数][最小间隔][最大间隔][最大抖动] (u32)
+         *       [抖动累计 u64][抖动平方累计 u64][跳过次数][延后次数][最大启动延迟] (u32)，
+         *       时间单位均为CPU周期 */
+        case CMD_SAMPLE_TIMING:
+            {
+                uint8_t timing_data[52];
+                ADCTiming_t timing;
+                uint8_t op = (frame->len >= 1) ? frame->data[0] : 0;
+                uint32_t period_us;
+                
+                if (op == 2)
+                {
+                    if (frame->len < 5)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    memcpy(&period_us, &frame->data[1], 4);
+                    SVC_ADC_SetSamplePeriod(period_us);
+                }
+                
+                SVC_ADC_GetTiming(&timing);
+                memcpy(&timing_data[0], &timing.period_us, 4);
+                memcpy(&timing_data[4], &SystemCoreClock, 4);
+                memcpy(&timing_data[8], &timing.interval_count, 4);
+                memcpy(&timing_data[12], &timing.min_interval_cycles, 4);
+                memcpy(&timing_data[16], &timing.max_interval_cycles, 4);
+                memcpy(&timing_data[20], &timing.max_jitter_cycles, 4);
+                memcpy(&timing_data[24], &timing.sum_jitter_cycles, 8);
+                memcpy(&timing_data[32], &timing.sum_sq_jitter, 8);
+                memcpy(&timing_data[40], &timing.overrun_count, 4);
+                memcpy(&timing_data[44], &timing.deferred_count, 4);
+                memcpy(&timing_data[48], &timing.max_delay_cycles, 4);
+                APP_Comm_SendData(CMD_SAMPLE_TIMING, timing_data, sizeof(timing_data));
+                
+                if (op == 1)
+                {
+                    SVC_ADC_ResetTiming();
+                }
+            }
+            break;
+            
+        /* 时钟档位设置与CPU负载统计
+         * 请求: data[0]=0读取, 1读取后清零, 2切换档位 (data[1]=档位，同时写入参数，
+         *       需保存参数才在下次上电生效) 后读取
+         * 格式: [档位 u8][档位数 u8][平均负载‰ u16][最大窗口负载‰ u16][最近窗口负载‰ u16]
+         *       [HCLK Hz u32][睡眠次数 u32][统计时长ms u32] */
+        case CMD_POWER:
+            {
+                uint8_t power_data[20];
+                PowerStats_t pstats;
+                uint8_t op = (frame->len >= 1) ? frame->data[0] : 0;
+                
+                if (op == 2)
+                {
+                    if (frame->len < 2 || APP_Power_SetProfile(frame->data[1]) != 0)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    APP_Param_SetClockProfile(frame->data[1]);
+                }
+                
+                APP_Power_GetStats(&pstats);
+                power_data[0] = APP_Power_GetProfile();
+                power_data[1] = POWER_PROFILE_COUNT;
+                memcpy(&power_data[2], &pstats.load_avg, 2);
+                memcpy(&power_data[4], &pstats.load_peak, 2);
+                memcpy(&power_data[6], &pstats.load_last, 2);
+                memcpy(&power_data[8], &SystemCoreClock, 4);
+                memcpy(&power_data[12], &pstats.sleep_count, 4);
+                memcpy(&power_data[16], &pstats.elapsed_ms, 4);
+                APP_Comm_SendData(CMD_POWER, power_data, sizeof(power_data));
+                
+                if (op == 1)
+                {
+                    APP_Power_ResetStats();
+                }
+            }
+            break;
+            
+        /* 热路径自测：每个计算内核分别从SRAM、Flash(加速器开)、Flash(加速器关)执行，
+         * 测量期间改变加速器配置，采集中返回STATUS_BUSY
+         * 格式: [函数数 u8][方式数 u8][加速器 u8: bit0预取 bit1指令缓存 bit2数据缓存]
+         *       [等待周期 u8][HCLK Hz u32]，随后按函数、方式顺序为
+         *       [最小 u32][最大 u32][平均 u32]，未测的项全为0 */
+        case CMD_BENCH:
+            if (APP_Temp_IsRunning())
+            {
+                APP_Comm_SendAck(frame->cmd, STATUS_BUSY);
+            }
+            else
+            {
+                static BenchReport_t report;
+                uint8_t bench_data[8 + BENCH_FUNC_COUNT * BENCH_MODE_COUNT * 12];
+                uint8_t *p = &bench_data[8];
+                uint8_t func, mode;
+                
+                APP_Bench_Run(&report);
+                bench_data[0] = BENCH_FUNC_COUNT;
+                bench_data[1] = BENCH_MODE_COUNT;
+                bench_data[2] = ((report.accel & FLASH_ACCEL_PREFETCH) ? 0x01 : 0) |
+                                ((report.accel & FLASH_ACCEL_ICACHE) ? 0x02 : 0) |
+                                ((report.accel & FLASH_ACCEL_DCACHE) ? 0x04 : 0);
+                bench_data[3] = (uint8_t)report.latency;
+                memcpy(&bench_data[4], &report.hclk, 4);
+                for (func = 0; func < BENCH_FUNC_COUNT; func++)
+                {
+                    for (mode = 0; mode < BENCH_MODE_COUNT; mode++)
+                    {
+                        memcpy(p, &report.result[func][mode].min_cycles, 4);
+                        memcpy(p + 4, &report.result[func][mode].max_cycles, 4);
+                        memcpy(p + 8, &report.result[func][mode].avg_cycles, 4);
+                        p += 12;
+                    }
+                }
+                APP_Comm_SendData(CMD_BENCH, bench_data, sizeof(bench_data));
+            }
+            break;
+            
+#if PROF_ENABLE
+        /* 获取性能探针统计，data[0]=探针编号，data[1]=1时读取后清零该探针
+         * 格式: [探针编号][探针数][次数 u32][最小 u32][最大 u32][累计 u64]
+         *       [CPU主频Hz u32][log2直方图 24×u16]，时间单位均为CPU周期 */
+        case CMD_GET_PROFILE:
+            {
+                uint8_t prof_data[26 + PROF_HIST_BINS * 2];
+                ProfProbe_t probe;
+                uint8_t id = (frame->len >= 1) ? frame->data[0] : 0;
+                
+                if (BSP_Prof_Get(id, &probe) != 0)
+                {
+                    APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                    break;
+                }
+                
+                prof_data[0] = id;
+                prof_data[1] = PROF_PROBE_COUNT;
+                memcpy(&prof_data[2], &probe.count, 4);
+                memcpy(&prof_data[6], &probe.min_cycles, 4);
+                memcpy(&prof_data[10], &probe.max_cycles, 4);
+                memcpy(&prof_data[14], &probe.sum_cycles, 8);
+                memcpy(&prof_data[22], &SystemCoreClock, 4);
+                memcpy(&prof_data[26], probe.hist, PROF_HIST_BINS * 2);
+                APP_Comm_SendData(CMD_GET_PROFILE, prof_data, sizeof(prof_data));
+                
+                if (frame->len >= 2 && frame->data[1] == 1)
+                {
+                    BSP_Prof_Reset(id);
+                }
+            }
+            break;
+#endif
+            
+#if TRACE_ENABLE
+        /* 读取事件跟踪缓冲区，data[0]为操作:
+         * 0=停止记录，返回 [有效条数 u16][缓冲区容量 u16][被覆盖条数 u32][CPU主频Hz u32]
+         * 1=读取，data[1..2]=起始序号 u16，返回 [起始序号 u16][条数 u8] + 条数×8字节记录
+         * 2=清空并重新开始记录，返回ACK */
+        case CMD_GET_TRACE:
+            {
+                uint8_t trace_data[3 + CMD_TRACE_ENTRIES_PER_FRAME * sizeof(TraceEntry_t)];
+                TraceEntry_t entries[CMD_TRACE_ENTRIES_PER_FRAME];
+                uint16_t count;
+                uint32_t lost;
+                uint16_t index;
+                uint8_t op = (frame->len >= 1) ? frame->data[0] : 0;
+                
+                if (op == 0)
+                {
+                    BSP_Trace_Stop(&count, &lost);
+                    index = TRACE_BUF_SIZE;
+                    memcpy(&trace_data[0], &count, 2);
+                    memcpy(&trace_data[2], &index, 2);
+                    memcpy(&trace_data[4], &lost, 4);
+                    memcpy(&trace_data[8], &SystemCoreClock, 4);
+                    APP_Comm_SendData(CMD_GET_TRACE, trace_data, 12);
+                }
+                else if (op == 1 && frame->len >= 3)
+                {
+                    memcpy(&index, &frame->data[1], 2);
+                    count = BSP_Trace_Read(index, entries, CMD_TRACE_ENTRIES_PER_FRAME);
+                    memcpy(&trace_data[0], &index, 2);
+                    trace_data[2] = (uint8_t)count;
+                    memcpy(&trace_data[3], entries, count * sizeof(TraceEntry_t));
+                    APP_Comm_SendData(CMD_GET_TRACE, trace_data, 3 + count * sizeof(TraceEntry_t));
+                }
+                else if (op == 2)
+                {
+                    BSP_Trace_Restart();
+                    APP_Comm_SendAck(frame->cmd, STATUS_OK);
+                }
+                else
+                {
+                    APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                }
+            }
+            break;
+#endif
+            
+        /* 原始采样录制，data[0]为操作:
+         * 0=读取状态, 1=开始录制, 2=停止录制，均返回状态:
+         *   [录制中 u8][电流源 u8][保留 u16][采样周期μs u32][增益 f32][参考电压V f32]
+         *   [4mA温度℃ f32][20mA温度℃ f32][分度表点数 u16][缓冲区容量 u16]
+         *   [未读条数 u16][保留 u16][已记录条数 u32][丢弃条数 u32]
+         * 3=读出，data[1]可选为本帧最多条数，返回 [首条序号 u32][条数 u8] +
+         *   条数×[码值 u24][间隔μs u24]，读出的记录从缓冲区移除 */
+        case CMD_CAPTURE:
+            {
+                uint8_t cap_data[5 + CMD_CAPTURE_RECORDS_PER_FRAME * 6];
+                CaptureRecord_t records[CMD_CAPTURE_RECORDS_PER_FRAME];
+                CaptureStatus_t cstatus;
+                uint32_t first_seq;
+                uint32_t period_us;
+                uint16_t count, i;
+                uint8_t op = (frame->len >= 1) ? frame->data[0] : 0;
+                
+                if (op == 3)
+                {
+                    /* 可选第2字节限制本帧条数 */
+                    count = CMD_CAPTURE_RECORDS_PER_FRAME;
+                    if (frame->len >= 2 && frame->data[1] != 0 && frame->data[1] < count)
+                    {
+                        count = frame->data[1];
+                    }
+                    count = APP_Capture_Read(records, count, &first_seq);
+                    memcpy(&cap_data[0], &first_seq, 4);
+                    cap_data[4] = (uint8_t)count;
+                    for (i = 0; i < count; i++)
+                    {
+                        memcpy(&cap_data[5 + i * 6], &records[i].raw, 3);
+                        memcpy(&cap_data[8 + i * 6], &records[i].dt_us, 3);
+                    }
+                    APP_Comm_SendData(CMD_CAPTURE, cap_data, 5 + count * 6);
+                    break;
+                }
+                
+                if (op == 1)
+                {
+                    APP_Capture_Start();
+                }
+                else if (op == 2)
+                {
+                    APP_Capture_Stop();
+                }
+                else if (op != 0)
+                {
+                    APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                    break;
+                }
+                
+                APP_Capture_GetStatus(&cstatus);
+                memset(cap_data, 0, 40);
+                cap_data[0] = cstatus.active;
+                cap_data[1] = APP_Temp_GetCurrentSource();
+                period_us = SVC_ADC_GetSamplePeriod();
+                memcpy(&cap_data[4], &period_us, 4);
+                fval = SVC_ADC_GetGain();
+                memcpy(&cap_data[8], &fval, 4);
+                fval = SVC_ADC_GetVref();
+                memcpy(&cap_data[12], &fval, 4);
+                fval = APP_Output_Get4mATemp();
+                memcpy(&cap_data[16], &fval, 4);
+                fval = APP_Output_Get20mATemp();
+                memcpy(&cap_data[20], &fval, 4);
+                count = APP_Temp_GetTablePoints();
+                memcpy(&cap_data[24], &count, 2);
+                count = CAPTURE_BUF_SIZE - 1;
+                memcpy(&cap_data[26], &count, 2);
+                memcpy(&cap_data[28], &cstatus.buffered, 2);
+                memcpy(&cap_data[32], &cstatus.recorded, 4);
+                memcpy(&cap_data[36], &cstatus.lost, 4);
+                APP_Comm_SendData(CMD_CAPTURE, cap_data, 40);
+            }
+            break;
+            
+        /* 获取Flash擦写停顿/采样间隔统计，data[0]=1时读取后清零 */
+        case CMD_GET_FLASH_STATS:
+            {
+                FlashStats_t fstats;
+                ADCStats_t astats;
+                uint32_t stats_data[10];
+                
+                BSP_Flash_GetStats(&fstats);
+                SVC_ADC_GetStats(&astats);
+                stats_data[0] = fstats.erase_count;
+                stats_data[1] = fstats.erase_max_us;
+                stats_data[2] = fstats.program_words;
+                stats_data[3] = fstats.program_chunk_max_us;
+                stats_data[4] = astats.sample_count;
+                stats_data[5] = astats.overflow_count;
+                stats_data[6] = astats.deferred_count;
+                stats_data[7] = astats.max_gap_us;
+                stats_data[8] = astats.max_gap_flash_us;
+                stats_data[9] = astats.max_latency_us;
+                APP_Comm_SendData(CMD_GET_FLASH_STATS, (uint8_t *)stats_data, sizeof(stats_data));
+                
+                if (frame->len >= 1 && frame->data[0] == 1)
+                {
+                    BSP_Flash_ResetStats();
+                    SVC_ADC_ResetStats();
+                }
+            }
+            break;
+            
+        /* 突发采集，data[0]为操作:
+         * 0=读取状态, 1=布防 [沿 u8][触发前样本数 u16][触发后样本数 u16][电平mV f32]
+         * [变化率K/s f32], 2=命令触发, 3=取消，均返回状态:
+         *   [状态 u8][触发源 u8][沿 u8][保留 u8][触发前设定 u16][触发后设定 u16]
+         *   [触发前样本数 u16][已采触发后样本数 u16][缓冲区容量 u16][保留 u16]
+         *   [电平mV f32][变化率K/s f32][平均间隔ns u32][最大间隔ns u32]
+         *   [增益 f32][参考电压V f32]
+         * 4=读出 [偏移 u16][条数 u8，可选]，采集完成后有效，返回 [偏移 u16][条数 u8] +
+         *   条数×[码值 u24]，数据块读出后保留直到重新布防或取消 */
+        case CMD_BURST:
+            {
+                uint8_t burst_data[3 + CMD_BURST_SAMPLES_PER_FRAME * 3];
+                uint32_t samples[CMD_BURST_SAMPLES_PER_FRAME];
+                TempBurstConfig_t bconfig;
+                ADCBurstStatus_t bstatus;
+                uint16_t offset, count, i;
+                uint8_t op = (frame->len >= 1) ? frame->data[0] : 0;
+                
+                if (op == 4)
+                {
+                    SVC_ADC_BurstGetStatus(&bstatus);
+                    if (frame->len < 3)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    if (bstatus.state != ADC_BURST_DONE)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_BUSY);
+                        break;
+                    }
+                    
+                    memcpy(&offset, &frame->data[1], 2);
+                    count = CMD_BURST_SAMPLES_PER_FRAME;
+                    if (frame->len >= 4 && frame->data[3] != 0 && frame->data[3] < count)
+                    {
+                        count = frame->data[3];
+                    }
+                    count = SVC_ADC_BurstRead(offset, samples, count);
+                    memcpy(&burst_data[0], &offset, 2);
+                    burst_data[2] = (uint8_t)count;
+                    for (i = 0; i < count; i++)
+                    {
+                        memcpy(&burst_data[3 + i * 3], &samples[i], 3);
+                    }
+                    APP_Comm_SendData(CMD_BURST, burst_data, 3 + count * 3);
+                    break;
+                }
+                
+                if (op == 1)
+                {
+                    if (frame->len < 14)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    bconfig.edge = frame->data[1];
+                    memcpy(&bconfig.pre_samples, &frame->data[2], 2);
+                    memcpy(&bconfig.post_samples, &frame->data[4], 2);
+                    memcpy(&bconfig.level_mV, &frame->data[6], 4);
+                    memcpy(&bconfig.rate_limit, &frame->data[10], 4);
+                    if (APP_Temp_BurstArm(&bconfig) != 0)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                }
+                else if (op == 2)
+                {
+                    if (!APP_Temp_BurstTrigger())
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_BUSY);
+                        break;
+                    }
+                }
+                else if (op == 3)
+                {
+                    APP_Temp_BurstAbort();
+                }
+                else if (op != 0)
+                {
+                    APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                    break;
+                }
+                
+                APP_Temp_GetBurstConfig(&bconfig);
+                SVC_ADC_BurstGetStatus(&bstatus);
+                memset(burst_data, 0, 40);
+                burst_data[0] = bstatus.state;
+                burst_data[1] = bstatus.source;
+                burst_data[2] = bconfig.edge;
+                memcpy(&burst_data[4], &bconfig.pre_samples, 2);
+                memcpy(&burst_data[6], &bconfig.post_samples, 2);
+                memcpy(&burst_data[8], &bstatus.pre_count, 2);
+                memcpy(&burst_data[10], &bstatus.post_count, 2);
+                count = ADC_BURST_SIZE;
+                memcpy(&burst_data[12], &count, 2);
+                memcpy(&burst_data[16], &bconfig.level_mV, 4);
+                memcpy(&burst_data[20], &bconfig.rate_limit, 4);
+                memcpy(&burst_data[24], &bstatus.interval_ns, 4);
+                memcpy(&burst_data[28], &bstatus.max_interval_ns, 4);
+                fval = SVC_ADC_GetGain();
+                memcpy(&burst_data[32], &fval, 4);
+                fval = SVC_ADC_GetVref();
+                memcpy(&burst_data[36], &fval, 4);
+                APP_Comm_SendData(CMD_BURST, burst_data, 40);
+            }
+            break;
+            
+        /* 测量历史记录，data[0]为操作:
+         * 0=读取状态, 1=设置抽取比 [抽取比 u16]（经CMD_SAVE_PARAM保存）, 2=清空，均返回状态:
+         *   [缓冲区容量 u16][抽取比 u16][条数 u16][保留 u16][下一条序号 u32][当前时刻ms u32]
+         * 3=读出 [起始序号 u32][条数 u8，可选]，返回 [首条序号 u32][条数 u8] +
+         *   条数×[时间戳ms u32][温度K f32][电压mV f32][探头状态 u8]，
+         *   起始序号已被覆盖时从最旧记录开始，读出不移除记录 */
+        case CMD_HISTORY:
+            {
+                uint8_t hist_data[5 + CMD_HISTORY_RECORDS_PER_FRAME * 13];
+                HistoryRecord_t hrecords[CMD_HISTORY_RECORDS_PER_FRAME];
+                HistoryStatus_t hstatus;
+                uint32_t seq;
+                uint16_t count, i;
+                uint8_t op = (frame->len >= 1) ? frame->data[0] : 0;
+                
+                if (op == 3)
+                {
+                    if (frame->len < 5)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    memcpy(&seq, &frame->data[1], 4);
+                    count = CMD_HISTORY_RECORDS_PER_FRAME;
+                    if (frame->len >= 6 && frame->data[5] != 0 && frame->data[5] < count)
+                    {
+                        count = frame->data[5];
+                    }
+                    count = APP_History_Read(seq, hrecords, count, &seq);
+                    memcpy(&hist_data[0], &seq, 4);
+                    hist_data[4] = (uint8_t)count;
+                    for (i = 0; i < count; i++)
+                    {
+                        memcpy(&hist_data[5 + i * 13], &hrecords[i].time_ms, 4);
+                        memcpy(&hist_data[9 + i * 13], &hrecords[i].temperature_K, 4);
+                        memcpy(&hist_data[13 + i * 13], &hrecords[i].voltage, 4);
+                        hist_data[17 + i * 13] = hrecords[i].probe_status;
+                    }
+                    APP_Comm_SendData(CMD_HISTORY, hist_data, 5 + count * 13);
+                    break;
+                }
+                
+                if (op == 1)
+                {
+                    if (frame->len < 3)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    memcpy(&count, &frame->data[1], 2);
+                    if (APP_History_SetDecimation(count) != 0)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    APP_Param_SetHistoryDecimation(count);
+                }
+                else if (op == 2)
+                {
+                    APP_History_Clear();
+                }
+                else if (op != 0)
+                {
+                    APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                    break;
+                }
+                
+                APP_History_GetStatus(&hstatus);
+                memset(hist_data, 0, 16);
+                count = HISTORY_BUF_SIZE;
+                memcpy(&hist_data[0], &count, 2);
+                memcpy(&hist_data[2], &hstatus.decimation, 2);
+                memcpy(&hist_data[4], &hstatus.count, 2);
+                memcpy(&hist_data[8], &hstatus.next_seq, 4);
+                seq = HAL_GetTick();
+                memcpy(&hist_data[12], &seq, 4);
+                APP_Comm_SendData(CMD_HISTORY, hist_data, 16);
+            }
+            break;
+            
+        /* 长期数据日志，data[0]为操作:
+         * 0=读取状态, 1=设置统计周期 [周期s u16]（经CMD_SAVE_PARAM保存）, 2=校时 [UNIX时间s u32],
+         * 3=立即写入RAM页, 4=擦除日志区域（阻塞1~2s），均返回状态:
+         *   [页大小 u16][页数 u16][已用页数 u16][周期s u16][首页序号 u32][RAM页序号 u32]
+         *   [启动序号 u16][标志 u8][RAM页条数 u8][当前时间s u32][丢弃条数 u32]
+         * 5=读Flash [区域内偏移 u32][字节数 u8，可选]，6=读RAM页 [页内偏移 u32][字节数 u8，可选]，
+         *   返回 [偏移 u32][字节数 u8] + 数据，已用页（或RAM页有效长度）之外返回0字节 */
+        case CMD_DATALOG:
+            {
+                uint8_t log_data[5 + CMD_DATALOG_BYTES_PER_FRAME];
+                DataLogStatus_t lstatus;
+                uint32_t offset;
+                uint16_t count;
+                int ret;
+                uint8_t op = (frame->len >= 1) ? frame->data[0] : 0;
+                
+                if (op == 5 || op == 6)
+                {
+                    if (frame->len < 5)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    memcpy(&offset, &frame->data[1], 4);
+                    count = CMD_DATALOG_BYTES_PER_FRAME;
+                    if (frame->len >= 6 && frame->data[5] != 0 && frame->data[5] < count)
+                    {
+                        count = frame->data[5];
+                    }
+                    
+                    if (op == 5)
+                    {
+                        ret = APP_DataLog_ReadFlash(offset, &log_data[5], count);
+                        if (ret < 0)
+                        {
+                            APP_Comm_SendAck(frame->cmd, STATUS_FLASH_ERROR);
+                            break;
+                        }
+                        count = (uint16_t)ret;
+                    }
+                    else
+                    {
+                        count = (offset < DATALOG_PAGE_SIZE) ?
+                                APP_DataLog_ReadPending((uint16_t)offset, &log_data[5], count) : 0;
+                    }
+                    
+                    memcpy(&log_data[0], &offset, 4);
+                    log_data[4] = (uint8_t)count;
+                    APP_Comm_SendData(CMD_DATALOG, log_data, 5 + count);
+                    break;
+                }
+                
+                if (op == 1)
+                {
+                    if (frame->len < 3)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    memcpy(&count, &frame->data[1], 2);
+                    ret = APP_DataLog_SetInterval(count);
+                    if (ret != 0)
+                    {
+                        APP_Comm_SendAck(frame->cmd, (ret == -1) ? STATUS_INVALID_PARAM : STATUS_FLASH_ERROR);
+                        break;
+                    }
+                    APP_Param_SetDatalogInterval(count);
+                }
+                else if (op == 2)
+                {
+                    if (frame->len < 5)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    memcpy(&offset, &frame->data[1], 4);
+                    APP_DataLog_SetTime(offset);
+                }
+                else if (op == 3 || op == 4)
+                {
+                    if ((op == 3 ? APP_DataLog_Flush() : APP_DataLog_Erase()) != 0)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_FLASH_ERROR);
+                        break;
+                    }
+                }
+                else if (op != 0)
+                {
+                    APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                    break;
+                }
+                
+                APP_DataLog_GetStatus(&lstatus);
+                count = DATALOG_PAGE_SIZE;
+                memcpy(&log_data[0], &count, 2);
+                memcpy(&log_data[2], &lstatus.page_count, 2);
+                memcpy(&log_data[4], &lstatus.used_pages, 2);
+                memcpy(&log_data[6], &lstatus.interval_s, 2);
+                memcpy(&log_data[8], &lstatus.oldest_seq, 4);
+                memcpy(&log_data[12], &lstatus.next_seq, 4);
+                memcpy(&log_data[16], &lstatus.boot, 2);
+                log_data[18] = lstatus.time_synced ? DATALOG_FLAG_TIME_SYNCED : 0;
+                log_data[19] = lstatus.pending_count;
+                memcpy(&log_data[20], &lstatus.time_s, 4);
+                memcpy(&log_data[24], &lstatus.lost, 4);
+                APP_Comm_SendData(CMD_DATALOG, log_data, 28);
+            }
+            break;
+            
+        /* 温度窗口统计与Allan偏差，data[0]为操作:
+         * 0=读取, 1=设置窗口长度 [窗口号 u8][长度 u32]（0=累计，不保存）, 2=清空全部统计,
+         * 3=Allan偏差 [1=清空后开始 / 0=停止 u8]，均返回:
+         *   [跳过的无效测量次数 u32][窗口数 u8][Allan层数 u8][Allan累计中 u8][保留 u8]
+         *   + 窗口数×([长度 u32][已结束窗口数 u32] + 当前窗口与最近完整窗口各
+         *     [次数 u32][平均K f32][标准差K f32][最小K f32][最大K f32][峰峰值K f32])
+         *   + [Allan累计次数 u32][首末测量间隔ms u32] + 层数×[Allan偏差K f32]
+         *   第j层τ = 2^j × 测量周期 */
+        case CMD_STATS:
+            {
+                uint8_t stats_data[8 + TEMP_STATS_WINDOWS * 56 + 8 + TEMP_ADEV_LEVELS * 4];
+                TempStatsWindow_t window;
+                TempAdev_t adev;
+                const TempStatsResult_t *result;
+                uint32_t value;
+                uint16_t pos;
+                uint8_t i, k;
+                uint8_t op = (frame->len >= 1) ? frame->data[0] : 0;
+                
+                if (op == 1)
+                {
+                    if (frame->len < 6)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    memcpy(&value, &frame->data[2], 4);
+                    if (APP_Temp_StatsSetWindow(frame->data[1], value) != 0)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                }
+                else if (op == 2)
+                {
+                    APP_Temp_StatsReset();
+                }
+                else if (op == 3)
+                {
+                    if (frame->len < 2)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    APP_Temp_AdevEnable(frame->data[1]);
+                }
+                else if (op != 0)
+                {
+                    APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                    break;
+                }
+                
+                value = APP_Temp_GetStatsSkipped();
+                memcpy(&stats_data[0], &value, 4);
+                stats_data[4] = TEMP_STATS_WINDOWS;
+                stats_data[5] = TEMP_ADEV_LEVELS;
+                APP_Temp_GetAdev(&adev);
+                stats_data[6] = adev.enabled;
+                stats_data[7] = 0;
+                pos = 8;
+                
+                for (i = 0; i < TEMP_STATS_WINDOWS; i++)
+                {
+                    APP_Temp_GetStats(i, &window);
+                    memcpy(&stats_data[pos], &window.length, 4);
+                    memcpy(&stats_data[pos + 4], &window.completed, 4);
+                    pos += 8;
+                    for (k = 0; k < 2; k++)
+                    {
+                        result = (k == 0) ? &window.current : &window.last;
+                        fval = result->max - result->min;
+                        memcpy(&stats_data[pos], &result->count, 4);
+                        memcpy(&stats_data[pos + 4], &result->mean, 4);
+                        memcpy(&stats_data[pos + 8], &result->stddev, 4);
+                        memcpy(&stats_data[pos + 12], &result->min, 4);
+                        memcpy(&stats_data[pos + 16], &result->max, 4);
+                        memcpy(&stats_data[pos + 20], &fval, 4);
+                        pos += 24;
+                    }
+                }
+                
+                memcpy(&stats_data[pos], &adev.samples, 4);
+                memcpy(&stats_data[pos + 4], &adev.elapsed_ms, 4);
+                memcpy(&stats_data[pos + 8], adev.adev, TEMP_ADEV_LEVELS * 4);
+                pos += 8 + TEMP_ADEV_LEVELS * 4;
+                APP_Comm_SendData(CMD_STATS, stats_data, pos);
+            }
+            break;
+            
+        /* 报警设置与状态 */
+        case CMD_ALARM:
+            {
+                uint8_t alarm_data[44];
+                AlarmConfig_t alarm_config;
+                AlarmStatus_t alarm_status;
+                uint8_t op = (frame->len >= 1) ? frame->data[0] : 0;
+                
+                if (op == 1)
+                {
+                    /* [op][启用位][故障位][上限][下限][回差][变化率][变化率回差][故障电流] */
+                    if (frame->len < 27)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                    alarm_config.enable = frame->data[1];
+                    alarm_config.fault = frame->data[2];
+                    memcpy(&alarm_config.high_K, &frame->data[3], 4);
+                    memcpy(&alarm_config.low_K, &frame->data[7], 4);
+                    memcpy(&alarm_config.hyst_K, &frame->data[11], 4);
+                    memcpy(&alarm_config.rate_K_s, &frame->data[15], 4);
+                    memcpy(&alarm_config.rate_hyst_K_s, &frame->data[19], 4);
+                    memcpy(&alarm_config.fault_mA, &frame->data[23], 4);
+                    if (APP_Alarm_SetConfig(&alarm_config) != 0)
+                    {
+                        APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                        break;
+                    }
+                }
+                else if (op == 2)
+                {
+                    APP_Alarm_ClearTrips();
+                }
+                else if (op != 0)
+                {
+                    APP_Comm_SendAck(frame->cmd, STATUS_INVALID_PARAM);
+                    break;
+                }
+                
+                /* [报警位][启用位][故障位][输出故障][事件序号 u32][变化率 f32][触发次数 u16×4]
+                   + 设置 [上限][下限][回差][变化率][变化率回差][故障电流] f32 */
+                APP_Alarm_GetConfig(&alarm_config);
+                APP_Alarm_GetStatus(&alarm_status);
+                alarm_data[0] = alarm_status.active;
+                alarm_data[1] = alarm_config.enable;
+                alarm_data[2] = alarm_config.fault;
+                alarm_data[3] = alarm_status.output_fault;
+                memcpy(&alarm_data[4], &alarm_status.event_seq, 4);
+                memcpy(&alarm_data[8], &alarm_status.rate_K_s, 4);
+                memcpy(&alarm_data[12], alarm_status.trips, ALARM_COUNT * 2);
+                memcpy(&alarm_data[20], &alarm_config.high_K, 4);
+                memcpy(&alarm_data[24], &alarm_config.low_K, 4);
+                memcpy(&alarm_data[28], &alarm_config.hyst_K, 4);
+                memcpy(&alarm_data[32], &alarm_config.rate_K_s, 4);
+                memcpy(&alarm_data[36], &alarm_config.rate_hyst_K_s, 4);
+                memcpy(&alarm_data[40], &alarm_config.fault_mA, 4);
+                APP_Comm_SendData(CMD_ALARM, alarm_data, sizeof(alarm_data));
+            }
+            break;
+            
         /* 未知命令 */
         default:
             APP_Comm_SendAck(frame->cmd, STATUS_INVALID_CMD);
@@ -274,7 +1160,9 @@ static void ParseByte(uint8_t byte)
                 if (calc_crc == rx_frame.crc)
                 {
                     /* CRC正确，处理帧 */
+                    TRACE_BEGIN(TRACE_EVT_COMM_CMD, rx_frame.cmd);
                     ProcessFrame(&rx_frame);
+                    TRACE_END(TRACE_EVT_COMM_CMD, rx_frame.cmd);
                 }
                 else
                 {
@@ -297,9 +1185,6 @@ void APP_Comm_Init(void)
 {
     parse_state = PARSE_HEAD;
     data_index = 0;
-    
-    /* 初始化USB服务 */
-    SVC_USB_Init();
 }
 
 /**
@@ -0,0 +1,638 @@
+/**
+ * @file    app_datalog.c
+ * @brief   长期数据日志应用层源文件
+ * @details 实现周期统计、差分编码、按页写入Flash、区域写满时的回收和启动时的日志扫描
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "app_datalog.h"
+#include "app_param.h"
+#include "app_comm.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* 一条记录编码后的最大长度（3个32位变长整数） */
+#define DATALOG_ENTRY_MAX           15
+
+/* 私有类型定义 --------------------------------------------------------------*/
+
+/* 页（RAM页与Flash中的页格式相同） */
+typedef struct {
+    DataLogHeader_t header;
+    uint8_t payload[DATALOG_PAYLOAD_SIZE];
+} DataLogPage_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* RAM页 */
+static DataLogPage_t log_page;
+static uint32_t page_start_tick;            /* 第一条记录的周期起点 (HAL_GetTick) */
+static int32_t last_avg_mK;                 /* 上一条有数据记录的平均值 */
+
+/* Flash写入位置 */
+static uint8_t log_enabled = 0;             /* 0=日志区域不可用，数据日志不启用 */
+static uint16_t write_page;                 /* 下一个写入的页号 */
+static uint8_t erase_pending;               /* 1=区域已满，等待Flash任务回收 */
+static uint32_t next_seq;                   /* RAM页的序号 */
+static uint32_t oldest_seq;                 /* Flash中第一页的序号 */
+static uint16_t boot_id;
+static uint32_t lost_count;
+
+/* 当前周期统计 */
+static uint16_t interval_s = DATALOG_INTERVAL_DEFAULT;
+static uint32_t interval_start;             /* 周期起点 (HAL_GetTick) */
+static uint32_t acc_count;
+static int64_t acc_sum_mK;
+static int32_t acc_min_mK;
+static int32_t acc_max_mK;
+
+/* 连续无数据的周期 */
+static uint32_t gap_count;
+static uint32_t gap_start;
+
+/* 校时：UNIX时间 = epoch_offset + HAL_GetTick() / 1000 */
+static uint8_t time_synced = 0;
+static uint32_t epoch_offset;
+
+/* 回收时暂存最新的页 */
+static DataLogPage_t keep_buf[DATALOG_KEEP_PAGES];
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static const DataLogHeader_t* GetPageHeader(uint16_t index);
+static uint16_t CalcPageCRC(DataLogPage_t *page);
+static uint16_t CountUsed(void);
+static void ScanLog(void);
+static void UpdateOldest(void);
+static void StartPage(void);
+static void FinishHeader(void);
+static int WritePage(void);
+static int Append(const uint8_t *entry, uint8_t len, uint32_t start_tick);
+static uint8_t EncodeVarint(uint8_t *buf, uint32_t value);
+static void EmitGap(void);
+static void CloseInterval(void);
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  获取Flash中第index页的页头
+ * @param  index: 页号
+ * @retval 页头指针（直接指向Flash）
+ */
+static const DataLogHeader_t* GetPageHeader(uint16_t index)
+{
+    return (const DataLogHeader_t *)(FLASH_LOG_START + (uint32_t)index * DATALOG_PAGE_SIZE);
+}
+
+/**
+ * @brief  计算页CRC16（CRC字段按0计）
+ * @param  page: 页指针，数据长度取自页头
+ * @retval CRC16值
+ */
+static uint16_t CalcPageCRC(DataLogPage_t *page)
+{
+    uint16_t saved = page->header.crc;
+    uint16_t crc;
+    
+    page->header.crc = 0;
+    crc = APP_Comm_CRC16((uint8_t *)page, DATALOG_HEADER_SIZE + page->header.len);
+    page->header.crc = saved;
+    
+    return crc;
+}
+
+/**
+ * @brief  统计已用页数
+ * @note   页只顺序写入，已用页构成连续前缀，用二分查找定位第一个空白页
+ * @retval 已用页数
+ */
+static uint16_t CountUsed(void)
+{
+    uint16_t lo = 0;
+    uint16_t hi = DATALOG_PAGE_COUNT;
+    uint16_t mid;
+    
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (GetPageHeader(mid)->magic == 0xFFFF)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+    
+    return lo;
+}
+
+/**
+ * @brief  扫描数据日志，确定写入位置、页序号和启动序号
+ * @note   向前查找最新一页CRC有效的页，掉电造成的半写页被跳过；
+ *         区域已满时请求回收
+ * @retval 无
+ */
+static void ScanLog(void)
+{
+    DataLogPage_t page;
+    int32_t i;
+    
+    write_page = CountUsed();
+    erase_pending = (write_page >= DATALOG_PAGE_COUNT) ? 1 : 0;
+    
+    next_seq = 0;
+    boot_id = 0;
+    for (i = (int32_t)write_page - 1; i >= 0; i--)
+    {
+        BSP_Flash_ReadLog((uint32_t)i * DATALOG_PAGE_SIZE, (uint8_t *)&page, DATALOG_PAGE_SIZE);
+        if (page.header.magic == DATALOG_MAGIC && page.header.len <= DATALOG_PAYLOAD_SIZE &&
+            page.header.crc == CalcPageCRC(&page))
+        {
+            next_seq = page.header.seq + 1;
+            boot_id = page.header.boot + 1;
+            break;
+        }
+    }
+    
+    UpdateOldest();
+}
+
+/**
+ * @brief  更新Flash中第一页的序号
+ * @note   第一页损坏时按已用页数推算
+ * @retval 无
+ */
+static void UpdateOldest(void)
+{
+    oldest_seq = next_seq - write_page;
+    if (write_page > 0 && GetPageHeader(0)->magic == DATALOG_MAGIC)
+    {
+        oldest_seq = GetPageHeader(0)->seq;
+    }
+}
+
+/**
+ * @brief  开始新的RAM页
+ * @retval 无
+ */
+static void StartPage(void)
+{
+    memset(&log_page, 0xFF, sizeof(log_page));
+    memset(&log_page.header, 0, sizeof(log_page.header));
+    log_page.header.magic = DATALOG_MAGIC;
+    log_page.header.seq = next_seq;
+    log_page.header.interval_s = interval_s;
+    log_page.header.boot = boot_id;
+    log_page.header.base_mK = last_avg_mK;
+}
+
+/**
+ * @brief  按当前校时状态填写页头时间并计算CRC
+ * @retval 无
+ */
+static void FinishHeader(void)
+{
+    log_page.header.time_s = page_start_tick / 1000;
+    log_page.header.flags = 0;
+    if (time_synced)
+    {
+        log_page.header.time_s += epoch_offset;
+        log_page.header.flags |= DATALOG_FLAG_TIME_SYNCED;
+    }
+    log_page.header.crc = CalcPageCRC(&log_page);
+}
+
+/**
+ * @brief  将RAM页写入Flash并开始新页
+ * @note   区域已满且尚未回收时失败（不在此擦除）；写入后区域写满时请求
+ *         Flash任务回收；编程失败的页位置被跳过，RAM页保留到下次重试
+ * @retval 0=成功, -1=失败
+ */
+static int WritePage(void)
+{
+    FlashStatus_t status;
+    
+    if (write_page >= DATALOG_PAGE_COUNT)
+    {
+        erase_pending = 1;
+        return -1;
+    }
+    
+    FinishHeader();
+    status = BSP_Flash_WriteLog((uint32_t)write_page * DATALOG_PAGE_SIZE,
+                                (uint8_t *)&log_page, DATALOG_PAGE_SIZE);
+    if (status != FLASH_OK)
+    {
+        /* 忙时原位置重试，其余错误说明该页已部分编程 */
+        if (status != FLASH_ERROR_BUSY)
+        {
+            write_page++;
+            erase_pending = (write_page >= DATALOG_PAGE_COUNT) ? 1 : 0;
+        }
+        return -1;
+    }
+    
+    write_page++;
+    next_seq++;
+    StartPage();
+    erase_pending = (write_page >= DATALOG_PAGE_COUNT) ? 1 : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief  向RAM页追加一条编码后的记录
+ * @param  entry: 编码后的记录
+ * @param  len: 长度
+ * @param  start_tick: 记录的周期起点
+ * @note   放不下时先写入当前页；写入失败时丢弃该记录
+ * @retval 0=成功, -1=丢弃
+ */
+static int Append(const uint8_t *entry, uint8_t len, uint32_t start_tick)
+{
+    if (log_page.header.len + len > DATALOG_PAYLOAD_SIZE || log_page.header.count == 0xFF)
+    {
+        if (WritePage() != 0)
+        {
+            lost_count++;
+            return -1;
+        }
+    }
+    
+    if (log_page.header.count == 0)
+    {
+        page_start_tick = start_tick;
+    }
+    memcpy(&log_page.payload[log_page.header.len], entry, len);
+    log_page.header.len += len;
+    log_page.header.count++;
+    
+    return 0;
+}
+
+/**
+ * @brief  无符号LEB128编码
+ * @param  buf: 输出缓冲区（至少5字节）
+ * @param  value: 数值
+ * @retval 编码长度
+ */
+static uint8_t EncodeVarint(uint8_t *buf, uint32_t value)
+{
+    uint8_t len = 0;
+    
+    while (value >= 0x80)
+    {
+        buf[len++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buf[len++] = (uint8_t)value;
+    
+    return len;
+}
+
+/**
+ * @brief  写出累计的无数据周期
+ * @retval 无
+ */
+static void EmitGap(void)
+{
+    uint8_t entry[DATALOG_ENTRY_MAX];
+    uint8_t len;
+    
+    if (gap_count == 0)
+    {
+        return;
+    }
+    
+    len = EncodeVarint(entry, (gap_count << 1) | 1);
+    Append(entry, len, gap_start);
+    gap_count = 0;
+}
+
+/**
+ * @brief  结束当前周期，生成一条记录
+ * @retval 无
+ */
+static void CloseInterval(void)
+{
+    uint8_t entry[DATALOG_ENTRY_MAX];
+    uint8_t len;
+    int32_t avg_mK;
+    int32_t delta;
+    
+    if (acc_count == 0)
+    {
+        if (gap_count == 0)
+        {
+            gap_start = interval_start;
+        }
+        gap_count++;
+        return;
+    }
+    
+    EmitGap();
+    
+    avg_mK = (int32_t)(acc_sum_mK / (int64_t)acc_count);
+    delta = avg_mK - last_avg_mK;
+    len = EncodeVarint(entry, (((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31)) << 1);
+    len += EncodeVarint(&entry[len], (uint32_t)(avg_mK - acc_min_mK));
+    len += EncodeVarint(&entry[len], (uint32_t)(acc_max_mK - avg_mK));
+    
+    if (Append(entry, len, interval_start) == 0)
+    {
+        last_avg_mK = avg_mK;
+    }
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  数据日志初始化
+ * @retval 无
+ */
+void APP_DataLog_Init(void)
+{
+    /* 固件映像延伸到日志区域时不启用，避免擦除运行中的代码 */
+    log_enabled = BSP_Flash_LogAvailable();
+    if (log_enabled)
+    {
+        ScanLog();
+    }
+    else
+    {
+        write_page = 0;
+        erase_pending = 0;
+        next_seq = 0;
+        oldest_seq = 0;
+        boot_id = 0;
+    }
+    
+    /* 旧参数记录中该字段为0，使用默认值 */
+    interval_s = APP_Param_GetDatalogInterval();
+    if (interval_s == 0 || interval_s > DATALOG_INTERVAL_MAX)
+    {
+        interval_s = DATALOG_INTERVAL_DEFAULT;
+    }
+    
+    lost_count = 0;
+    last_avg_mK = 0;
+    acc_count = 0;
+    gap_count = 0;
+    interval_start = HAL_GetTick();
+    StartPage();
+}
+
+/**
+ * @brief  记录一次测量结果
+ * @param  temperature_K: 温度 (K)
+ * @param  valid: 1=探头正常, 0=本次测量无效
+ * @retval 无
+ */
+void APP_DataLog_Record(float temperature_K, uint8_t valid)
+{
+    uint32_t interval_ms = (uint32_t)interval_s * 1000;
+    uint32_t elapsed = HAL_GetTick() - interval_start;
+    int32_t value_mK;
+    
+    if (!log_enabled)
+    {
+        return;
+    }
+    
+    /* 周期结束；测量停顿超过一个周期时中间的周期记为无数据 */
+    if (elapsed >= interval_ms)
+    {
+        CloseInterval();
+        interval_start += interval_ms;
+        elapsed -= interval_ms;
+        if (elapsed >= interval_ms)
+        {
+            if (gap_count == 0)
+            {
+                gap_start = interval_start;
+            }
+            gap_count += elapsed / interval_ms;
+            interval_start += (elapsed / interval_ms) * interval_ms;
+        }
+        acc_count = 0;
+        acc_sum_mK = 0;
+    }
+    
+    if (!valid)
+    {
+        return;
+    }
+    
+    value_mK = (int32_t)(temperature_K * 1000.0f + 0.5f);
+    if (acc_count == 0 || value_mK < acc_min_mK)
+    {
+        acc_min_mK = value_mK;
+    }
+    if (acc_count == 0 || value_mK > acc_max_mK)
+    {
+        acc_max_mK = value_mK;
+    }
+    acc_sum_mK += value_mK;
+    acc_count++;
+}
+
+/**
+ * @brief  设置统计周期
+ * @param  interval: 统计周期 (s)
+ * @retval 0=成功, -1=参数无效, -2=Flash写入失败
+ */
+int APP_DataLog_SetInterval(uint16_t interval)
+{
+    if (interval == 0 || interval > DATALOG_INTERVAL_MAX)
+    {
+        return -1;
+    }
+    
+    /* 页内记录须为同一周期 */
+    if (APP_DataLog_Flush() != 0)
+    {
+        return -2;
+    }
+    
+    interval_s = interval;
+    log_page.header.interval_s = interval;
+    acc_count = 0;
+    acc_sum_mK = 0;
+    gap_count = 0;
+    interval_start = HAL_GetTick();
+    
+    return 0;
+}
+
+/**
+ * @brief  校时
+ * @param  unix_s: 当前UNIX时间 (s)
+ * @retval 无
+ */
+void APP_DataLog_SetTime(uint32_t unix_s)
+{
+    epoch_offset = unix_s - HAL_GetTick() / 1000;
+    time_synced = 1;
+}
+
+/**
+ * @brief  立即将RAM页中的记录写入Flash
+ * @retval 0=成功或无记录, -1=Flash写入失败
+ */
+int APP_DataLog_Flush(void)
+{
+    EmitGap();
+    
+    if (log_page.header.count == 0)
+    {
+        return 0;
+    }
+    
+    return WritePage();
+}
+
+/**
+ * @brief  数据日志区域回收（Flash任务中调用）
+ * @note   分步编程进行中时等待；擦除失败时保留原有的页，下一次写页重新请求
+ * @retval 无
+ */
+void APP_DataLog_Process(void)
+{
+    uint16_t first;
+    uint16_t i;
+    
+    if (!erase_pending || BSP_Flash_IsBusy())
+    {
+        return;
+    }
+    erase_pending = 0;
+    
+    /* 最新的页暂存到RAM，擦除后按原顺序写回区域开头 */
+    first = write_page - DATALOG_KEEP_PAGES;
+    for (i = 0; i < DATALOG_KEEP_PAGES; i++)
+    {
+        BSP_Flash_ReadLog((uint32_t)(first + i) * DATALOG_PAGE_SIZE,
+                          (uint8_t *)&keep_buf[i], DATALOG_PAGE_SIZE);
+    }
+    
+    if (BSP_Flash_EraseLog() != FLASH_OK)
+    {
+        write_page = CountUsed();
+        UpdateOldest();
+        return;
+    }
+    
+    /* 编程失败的页位置同样被跳过 */
+    for (i = 0; i < DATALOG_KEEP_PAGES; i++)
+    {
+        BSP_Flash_WriteLog((uint32_t)i * DATALOG_PAGE_SIZE,
+                           (uint8_t *)&keep_buf[i], DATALOG_PAGE_SIZE);
+    }
+    write_page = DATALOG_KEEP_PAGES;
+    UpdateOldest();
+}
+
+/**
+ * @brief  检查是否有待回收的区域
+ * @retval 1=有, 0=无
+ */
+uint8_t APP_DataLog_HasWork(void)
+{
+    return erase_pending;
+}
+
+/**
+ * @brief  擦除全部数据日志
+ * @retval 0=成功, -1=擦除失败或数据日志不可用
+ */
+int APP_DataLog_Erase(void)
+{
+    if (!log_enabled || BSP_Flash_EraseLog() != FLASH_OK)
+    {
+        return -1;
+    }
+    
+    write_page = 0;
+    erase_pending = 0;
+    oldest_seq = next_seq;
+    
+    return 0;
+}
+
+/**
+ * @brief  读出Flash中的日志页
+ * @param  offset: 数据日志区域内的偏移
+ * @param  data: 输出缓冲区
+ * @param  max_len: 最多读出字节数
+ * @retval 读出的字节数（已用页之外为0），-1=Flash读取失败
+ */
+int APP_DataLog_ReadFlash(uint32_t offset, uint8_t *data, uint16_t max_len)
+{
+    uint32_t used = (uint32_t)write_page * DATALOG_PAGE_SIZE;
+    
+    if (offset >= used)
+    {
+        return 0;
+    }
+    if (max_len > used - offset)
+    {
+        max_len = (uint16_t)(used - offset);
+    }
+    
+    if (BSP_Flash_ReadLog(offset, data, max_len) != FLASH_OK)
+    {
+        return -1;
+    }
+    
+    return max_len;
+}
+
+/**
+ * @brief  读出RAM页
+ * @param  offset: 页内偏移
+ * @param  data: 输出缓冲区
+ * @param  max_len: 最多读出字节数
+ * @retval 读出的字节数
+ */
+uint16_t APP_DataLog_ReadPending(uint16_t offset, uint8_t *data, uint16_t max_len)
+{
+    uint16_t total = DATALOG_HEADER_SIZE + log_page.header.len;
+    
+    if (offset >= total)
+    {
+        return 0;
+    }
+    if (max_len > total - offset)
+    {
+        max_len = total - offset;
+    }
+    
+    FinishHeader();
+    memcpy(data, (uint8_t *)&log_page + offset, max_len);
+    
+    return max_len;
+}
+
+/**
+ * @brief  获取数据日志状态
+ * @param  status: 输出状态结构体指针
+ * @retval 无
+ */
+void APP_DataLog_GetStatus(DataLogStatus_t *status)
+{
+    status->interval_s = interval_s;
+    status->page_count = log_enabled ? DATALOG_PAGE_COUNT : 0;
+    status->used_pages = write_page;
+    status->boot = boot_id;
+    status->time_synced = time_synced;
+    status->pending_count = log_page.header.count;
+    status->oldest_seq = oldest_seq;
+    status->next_seq = next_seq;
+    status->time_s = HAL_GetTick() / 1000 + (time_synced ? epoch_offset : 0);
+    status->lost = lost_count;
+}
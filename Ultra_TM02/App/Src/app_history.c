@@ -0,0 +1,142 @@
+/**
+ * @file    app_history.c
+ * @brief   测量历史记录应用层源文件
+ * @details 实现历史缓冲区的抽取写入和按序号读出
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "app_history.h"
+#include "app_param.h"
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 历史缓冲区（记录序号seq位于 seq & (HISTORY_BUF_SIZE - 1)） */
+static HistoryRecord_t history_buf[HISTORY_BUF_SIZE];
+static uint32_t history_next_seq = 0;       /* 下一条记录的序号 */
+static uint16_t history_count = 0;          /* 缓冲区中的条数 */
+
+/* 抽取 */
+static uint16_t history_decimation = HISTORY_DECIMATION_DEFAULT;
+static uint16_t decimation_count = 0;
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  历史记录初始化
+ * @retval 无
+ */
+void APP_History_Init(void)
+{
+    history_next_seq = 0;
+    history_count = 0;
+    decimation_count = 0;
+    
+    /* 旧参数记录中该字段为0，使用默认值 */
+    if (APP_History_SetDecimation(APP_Param_GetHistoryDecimation()) != 0)
+    {
+        history_decimation = HISTORY_DECIMATION_DEFAULT;
+    }
+}
+
+/**
+ * @brief  记录一次测量结果
+ * @param  temperature_K: 温度 (K)
+ * @param  voltage: 滤波后电压 (mV)
+ * @param  probe_status: 探头状态
+ * @retval 无
+ */
+void APP_History_Record(float temperature_K, float voltage, uint8_t probe_status)
+{
+    HistoryRecord_t *record;
+    
+    if (++decimation_count < history_decimation)
+    {
+        return;
+    }
+    decimation_count = 0;
+    
+    record = &history_buf[history_next_seq & (HISTORY_BUF_SIZE - 1)];
+    record->time_ms = HAL_GetTick();
+    record->temperature_K = temperature_K;
+    record->voltage = voltage;
+    record->probe_status = probe_status;
+    
+    history_next_seq++;
+    if (history_count < HISTORY_BUF_SIZE)
+    {
+        history_count++;
+    }
+}
+
+/**
+ * @brief  按序号读出记录
+ * @param  seq: 起始序号
+ * @param  records: 输出记录数组
+ * @param  max_count: 最多读出条数
+ * @param  first_seq: 输出第一条记录的实际序号
+ * @retval 读出的条数
+ */
+uint16_t APP_History_Read(uint32_t seq, HistoryRecord_t *records, uint16_t max_count,
+                          uint32_t *first_seq)
+{
+    uint32_t oldest = history_next_seq - history_count;
+    uint16_t count = 0;
+    
+    /* 已被覆盖的记录从最旧的一条开始，尚未产生的序号返回0条 */
+    if ((int32_t)(seq - oldest) < 0)
+    {
+        seq = oldest;
+    }
+    *first_seq = seq;
+    
+    while (count < max_count && (int32_t)(history_next_seq - seq) > 0)
+    {
+        records[count++] = history_buf[seq & (HISTORY_BUF_SIZE - 1)];
+        seq++;
+    }
+    
+    return count;
+}
+
+/**
+ * @brief  设置抽取比
+ * @param  decimation: 每N次测量保存一条
+ * @retval 0=成功, -1=参数无效
+ */
+int APP_History_SetDecimation(uint16_t decimation)
+{
+    if (decimation == 0 || decimation > HISTORY_DECIMATION_MAX)
+    {
+        return -1;
+    }
+    
+    history_decimation = decimation;
+    decimation_count = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief  清空历史记录
+ * @retval 无
+ */
+void APP_History_Clear(void)
+{
+    history_count = 0;
+    decimation_count = 0;
+}
+
+/**
+ * @brief  获取历史状态
+ * @param  status: 输出状态结构体指针
+ * @retval 无
+ */
+void APP_History_GetStatus(HistoryStatus_t *status)
+{
+    status->decimation = history_decimation;
+    status->count = history_count;
+    status->next_seq = history_next_seq;
+}
@@ -22,8 +22,78 @@ static OutputConfig_t g_output = {
     .current_mA = OUTPUT_MIN_CURRENT
 };
 
+/* 温度到电流的线性映射系数：I = output_gain * T + output_offset */
+static float output_gain = 0.0f;
+static float output_offset = 12.0f;
+
+/* 最近一次写入DAC的码值及时间 */
+static uint16_t last_dac_code = 0;
+static uint8_t last_dac_code_valid = 0;
+static uint32_t last_write_tick = 0;
+
+/* 被限速暂存的输出值 */
+static float pending_current_mA = 0.0f;
+static uint8_t pending_valid = 0;
+
+/* 输出更新最小间隔 (ms) */
+static uint32_t min_interval_ms = OUTPUT_MIN_UPDATE_INTERVAL;
+
+/* 故障电流保持，及保持期间应输出的电流 */
+static uint8_t fault_active = 0;
+static float fault_restore_mA = OUTPUT_MIN_CURRENT;
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static void UpdateCoefficients(void);
+static void WriteCurrent(float current_mA);
+
 /* 私有函数 ------------------------------------------------------------------*/
 
+/**
+ * @brief  根据4mA/20mA温度点重新计算映射系数
+ * @note   仅在温度点变化时调用，避免每次输出都做除法
+ * @retval 无
+ */
+static void UpdateCoefficients(void)
+{
+    float temp_range = g_output.temp_20mA - g_output.temp_4mA;
+    
+    /* 避免除零：量程为零时固定输出中间值 */
+    if (temp_range == 0.0f)
+    {
+        output_gain = 0.0f;
+        output_offset = 12.0f;
+        return;
+    }
+    
+    output_gain = (OUTPUT_MAX_CURRENT - OUTPUT_MIN_CURRENT) / temp_range;
+    output_offset = OUTPUT_MIN_CURRENT - g_output.temp_4mA * output_gain;
+}
+
+/**
+ * @brief  写入输出电流（DAC码值未变化时跳过）
+ * @param  current_mA: 电流值 (mA)，已限幅
+ * @retval 无
+ */
+static void WriteCurrent(float current_mA)
+{
+    uint16_t code = SVC_DAC_Calc420mACode(current_mA);
+    
+    g_output.current_mA = current_mA;
+    pending_valid = 0;
+    
+    if (last_dac_code_valid && code == last_dac_code)
+    {
+        return;
+    }
+    
+    last_dac_code = code;
+    last_dac_code_valid = 1;
+    last_write_tick = HAL_GetTick();
+    
+    SVC_DAC_Set420mA(current_mA);
+    SVC_LCD_SetCurrent(current_mA);
+}
+
 /* 公共函数 ------------------------------------------------------------------*/
 
 /**
@@ -36,9 +106,13 @@ void APP_Output_Init(void)
     g_output.temp_4mA = APP_Param_Get4mATemp();
     g_output.temp_20mA = APP_Param_Get20mATemp();
     g_output.current_mA = OUTPUT_MIN_CURRENT;
+    UpdateCoefficients();
     
     /* 设置初始输出为4mA */
-    SVC_DAC_Set420mA(OUTPUT_MIN_CURRENT);
+    pending_valid = 0;
+    fault_active = 0;
+    last_dac_code_valid = 0;
+    WriteCurrent(OUTPUT_MIN_CURRENT);
 }
 
 /**
@@ -48,24 +122,71 @@ void APP_Output_Init(void)
  */
 void APP_Output_UpdateCurrent(float temperature)
 {
-    float current;
+    float current = APP_Output_CalcCurrent(temperature);
     
-    /* 计算输出电流 */
-    current = APP_Output_CalcCurrent(temperature);
-    
-    /* 保存当前值 */
-    g_output.current_mA = current;
+    /* 故障电流保持中：只记录，解除时输出 */
+    if (fault_active)
+    {
+        fault_restore_mA = current;
+        return;
+    }
     
-    /* 设置DAC输出 */
-    SVC_DAC_Set420mA(current);
+    /* 未到最小间隔：暂存，由APP_Output_Process()补发 */
+    if (last_dac_code_valid && min_interval_ms != 0 &&
+        HAL_GetTick() - last_write_tick < min_interval_ms)
+    {
+        pending_current_mA = current;
+        pending_valid = 1;
+        return;
+    }
     
-    /* 更新LCD显示 */
-    SVC_LCD_SetCurrent(current);
+    WriteCurrent(current);
+}
+
+/**
+ * @brief  输出处理（主循环中调用）
+ * @retval 无
+ */
+void APP_Output_Process(void)
+{
+    if (APP_Output_IsDue())
+    {
+        WriteCurrent(pending_current_mA);
+    }
+}
+
+/**
+ * @brief  检查是否有到期待补发的输出值
+ * @retval 1=到期, 0=无
+ */
+uint8_t APP_Output_IsDue(void)
+{
+    return (pending_valid && !fault_active && HAL_GetTick() - last_write_tick >= min_interval_ms) ? 1 : 0;
+}
+
+/**
+ * @brief  设置输出更新最小间隔
+ * @param  interval_ms: 最小间隔 (ms)，0表示不限速
+ * @retval 无
+ */
+void APP_Output_SetMinInterval(uint32_t interval_ms)
+{
+    min_interval_ms = interval_ms;
+}
+
+/**
+ * @brief  获取输出更新最小间隔
+ * @retval 最小间隔 (ms)
+ */
+uint32_t APP_Output_GetMinInterval(void)
+{
+    return min_interval_ms;
 }
 
 /**
  * @brief  直接设置输出电流
  * @param  current_mA: 电流值 (mA)
+ * @note   手动设置，不受最小间隔限制
  * @retval 无
  */
 void APP_Output_SetCurrent(float current_mA)
@@ -80,10 +201,15 @@ void APP_Output_SetCurrent(float current_mA)
         current_mA = OUTPUT_MAX_CURRENT;
     }
     
+    /* 故障电流保持中：只记录，解除时输出 */
+    if (fault_active)
+    {
+        fault_restore_mA = current_mA;
+        return;
+    }
+    
     /* 保存并输出 */
-    g_output.current_mA = current_mA;
-    SVC_DAC_Set420mA(current_mA);
-    SVC_LCD_SetCurrent(current_mA);
+    WriteCurrent(current_mA);
 }
 
 /**
@@ -95,6 +221,56 @@ float APP_Output_GetCurrent(void)
     return g_output.current_mA;
 }
 
+/**
+ * @brief  强制输出故障电流
+ * @param  current_mA: 故障电流 (mA)
+ * @retval 无
+ */
+void APP_Output_SetFault(float current_mA)
+{
+    if (current_mA < OUTPUT_FAULT_MIN_CURRENT)
+    {
+        current_mA = OUTPUT_FAULT_MIN_CURRENT;
+    }
+    if (current_mA > OUTPUT_FAULT_MAX_CURRENT)
+    {
+        current_mA = OUTPUT_FAULT_MAX_CURRENT;
+    }
+    
+    /* 被限速暂存的值比当前输出更新 */
+    if (!fault_active)
+    {
+        fault_restore_mA = pending_valid ? pending_current_mA : g_output.current_mA;
+        fault_active = 1;
+    }
+    
+    WriteCurrent(current_mA);
+}
+
+/**
+ * @brief  解除故障电流
+ * @retval 无
+ */
+void APP_Output_ClearFault(void)
+{
+    if (!fault_active)
+    {
+        return;
+    }
+    
+    fault_active = 0;
+    WriteCurrent(fault_restore_mA);
+}
+
+/**
+ * @brief  检查输出是否被强制为故障电流
+ * @retval 1=故障电流, 0=正常输出
+ */
+uint8_t APP_Output_IsFault(void)
+{
+    return fault_active;
+}
+
 /**
  * @brief  设置4mA对应温度点
  * @param  temp: 温度值 (℃)
@@ -103,6 +279,7 @@ float APP_Output_GetCurrent(void)
 void APP_Output_Set4mATemp(float temp)
 {
     g_output.temp_4mA = temp;
+    UpdateCoefficients();
 }
 
 /**
@@ -122,6 +299,7 @@ float APP_Output_Get4mATemp(void)
 void APP_Output_Set20mATemp(float temp)
 {
     g_output.temp_20mA = temp;
+    UpdateCoefficients();
 }
 
 /**
@@ -137,27 +315,15 @@ float APP_Output_Get20mATemp(void)
  * @brief  根据温度计算输出电流
  * @param  temperature: 温度值 (℃)
  * @retval 计算得到的电流值 (mA)
- * @note   使用线性插值公式：
- *         I = 4 + (T - T_4mA) / (T_20mA - T_4mA) * 16
+ * @note   线性插值公式 I = 4 + (T - T_4mA) / (T_20mA - T_4mA) * 16
+ *         已预先化简为 I = gain * T + offset，系数在温度点变化时更新
  */
 float APP_Output_CalcCurrent(float temperature)
 {
     float current;
-    float temp_range;
-    
-    /* 计算温度范围 */
-    temp_range = g_output.temp_20mA - g_output.temp_4mA;
-    
-    /* 避免除零 */
-    if (temp_range == 0.0f)
-    {
-        return 12.0f;  /* 返回中间值 */
-    }
     
-    /* 线性插值计算 */
-    current = OUTPUT_MIN_CURRENT + 
-              (temperature - g_output.temp_4mA) / temp_range * 
-              (OUTPUT_MAX_CURRENT - OUTPUT_MIN_CURRENT);
+    /* 线性映射 */
+    current = output_gain * temperature + output_offset;
     
     /* 限幅 */
     if (current < OUTPUT_MIN_CURRENT)
@@ -198,5 +364,6 @@ void APP_Output_SetConfig(OutputConfig_t *config)
     {
         g_output.temp_4mA = config->temp_4mA;
         g_output.temp_20mA = config->temp_20mA;
+        UpdateCoefficients();
     }
 }
@@ -18,8 +18,10 @@
 static UserParam_t g_param = {
     .magic = PARAM_MAGIC,
     .version = PARAM_VERSION,
-    .reserved = 0,
+    .history_decimation = DEFAULT_HISTORY_DECIMATION,
+    .datalog_interval = DEFAULT_DATALOG_INTERVAL,
     .current_source = DEFAULT_CURRENT_SOURCE,
+    .clock_profile = DEFAULT_CLOCK_PROFILE,
     .current_adj_10uA = DEFAULT_CURRENT_ADJ_10,
     .current_adj_17uA = DEFAULT_CURRENT_ADJ_17,
     .temp_4mA = DEFAULT_TEMP_4MA,
@@ -27,9 +29,16 @@ static UserParam_t g_param = {
     .crc = 0
 };
 
+/* 参数日志位置缓存（以记录序号表示） */
+static uint16_t log_next = 0;           /* 下一条记录的写入位置 */
+static int32_t log_last = -1;           /* 最新有效记录位置，-1表示无 */
+static uint8_t log_scanned = 0;         /* 位置缓存是否有效 */
+
 /* 私有函数声明 --------------------------------------------------------------*/
 static uint16_t CalcParamCRC(UserParam_t *param);
 static int VerifyParam(UserParam_t *param);
+static const UserParam_t* GetRecord(uint16_t index);
+static void ScanLog(void);
 
 /* 私有函数 ------------------------------------------------------------------*/
 
@@ -93,10 +102,65 @@ static int VerifyParam(UserParam_t *param)
     {
         return -1;
     }
+    if (param->clock_profile >= POWER_PROFILE_COUNT)
+    {
+        return -1;
+    }
     
     return 0;
 }
 
+/**
+ * @brief  获取日志记录在Flash中的地址
+ * @param  index: 记录序号
+ * @retval 记录指针（直接指向Flash）
+ */
+static const UserParam_t* GetRecord(uint16_t index)
+{
+    return (const UserParam_t *)(FLASH_PARAM_START + (uint32_t)index * PARAM_RECORD_SIZE);
+}
+
+/**
+ * @brief  扫描参数日志，更新位置缓存
+ * @note   记录只追加写入，已用记录构成连续前缀，用二分查找定位第一个空白记录
+ *         （首字为0xFFFFFFFF）；再向前查找最新一条CRC有效的记录，
+ *         掉电造成的半写记录因CRC错误被跳过
+ * @retval 无
+ */
+static void ScanLog(void)
+{
+    uint16_t lo = 0;
+    uint16_t hi = PARAM_LOG_CAPACITY;
+    uint16_t mid;
+    int32_t i;
+    
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (GetRecord(mid)->magic == 0xFFFFFFFF)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+    log_next = lo;
+    
+    log_last = -1;
+    for (i = (int32_t)lo - 1; i >= 0; i--)
+    {
+        if (VerifyParam((UserParam_t *)GetRecord((uint16_t)i)) == 0)
+        {
+            log_last = i;
+            break;
+        }
+    }
+    
+    log_scanned = 1;
+}
+
 /* 公共函数 ------------------------------------------------------------------*/
 
 /**
@@ -115,6 +179,7 @@ void APP_Param_Init(void)
 
 /**
  * @brief  加载参数
+ * @note   从参数日志中读取最新的有效记录，位置缓存在首次加载时建立
  * @retval 0=成功, -1=失败（使用默认值）
  */
 int APP_Param_Load(void)
@@ -122,8 +187,19 @@ int APP_Param_Load(void)
     UserParam_t temp_param;
     FlashStatus_t status;
     
+    if (!log_scanned)
+    {
+        ScanLog();
+    }
+    
+    if (log_last < 0)
+    {
+        return -1;
+    }
+    
     /* 从Flash读取参数 */
-    status = BSP_Flash_ReadParam(0, (uint8_t *)&temp_param, sizeof(UserParam_t));
+    status = BSP_Flash_ReadParam((uint32_t)log_last * PARAM_RECORD_SIZE,
+                                 (uint8_t *)&temp_param, sizeof(UserParam_t));
     
     if (status != FLASH_OK)
     {
@@ -133,6 +209,8 @@ int APP_Param_Load(void)
     /* 验证参数 */
     if (VerifyParam(&temp_param) != 0)
     {
+        /* Flash内容与缓存不符，下次重新扫描 */
+        log_scanned = 0;
         return -1;
     }
     
@@ -144,6 +222,8 @@ int APP_Param_Load(void)
 
 /**
  * @brief  保存参数
+ * @note   与最新记录相同时不写Flash；否则追加一条记录，扇区写满时先擦除
+ *         整个扇区再从头写入（约每PARAM_LOG_CAPACITY次保存擦除一次）
  * @retval 0=成功, -1=失败
  */
 int APP_Param_Save(void)
@@ -153,23 +233,62 @@ int APP_Param_Save(void)
     /* 更新CRC */
     g_param.crc = CalcParamCRC(&g_param);
     
-    /* 擦除参数区域 */
-    status = BSP_Flash_EraseParam();
-    if (status != FLASH_OK)
+    if (!log_scanned)
     {
-        return -1;
+        ScanLog();
+    }
+    
+    /* 参数未变化，跳过写入 */
+    if (log_last >= 0 &&
+        memcmp(GetRecord((uint16_t)log_last), &g_param, sizeof(UserParam_t)) == 0)
+    {
+        return 0;
     }
     
-    /* 写入参数 */
-    status = BSP_Flash_WriteParam(0, (uint8_t *)&g_param, sizeof(UserParam_t));
+    /* 日志已满，擦除参数区域 */
+    if (log_next >= PARAM_LOG_CAPACITY)
+    {
+        status = BSP_Flash_EraseParam();
+        if (status != FLASH_OK)
+        {
+            log_scanned = 0;
+            return -1;
+        }
+        log_next = 0;
+        log_last = -1;
+    }
+    
+    /* 追加写入参数记录 */
+    status = BSP_Flash_WriteParam((uint32_t)log_next * PARAM_RECORD_SIZE,
+                                  (uint8_t *)&g_param, sizeof(UserParam_t));
+    
+    /* 无论成败该位置都已不再空白，下次写入下一条 */
+    log_next++;
+    
     if (status != FLASH_OK)
     {
         return -1;
     }
     
+    log_last = log_next - 1;
+    
     return 0;
 }
 
+/**
+ * @brief  获取参数日志已使用的记录数
+ * @retval 已使用记录数 (0 ~ PARAM_LOG_CAPACITY)
+ */
+uint16_t APP_Param_GetLogUsed(void)
+{
+    if (!log_scanned)
+    {
+        ScanLog();
+    }
+    
+    return log_next;
+}
+
 /**
  * @brief  恢复默认参数
  * @retval 无
@@ -178,8 +297,10 @@ void APP_Param_SetDefault(void)
 {
     g_param.magic = PARAM_MAGIC;
     g_param.version = PARAM_VERSION;
-    g_param.reserved = 0;
+    g_param.history_decimation = DEFAULT_HISTORY_DECIMATION;
+    g_param.datalog_interval = DEFAULT_DATALOG_INTERVAL;
     g_param.current_source = DEFAULT_CURRENT_SOURCE;
+    g_param.clock_profile = DEFAULT_CLOCK_PROFILE;
     g_param.current_adj_10uA = DEFAULT_CURRENT_ADJ_10;
     g_param.current_adj_17uA = DEFAULT_CURRENT_ADJ_17;
     g_param.temp_4mA = DEFAULT_TEMP_4MA;
@@ -293,6 +414,66 @@ void APP_Param_Set20mATemp(float temp)
     g_param.temp_20mA = temp;
 }
 
+/**
+ * @brief  获取时钟档位
+ * @retval 时钟档位 (POWER_PROFILE_xxx)
+ */
+uint8_t APP_Param_GetClockProfile(void)
+{
+    return g_param.clock_profile;
+}
+
+/**
+ * @brief  设置时钟档位
+ * @param  profile: 时钟档位 (POWER_PROFILE_xxx)
+ * @retval 无
+ */
+void APP_Param_SetClockProfile(uint8_t profile)
+{
+    if (profile < POWER_PROFILE_COUNT)
+    {
+        g_param.clock_profile = profile;
+    }
+}
+
+/**
+ * @brief  获取历史记录抽取比
+ * @retval 抽取比，0=默认
+ */
+uint16_t APP_Param_GetHistoryDecimation(void)
+{
+    return g_param.history_decimation;
+}
+
+/**
+ * @brief  设置历史记录抽取比
+ * @param  decimation: 抽取比
+ * @retval 无
+ */
+void APP_Param_SetHistoryDecimation(uint16_t decimation)
+{
+    g_param.history_decimation = decimation;
+}
+
+/**
+ * @brief  获取数据日志统计周期
+ * @retval 统计周期 (s)，0=默认
+ */
+uint16_t APP_Param_GetDatalogInterval(void)
+{
+    return g_param.datalog_interval;
+}
+
+/**
+ * @brief  设置数据日志统计周期
+ * @param  interval_s: 统计周期 (s)
+ * @retval 无
+ */
+void APP_Param_SetDatalogInterval(uint16_t interval_s)
+{
+    g_param.datalog_interval = interval_s;
+}
+
 /**
  * @brief  获取参数结构体指针
  * @retval 参数结构体指针
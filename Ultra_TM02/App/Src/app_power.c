@@ -0,0 +1,174 @@
+/**
+ * @file    app_power.c
+ * @brief   空闲睡眠与时钟档位应用层源文件
+ * @details 实现空闲睡眠、CPU负载统计和时钟档位切换
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "app_power.h"
+#include "app_param.h"
+#include "app_alarm.h"
+#include "app_sched.h"
+#include "svc_adc.h"
+#include "bsp_uart.h"
+#include "bsp_spi.h"
+#include "bsp_trace.h"
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* 切换档位前等待串口发送完成的超时 (ms) */
+#define POWER_UART_FLUSH_MS     50
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 负载统计 */
+static PowerStats_t power_stats = {0};
+
+/* 当前窗口：起始时刻 (ms) 与累计睡眠 (HCLK周期) */
+static uint32_t window_start_tick = 0;
+static uint32_t window_sleep_cycles = 0;
+
+/* 全部窗口累计 (HCLK周期) */
+static uint64_t total_cycles = 0;
+static uint64_t total_sleep_cycles = 0;
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  电源管理初始化
+ * @retval 无
+ */
+void APP_Power_Init(void)
+{
+    APP_Power_SetProfile(APP_Param_GetClockProfile());
+    APP_Power_ResetStats();
+}
+
+/**
+ * @brief  切换时钟档位
+ * @param  profile: 时钟档位 (POWER_PROFILE_xxx)
+ * @retval 0=成功, -1=档位无效或切换失败
+ */
+int APP_Power_SetProfile(uint8_t profile)
+{
+    int result;
+    
+    if (profile >= POWER_PROFILE_COUNT)
+    {
+        return -1;
+    }
+    if (profile == BSP_Power_GetProfile())
+    {
+        return 0;
+    }
+    
+    /* 避开串口和SPI传输；切换期间到来的ADC中断延后到释放总线 */
+    BSP_UART_FlushTx(POWER_UART_FLUSH_MS);
+    BSP_SPI_Lock();
+    result = BSP_Power_SetProfile(profile);
+    if (result == 0)
+    {
+        BSP_UART_UpdateClock();
+        SVC_ADC_UpdateClock();
+    }
+    BSP_SPI_Unlock();
+    
+    /* 周期数与新时钟不可比，重新开始统计；切换期间采样可能延后，变化率重新计算 */
+    APP_Power_ResetStats();
+    APP_Alarm_ResetRate();
+    
+    return result;
+}
+
+/**
+ * @brief  获取当前时钟档位
+ * @retval 时钟档位
+ */
+uint8_t APP_Power_GetProfile(void)
+{
+    return BSP_Power_GetProfile();
+}
+
+/**
+ * @brief  空闲处理
+ * @retval 无
+ */
+void APP_Power_Idle(void)
+{
+    __disable_irq();
+    
+    /* 关中断后再确认一次，检查之后到来的中断会让WFI立即返回 */
+    if (!APP_Sched_HasReady())
+    {
+        TRACE_BEGIN(TRACE_EVT_SLEEP, 0);
+        window_sleep_cycles += BSP_Power_Sleep();
+        TRACE_END(TRACE_EVT_SLEEP, 0);
+        power_stats.sleep_count++;
+    }
+    
+    __enable_irq();
+}
+
+/**
+ * @brief  负载统计处理
+ * @retval 无
+ */
+void APP_Power_Process(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t elapsed_ms = now - window_start_tick;
+    uint64_t cycles;
+    uint64_t sleep;
+    uint16_t load;
+    
+    if (elapsed_ms == 0)
+    {
+        return;
+    }
+    
+    /* 窗口时长按ms时基计算，睡眠时间不会超过窗口时长 */
+    cycles = (uint64_t)elapsed_ms * (SystemCoreClock / 1000U);
+    sleep = (window_sleep_cycles < cycles) ? window_sleep_cycles : cycles;
+    load = (uint16_t)(((cycles - sleep) * 1000U) / cycles);
+    
+    power_stats.load_last = load;
+    if (load > power_stats.load_peak)
+    {
+        power_stats.load_peak = load;
+    }
+    
+    total_cycles += cycles;
+    total_sleep_cycles += sleep;
+    power_stats.load_avg = (uint16_t)(((total_cycles - total_sleep_cycles) * 1000U) / total_cycles);
+    power_stats.elapsed_ms += elapsed_ms;
+    
+    window_start_tick = now;
+    window_sleep_cycles = 0;
+}
+
+/**
+ * @brief  获取CPU负载统计
+ * @param  stats: 输出统计结构体指针
+ * @retval 无
+ */
+void APP_Power_GetStats(PowerStats_t *stats)
+{
+    *stats = power_stats;
+}
+
+/**
+ * @brief  清零CPU负载统计
+ * @retval 无
+ */
+void APP_Power_ResetStats(void)
+{
+    memset(&power_stats, 0, sizeof(power_stats));
+    total_cycles = 0;
+    total_sleep_cycles = 0;
+    window_start_tick = HAL_GetTick();
+    window_sleep_cycles = 0;
+}
@@ -0,0 +1,265 @@
+/**
+ * @file    app_sched.c
+ * @brief   协作式任务调度应用层源文件
+ * @details 实现静态任务表的优先级调度与执行时间统计
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "app_sched.h"
+#include "app_temp.h"
+#include "app_output.h"
+#include "app_comm.h"
+#include "app_power.h"
+#include "app_datalog.h"
+#include "svc_lcd.h"
+#include "svc_usb.h"
+#include "bsp_gpio.h"
+#include "bsp_flash.h"
+#include "bsp_dwt.h"
+#include "bsp_trace.h"
+#include <string.h>
+
+/* 私有函数声明 --------------------------------------------------------------*/
+static void Task_Led(void);
+static void Task_Flash(void);
+static uint8_t Ready_Comm(void);
+static uint8_t Ready_Flash(void);
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/**
+ * 任务表
+ * 预算按正常路径估算：通讯任务处理分度表擦除/参数保存等命令时会阻塞数百毫秒，
+ * Flash任务回收数据日志区域时阻塞1~2s，此时记为超限属预期，统计用于发现意外的长时间执行
+ */
+static const SchedTask_t task_table[SCHED_TASK_COUNT] = {
+    [SCHED_TASK_TEMP]   = { "temp",   APP_Temp_Process,   APP_Temp_HasWork, 0,   200, 0 },
+    [SCHED_TASK_OUTPUT] = { "output", APP_Output_Process, APP_Output_IsDue, 0,   100, 1 },
+    [SCHED_TASK_COMM]   = { "comm",   APP_Comm_Process,   Ready_Comm,       0,   500, 2 },
+    [SCHED_TASK_FLASH]  = { "flash",  Task_Flash,         Ready_Flash,      0,   400, 3 },
+    [SCHED_TASK_LCD]    = { "lcd",    SVC_LCD_Update,     NULL,             20,  300, 4 },
+    [SCHED_TASK_LED]    = { "led",    Task_Led,           NULL,             500, 20,  5 },
+    [SCHED_TASK_POWER]  = { "power",  APP_Power_Process,  NULL,             100, 20,  6 },
+};
+
+/* 按优先级排列的任务编号 */
+static uint8_t task_order[SCHED_TASK_COUNT];
+
+/* 周期任务下次释放时刻 (ms) */
+static uint32_t next_release[SCHED_TASK_COUNT];
+
+/* 运行统计 */
+static SchedStats_t task_stats[SCHED_TASK_COUNT];
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  运行指示灯任务 (1Hz闪烁)
+ * @retval 无
+ */
+static void Task_Led(void)
+{
+    BSP_LED_Toggle();
+}
+
+/**
+ * @brief  Flash任务：分步编程与数据日志单元回收
+ * @retval 无
+ */
+static void Task_Flash(void)
+{
+    BSP_Flash_Process();
+    APP_DataLog_Process();
+}
+
+/**
+ * @brief  通讯任务就绪判断
+ * @retval 1=USB有待解析数据
+ */
+static uint8_t Ready_Comm(void)
+{
+    return (SVC_USB_Available() > 0) ? 1 : 0;
+}
+
+/**
+ * @brief  Flash任务就绪判断
+ * @retval 1=有分步编程进行中或有待回收的数据日志单元
+ */
+static uint8_t Ready_Flash(void)
+{
+    return (BSP_Flash_GetAsyncStatus() == FLASH_ERROR_BUSY || APP_DataLog_HasWork()) ? 1 : 0;
+}
+
+/**
+ * @brief  检查任务是否就绪
+ * @param  id: 任务编号
+ * @param  now: 当前时刻 (ms)
+ * @retval 1=就绪, 0=未就绪
+ */
+static uint8_t IsReady(uint8_t id, uint32_t now)
+{
+    const SchedTask_t *task = &task_table[id];
+    
+    if (task->ready != NULL)
+    {
+        return task->ready();
+    }
+    
+    return ((int32_t)(now - next_release[id]) >= 0) ? 1 : 0;
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  调度器初始化
+ * @retval 无
+ */
+void APP_Sched_Init(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint8_t id;
+    uint8_t i, j;
+    
+    /* 按优先级插入排序 */
+    for (i = 0; i < SCHED_TASK_COUNT; i++)
+    {
+        id = i;
+        for (j = i; j > 0 && task_table[task_order[j - 1]].priority > task_table[id].priority; j--)
+        {
+            task_order[j] = task_order[j - 1];
+        }
+        task_order[j] = id;
+        
+        next_release[i] = now + task_table[i].period_ms;
+    }
+    
+    APP_Sched_ResetStats();
+}
+
+/**
+ * @brief  调度一次（主循环中调用）
+ * @retval 1=运行了任务, 0=无就绪任务
+ */
+uint8_t APP_Sched_Run(void)
+{
+    const SchedTask_t *task;
+    SchedStats_t *stats;
+    uint32_t now = HAL_GetTick();
+    uint32_t start;
+    uint32_t exec_us;
+    uint32_t late_ms;
+    uint8_t id;
+    uint8_t i;
+    
+    for (i = 0; i < SCHED_TASK_COUNT; i++)
+    {
+        id = task_order[i];
+        if (!IsReady(id, now))
+        {
+            continue;
+        }
+        
+        task = &task_table[id];
+        stats = &task_stats[id];
+        
+        /* 周期任务：记录延迟并计算下次释放时刻，落后超过一个周期时不补跑 */
+        if (task->ready == NULL)
+        {
+            late_ms = now - next_release[id];
+            if (late_ms > stats->max_late_ms)
+            {
+                stats->max_late_ms = late_ms;
+            }
+            
+            next_release[id] += task->period_ms;
+            if ((int32_t)(now - next_release[id]) >= 0)
+            {
+                next_release[id] = now + task->period_ms;
+            }
+        }
+        
+        TRACE_BEGIN(TRACE_EVT_TASK, id);
+        start = BSP_DWT_GetCycles();
+        task->func();
+        exec_us = BSP_DWT_CyclesToUs(BSP_DWT_GetCycles() - start);
+        TRACE_END(TRACE_EVT_TASK, id);
+        
+        stats->run_count++;
+        if (exec_us > stats->max_exec_us)
+        {
+            stats->max_exec_us = exec_us;
+        }
+        if (exec_us > task->budget_us)
+        {
+            stats->overrun_count++;
+        }
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  检查是否有就绪任务
+ * @retval 1=有就绪任务, 0=无
+ */
+uint8_t APP_Sched_HasReady(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint8_t id;
+    
+    for (id = 0; id < SCHED_TASK_COUNT; id++)
+    {
+        if (IsReady(id, now))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  获取任务描述
+ * @param  id: 任务编号
+ * @retval 任务描述指针，编号无效时为NULL
+ */
+const SchedTask_t *APP_Sched_GetTask(uint8_t id)
+{
+    if (id >= SCHED_TASK_COUNT)
+    {
+        return NULL;
+    }
+    
+    return &task_table[id];
+}
+
+/**
+ * @brief  获取任务运行统计
+ * @param  id: 任务编号
+ * @param  stats: 输出统计结构体指针
+ * @retval 无
+ */
+void APP_Sched_GetStats(uint8_t id, SchedStats_t *stats)
+{
+    if (id >= SCHED_TASK_COUNT)
+    {
+        memset(stats, 0, sizeof(SchedStats_t));
+        return;
+    }
+    
+    *stats = task_stats[id];
+}
+
+/**
+ * @brief  清零全部任务运行统计
+ * @retval 无
+ */
+void APP_Sched_ResetStats(void)
+{
+    memset(task_stats, 0, sizeof(task_stats));
+}
@@ -9,11 +9,21 @@
 
 /* 包含头文件 ----------------------------------------------------------------*/
 #include "app_temp.h"
+#include "app_temp_calc.h"
 #include "app_output.h"
 #include "svc_adc.h"
 #include "svc_dac.h"
 #include "svc_lcd.h"
+#include "bsp_flash.h"
+#include "bsp_prof.h"
+#include "bsp_trace.h"
+#include "app_boot.h"
+#include "app_capture.h"
+#include "app_history.h"
+#include "app_datalog.h"
+#include "app_alarm.h"
 #include <string.h>
+#include <math.h>
 
 /* 私有宏定义 ----------------------------------------------------------------*/
 
@@ -23,6 +33,25 @@
 #define PROBE_MAX_VOLTAGE       2500.0f     /* 最大有效电压 (mV) */
 #define PROBE_MIN_VOLTAGE       100.0f      /* 最小有效电压 (mV) */
 
+/* 私有类型定义 --------------------------------------------------------------*/
+
+/* Welford在线统计（均值与二阶中心矩用double，避免长窗口下float累加误差） */
+typedef struct {
+    uint32_t count;
+    double mean;
+    double m2;
+    float min;
+    float max;
+} Welford_t;
+
+/* Allan偏差的一层 */
+typedef struct {
+    uint32_t blocks;            /* 已形成的块数 */
+    float prev;                 /* 上一块的平均值 */
+    float half;                 /* 待与下一块合并为上一层块的前半块 */
+    double sum_sq;              /* 相邻块差值平方和 */
+} AdevLevel_t;
+
 /* 私有变量 ------------------------------------------------------------------*/
 
 /* 温度测量数据 */
@@ -35,28 +64,66 @@ static TempMeasure_t g_temp = {
     .filtered_voltage = 0.0f,
     .temperature_K = 0.0f,
     .temperature_C = 0.0f,
-    .sample_count = 0
+    .sample_count = 0,
+    .sample_cycles = 0,
+    .sample_tick = 0
 };
 
 /* 采样缓冲区 */
 static float sample_buffer[TEMP_SAMPLE_COUNT];
 static uint8_t sample_index = 0;
 
+/* 本次测量有效（探头正常且分度表有效），无效时温度不更新 */
+static uint8_t meas_valid = 0;
+
 /* 滑动平均滤波器 */
-static float filter_buffer[TEMP_FILTER_SIZE];
-static uint8_t filter_index = 0;
-static uint8_t filter_count = 0;
-static float filter_sum = 0.0f;
+static MovingAvg_t avg_filter;
+
+/* 本次测量的中值电压与未经滑动平均的温度（统计与Allan偏差用，相邻测量互不相关） */
+static float median_voltage = 0.0f;
+static float unfiltered_K = 0.0f;
 
 /* 分度表指针（指向Flash） */
 static TempTableHeader_t *p_table_header = (TempTableHeader_t *)TEMP_TABLE_FLASH_ADDR;
 static TempTablePoint_t *p_table_points = (TempTablePoint_t *)(TEMP_TABLE_FLASH_ADDR + sizeof(TempTableHeader_t));
 
+/* 分度表下载状态 */
+static FlashWriter_t table_writer;
+static uint16_t table_load_count = 0;       /* 声明的数据点数 */
+static uint16_t table_load_received = 0;    /* 已写入的数据点数 */
+static uint16_t table_load_next = 0;        /* 期望的下一包序号 */
+static uint8_t table_loading = 0;           /* 下载进行中标志 */
+
+/* 突发采集设置与变化率触发状态 */
+static TempBurstConfig_t burst_config = {0};
+static float rate_last_K = 0.0f;
+static uint32_t rate_last_tick = 0;
+static uint8_t rate_last_valid = 0;
+
+/* 统计窗口 */
+static Welford_t stats_current[TEMP_STATS_WINDOWS];
+static TempStatsResult_t stats_last[TEMP_STATS_WINDOWS];
+static uint32_t stats_length[TEMP_STATS_WINDOWS] = {TEMP_STATS_WINDOW_0, TEMP_STATS_WINDOW_1};
+static uint32_t stats_completed[TEMP_STATS_WINDOWS];
+static uint32_t stats_skipped = 0;
+
+/* Allan偏差（各层数据减去第一次测量值，float差分不损失精度） */
+static AdevLevel_t adev_levels[TEMP_ADEV_LEVELS];
+static uint8_t adev_enabled = 0;
+static uint32_t adev_samples = 0;
+static uint32_t adev_first_ms = 0;
+static uint32_t adev_last_ms = 0;
+static float adev_ref = 0.0f;
+
 /* 私有函数声明 --------------------------------------------------------------*/
 static float MedianFilter(float *data, uint8_t len);
 static float MovingAvgFilter(float value);
 static void CheckProbeStatus(float voltage);
 static float Kelvin_to_Celsius(float kelvin);
+static void CheckBurstRate(void);
+static void WelfordResult(const Welford_t *w, TempStatsResult_t *result);
+static void UpdateStats(float value);
+static void UpdateAdev(float value);
 
 /* 私有函数 ------------------------------------------------------------------*/
 
@@ -64,63 +131,23 @@ static float Kelvin_to_Celsius(float kelvin);
  * @brief  中值滤波
  * @param  data: 数据数组
  * @param  len: 数据长度
+ * @note   位于RAM中
  * @retval 中值
  */
-static float MedianFilter(float *data, uint8_t len)
+static RAMFUNC float MedianFilter(float *data, uint8_t len)
 {
-    float temp[TEMP_SAMPLE_COUNT];
-    float t;
-    uint8_t i, j;
-    
-    /* 复制数据 */
-    for (i = 0; i < len && i < TEMP_SAMPLE_COUNT; i++)
-    {
-        temp[i] = data[i];
-    }
-    
-    /* 冒泡排序 */
-    for (i = 0; i < len - 1; i++)
-    {
-        for (j = 0; j < len - 1 - i; j++)
-        {
-            if (temp[j] > temp[j + 1])
-            {
-                t = temp[j];
-                temp[j] = temp[j + 1];
-                temp[j + 1] = t;
-            }
-        }
-    }
-    
-    /* 返回中值 */
-    return temp[len / 2];
+    return TempCalc_Median(data, len);
 }
 
 /**
  * @brief  滑动平均滤波
  * @param  value: 新数据
+ * @note   位于RAM中
  * @retval 滤波后的值
  */
-static float MovingAvgFilter(float value)
+static RAMFUNC float MovingAvgFilter(float value)
 {
-    /* 减去旧值 */
-    filter_sum -= filter_buffer[filter_index];
-    
-    /* 添加新值 */
-    filter_buffer[filter_index] = value;
-    filter_sum += value;
-    
-    /* 更新索引 */
-    filter_index = (filter_index + 1) % TEMP_FILTER_SIZE;
-    
-    /* 更新计数 */
-    if (filter_count < TEMP_FILTER_SIZE)
-    {
-        filter_count++;
-    }
-    
-    /* 返回平均值 */
-    return filter_sum / filter_count;
+    return TempCalc_MovingAvg(&avg_filter, value);
 }
 
 /**
@@ -158,6 +185,132 @@ static float Kelvin_to_Celsius(float kelvin)
     return kelvin - 273.15f;
 }
 
+/**
+ * @brief  温度变化率超限时触发突发采集
+ * @note   用相邻两次滤波后温度及其样本时刻计算变化率；间隔按ms时基计算，
+ *         DWT周期差在长采样周期下会回绕，且跨时钟档位切换不可比
+ * @retval 无
+ */
+static void CheckBurstRate(void)
+{
+    float dt;
+    float rate;
+    
+    if (burst_config.rate_limit > 0.0f && rate_last_valid)
+    {
+        dt = (float)(g_temp.sample_tick - rate_last_tick) * 0.001f;
+        rate = g_temp.temperature_K - rate_last_K;
+        if (rate < 0.0f)
+        {
+            rate = -rate;
+        }
+        if (dt > 0.0f && rate > burst_config.rate_limit * dt)
+        {
+            SVC_ADC_BurstTrigger(ADC_BURST_SRC_RATE);
+        }
+    }
+    
+    rate_last_K = g_temp.temperature_K;
+    rate_last_tick = g_temp.sample_tick;
+    rate_last_valid = 1;
+}
+
+/**
+ * @brief  由Welford状态计算统计结果
+ * @param  w: Welford状态
+ * @param  result: 输出统计结果
+ * @retval 无
+ */
+static void WelfordResult(const Welford_t *w, TempStatsResult_t *result)
+{
+    result->count = w->count;
+    result->mean = (float)w->mean;
+    result->stddev = (w->count > 1) ? sqrtf((float)(w->m2 / (double)(w->count - 1))) : 0.0f;
+    result->min = w->min;
+    result->max = w->max;
+}
+
+/**
+ * @brief  以一次测量结果更新各统计窗口
+ * @param  value: 温度 (K)
+ * @note   窗口满时保存为最近完整窗口并清空，开始下一个窗口
+ * @retval 无
+ */
+static void UpdateStats(float value)
+{
+    Welford_t *w;
+    double delta;
+    uint8_t i;
+    
+    for (i = 0; i < TEMP_STATS_WINDOWS; i++)
+    {
+        w = &stats_current[i];
+        w->count++;
+        delta = (double)value - w->mean;
+        w->mean += delta / (double)w->count;
+        w->m2 += delta * ((double)value - w->mean);
+        if (w->count == 1 || value < w->min)
+        {
+            w->min = value;
+        }
+        if (w->count == 1 || value > w->max)
+        {
+            w->max = value;
+        }
+        
+        if (stats_length[i] != 0 && w->count >= stats_length[i])
+        {
+            WelfordResult(w, &stats_last[i]);
+            stats_completed[i]++;
+            memset(w, 0, sizeof(Welford_t));
+        }
+    }
+}
+
+/**
+ * @brief  以一次测量结果更新Allan偏差各层
+ * @param  value: 温度 (K)
+ * @note   第0层的块即单次测量；某层每形成两个块，其平均值作为上一层的一个块，
+ *         每次测量平均只处理约2层
+ * @retval 无
+ */
+static void UpdateAdev(float value)
+{
+    AdevLevel_t *level;
+    float y;
+    float d;
+    uint8_t j;
+    
+    if (adev_samples == 0)
+    {
+        adev_ref = value;
+        adev_first_ms = HAL_GetTick();
+    }
+    adev_samples++;
+    adev_last_ms = HAL_GetTick();
+    
+    y = value - adev_ref;
+    for (j = 0; j < TEMP_ADEV_LEVELS; j++)
+    {
+        level = &adev_levels[j];
+        if (level->blocks > 0)
+        {
+            d = y - level->prev;
+            level->sum_sq += (double)(d * d);
+        }
+        level->prev = y;
+        level->blocks++;
+        
+        /* 奇数块暂存为前半块，偶数块与之合并后送入上一层 */
+        if (level->blocks & 1)
+        {
+            level->half = y;
+            break;
+        }
+        y = 0.5f * (level->half + y);
+    }
+}
+
 /* 公共函数 ------------------------------------------------------------------*/
 
 /**
@@ -178,18 +331,11 @@ void APP_Temp_Init(void)
     g_temp.sample_count = 0;
     
     /* 清空滤波器 */
-    memset(filter_buffer, 0, sizeof(filter_buffer));
-    filter_index = 0;
-    filter_count = 0;
-    filter_sum = 0.0f;
+    memset(&avg_filter, 0, sizeof(avg_filter));
     
     sample_index = 0;
     
-    /* 初始化ADC */
-    SVC_ADC_Init();
-    
-    /* 初始化DAC并设置默认电流源 */
-    SVC_DAC_Init();
+    /* ADC/DAC服务已在App_Init()中初始化，这里只设置默认电流源 */
     SVC_DAC_SetCurrentSource(CURRENT_SRC_10UA);
     
     /* 验证分度表 */
@@ -209,8 +355,10 @@ void APP_Temp_Start(void)
     g_temp.running = 1;
     g_temp.state = TEMP_STATE_SAMPLING;
     sample_index = 0;
+    rate_last_valid = 0;
+    APP_Alarm_ResetRate();
     
-    /* 启动ADC转换 */
+    /* 启动定时采样（此后由TIM2中断按采样周期启动转换，DRDY中断读取结果） */
     SVC_ADC_StartConversion();
     
     /* 更新LCD状态 */
@@ -226,6 +374,9 @@ void APP_Temp_Stop(void)
     g_temp.running = 0;
     g_temp.state = TEMP_STATE_IDLE;
     
+    /* 停止定时采样 */
+    SVC_ADC_StopConversion();
+    
     /* 更新LCD状态 */
     SVC_LCD_SetStatus("Stopped");
 }
@@ -247,13 +398,18 @@ void APP_Temp_Process(void)
     switch (g_temp.state)
     {
         case TEMP_STATE_SAMPLING:
-            /* 检查ADC数据是否就绪 */
+            /* 检查FIFO中是否有DRDY中断采集的样本 */
             if (SVC_ADC_IsReady())
             {
-                /* 读取ADC电压 */
+                /* 读取ADC电压及其采集时刻 */
                 g_temp.raw_voltage = SVC_ADC_ReadVoltage();
+                g_temp.sample_cycles = SVC_ADC_GetLastSampleCycles();
+                g_temp.sample_tick = SVC_ADC_GetLastSampleTick();
+                APP_Capture_Record(SVC_ADC_GetLastRaw(), g_temp.sample_cycles);
                 
                 /* 存入采样缓冲区 */
+                APP_Boot_Mark(BOOT_STAGE_FIRST_SAMPLE);
+                TRACE_EVENT(TRACE_EVT_SAMPLE, sample_index);
                 sample_buffer[sample_index++] = g_temp.raw_voltage;
                 
                 /* 检查是否采集够了 */
@@ -262,21 +418,25 @@ void APP_Temp_Process(void)
                     sample_index = 0;
                     g_temp.state = TEMP_STATE_FILTERING;
                 }
-                else
-                {
-                    /* 启动下一次ADC转换 */
-                    SVC_ADC_StartConversion();
-                }
             }
             break;
             
         case TEMP_STATE_FILTERING:
+            TRACE_BEGIN(TRACE_EVT_FILTER, 0);
+            
             /* 中值滤波 */
-            median_value = MedianFilter(sample_buffer, TEMP_SAMPLE_COUNT);
+            {
+                PROF_BEGIN(PROF_PROBE_MEDIAN);
+                median_value = MedianFilter(sample_buffer, TEMP_SAMPLE_COUNT);
+                PROF_END(PROF_PROBE_MEDIAN);
+            }
+            median_voltage = median_value;
             
             /* 滑动平均滤波 */
             g_temp.filtered_voltage = MovingAvgFilter(median_value);
             
+            TRACE_END(TRACE_EVT_FILTER, 0);
+            
             /* 检查探头状态 */
             CheckProbeStatus(g_temp.filtered_voltage);
             
@@ -284,14 +444,23 @@ void APP_Temp_Process(void)
             break;
             
         case TEMP_STATE_CALCULATING:
-            /* 只有探头正常时才计算温度 */
-            if (g_temp.probe_status == PROBE_STATUS_OK)
+            /* 只有探头正常且分度表有效时才计算温度（下载分度表期间表头无效） */
+            meas_valid = (g_temp.probe_status == PROBE_STATUS_OK && APP_Temp_TableVerify() == 0);
+            if (meas_valid)
             {
                 /* 查分度表获取温度 */
-                g_temp.temperature_K = APP_Temp_TableLookup(g_temp.filtered_voltage);
+                {
+                    TRACE_BEGIN(TRACE_EVT_LOOKUP, 0);
+                    PROF_BEGIN(PROF_PROBE_TABLE_LOOKUP);
+                    g_temp.temperature_K = APP_Temp_TableLookup(g_temp.filtered_voltage);
+                    PROF_END(PROF_PROBE_TABLE_LOOKUP);
+                    TRACE_END(TRACE_EVT_LOOKUP, 0);
+                }
+                unfiltered_K = APP_Temp_TableLookup(median_voltage);
                 
                 /* 单位转换 */
                 g_temp.temperature_C = Kelvin_to_Celsius(g_temp.temperature_K);
+                CheckBurstRate();
                 
                 /* 更新LCD显示 */
                 SVC_LCD_SetTemperature(g_temp.temperature_C);
@@ -300,9 +469,14 @@ void APP_Temp_Process(void)
             }
             else
             {
-                /* 探头异常，显示错误 */
+                rate_last_valid = 0;
+                
+                /* 探头异常或无分度表，显示错误 */
                 switch (g_temp.probe_status)
                 {
+                    case PROBE_STATUS_OK:
+                        SVC_LCD_SetStatus("No Table!");
+                        break;
                     case PROBE_STATUS_OPEN:
                         SVC_LCD_SetStatus("Probe Open!");
                         break;
@@ -322,18 +496,44 @@ void APP_Temp_Process(void)
             break;
             
         case TEMP_STATE_OUTPUTTING:
+            /* 判断报警（需强制故障电流时先于输出更新）；无分度表时温度无意义，报警保持原状态 */
+            if (meas_valid || g_temp.probe_status != PROBE_STATUS_OK)
+            {
+                APP_Alarm_Check(g_temp.temperature_K, g_temp.sample_tick, (uint8_t)g_temp.probe_status);
+            }
+            
             /* 更新4-20mA输出 */
-            if (g_temp.probe_status == PROBE_STATUS_OK)
+            if (meas_valid)
             {
                 APP_Output_UpdateCurrent(g_temp.temperature_C);
+                APP_Boot_Mark(BOOT_STAGE_FIRST_READING);
+                PROF_RECORD(PROF_PROBE_SAMPLE_TO_OUT, BSP_DWT_GetCycles() - g_temp.sample_cycles);
             }
             
-            /* 增加采样计数 */
+            /* 增加采样计数，更新统计并保存历史记录与数据日志（无分度表的测量不记录） */
             g_temp.sample_count++;
+            if (meas_valid)
+            {
+                /* 滑动平均后相邻测量共享15/16数据，会低估σ并压低小τ的Allan偏差 */
+                UpdateStats(unfiltered_K);
+                if (adev_enabled)
+                {
+                    UpdateAdev(unfiltered_K);
+                }
+            }
+            else
+            {
+                stats_skipped++;
+            }
+            if (meas_valid || g_temp.probe_status != PROBE_STATUS_OK)
+            {
+                APP_History_Record(g_temp.temperature_K, g_temp.filtered_voltage,
+                                   (uint8_t)g_temp.probe_status);
+                APP_DataLog_Record(g_temp.temperature_K, meas_valid);
+            }
             
-            /* 启动下一轮采样 */
+            /* 进入下一轮采样（转换由定时器中断持续触发） */
             g_temp.state = TEMP_STATE_SAMPLING;
-            SVC_ADC_StartConversion();
             break;
             
         case TEMP_STATE_ERROR:
@@ -401,6 +601,32 @@ uint8_t APP_Temp_IsRunning(void)
     return g_temp.running;
 }
 
+/**
+ * @brief  检查测量任务是否有待处理的工作
+ * @retval 1=有工作, 0=无
+ */
+uint8_t APP_Temp_HasWork(void)
+{
+    if (!g_temp.running)
+    {
+        return 0;
+    }
+    
+    switch (g_temp.state)
+    {
+        case TEMP_STATE_SAMPLING:
+            return SVC_ADC_IsReady();
+            
+        case TEMP_STATE_FILTERING:
+        case TEMP_STATE_CALCULATING:
+        case TEMP_STATE_OUTPUTTING:
+            return 1;
+            
+        default:
+            return 0;
+    }
+}
+
 /**
  * @brief  设置电流源
  * @param  src: 电流源选择 (0:10μA, 1:17μA)
@@ -425,74 +651,150 @@ uint8_t APP_Temp_GetCurrentSource(void)
 /**
  * @brief  分度表查表（二分查找+线性插值）
  * @param  voltage: 电压值 (mV)
+ * @note   位于RAM中，分度表数据经ART数据缓存从Flash读取
  * @retval 温度值 (K)
  */
-float APP_Temp_TableLookup(float voltage)
+RAMFUNC float APP_Temp_TableLookup(float voltage)
 {
-    int low = 0;
-    int high = p_table_header->point_count - 1;
-    int mid;
-    float v0, v1, t0, t1;
-    
     /* 检查分度表有效性 */
-    if (APP_Temp_TableVerify() != 0)
+    if (!TempCalc_TableValid(p_table_header))
     {
         return 0.0f;
     }
     
-    /* 边界检查 */
-    if (voltage >= p_table_points[0].voltage)
+    return TempCalc_Lookup(p_table_points, p_table_header->point_count, voltage);
+}
+
+/**
+ * @brief  验证分度表有效性
+ * @retval 0=有效, -1=无效
+ */
+int APP_Temp_TableVerify(void)
+{
+    return TempCalc_TableValid(p_table_header) ? 0 : -1;
+}
+
+/**
+ * @brief  获取分度表数据点数
+ * @retval 数据点数，分度表无效时为0
+ */
+uint16_t APP_Temp_GetTablePoints(void)
+{
+    return TempCalc_TableValid(p_table_header) ? p_table_header->point_count : 0;
+}
+
+/**
+ * @brief  开始下载分度表
+ * @param  point_count: 数据点数
+ * @retval 0=成功, -1=参数错误, -2=Flash错误
+ */
+int APP_Temp_TableLoadStart(uint16_t point_count)
+{
+    table_loading = 0;
+    
+    if (point_count == 0 || point_count > TEMP_TABLE_MAX_POINTS)
+    {
+        return -1;
+    }
+    
+    if (BSP_Flash_EraseTable() != FLASH_OK)
+    {
+        return -2;
+    }
+    
+    /* 数据点紧跟表头之后写入，表头留到最后 */
+    if (BSP_Flash_StreamOpen(&table_writer,
+                             TEMP_TABLE_FLASH_ADDR + sizeof(TempTableHeader_t),
+                             (uint32_t)point_count * sizeof(TempTablePoint_t)) != FLASH_OK)
+    {
+        return -2;
+    }
+    
+    table_load_count = point_count;
+    table_load_received = 0;
+    table_load_next = 0;
+    table_loading = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  写入一包分度表数据
+ * @param  packet_index: 包序号
+ * @param  data: 数据点
+ * @param  len: 数据长度（字节数）
+ * @retval 0=成功, -1=序号/长度错误, -2=Flash错误
+ */
+int APP_Temp_TableLoadData(uint16_t packet_index, const uint8_t *data, uint16_t len)
+{
+    uint16_t points = len / sizeof(TempTablePoint_t);
+    
+    if (!table_loading)
     {
-        return p_table_points[0].temperature;
+        return -1;
     }
-    if (voltage <= p_table_points[high].voltage)
+    
+    /* 上一包的重发 */
+    if (table_load_next > 0 && packet_index == table_load_next - 1)
     {
-        return p_table_points[high].temperature;
+        return 0;
     }
     
-    /* 二分查找 */
-    while (high - low > 1)
+    if (packet_index != table_load_next || points == 0 ||
+        len % sizeof(TempTablePoint_t) != 0 ||
+        table_load_received + points > table_load_count)
     {
-        mid = (low + high) / 2;
-        
-        if (voltage > p_table_points[mid].voltage)
-        {
-            high = mid;
-        }
-        else
-        {
-            low = mid;
-        }
+        return -1;
     }
     
-    /* 线性插值 */
-    v0 = p_table_points[low].voltage;
-    v1 = p_table_points[high].voltage;
-    t0 = p_table_points[low].temperature;
-    t1 = p_table_points[high].temperature;
+    if (BSP_Flash_StreamAppend(&table_writer, data, len) != FLASH_OK)
+    {
+        table_loading = 0;
+        return -2;
+    }
     
-    return t0 + (voltage - v0) * (t1 - t0) / (v1 - v0);
+    table_load_received += points;
+    table_load_next++;
+    
+    return 0;
 }
 
 /**
- * @brief  验证分度表有效性
- * @retval 0=有效, -1=无效
+ * @brief  结束下载分度表
+ * @param  expected_crc: 主机计算的数据点CRC32，NULL表示不比对
+ * @retval 0=成功, -1=点数或CRC不符, -2=Flash错误
  */
-int APP_Temp_TableVerify(void)
+int APP_Temp_TableLoadEnd(const uint32_t *expected_crc)
 {
-    /* 检查魔数 */
-    if (p_table_header->magic != TEMP_TABLE_MAGIC)
+    TempTableHeader_t header;
+    uint32_t crc;
+    
+    if (!table_loading || table_load_received != table_load_count)
     {
+        table_loading = 0;
         return -1;
     }
+    table_loading = 0;
     
-    /* 检查点数 */
-    if (p_table_header->point_count == 0 || 
-        p_table_header->point_count > TEMP_TABLE_MAX_POINTS)
+    if (BSP_Flash_StreamFinish(&table_writer, &crc) != FLASH_OK)
+    {
+        return -2;
+    }
+    
+    if (expected_crc != NULL && *expected_crc != crc)
     {
         return -1;
     }
     
+    header.magic = TEMP_TABLE_MAGIC;
+    header.point_count = table_load_count;
+    header.reserved = 0;
+    
+    if (BSP_Flash_Write(TEMP_TABLE_FLASH_ADDR, (uint8_t *)&header, sizeof(header)) != FLASH_OK)
+    {
+        return -2;
+    }
+    
     return 0;
 }
 
@@ -504,3 +806,165 @@ uint32_t APP_Temp_GetSampleCount(void)
 {
     return g_temp.sample_count;
 }
+
+/**
+ * @brief  布防突发采集
+ * @param  config: 采集配置
+ * @retval 0=成功, -1=参数无效
+ */
+int APP_Temp_BurstArm(const TempBurstConfig_t *config)
+{
+    ADCBurstConfig_t adc_burst;
+    
+    if (config->rate_limit < 0.0f)
+    {
+        return -1;
+    }
+    
+    adc_burst.pre_samples = config->pre_samples;
+    adc_burst.post_samples = config->post_samples;
+    adc_burst.edge = config->edge & (ADC_BURST_EDGE_RISING | ADC_BURST_EDGE_FALLING);
+    adc_burst.level_raw = SVC_ADC_VoltageToRaw(config->level_mV);
+    if (SVC_ADC_BurstArm(&adc_burst) != 0)
+    {
+        return -1;
+    }
+    
+    burst_config = *config;
+    burst_config.edge = adc_burst.edge;
+    rate_last_valid = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief  命令触发突发采集
+ * @retval 1=已触发, 0=未处于布防状态
+ */
+uint8_t APP_Temp_BurstTrigger(void)
+{
+    return SVC_ADC_BurstTrigger(ADC_BURST_SRC_COMMAND);
+}
+
+/**
+ * @brief  取消突发采集
+ * @retval 无
+ */
+void APP_Temp_BurstAbort(void)
+{
+    SVC_ADC_BurstAbort();
+    burst_config.rate_limit = 0.0f;
+}
+
+/**
+ * @brief  获取突发采集配置
+ * @param  config: 输出配置结构体指针
+ * @retval 无
+ */
+void APP_Temp_GetBurstConfig(TempBurstConfig_t *config)
+{
+    *config = burst_config;
+}
+
+/**
+ * @brief  设置统计窗口长度
+ * @param  index: 窗口编号
+ * @param  length: 窗口长度 (测量次数)，0=累计不分窗口
+ * @retval 0=成功, -1=参数无效
+ */
+int APP_Temp_StatsSetWindow(uint8_t index, uint32_t length)
+{
+    if (index >= TEMP_STATS_WINDOWS)
+    {
+        return -1;
+    }
+    
+    stats_length[index] = length;
+    stats_completed[index] = 0;
+    memset(&stats_current[index], 0, sizeof(Welford_t));
+    memset(&stats_last[index], 0, sizeof(TempStatsResult_t));
+    
+    return 0;
+}
+
+/**
+ * @brief  清空全部统计窗口与Allan偏差累计
+ * @retval 无
+ */
+void APP_Temp_StatsReset(void)
+{
+    memset(stats_current, 0, sizeof(stats_current));
+    memset(stats_last, 0, sizeof(stats_last));
+    memset(stats_completed, 0, sizeof(stats_completed));
+    stats_skipped = 0;
+    
+    memset(adev_levels, 0, sizeof(adev_levels));
+    adev_samples = 0;
+}
+
+/**
+ * @brief  开始或停止Allan偏差累计
+ * @param  enable: 1=清空后开始累计, 0=停止
+ * @retval 无
+ */
+void APP_Temp_AdevEnable(uint8_t enable)
+{
+    if (enable)
+    {
+        memset(adev_levels, 0, sizeof(adev_levels));
+        adev_samples = 0;
+    }
+    adev_enabled = enable ? 1 : 0;
+}
+
+/**
+ * @brief  获取统计窗口
+ * @param  index: 窗口编号
+ * @param  window: 输出窗口结构体指针
+ * @retval 0=成功, -1=编号无效
+ */
+int APP_Temp_GetStats(uint8_t index, TempStatsWindow_t *window)
+{
+    if (index >= TEMP_STATS_WINDOWS)
+    {
+        return -1;
+    }
+    
+    window->length = stats_length[index];
+    window->completed = stats_completed[index];
+    WelfordResult(&stats_current[index], &window->current);
+    window->last = stats_last[index];
+    
+    return 0;
+}
+
+/**
+ * @brief  获取Allan偏差
+ * @param  adev: 输出结构体指针
+ * @retval 无
+ */
+void APP_Temp_GetAdev(TempAdev_t *adev)
+{
+    uint32_t pairs;
+    uint8_t j;
+    
+    adev->enabled = adev_enabled;
+    adev->samples = adev_samples;
+    adev->elapsed_ms = (adev_samples > 0) ? (adev_last_ms - adev_first_ms) : 0;
+    
+    for (j = 0; j < TEMP_ADEV_LEVELS; j++)
+    {
+        pairs = (adev_levels[j].blocks > 0) ? adev_levels[j].blocks - 1 : 0;
+        adev->adev[j] = (pairs > 0) ?
+                        sqrtf((float)(adev_levels[j].sum_sq / (2.0 * (double)pairs))) : 0.0f;
+    }
+}
+
+/**
+ * @brief  获取统计中跳过的无效测量次数
+ * @retval 次数
+ */
+uint32_t APP_Temp_GetStatsSkipped(void)
+{
+    return stats_skipped;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file    bsp_dwt.h
+ * @brief   DWT周期计数器板级支持包头文件
+ * @details 提供基于Cortex-M4 DWT->CYCCNT的微秒级延时和周期计时功能
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __BSP_DWT_H
+#define __BSP_DWT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* HAL时基计数，由SysTick_Handler（RAMFUNC）递增 */
+extern __IO uint32_t uwTick;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  DWT周期计数器初始化
+ * @note   需在任何微秒延时之前调用，重复调用无副作用
+ * @retval 无
+ */
+void BSP_DWT_Init(void);
+
+/**
+ * @brief  读取当前CPU周期计数
+ * @note   内联实现，可在RAM中执行的中断代码里使用
+ * @retval 32位周期计数（自由运行，溢出回绕）
+ */
+static inline uint32_t BSP_DWT_GetCycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief  读取当前ms时基
+ * @note   与HAL_GetTick()相同的值；直接读uwTick，Flash擦除期间RAM中的中断代码也可使用
+ * @retval ms计数（溢出回绕）
+ */
+static inline ALWAYS_INLINE uint32_t BSP_DWT_GetTick(void)
+{
+    return uwTick;
+}
+
+/**
+ * @brief  微秒级忙等待延时
+ * @param  us: 延时时间 (μs)
+ * @note   基于CYCCNT，不依赖SysTick，可在中断中使用
+ * @retval 无
+ */
+void BSP_DWT_DelayUs(uint32_t us);
+
+/**
+ * @brief  周期数转换为微秒
+ * @param  cycles: CPU周期数
+ * @retval 时间 (μs)
+ */
+uint32_t BSP_DWT_CyclesToUs(uint32_t cycles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BSP_DWT_H */
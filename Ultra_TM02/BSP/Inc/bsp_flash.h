@@ -1,7 +1,14 @@
 /**
  * @file    bsp_flash.h
  * @brief   内部Flash板级支持包头文件
- * @details 提供STM32F411内部Flash读写操作，用于参数和分度表存储
+ * @details 提供STM32F411内部Flash读写操作，用于参数、分度表和数据日志存储
+ *          F411为单Bank Flash，擦写期间所有从Flash取指的代码都会停顿，因此：
+ *          - 中断向量表复制到SRAM，DRDY/SysTick中断及其调用链位于RAM(.RamFunc)
+ *          - 扇区擦除在RAM中等待完成，期间屏蔽处理函数位于Flash中的中断
+ *          - 编程按小块分步执行(BSP_Flash_Process)，主循环不被长时间阻塞
+ *          - 编程直接按字写寄存器（不逐字经过HAL），每块回读按字比较；
+ *            分度表等大块数据使用流式写入(Open/Append/Finish)，并对回读
+ *            内容累加CRC32，写入结束后与数据来源的CRC比对
  * @author  Ultra-TM02 开发团队
  * @version V1.0
  * @date    2025-12-18
@@ -27,14 +34,28 @@ extern "C" {
  * Sector 2:  0x08008000 - 0x0800BFFF (16KB)  - 程序代码
  * Sector 3:  0x0800C000 - 0x0800FFFF (16KB)  - 程序代码
  * Sector 4:  0x08010000 - 0x0801FFFF (64KB)  - 程序代码
- * Sector 5:  0x08020000 - 0x0803FFFF (128KB) - 程序代码
+ * Sector 5:  0x08020000 - 0x0803FFFF (128KB) - 长期数据日志
  * Sector 6:  0x08040000 - 0x0805FFFF (128KB) - 分度表存储
- * Sector 7:  0x08060000 - 0x0807FFFF (128KB) - 用户参数
+ * Sector 7:  0x08060000 - 0x0807FFFF (128KB) - 用户参数（追加写日志）
+ *
+ * 程序代码限于Sector 0~4 (128KB)：附加链接脚本flash_layout.ld在固件映像超出
+ * FLASH_CODE_END时使链接失败；运行时再以FIRMWARE_IMAGE_END检查
+ * （BSP_Flash_LogAvailable），未加入该脚本的构建也不会擦除运行中的代码
  */
 
 /* 程序代码区域 */
 #define FLASH_CODE_START        0x08000000
-#define FLASH_CODE_END          0x0803FFFF
+#define FLASH_CODE_END          0x0801FFFF
+
+/* 长期数据日志区域 (Sector 5) */
+#define FLASH_LOG_START         0x08020000
+#define FLASH_LOG_END           0x0803FFFF
+#define FLASH_LOG_SIZE          (128 * 1024)  /* 128KB */
+#define FLASH_LOG_SECTOR        FLASH_SECTOR_5
+
+#if FLASH_CODE_END >= FLASH_LOG_START
+#error "程序代码区域与数据日志区域重叠，需同时修改flash_layout.ld"
+#endif
 
 /* 分度表存储区域 (Sector 6) */
 #define FLASH_TABLE_START       0x08040000
@@ -48,6 +69,30 @@ extern "C" {
 #define FLASH_PARAM_SIZE        (128 * 1024)  /* 128KB */
 #define FLASH_PARAM_SECTOR      FLASH_SECTOR_7
 
+/* 擦除期间屏蔽的中断优先级阈值：优先级数值>=此值的中断（SPI1/USART6/DMA/USB，
+ * 处理函数在Flash中）被BASEPRI屏蔽，SysTick(0)与ADC_DRDY(5)保持响应 */
+#define FLASH_ERASE_BASEPRI     6
+
+/* 分步编程时每次BSP_Flash_Process()写入的字数（每字约16μs） */
+#define FLASH_PROGRAM_CHUNK     16
+
+/* 编程并行度：VDD=3.3V（电压范围2.7V~3.6V）下允许的最宽并行度为x32；
+ * x64需要在VPP引脚外加8~9V，本板不具备 */
+#define FLASH_PROGRAM_PSIZE     FLASH_CR_PSIZE_1
+
+/* SRAM中断向量表项数（16个内核异常 + 86个外设中断，按512字节对齐取128） */
+#define FLASH_VECTOR_COUNT      128
+
+/* ART加速器选项（FLASH->ACR使能位） */
+#define FLASH_ACCEL_PREFETCH    FLASH_ACR_PRFTEN
+#define FLASH_ACCEL_ICACHE      FLASH_ACR_ICEN
+#define FLASH_ACCEL_DCACHE      FLASH_ACR_DCEN
+#define FLASH_ACCEL_ALL         (FLASH_ACCEL_PREFETCH | FLASH_ACCEL_ICACHE | FLASH_ACCEL_DCACHE)
+
+/* 上电时的加速器配置：3个等待周期下预取减少顺序取指停顿，指令缓存（64行）
+ * 覆盖分支目标，数据缓存（8行）覆盖常量池和分度表读取 */
+#define FLASH_ACCEL_BOOT        FLASH_ACCEL_ALL
+
 /* 类型定义 ------------------------------------------------------------------*/
 
 /* Flash操作状态 */
@@ -60,11 +105,63 @@ typedef enum {
     FLASH_ERROR_BUSY        /* Flash忙 */
 } FlashStatus_t;
 
+/* Flash操作统计（主循环停顿时间） */
+typedef struct {
+    uint32_t erase_count;           /* 扇区擦除次数 */
+    uint32_t erase_max_us;          /* 单次擦除最长耗时 (μs) */
+    uint32_t program_words;         /* 累计编程字数 */
+    uint32_t program_chunk_max_us;  /* 单次分步编程最长耗时 (μs) */
+} FlashStats_t;
+
+/* 流式写入上下文（调用者分配，成员仅由本模块修改） */
+typedef struct {
+    uint32_t start;             /* 起始地址 */
+    uint32_t end;               /* 结束地址（不含） */
+    uint32_t addr;              /* 下一个待编程地址 */
+    uint32_t crc;               /* 已写入数据回读的CRC32（未取反的中间值） */
+    uint32_t pending;           /* 不足一字的暂存字节 */
+    uint8_t pending_len;        /* 暂存字节数 (0~3) */
+    FlashStatus_t status;       /* 首个错误，出错后后续追加直接返回该错误 */
+} FlashWriter_t;
+
 /* 函数声明 ------------------------------------------------------------------*/
 
+/**
+ * @brief  Flash驱动初始化
+ * @note   将中断向量表复制到SRAM并重定位VTOR，使擦写期间中断入口不经过Flash；
+ *         需在使能外设中断前调用
+ * @retval 无
+ */
+void BSP_Flash_Init(void);
+
+/**
+ * @brief  按FLASH_ACCEL_BOOT配置ART加速器
+ * @note   在HAL_Init()之后、SystemClock_Config()之前调用；先关闭并复位指令/数据
+ *         缓存再使能，结果不依赖HAL配置和复位前（调试器、Bootloader）留下的状态
+ * @retval 无
+ */
+void BSP_Flash_AccelInit(void);
+
+/**
+ * @brief  设置ART加速器
+ * @param  flags: FLASH_ACCEL_xxx组合
+ * @note   由关闭变为使能的缓存先复位（关闭期间的擦写不会刷新缓存）；
+ *         关闭加速器期间Flash中的代码明显变慢，调用者应关中断并尽快恢复
+ * @retval 设置前的FLASH_ACCEL_xxx组合
+ */
+uint32_t BSP_Flash_SetAccel(uint32_t flags);
+
+/**
+ * @brief  获取ART加速器配置
+ * @retval FLASH_ACCEL_xxx组合
+ */
+uint32_t BSP_Flash_GetAccel(void);
+
 /**
  * @brief  擦除指定扇区
  * @param  sector: 扇区号 (FLASH_SECTOR_0 - FLASH_SECTOR_7)
+ * @note   主循环在RAM中等待擦除完成（128KB扇区约1~2s），期间DRDY采样与
+ *         SysTick继续运行，其余中断延后到擦除结束
  * @retval Flash操作状态
  */
 FlashStatus_t BSP_Flash_EraseSector(uint32_t sector);
@@ -74,10 +171,83 @@ FlashStatus_t BSP_Flash_EraseSector(uint32_t sector);
  * @param  addr: 目标地址（必须4字节对齐）
  * @param  data: 数据缓冲区指针
  * @param  len: 数据长度（字节数）
+ * @note   同步接口，内部按FLASH_PROGRAM_CHUNK分步编程直到完成
  * @retval Flash操作状态
  */
 FlashStatus_t BSP_Flash_Write(uint32_t addr, uint8_t *data, uint32_t len);
 
+/**
+ * @brief  启动分步编程
+ * @param  addr: 目标地址（必须4字节对齐）
+ * @param  data: 数据缓冲区指针（编程完成前必须保持有效）
+ * @param  len: 数据长度（字节数）
+ * @note   实际编程在BSP_Flash_Process()中分块完成
+ * @retval FLASH_OK=已启动, FLASH_ERROR_BUSY=上一操作未完成, FLASH_ERROR_ADDR=地址无效
+ */
+FlashStatus_t BSP_Flash_ProgramAsync(uint32_t addr, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief  打开流式写入
+ * @param  writer: 写入上下文
+ * @param  addr: 起始地址（必须4字节对齐，目标区域需已擦除）
+ * @param  max_len: 最大写入长度（字节数），写入范围不得超出Flash
+ * @retval FLASH_OK=已打开, FLASH_ERROR_ADDR=地址无效, FLASH_ERROR_BUSY=分步编程未完成
+ */
+FlashStatus_t BSP_Flash_StreamOpen(FlashWriter_t *writer, uint32_t addr, uint32_t max_len);
+
+/**
+ * @brief  追加写入数据
+ * @param  writer: 写入上下文
+ * @param  data: 数据缓冲区指针（返回后即可复用）
+ * @param  len: 数据长度（字节数），可为任意长度
+ * @note   同步接口：整字直接从源缓冲区编程（源地址4字节对齐时无需拼字），
+ *         每FLASH_PROGRAM_CHUNK字回读比较一次并累加CRC32；
+ *         不足一字的尾部暂存，由下次追加或BSP_Flash_StreamFinish()写入
+ * @retval Flash操作状态
+ */
+FlashStatus_t BSP_Flash_StreamAppend(FlashWriter_t *writer, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief  结束流式写入
+ * @param  writer: 写入上下文
+ * @param  crc: 输出回读的全部写入数据的CRC32（与zlib.crc32一致），可为NULL
+ * @note   暂存的尾部字节以0xFF补齐为一字后写入，补齐字节不计入CRC
+ * @retval Flash操作状态（首个错误）
+ */
+FlashStatus_t BSP_Flash_StreamFinish(FlashWriter_t *writer, uint32_t *crc);
+
+/**
+ * @brief  Flash分步编程处理（主循环中调用）
+ * @retval 无
+ */
+void BSP_Flash_Process(void);
+
+/**
+ * @brief  获取分步编程状态
+ * @retval FLASH_ERROR_BUSY=进行中, FLASH_OK=已完成, 其他=失败原因
+ */
+FlashStatus_t BSP_Flash_GetAsyncStatus(void);
+
+/**
+ * @brief  检查Flash是否正在擦除或编程
+ * @note   位于RAM中，可在中断中调用
+ * @retval 1=忙, 0=空闲
+ */
+uint8_t BSP_Flash_IsBusy(void);
+
+/**
+ * @brief  获取Flash操作统计
+ * @param  stats: 输出统计结构体指针
+ * @retval 无
+ */
+void BSP_Flash_GetStats(FlashStats_t *stats);
+
+/**
+ * @brief  清零Flash操作统计
+ * @retval 无
+ */
+void BSP_Flash_ResetStats(void);
+
 /**
  * @brief  从Flash读取数据
  * @param  addr: 源地址
@@ -99,6 +269,19 @@ FlashStatus_t BSP_Flash_EraseTable(void);
  */
 FlashStatus_t BSP_Flash_EraseParam(void);
 
+/**
+ * @brief  检查数据日志区域是否可用
+ * @note   固件映像结束地址超出程序代码区域时不可用，此时日志区域的擦写均被拒绝
+ * @retval 1=可用, 0=不可用
+ */
+uint8_t BSP_Flash_LogAvailable(void);
+
+/**
+ * @brief  擦除数据日志区域
+ * @retval Flash操作状态，日志区域不可用时为FLASH_ERROR_ADDR
+ */
+FlashStatus_t BSP_Flash_EraseLog(void);
+
 /**
  * @brief  写入分度表数据
  * @param  offset: 相对于分度表区域起始地址的偏移
@@ -135,6 +318,24 @@ FlashStatus_t BSP_Flash_WriteParam(uint32_t offset, uint8_t *data, uint32_t len)
  */
 FlashStatus_t BSP_Flash_ReadParam(uint32_t offset, uint8_t *data, uint32_t len);
 
+/**
+ * @brief  写入数据日志
+ * @param  offset: 相对于数据日志区域起始地址的偏移
+ * @param  data: 数据缓冲区指针
+ * @param  len: 数据长度
+ * @retval Flash操作状态
+ */
+FlashStatus_t BSP_Flash_WriteLog(uint32_t offset, uint8_t *data, uint32_t len);
+
+/**
+ * @brief  读取数据日志
+ * @param  offset: 相对于数据日志区域起始地址的偏移
+ * @param  data: 数据缓冲区指针
+ * @param  len: 数据长度
+ * @retval Flash操作状态
+ */
+FlashStatus_t BSP_Flash_ReadLog(uint32_t offset, uint8_t *data, uint32_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -79,6 +79,7 @@ void BSP_GPIO_Init(void);
 /**
  * @brief  设置ADC1片选信号
  * @param  state: 0=选中(低电平), 1=取消选中(高电平)
+ * @note   位于RAM中，可在Flash擦写期间由DRDY中断调用
  * @retval 无
  */
 void BSP_ADC_CS(uint8_t state);
@@ -127,6 +128,7 @@ void BSP_LED_Toggle(void);
 
 /**
  * @brief  读取ADC数据就绪状态
+ * @note   位于RAM中，可在Flash擦写期间由DRDY中断调用
  * @retval 1=数据就绪(低电平), 0=未就绪(高电平)
  */
 uint8_t BSP_ADC_IsDataReady(void);
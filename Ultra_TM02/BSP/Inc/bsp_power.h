@@ -0,0 +1,66 @@
+/**
+ * @file    bsp_power.h
+ * @brief   时钟档位与睡眠板级支持包头文件
+ * @details 提供运行时切换的系统时钟档位和WFI睡眠：
+ *          - PLL固定输出192MHz VCO（SYSCLK 96MHz，USB 48MHz），档位只改变AHB/APB分频，
+ *            切换时不关闭PLL，USB时钟不中断
+ *          - 全速 96MHz / 均衡 48MHz / 低功耗 24MHz（回路供电），
+ *            HCLK不低于USB OTG FS要求的14.2MHz
+ *          - 切换后HAL自动更新SystemCoreClock并重新配置SysTick，
+ *            依赖APB时钟的外设（串口波特率、定时器预分频）由调用者重新同步
+ *          - 睡眠为Sleep模式（内核停止、外设运行），任一中断挂起即唤醒
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __BSP_POWER_H
+#define __BSP_POWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 时钟档位（上位机按此编号显示名称） */
+typedef enum {
+    POWER_PROFILE_FULL = 0,     /* 全速: HCLK 96MHz, APB1 48MHz, APB2 96MHz */
+    POWER_PROFILE_BALANCED,     /* 均衡: HCLK/APB1/APB2 48MHz */
+    POWER_PROFILE_LOW,          /* 低功耗: HCLK/APB1/APB2 24MHz */
+    POWER_PROFILE_COUNT
+} PowerProfile_t;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  切换时钟档位
+ * @param  profile: 时钟档位 (POWER_PROFILE_xxx)
+ * @note   上电时SystemClock_Config()配置为全速档；切换期间约数μs总线时钟不稳定，
+ *         调用者应避开SPI/串口传输
+ * @retval 0=成功, -1=档位无效或时钟配置失败
+ */
+int BSP_Power_SetProfile(uint8_t profile);
+
+/**
+ * @brief  获取当前时钟档位
+ * @retval 时钟档位
+ */
+uint8_t BSP_Power_GetProfile(void);
+
+/**
+ * @brief  进入睡眠直到有中断挂起
+ * @note   调用者须已关中断(PRIMASK=1)并确认没有待处理的工作，唤醒后由调用者
+ *         开中断执行中断服务；SysTick每1ms必然唤醒一次
+ * @retval 睡眠时长 (HCLK周期)
+ */
+uint32_t BSP_Power_Sleep(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BSP_POWER_H */
@@ -0,0 +1,122 @@
+/**
+ * @file    bsp_prof.h
+ * @brief   周期级性能探针板级支持包头文件
+ * @details 基于DWT->CYCCNT的轻量级执行时间统计：
+ *          - 每个探针记录次数、最小/最大/累计周期数和log2直方图
+ *          - 直方图第n格统计[2^n, 2^(n+1))个周期的样本，0和1周期计入第0格，
+ *            超出范围的计入最后一格
+ *          - 编译时定义PROF_ENABLE=0则全部宏展开为空，探针无任何代码和数据开销
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __BSP_PROF_H
+#define __BSP_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+#include "bsp_dwt.h"
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 性能探针总开关 */
+#ifndef PROF_ENABLE
+#define PROF_ENABLE             1
+#endif
+
+/* 直方图格数：2^23周期在96MHz下约87ms，覆盖主循环中所有正常路径 */
+#define PROF_HIST_BINS          24
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 探针编号（上位机按此顺序显示名称） */
+typedef enum {
+    PROF_PROBE_MEDIAN = 0,      /* 中值滤波 MedianFilter() */
+    PROF_PROBE_TABLE_LOOKUP,    /* 分度表查表 APP_Temp_TableLookup() */
+    PROF_PROBE_LCD_UPDATE,      /* 显示刷新 SVC_LCD_Update()（有控件变化时） */
+    PROF_PROBE_USB_TX,          /* USB发送 SVC_USB_Transmit() */
+    PROF_PROBE_LOOP,            /* 主循环周期 */
+    PROF_PROBE_SAMPLE_TO_OUT,   /* 最后一个样本启动转换到4-20mA输出更新的延迟 */
+    PROF_PROBE_COUNT
+} ProfProbeId_t;
+
+/* 单个探针统计 */
+typedef struct {
+    uint32_t count;                     /* 样本数 */
+    uint32_t min_cycles;                /* 最小周期数（无样本时为0） */
+    uint32_t max_cycles;                /* 最大周期数 */
+    uint64_t sum_cycles;                /* 累计周期数 */
+    uint16_t hist[PROF_HIST_BINS];      /* log2直方图，计数饱和于0xFFFF */
+} ProfProbe_t;
+
+/* 探针宏 --------------------------------------------------------------------*/
+
+#if PROF_ENABLE
+
+/* 在同一作用域内成对使用，测量两者之间代码的执行周期 */
+#define PROF_BEGIN(id)          uint32_t prof_start_##id = BSP_DWT_GetCycles()
+#define PROF_END(id)            BSP_Prof_Record((id), BSP_DWT_GetCycles() - prof_start_##id)
+
+/* 直接记录一个已测得的周期数 */
+#define PROF_RECORD(id, cycles) BSP_Prof_Record((id), (cycles))
+
+/* 记录相邻两次经过同一位置的间隔 */
+#define PROF_MARK(id)           BSP_Prof_Mark(id)
+
+#else
+
+#define PROF_BEGIN(id)          ((void)0)
+#define PROF_END(id)            ((void)0)
+#define PROF_RECORD(id, cycles) ((void)0)
+#define PROF_MARK(id)           ((void)0)
+
+#endif /* PROF_ENABLE */
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+#if PROF_ENABLE
+
+/**
+ * @brief  记录一次测量
+ * @param  id: 探针编号
+ * @param  cycles: 执行周期数
+ * @note   只在主循环中调用，不做中断保护
+ * @retval 无
+ */
+void BSP_Prof_Record(uint8_t id, uint32_t cycles);
+
+/**
+ * @brief  记录与上次标记之间的间隔
+ * @param  id: 探针编号
+ * @note   复位后的第一次标记只保存时刻，不产生样本
+ * @retval 无
+ */
+void BSP_Prof_Mark(uint8_t id);
+
+/**
+ * @brief  获取探针统计
+ * @param  id: 探针编号
+ * @param  probe: 输出统计结构体指针
+ * @retval 0=成功, -1=编号无效
+ */
+int BSP_Prof_Get(uint8_t id, ProfProbe_t *probe);
+
+/**
+ * @brief  清零探针统计
+ * @param  id: 探针编号，PROF_PROBE_COUNT表示全部
+ * @retval 无
+ */
+void BSP_Prof_Reset(uint8_t id);
+
+#endif /* PROF_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BSP_PROF_H */
@@ -68,6 +68,37 @@ HAL_StatusTypeDef BSP_SPI_Receive(uint8_t *data, uint16_t len);
  */
 HAL_StatusTypeDef BSP_SPI_TransmitReceiveBuffer(uint8_t *tx_data, uint8_t *rx_data, uint16_t len);
 
+/**
+ * @brief  SPI收发一个字节（寄存器直接操作）
+ * @param  tx_data: 要发送的数据
+ * @note   位于RAM中，不经过HAL，供DRDY中断在Flash擦写期间使用
+ * @retval 接收到的数据
+ */
+uint8_t BSP_SPI_TransferFast(uint8_t tx_data);
+
+/**
+ * @brief  主循环占用SPI总线
+ * @note   主循环中的每次片选事务（ADC寄存器读写、DAC写入）前调用，
+ *         占用期间到来的中断事务被延后到BSP_SPI_Unlock()
+ * @retval 无
+ */
+void BSP_SPI_Lock(void);
+
+/**
+ * @brief  主循环释放SPI总线
+ * @note   若占用期间有中断事务被延后，重新挂起该中断
+ * @retval 无
+ */
+void BSP_SPI_Unlock(void);
+
+/**
+ * @brief  中断中申请使用SPI总线
+ * @param  irq: 调用者的中断号，总线被占用时在释放后重新挂起
+ * @note   位于RAM中
+ * @retval 1=总线空闲可直接使用, 0=总线被主循环占用（已登记延后）
+ */
+uint8_t BSP_SPI_ClaimFromISR(IRQn_Type irq);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,77 @@
+/**
+ * @file    bsp_tim.h
+ * @brief   采样定时器板级支持包头文件
+ * @details 使用TIM2（32位）产生固定周期的ADC采样触发：
+ *          - 计数时钟1MHz，周期以μs为单位，范围1μs ~ 4294s
+ *          - 周期寄存器带预装载，运行中修改周期在下一次触发后生效
+ *          - 更新中断优先级与EXTI0(ADC_DRDY)相同，两者不会相互嵌套
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __BSP_TIM_H
+#define __BSP_TIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 采样定时器 */
+#define BSP_TIM_SAMPLE              TIM2
+#define BSP_TIM_SAMPLE_IRQn         TIM2_IRQn
+
+/* 计数时钟 (Hz) */
+#define BSP_TIM_TICK_HZ             1000000U
+
+/* 中断优先级（与EXTI0相同） */
+#define BSP_TIM_IRQ_PRIORITY        5
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  采样定时器初始化
+ * @param  period_us: 触发周期 (μs)
+ * @note   寄存器级配置，不启动计数；重复调用无副作用
+ * @retval 无
+ */
+void BSP_TIM_Init(uint32_t period_us);
+
+/**
+ * @brief  启动采样定时器
+ * @note   启动时立即产生一次触发，之后每个周期触发一次
+ * @retval 无
+ */
+void BSP_TIM_Start(void);
+
+/**
+ * @brief  停止采样定时器
+ * @retval 无
+ */
+void BSP_TIM_Stop(void);
+
+/**
+ * @brief  设置触发周期
+ * @param  period_us: 触发周期 (μs)
+ * @note   运行中修改在下一次触发后生效，不产生额外触发
+ * @retval 无
+ */
+void BSP_TIM_SetPeriod(uint32_t period_us);
+
+/**
+ * @brief  按当前APB1定时器时钟重新计算预分频
+ * @note   切换时钟档位后调用，新预分频在下一次触发后生效
+ * @retval 无
+ */
+void BSP_TIM_UpdateClock(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BSP_TIM_H */
@@ -0,0 +1,130 @@
+/**
+ * @file    bsp_trace.h
+ * @brief   事件跟踪环形缓冲区板级支持包头文件
+ * @details 在RAM中按时间顺序记录带CPU周期时间戳的事件，用于分析中断与主循环的时序：
+ *          - 每条记录8字节 {周期计数 u32, 事件 u16, 参数 u16}，满时覆盖最旧记录
+ *          - 事件 = 类型(高4位: 瞬时/开始/结束) | 事件编号(低12位)
+ *          - 中断和主循环均可记录，写入时短暂关中断保证记录完整
+ *          - 读出前先停止记录，读出完成后清空并重新开始
+ *          - 编译时定义TRACE_ENABLE=0则全部宏展开为空
+ *          周期计数32位，96MHz下约44.7s回绕一次，上位机按相邻记录间隔不超过
+ *          一个回绕周期展开时间戳
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __BSP_TRACE_H
+#define __BSP_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 事件跟踪总开关 */
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE            1
+#endif
+
+/* 缓冲区记录数（2的幂），占用RAM = 8 × TRACE_BUF_SIZE 字节 */
+#define TRACE_BUF_SIZE          512
+
+/* 事件类型（事件字段高4位） */
+#define TRACE_PHASE_INSTANT     0x0000U
+#define TRACE_PHASE_BEGIN       0x1000U
+#define TRACE_PHASE_END         0x2000U
+#define TRACE_ID_MASK           0x0FFFU
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 事件编号（上位机按此编号显示名称） */
+typedef enum {
+    TRACE_EVT_DRDY_IRQ = 1,     /* EXTI0 ADC数据就绪中断 */
+    TRACE_EVT_UART_IRQ,         /* USART6中断 */
+    TRACE_EVT_UART_RX_DMA_IRQ,  /* USART6接收DMA中断 */
+    TRACE_EVT_UART_TX_DMA_IRQ,  /* USART6发送DMA中断 */
+    TRACE_EVT_USB_IRQ,          /* USB OTG FS中断 */
+    TRACE_EVT_TASK,             /* 调度任务执行，参数=任务编号 */
+    TRACE_EVT_SAMPLE,           /* 主循环取出一个样本，参数=缓冲区序号 */
+    TRACE_EVT_FILTER,           /* 中值+滑动平均滤波 */
+    TRACE_EVT_LOOKUP,           /* 分度表查表 */
+    TRACE_EVT_COMM_CMD,         /* 处理一帧命令，参数=命令码 */
+    TRACE_EVT_DAC1_LOAD,        /* DAC1(电流源)加载，参数=码值 */
+    TRACE_EVT_DAC2_LOAD,        /* DAC2(4-20mA)加载，参数=码值 */
+    TRACE_EVT_LCD_UPDATE,       /* LCD刷新，参数=发送的控件掩码 */
+    TRACE_EVT_TIM_IRQ,          /* TIM2 ADC采样触发中断 */
+    TRACE_EVT_SLEEP,            /* 空闲WFI睡眠 */
+    TRACE_EVT_COUNT
+} TraceEventId_t;
+
+/* 跟踪记录 */
+typedef struct {
+    uint32_t cycles;            /* CPU周期计数 */
+    uint16_t event;             /* 事件类型 | 事件编号 */
+    uint16_t arg;               /* 事件参数 */
+} TraceEntry_t;
+
+/* 跟踪宏 --------------------------------------------------------------------*/
+
+#if TRACE_ENABLE
+
+#define TRACE_EVENT(id, arg)    BSP_Trace_Log(TRACE_PHASE_INSTANT | (id), (uint16_t)(arg))
+#define TRACE_BEGIN(id, arg)    BSP_Trace_Log(TRACE_PHASE_BEGIN | (id), (uint16_t)(arg))
+#define TRACE_END(id, arg)      BSP_Trace_Log(TRACE_PHASE_END | (id), (uint16_t)(arg))
+
+#else
+
+#define TRACE_EVENT(id, arg)    ((void)0)
+#define TRACE_BEGIN(id, arg)    ((void)0)
+#define TRACE_END(id, arg)      ((void)0)
+
+#endif /* TRACE_ENABLE */
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+#if TRACE_ENABLE
+
+/**
+ * @brief  记录一个事件
+ * @param  event: 事件类型 | 事件编号
+ * @param  arg: 事件参数
+ * @note   位于RAM中，Flash擦写期间的中断里也可调用；停止记录时直接返回
+ * @retval 无
+ */
+void BSP_Trace_Log(uint16_t event, uint16_t arg);
+
+/**
+ * @brief  停止记录（读出前调用）
+ * @param  count: 输出缓冲区中有效记录数
+ * @param  lost: 输出被覆盖的记录数
+ * @retval 无
+ */
+void BSP_Trace_Stop(uint16_t *count, uint32_t *lost);
+
+/**
+ * @brief  读取记录
+ * @param  index: 起始序号，0为最旧的一条
+ * @param  entries: 输出记录数组
+ * @param  max: 最多读取条数
+ * @retval 实际读取条数
+ */
+uint16_t BSP_Trace_Read(uint16_t index, TraceEntry_t *entries, uint16_t max);
+
+/**
+ * @brief  清空缓冲区并开始记录
+ * @retval 无
+ */
+void BSP_Trace_Restart(void);
+
+#endif /* TRACE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BSP_TRACE_H */
@@ -2,6 +2,8 @@
  * @file    bsp_uart.h
  * @brief   UART板级支持包头文件
  * @details 提供USART6通讯函数，用于LCD串口屏通讯
+ *          - 接收: DMA循环模式 + 空闲线路(IDLE)中断，按数据块更新写入位置
+ *          - 发送: 软件发送队列 + DMA，发送函数只入队不阻塞
  * @author  Ultra-TM02 开发团队
  * @version V1.0
  * @date    2025-12-18
@@ -20,10 +22,16 @@ extern "C" {
 
 /* 宏定义 --------------------------------------------------------------------*/
 
-/* UART接收缓冲区大小 */
+/* UART接收缓冲区大小（即DMA循环接收缓冲区） */
 #define UART_RX_BUFFER_SIZE     256
 
-/* UART发送超时时间 (ms) */
+/* UART发送队列大小，需能容纳LCD一次完整刷新 */
+#define UART_TX_BUFFER_SIZE     512
+
+/* BSP_UART_Printf格式化缓冲区大小（栈上分配） */
+#define UART_PRINTF_BUFFER_SIZE 96
+
+/* 等待发送队列排空的超时时间 (ms) */
 #define UART_TX_TIMEOUT         1000
 
 /* 类型定义 ------------------------------------------------------------------*/
@@ -35,30 +43,52 @@ extern UART_HandleTypeDef huart6;
 
 /**
  * @brief  UART初始化
- * @note   CubeIDE已自动初始化，此函数启用接收中断
+ * @note   CubeIDE已自动初始化USART6及其DMA通道，此函数启动DMA循环接收
  * @retval 无
  */
 void BSP_UART_Init(void);
 
 /**
- * @brief  UART发送数据
+ * @brief  UART发送数据（非阻塞）
  * @param  data: 数据缓冲区指针
  * @param  len: 数据长度
- * @retval HAL状态
+ * @note   数据被复制到发送队列后立即返回，调用者可立即复用缓冲区
+ * @retval HAL_OK: 已入队, HAL_BUSY: 队列剩余空间不足（整包丢弃）
  */
 HAL_StatusTypeDef BSP_UART_Transmit(uint8_t *data, uint16_t len);
 
 /**
- * @brief  UART发送字符串
+ * @brief  UART发送字符串（非阻塞）
  * @param  str: 字符串指针
  * @retval 无
  */
 void BSP_UART_SendString(const char *str);
 
+/**
+ * @brief  获取发送队列剩余空间
+ * @retval 可入队的字节数
+ */
+uint16_t BSP_UART_GetTxFree(void);
+
+/**
+ * @brief  检查发送是否全部完成
+ * @retval 1: 队列为空且DMA空闲, 0: 正在发送
+ */
+uint8_t BSP_UART_IsTxIdle(void);
+
+/**
+ * @brief  等待发送队列排空
+ * @param  timeout: 超时时间 (ms)
+ * @retval HAL_OK: 已排空, HAL_TIMEOUT: 超时
+ */
+HAL_StatusTypeDef BSP_UART_FlushTx(uint32_t timeout);
+
 /**
  * @brief  UART发送格式化字符串
  * @param  fmt: 格式化字符串
  * @param  ...: 可变参数
+ * @note   仅用于调试输出，显示路径请使用svc_fmt格式化数字，
+ *         避免链接浮点printf；超过UART_PRINTF_BUFFER_SIZE的输出被截断
  * @retval 无
  */
 void BSP_UART_Printf(const char *fmt, ...);
@@ -90,11 +120,26 @@ uint16_t BSP_UART_ReadBuffer(uint8_t *data, uint16_t max_len);
 void BSP_UART_FlushRxBuffer(void);
 
 /**
- * @brief  UART接收中断回调（在中断处理函数中调用）
- * @param  data: 接收到的数据
+ * @brief  获取接收溢出次数
+ * @note   读取过慢导致DMA覆盖未读数据时累加
+ * @retval 溢出次数
+ */
+uint32_t BSP_UART_GetRxOverrun(void);
+
+/**
+ * @brief  按当前APB2时钟重新计算波特率
+ * @note   切换时钟档位后调用；正在发送的字节可能出错，调用前应等待发送完成
+ * @retval 无
+ */
+void BSP_UART_UpdateClock(void);
+
+/**
+ * @brief  UART接收事件回调（在中断中调用）
+ * @note   DMA半满/全满或线路空闲时由HAL_UARTEx_RxEventCallback调用
+ * @param  pos: DMA缓冲区当前写入位置 (1 ~ UART_RX_BUFFER_SIZE)
  * @retval 无
  */
-void BSP_UART_RxCallback(uint8_t data);
+void BSP_UART_RxEventCallback(uint16_t pos);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,56 @@
+/**
+ * @file    bsp_dwt.c
+ * @brief   DWT周期计数器板级支持包源文件
+ * @details 实现基于Cortex-M4 DWT->CYCCNT的微秒级延时和周期计时功能
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "bsp_dwt.h"
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  DWT周期计数器初始化
+ * @retval 无
+ */
+void BSP_DWT_Init(void)
+{
+    /* 使能跟踪模块（DWT需要TRCENA） */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    
+    /* 启动周期计数器 */
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
+
+/**
+ * @brief  微秒级忙等待延时
+ * @param  us: 延时时间 (μs)
+ * @retval 无
+ */
+void BSP_DWT_DelayUs(uint32_t us)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t ticks = us * (SystemCoreClock / 1000000U);
+    
+    /* 无符号减法自动处理计数器回绕 */
+    while ((DWT->CYCCNT - start) < ticks)
+    {
+    }
+}
+
+/**
+ * @brief  周期数转换为微秒
+ * @param  cycles: CPU周期数
+ * @retval 时间 (μs)
+ */
+uint32_t BSP_DWT_CyclesToUs(uint32_t cycles)
+{
+    return cycles / (SystemCoreClock / 1000000U);
+}
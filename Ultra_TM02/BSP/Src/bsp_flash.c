@@ -9,10 +9,80 @@
 
 /* 包含头文件 ----------------------------------------------------------------*/
 #include "bsp_flash.h"
+#include "bsp_dwt.h"
 #include <string.h>
 
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* Flash错误标志 */
+#define FLASH_SR_ERRORS         (FLASH_SR_OPERR | FLASH_SR_WRPERR | FLASH_SR_PGAERR | \
+                                 FLASH_SR_PGPERR | FLASH_SR_PGSERR)
+
 /* 私有变量 ------------------------------------------------------------------*/
 
+/* CRC32查找表（多项式0xEDB88320，反射，与zlib.crc32一致） */
+static const uint32_t crc32_table[256] = {
+    0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F,
+    0xE963A535, 0x9E6495A3, 0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988,
+    0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91, 0x1DB71064, 0x6AB020F2,
+    0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
+    0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9,
+    0xFA0F3D63, 0x8D080DF5, 0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172,
+    0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B, 0x35B5A8FA, 0x42B2986C,
+    0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
+    0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423,
+    0xCFBA9599, 0xB8BDA50F, 0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924,
+    0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D, 0x76DC4190, 0x01DB7106,
+    0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
+    0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D,
+    0x91646C97, 0xE6635C01, 0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E,
+    0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457, 0x65B0D9C6, 0x12B7E950,
+    0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
+    0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7,
+    0xA4D1C46D, 0xD3D6F4FB, 0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0,
+    0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9, 0x5005713C, 0x270241AA,
+    0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
+    0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81,
+    0xB7BD5C3B, 0xC0BA6CAD, 0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A,
+    0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683, 0xE3630B12, 0x94643B84,
+    0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
+    0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB,
+    0x196C3671, 0x6E6B06E7, 0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC,
+    0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5, 0xD6D6A3E8, 0xA1D1937E,
+    0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
+    0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55,
+    0x316E8EEF, 0x4669BE79, 0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236,
+    0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F, 0xC5BA3BBE, 0xB2BD0B28,
+    0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
+    0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F,
+    0x72076785, 0x05005713, 0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38,
+    0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21, 0x86D3D2D4, 0xF1D4E242,
+    0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
+    0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69,
+    0x616BFFD3, 0x166CCF45, 0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2,
+    0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB, 0xAED16A4A, 0xD9D65ADC,
+    0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
+    0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693,
+    0x54DE5729, 0x23D967BF, 0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94,
+    0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
+};
+
+/* SRAM中的中断向量表（VTOR要求按表大小的2次幂对齐） */
+static uint32_t ram_vectors[FLASH_VECTOR_COUNT] __attribute__((aligned(512)));
+
+/* Flash忙标志（擦除或分步编程进行中） */
+static volatile uint8_t flash_busy = 0;
+
+/* 分步编程状态 */
+static uint32_t prog_addr = 0;              /* 目标起始地址 */
+static const uint8_t *prog_data = NULL;     /* 源数据 */
+static uint32_t prog_len = 0;               /* 总长度 */
+static uint32_t prog_done = 0;              /* 已编程字节数 */
+static FlashStatus_t prog_status = FLASH_OK;
+
+/* 操作统计 */
+static FlashStats_t flash_stats = {0};
+
 /* 私有函数 ------------------------------------------------------------------*/
 
 /**
@@ -42,8 +112,238 @@ static int32_t GetSector(uint32_t addr)
         return -1;  /* 无效地址 */
 }
 
+/**
+ * @brief  在RAM中执行扇区擦除并等待完成
+ * @param  sector: 扇区号
+ * @note   擦除期间Flash不可取指，本函数及其等待循环必须全部位于RAM；
+ *         通过BASEPRI屏蔽处理函数在Flash中的中断，等待时WFI由SysTick唤醒
+ * @retval 擦除结束时的FLASH->SR
+ */
+static RAMFUNC uint32_t Flash_RamErase(uint32_t sector)
+{
+    uint32_t basepri = __get_BASEPRI();
+    uint32_t sr;
+    
+    __set_BASEPRI(FLASH_ERASE_BASEPRI << (8U - __NVIC_PRIO_BITS));
+    
+    while (FLASH->SR & FLASH_SR_BSY)
+    {
+    }
+    
+    /* 32位并行擦除 (2.7V-3.6V) */
+    FLASH->CR &= ~(FLASH_CR_PSIZE | FLASH_CR_SNB);
+    FLASH->CR |= FLASH_CR_PSIZE_1 | FLASH_CR_SER | (sector << FLASH_CR_SNB_Pos);
+    FLASH->CR |= FLASH_CR_STRT;
+    
+    while (FLASH->SR & FLASH_SR_BSY)
+    {
+        __WFI();
+    }
+    
+    FLASH->CR &= ~(FLASH_CR_SER | FLASH_CR_SNB);
+    sr = FLASH->SR;
+    
+    __set_BASEPRI(basepri);
+    
+    return sr;
+}
+
+/**
+ * @brief  擦写后刷新ART指令/数据缓存
+ * @note   与HAL中FLASH_FlushCaches()相同，避免读到擦除前的缓存内容
+ * @retval 无
+ */
+static void Flash_FlushCaches(void)
+{
+    if (FLASH->ACR & FLASH_ACR_ICEN)
+    {
+        __HAL_FLASH_INSTRUCTION_CACHE_DISABLE();
+        __HAL_FLASH_INSTRUCTION_CACHE_RESET();
+        __HAL_FLASH_INSTRUCTION_CACHE_ENABLE();
+    }
+    
+    if (FLASH->ACR & FLASH_ACR_DCEN)
+    {
+        __HAL_FLASH_DATA_CACHE_DISABLE();
+        __HAL_FLASH_DATA_CACHE_RESET();
+        __HAL_FLASH_DATA_CACHE_ENABLE();
+    }
+}
+
+/**
+ * @brief  CRC32累加一个字（小端字节序）
+ * @param  crc: 当前CRC中间值
+ * @param  word: 数据字
+ * @retval 新的CRC中间值
+ */
+static inline uint32_t Flash_CRC32Word(uint32_t crc, uint32_t word)
+{
+    crc ^= word;
+    crc = (crc >> 8) ^ crc32_table[crc & 0xFF];
+    crc = (crc >> 8) ^ crc32_table[crc & 0xFF];
+    crc = (crc >> 8) ^ crc32_table[crc & 0xFF];
+    crc = (crc >> 8) ^ crc32_table[crc & 0xFF];
+    
+    return crc;
+}
+
+/**
+ * @brief  CRC32累加若干字节
+ * @param  crc: 当前CRC中间值
+ * @param  data: 数据指针
+ * @param  len: 字节数
+ * @retval 新的CRC中间值
+ */
+static uint32_t Flash_CRC32Bytes(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    while (len--)
+    {
+        crc = (crc >> 8) ^ crc32_table[(crc ^ *data++) & 0xFF];
+    }
+    
+    return crc;
+}
+
+/**
+ * @brief  连续编程若干字并回读校验
+ * @param  addr: 目标地址（4字节对齐）
+ * @param  src: 源数据，4字节对齐时按字直接读取，否则逐字拷贝
+ * @param  words: 字数（不超过FLASH_PROGRAM_CHUNK，控制单次停顿）
+ * @param  crc: 输入/输出回读数据的CRC32中间值，NULL表示不累加
+ * @note   PG位在整块编程期间保持置位，不逐字经过HAL_FLASH_Program的
+ *         等待/清标志流程；回读按字与源数据比较，同一遍累加CRC，
+ *         CRC反映Flash中的实际内容，由调用者在写入结束时与期望值比对
+ * @retval Flash操作状态
+ */
+static FlashStatus_t Flash_ProgramChunk(uint32_t addr, const uint8_t *src, uint32_t words, uint32_t *crc)
+{
+    volatile uint32_t *dst = (volatile uint32_t *)addr;
+    uint32_t aligned = (((uint32_t)src & 0x3) == 0);
+    uint32_t crc_acc = (crc != NULL) ? *crc : 0;
+    uint32_t start;
+    uint32_t elapsed_us;
+    uint32_t word;
+    uint32_t readback;
+    uint32_t sr = 0;
+    uint32_t i;
+    
+    start = BSP_DWT_GetCycles();
+    
+    /* 解锁Flash */
+    HAL_FLASH_Unlock();
+    
+    /* 清除错误标志 */
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | 
+                           FLASH_FLAG_WRPERR | FLASH_FLAG_PGAERR | 
+                           FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+    
+    FLASH->CR &= ~FLASH_CR_PSIZE;
+    FLASH->CR |= FLASH_PROGRAM_PSIZE | FLASH_CR_PG;
+    
+    for (i = 0; i < words; i++)
+    {
+        if (aligned)
+        {
+            word = ((const uint32_t *)src)[i];
+        }
+        else
+        {
+            memcpy(&word, &src[i * 4], 4);
+        }
+        
+        dst[i] = word;
+        
+        while (FLASH->SR & FLASH_SR_BSY)
+        {
+        }
+        
+        sr = FLASH->SR;
+        if (sr & FLASH_SR_ERRORS)
+        {
+            break;
+        }
+    }
+    
+    FLASH->CR &= ~FLASH_CR_PG;
+    
+    /* 锁定Flash */
+    HAL_FLASH_Lock();
+    
+    flash_stats.program_words += i;
+    elapsed_us = BSP_DWT_CyclesToUs(BSP_DWT_GetCycles() - start);
+    if (elapsed_us > flash_stats.program_chunk_max_us)
+    {
+        flash_stats.program_chunk_max_us = elapsed_us;
+    }
+    
+    if (sr & FLASH_SR_ERRORS)
+    {
+        return FLASH_ERROR_PROGRAM;
+    }
+    
+    /* 回读校验本块 */
+    for (i = 0; i < words; i++)
+    {
+        readback = dst[i];
+        
+        if (aligned)
+        {
+            word = ((const uint32_t *)src)[i];
+        }
+        else
+        {
+            memcpy(&word, &src[i * 4], 4);
+        }
+        
+        if (readback != word)
+        {
+            return FLASH_ERROR_VERIFY;
+        }
+        
+        if (crc != NULL)
+        {
+            crc_acc = Flash_CRC32Word(crc_acc, readback);
+        }
+    }
+    
+    if (crc != NULL)
+    {
+        *crc = crc_acc;
+    }
+    
+    return FLASH_OK;
+}
+
 /* 公共函数 ------------------------------------------------------------------*/
 
+/**
+ * @brief  Flash驱动初始化
+ * @retval 无
+ */
+void BSP_Flash_Init(void)
+{
+    const uint32_t *src = (const uint32_t *)SCB->VTOR;
+    uint32_t primask;
+    uint32_t i;
+    
+    /* 已重定位则跳过 */
+    if (src == ram_vectors)
+    {
+        return;
+    }
+    
+    for (i = 0; i < FLASH_VECTOR_COUNT; i++)
+    {
+        ram_vectors[i] = src[i];
+    }
+    
+    primask = __get_PRIMASK();
+    __disable_irq();
+    SCB->VTOR = (uint32_t)ram_vectors;
+    __DSB();
+    __set_PRIMASK(primask);
+}
+
 /**
  * @brief  擦除指定扇区
  * @param  sector: 扇区号 (FLASH_SECTOR_0 - FLASH_SECTOR_7)
@@ -51,9 +351,16 @@ static int32_t GetSector(uint32_t addr)
  */
 FlashStatus_t BSP_Flash_EraseSector(uint32_t sector)
 {
-    FLASH_EraseInitTypeDef erase_init;
-    uint32_t sector_error = 0;
-    HAL_StatusTypeDef status;
+    uint32_t start;
+    uint32_t elapsed_us;
+    uint32_t sr;
+    
+    /* 分步编程未完成时不允许擦除 */
+    if (flash_busy)
+    {
+        return FLASH_ERROR_BUSY;
+    }
+    flash_busy = 1;
     
     /* 解锁Flash */
     HAL_FLASH_Unlock();
@@ -63,19 +370,24 @@ FlashStatus_t BSP_Flash_EraseSector(uint32_t sector)
                            FLASH_FLAG_WRPERR | FLASH_FLAG_PGAERR | 
                            FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
     
-    /* 配置擦除参数 */
-    erase_init.TypeErase = FLASH_TYPEERASE_SECTORS;
-    erase_init.VoltageRange = FLASH_VOLTAGE_RANGE_3;  /* 2.7V-3.6V */
-    erase_init.Sector = sector;
-    erase_init.NbSectors = 1;
-    
-    /* 执行擦除 */
-    status = HAL_FLASHEx_Erase(&erase_init, &sector_error);
+    /* 在RAM中执行擦除 */
+    start = BSP_DWT_GetCycles();
+    sr = Flash_RamErase(sector);
+    elapsed_us = BSP_DWT_CyclesToUs(BSP_DWT_GetCycles() - start);
     
     /* 锁定Flash */
     HAL_FLASH_Lock();
     
-    if (status != HAL_OK)
+    Flash_FlushCaches();
+    flash_busy = 0;
+    
+    flash_stats.erase_count++;
+    if (elapsed_us > flash_stats.erase_max_us)
+    {
+        flash_stats.erase_max_us = elapsed_us;
+    }
+    
+    if (sr & FLASH_SR_ERRORS)
     {
         return FLASH_ERROR_ERASE;
     }
@@ -92,57 +404,345 @@ FlashStatus_t BSP_Flash_EraseSector(uint32_t sector)
  */
 FlashStatus_t BSP_Flash_Write(uint32_t addr, uint8_t *data, uint32_t len)
 {
-    HAL_StatusTypeDef status;
-    uint32_t i;
-    uint32_t word;
+    FlashStatus_t status;
     
+    status = BSP_Flash_ProgramAsync(addr, data, len);
+    if (status != FLASH_OK)
+    {
+        return status;
+    }
+    
+    /* 分块编程直到完成，块之间中断可正常响应 */
+    while (prog_status == FLASH_ERROR_BUSY)
+    {
+        BSP_Flash_Process();
+    }
+    
+    return prog_status;
+}
+
+/**
+ * @brief  启动分步编程
+ * @param  addr: 目标地址（必须4字节对齐）
+ * @param  data: 数据缓冲区指针（编程完成前必须保持有效）
+ * @param  len: 数据长度（字节数）
+ * @retval FLASH_OK=已启动, FLASH_ERROR_BUSY=上一操作未完成, FLASH_ERROR_ADDR=地址无效
+ */
+FlashStatus_t BSP_Flash_ProgramAsync(uint32_t addr, const uint8_t *data, uint32_t len)
+{
     /* 检查地址是否有效 */
-    if (GetSector(addr) < 0)
+    if (GetSector(addr) < 0 || (addr & 0x3) != 0)
     {
         return FLASH_ERROR_ADDR;
     }
     
-    /* 解锁Flash */
-    HAL_FLASH_Unlock();
+    if (flash_busy)
+    {
+        return FLASH_ERROR_BUSY;
+    }
     
-    /* 清除错误标志 */
-    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | 
-                           FLASH_FLAG_WRPERR | FLASH_FLAG_PGAERR | 
-                           FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+    prog_addr = addr;
+    prog_data = data;
+    prog_len = len;
+    prog_done = 0;
+    prog_status = (len > 0) ? FLASH_ERROR_BUSY : FLASH_OK;
+    flash_busy = (len > 0) ? 1 : 0;
     
-    /* 按字（4字节）写入 */
-    for (i = 0; i < len; i += 4)
+    return FLASH_OK;
+}
+
+/**
+ * @brief  打开流式写入
+ * @param  writer: 写入上下文
+ * @param  addr: 起始地址（必须4字节对齐，目标区域需已擦除）
+ * @param  max_len: 最大写入长度（字节数）
+ * @retval FLASH_OK=已打开, FLASH_ERROR_ADDR=地址无效, FLASH_ERROR_BUSY=分步编程未完成
+ */
+FlashStatus_t BSP_Flash_StreamOpen(FlashWriter_t *writer, uint32_t addr, uint32_t max_len)
+{
+    memset(writer, 0, sizeof(FlashWriter_t));
+    writer->status = FLASH_ERROR_ADDR;
+    
+    /* 检查起止地址是否有效 */
+    if (max_len == 0 || (addr & 0x3) != 0 ||
+        GetSector(addr) < 0 || GetSector(addr + max_len - 1) < 0)
     {
-        /* 组合4字节为一个字 */
-        word = 0;
-        if (i < len) word |= data[i];
-        if (i + 1 < len) word |= ((uint32_t)data[i + 1] << 8);
-        if (i + 2 < len) word |= ((uint32_t)data[i + 2] << 16);
-        if (i + 3 < len) word |= ((uint32_t)data[i + 3] << 24);
+        return FLASH_ERROR_ADDR;
+    }
+    
+    if (flash_busy)
+    {
+        writer->status = FLASH_ERROR_BUSY;
+        return FLASH_ERROR_BUSY;
+    }
+    
+    writer->start = addr;
+    writer->end = addr + max_len;
+    writer->addr = addr;
+    writer->crc = 0xFFFFFFFF;
+    writer->status = FLASH_OK;
+    
+    return FLASH_OK;
+}
+
+/**
+ * @brief  追加写入数据
+ * @param  writer: 写入上下文
+ * @param  data: 数据缓冲区指针
+ * @param  len: 数据长度（字节数）
+ * @retval Flash操作状态
+ */
+FlashStatus_t BSP_Flash_StreamAppend(FlashWriter_t *writer, const uint8_t *data, uint32_t len)
+{
+    FlashStatus_t status = FLASH_OK;
+    uint32_t words;
+    
+    if (writer->status != FLASH_OK)
+    {
+        return writer->status;
+    }
+    
+    if (len > writer->end - writer->addr - writer->pending_len)
+    {
+        writer->status = FLASH_ERROR_ADDR;
+        return FLASH_ERROR_ADDR;
+    }
+    
+    /* 分步编程进行中，本次不写入，可稍后重试 */
+    if (flash_busy)
+    {
+        return FLASH_ERROR_BUSY;
+    }
+    flash_busy = 1;
+    
+    /* 先补齐上次剩余的暂存字 */
+    if (writer->pending_len > 0)
+    {
+        while (writer->pending_len < 4 && len > 0)
+        {
+            ((uint8_t *)&writer->pending)[writer->pending_len++] = *data++;
+            len--;
+        }
+        
+        if (writer->pending_len == 4)
+        {
+            status = Flash_ProgramChunk(writer->addr, (const uint8_t *)&writer->pending, 1, &writer->crc);
+            writer->addr += 4;
+            writer->pending_len = 0;
+        }
+    }
+    
+    /* 整字直接从源缓冲区编程 */
+    while (status == FLASH_OK && len >= 4)
+    {
+        words = len / 4;
+        if (words > FLASH_PROGRAM_CHUNK)
+        {
+            words = FLASH_PROGRAM_CHUNK;
+        }
         
-        /* 写入一个字 */
-        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + i, word);
+        status = Flash_ProgramChunk(writer->addr, data, words, &writer->crc);
+        writer->addr += words * 4;
+        data += words * 4;
+        len -= words * 4;
+    }
+    
+    /* 尾部不足一字的字节暂存 */
+    while (status == FLASH_OK && len > 0)
+    {
+        ((uint8_t *)&writer->pending)[writer->pending_len++] = *data++;
+        len--;
+    }
+    
+    flash_busy = 0;
+    writer->status = status;
+    
+    return status;
+}
+
+/**
+ * @brief  结束流式写入
+ * @param  writer: 写入上下文
+ * @param  crc: 输出全部写入数据的CRC32，可为NULL
+ * @retval Flash操作状态
+ */
+FlashStatus_t BSP_Flash_StreamFinish(FlashWriter_t *writer, uint32_t *crc)
+{
+    uint32_t word;
+    uint32_t i;
+    
+    if (writer->status == FLASH_OK && writer->pending_len > 0)
+    {
+        if (flash_busy)
+        {
+            return FLASH_ERROR_BUSY;
+        }
+        flash_busy = 1;
         
-        if (status != HAL_OK)
+        /* 补齐字节保持擦除态 */
+        word = 0xFFFFFFFF;
+        for (i = 0; i < writer->pending_len; i++)
         {
-            HAL_FLASH_Lock();
-            return FLASH_ERROR_PROGRAM;
+            ((uint8_t *)&word)[i] = ((uint8_t *)&writer->pending)[i];
         }
+        
+        writer->status = Flash_ProgramChunk(writer->addr, (const uint8_t *)&word, 1, NULL);
+        writer->crc = Flash_CRC32Bytes(writer->crc, (const uint8_t *)writer->addr, writer->pending_len);
+        writer->addr += 4;
+        writer->pending_len = 0;
+        
+        flash_busy = 0;
     }
     
-    /* 锁定Flash */
-    HAL_FLASH_Lock();
+    if (crc != NULL)
+    {
+        *crc = ~writer->crc;
+    }
+    
+    return writer->status;
+}
+
+/**
+ * @brief  Flash分步编程处理（主循环中调用）
+ * @note   每次最多编程FLASH_PROGRAM_CHUNK个字并校验，单次停顿约0.3ms
+ * @retval 无
+ */
+void BSP_Flash_Process(void)
+{
+    FlashStatus_t status;
+    uint32_t remain;
+    uint32_t words;
+    uint32_t word;
     
-    /* 校验写入的数据 */
-    for (i = 0; i < len; i++)
+    if (prog_status != FLASH_ERROR_BUSY)
     {
-        if (*((uint8_t *)(addr + i)) != data[i])
+        return;
+    }
+    
+    remain = prog_len - prog_done;
+    words = remain / 4;
+    
+    if (words > 0)
+    {
+        /* 整字直接从源缓冲区编程 */
+        if (words > FLASH_PROGRAM_CHUNK)
         {
-            return FLASH_ERROR_VERIFY;
+            words = FLASH_PROGRAM_CHUNK;
         }
+        
+        status = Flash_ProgramChunk(prog_addr + prog_done, &prog_data[prog_done], words, NULL);
+        prog_done += words * 4;
+    }
+    else
+    {
+        /* 末尾不足一字，补0后写入 */
+        word = 0;
+        memcpy(&word, &prog_data[prog_done], remain);
+        
+        status = Flash_ProgramChunk(prog_addr + prog_done, (const uint8_t *)&word, 1, NULL);
+        prog_done = prog_len;
     }
     
-    return FLASH_OK;
+    if (status != FLASH_OK)
+    {
+        prog_status = status;
+        flash_busy = 0;
+        return;
+    }
+    
+    if (prog_done >= prog_len)
+    {
+        prog_status = FLASH_OK;
+        flash_busy = 0;
+    }
+}
+
+/**
+ * @brief  按FLASH_ACCEL_BOOT配置ART加速器
+ * @retval 无
+ */
+void BSP_Flash_AccelInit(void)
+{
+    BSP_Flash_SetAccel(0);
+    BSP_Flash_SetAccel(FLASH_ACCEL_BOOT);
+}
+
+/**
+ * @brief  设置ART加速器
+ * @param  flags: FLASH_ACCEL_xxx组合
+ * @retval 设置前的FLASH_ACCEL_xxx组合
+ */
+uint32_t BSP_Flash_SetAccel(uint32_t flags)
+{
+    uint32_t acr = FLASH->ACR & ~FLASH_ACCEL_ALL;
+    uint32_t old = FLASH->ACR & FLASH_ACCEL_ALL;
+    uint32_t reset = 0;
+    
+    if ((flags & FLASH_ACCEL_ICACHE) && !(old & FLASH_ACCEL_ICACHE))
+    {
+        reset |= FLASH_ACR_ICRST;
+    }
+    if ((flags & FLASH_ACCEL_DCACHE) && !(old & FLASH_ACCEL_DCACHE))
+    {
+        reset |= FLASH_ACR_DCRST;
+    }
+    
+    /* 缓存只能在关闭状态下复位 */
+    FLASH->ACR = acr;
+    if (reset)
+    {
+        FLASH->ACR = acr | reset;
+        FLASH->ACR = acr;
+    }
+    FLASH->ACR = acr | (flags & FLASH_ACCEL_ALL);
+    
+    return old;
+}
+
+/**
+ * @brief  获取ART加速器配置
+ * @retval FLASH_ACCEL_xxx组合
+ */
+uint32_t BSP_Flash_GetAccel(void)
+{
+    return FLASH->ACR & FLASH_ACCEL_ALL;
+}
+
+/**
+ * @brief  获取分步编程状态
+ * @retval FLASH_ERROR_BUSY=进行中, FLASH_OK=已完成, 其他=失败原因
+ */
+FlashStatus_t BSP_Flash_GetAsyncStatus(void)
+{
+    return prog_status;
+}
+
+/**
+ * @brief  检查Flash是否正在擦除或编程
+ * @retval 1=忙, 0=空闲
+ */
+RAMFUNC uint8_t BSP_Flash_IsBusy(void)
+{
+    return flash_busy;
+}
+
+/**
+ * @brief  获取Flash操作统计
+ * @param  stats: 输出统计结构体指针
+ * @retval 无
+ */
+void BSP_Flash_GetStats(FlashStats_t *stats)
+{
+    *stats = flash_stats;
+}
+
+/**
+ * @brief  清零Flash操作统计
+ * @retval 无
+ */
+void BSP_Flash_ResetStats(void)
+{
+    memset(&flash_stats, 0, sizeof(flash_stats));
 }
 
 /**
@@ -184,6 +784,29 @@ FlashStatus_t BSP_Flash_EraseParam(void)
     return BSP_Flash_EraseSector(FLASH_PARAM_SECTOR);
 }
 
+/**
+ * @brief  检查数据日志区域是否可用
+ * @retval 1=可用, 0=不可用
+ */
+uint8_t BSP_Flash_LogAvailable(void)
+{
+    return (FIRMWARE_IMAGE_END <= FLASH_LOG_START) ? 1 : 0;
+}
+
+/**
+ * @brief  擦除数据日志区域
+ * @retval Flash操作状态
+ */
+FlashStatus_t BSP_Flash_EraseLog(void)
+{
+    if (!BSP_Flash_LogAvailable())
+    {
+        return FLASH_ERROR_ADDR;
+    }
+    
+    return BSP_Flash_EraseSector(FLASH_LOG_SECTOR);
+}
+
 /**
  * @brief  写入分度表数据
  * @param  offset: 相对于分度表区域起始地址的偏移
@@ -263,3 +886,43 @@ FlashStatus_t BSP_Flash_ReadParam(uint32_t offset, uint8_t *data, uint32_t len)
     
     return BSP_Flash_Read(addr, data, len);
 }
+
+/**
+ * @brief  写入数据日志
+ * @param  offset: 相对于数据日志区域起始地址的偏移
+ * @param  data: 数据缓冲区指针
+ * @param  len: 数据长度
+ * @retval Flash操作状态
+ */
+FlashStatus_t BSP_Flash_WriteLog(uint32_t offset, uint8_t *data, uint32_t len)
+{
+    uint32_t addr = FLASH_LOG_START + offset;
+    
+    /* 检查是否超出数据日志区域，或固件映像占用了日志区域 */
+    if (addr + len > FLASH_LOG_END + 1 || !BSP_Flash_LogAvailable())
+    {
+        return FLASH_ERROR_ADDR;
+    }
+    
+    return BSP_Flash_Write(addr, data, len);
+}
+
+/**
+ * @brief  读取数据日志
+ * @param  offset: 相对于数据日志区域起始地址的偏移
+ * @param  data: 数据缓冲区指针
+ * @param  len: 数据长度
+ * @retval Flash操作状态
+ */
+FlashStatus_t BSP_Flash_ReadLog(uint32_t offset, uint8_t *data, uint32_t len)
+{
+    uint32_t addr = FLASH_LOG_START + offset;
+    
+    /* 检查是否超出数据日志区域 */
+    if (addr + len > FLASH_LOG_END + 1)
+    {
+        return FLASH_ERROR_ADDR;
+    }
+    
+    return BSP_Flash_Read(addr, data, len);
+}
@@ -41,17 +41,18 @@ void BSP_GPIO_Init(void)
  * @param  state: 0=选中(低电平), 1=取消选中(高电平)
  * @retval 无
  */
-void BSP_ADC_CS(uint8_t state)
+RAMFUNC void BSP_ADC_CS(uint8_t state)
 {
+    /* 在RAM中执行（DRDY中断使用），直接写BSRR */
     if (state)
     {
         /* 取消选中 - 高电平 */
-        HAL_GPIO_WritePin(ADC1_CS_GPIO_Port, ADC1_CS_Pin, GPIO_PIN_SET);
+        ADC1_CS_GPIO_Port->BSRR = ADC1_CS_Pin;
     }
     else
     {
         /* 选中 - 低电平 */
-        HAL_GPIO_WritePin(ADC1_CS_GPIO_Port, ADC1_CS_Pin, GPIO_PIN_RESET);
+        ADC1_CS_GPIO_Port->BSRR = (uint32_t)ADC1_CS_Pin << 16U;
     }
 }
 
@@ -164,10 +165,10 @@ void BSP_LED_Toggle(void)
  * @brief  读取ADC数据就绪状态
  * @retval 1=数据就绪(DRDY为低电平), 0=未就绪(DRDY为高电平)
  */
-uint8_t BSP_ADC_IsDataReady(void)
+RAMFUNC uint8_t BSP_ADC_IsDataReady(void)
 {
-    /* DRDY低电平表示数据就绪 */
-    if (HAL_GPIO_ReadPin(ADC_DRDY_GPIO_Port, ADC_DRDY_Pin) == GPIO_PIN_RESET)
+    /* DRDY低电平表示数据就绪（在RAM中执行，直接读IDR） */
+    if ((ADC_DRDY_GPIO_Port->IDR & ADC_DRDY_Pin) == 0)
     {
         return 1;  /* 数据就绪 */
     }
@@ -0,0 +1,98 @@
+/**
+ * @file    bsp_power.c
+ * @brief   时钟档位与睡眠板级支持包源文件
+ * @details 实现AHB/APB分频切换和WFI睡眠计时
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "bsp_power.h"
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/* 档位配置 */
+typedef struct {
+    uint32_t ahb_div;           /* AHB分频 (RCC_SYSCLK_DIVx) */
+    uint32_t apb1_div;          /* APB1分频 (RCC_HCLK_DIVx)，APB1不超过50MHz */
+    uint32_t apb2_div;          /* APB2分频 (RCC_HCLK_DIVx) */
+    uint32_t latency;           /* Flash等待周期（3.3V供电） */
+} PowerProfileConfig_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 档位配置表 */
+static const PowerProfileConfig_t profile_table[POWER_PROFILE_COUNT] = {
+    [POWER_PROFILE_FULL]     = { RCC_SYSCLK_DIV1, RCC_HCLK_DIV2, RCC_HCLK_DIV1, FLASH_LATENCY_3 },
+    [POWER_PROFILE_BALANCED] = { RCC_SYSCLK_DIV2, RCC_HCLK_DIV1, RCC_HCLK_DIV1, FLASH_LATENCY_1 },
+    [POWER_PROFILE_LOW]      = { RCC_SYSCLK_DIV4, RCC_HCLK_DIV1, RCC_HCLK_DIV1, FLASH_LATENCY_0 },
+};
+
+/* 当前档位（与SystemClock_Config()一致） */
+static uint8_t current_profile = POWER_PROFILE_FULL;
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  切换时钟档位
+ * @param  profile: 时钟档位 (POWER_PROFILE_xxx)
+ * @retval 0=成功, -1=档位无效或时钟配置失败
+ */
+int BSP_Power_SetProfile(uint8_t profile)
+{
+    RCC_ClkInitTypeDef clk = {0};
+    const PowerProfileConfig_t *cfg;
+    
+    if (profile >= POWER_PROFILE_COUNT)
+    {
+        return -1;
+    }
+    if (profile == current_profile)
+    {
+        return 0;
+    }
+    
+    /* SYSCLK保持PLL不变，HAL按升降频顺序调整Flash等待周期 */
+    cfg = &profile_table[profile];
+    clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    clk.AHBCLKDivider = cfg->ahb_div;
+    clk.APB1CLKDivider = cfg->apb1_div;
+    clk.APB2CLKDivider = cfg->apb2_div;
+    
+    if (HAL_RCC_ClockConfig(&clk, cfg->latency) != HAL_OK)
+    {
+        return -1;
+    }
+    
+    current_profile = profile;
+    return 0;
+}
+
+/**
+ * @brief  获取当前时钟档位
+ * @retval 时钟档位
+ */
+uint8_t BSP_Power_GetProfile(void)
+{
+    return current_profile;
+}
+
+/**
+ * @brief  进入睡眠直到有中断挂起
+ * @retval 睡眠时长 (HCLK周期)
+ */
+uint32_t BSP_Power_Sleep(void)
+{
+    uint32_t reload = SysTick->LOAD + 1U;
+    uint32_t before;
+    uint32_t after;
+    
+    before = SysTick->VAL;
+    __DSB();
+    __WFI();
+    after = SysTick->VAL;
+    
+    /* SysTick递减计数，回绕即挂起中断并唤醒，睡眠期间最多回绕一次 */
+    return (before >= after) ? (before - after) : (before + reload - after);
+}
@@ -0,0 +1,146 @@
+/**
+ * @file    bsp_prof.c
+ * @brief   周期级性能探针板级支持包源文件
+ * @details 实现探针统计的记录、读取与清零
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "bsp_prof.h"
+
+#if PROF_ENABLE
+
+#include <string.h>
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 探针统计 */
+static ProfProbe_t prof_probes[PROF_PROBE_COUNT];
+
+/* PROF_MARK上次经过的时刻 */
+static uint32_t mark_cycles[PROF_PROBE_COUNT];
+static uint8_t mark_valid[PROF_PROBE_COUNT];
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  清零一个探针
+ * @param  id: 探针编号
+ * @retval 无
+ */
+static void Prof_Clear(uint8_t id)
+{
+    memset(&prof_probes[id], 0, sizeof(ProfProbe_t));
+    mark_valid[id] = 0;
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  记录一次测量
+ * @param  id: 探针编号
+ * @param  cycles: 执行周期数
+ * @retval 无
+ */
+void BSP_Prof_Record(uint8_t id, uint32_t cycles)
+{
+    ProfProbe_t *probe;
+    uint32_t bin;
+    
+    if (id >= PROF_PROBE_COUNT)
+    {
+        return;
+    }
+    
+    probe = &prof_probes[id];
+    
+    if (probe->count == 0 || cycles < probe->min_cycles)
+    {
+        probe->min_cycles = cycles;
+    }
+    if (cycles > probe->max_cycles)
+    {
+        probe->max_cycles = cycles;
+    }
+    if (probe->count != 0xFFFFFFFF)
+    {
+        probe->count++;
+    }
+    probe->sum_cycles += cycles;
+    
+    /* floor(log2(cycles))，CLZ单周期完成 */
+    bin = (cycles > 1) ? (31U - __CLZ(cycles)) : 0;
+    if (bin >= PROF_HIST_BINS)
+    {
+        bin = PROF_HIST_BINS - 1;
+    }
+    if (probe->hist[bin] != 0xFFFF)
+    {
+        probe->hist[bin]++;
+    }
+}
+
+/**
+ * @brief  记录与上次标记之间的间隔
+ * @param  id: 探针编号
+ * @retval 无
+ */
+void BSP_Prof_Mark(uint8_t id)
+{
+    uint32_t now = BSP_DWT_GetCycles();
+    
+    if (id >= PROF_PROBE_COUNT)
+    {
+        return;
+    }
+    
+    if (mark_valid[id])
+    {
+        BSP_Prof_Record(id, now - mark_cycles[id]);
+    }
+    mark_cycles[id] = now;
+    mark_valid[id] = 1;
+}
+
+/**
+ * @brief  获取探针统计
+ * @param  id: 探针编号
+ * @param  probe: 输出统计结构体指针
+ * @retval 0=成功, -1=编号无效
+ */
+int BSP_Prof_Get(uint8_t id, ProfProbe_t *probe)
+{
+    if (id >= PROF_PROBE_COUNT)
+    {
+        return -1;
+    }
+    
+    *probe = prof_probes[id];
+    
+    return 0;
+}
+
+/**
+ * @brief  清零探针统计
+ * @param  id: 探针编号，PROF_PROBE_COUNT表示全部
+ * @retval 无
+ */
+void BSP_Prof_Reset(uint8_t id)
+{
+    uint8_t i;
+    
+    if (id < PROF_PROBE_COUNT)
+    {
+        Prof_Clear(id);
+        return;
+    }
+    
+    for (i = 0; i < PROF_PROBE_COUNT; i++)
+    {
+        Prof_Clear(i);
+    }
+}
+
+#endif /* PROF_ENABLE */
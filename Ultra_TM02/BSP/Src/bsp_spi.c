@@ -12,6 +12,11 @@
 
 /* 私有变量 ------------------------------------------------------------------*/
 
+/* 总线仲裁 */
+static volatile uint8_t spi_locked = 0;         /* 主循环占用中 */
+static volatile uint8_t spi_deferred = 0;       /* 有中断事务被延后 */
+static volatile IRQn_Type spi_deferred_irq;     /* 被延后的中断号 */
+
 /* 私有函数 ------------------------------------------------------------------*/
 
 /* 公共函数 ------------------------------------------------------------------*/
@@ -30,7 +35,7 @@ void BSP_SPI_Init(void)
      * - 时钟极性: High (CPOL=1)
      * - 时钟相位: 2 Edge (CPHA=1)
      * - NSS: Software
-     * - 波特率预分频: 8 (PCLK2/8 = 100MHz/8 = 12.5MHz)
+     * - 波特率预分频: 8 (PCLK2/8，全速档96MHz/8 = 12MHz)
      * - 首位: MSB First
      */
     
@@ -90,3 +95,72 @@ HAL_StatusTypeDef BSP_SPI_TransmitReceiveBuffer(uint8_t *tx_data, uint8_t *rx_da
 {
     return HAL_SPI_TransmitReceive(&hspi1, tx_data, rx_data, len, BSP_SPI_TIMEOUT);
 }
+
+/**
+ * @brief  SPI收发一个字节（寄存器直接操作）
+ * @param  tx_data: 要发送的数据
+ * @retval 接收到的数据
+ */
+RAMFUNC uint8_t BSP_SPI_TransferFast(uint8_t tx_data)
+{
+    SPI_TypeDef *spi = hspi1.Instance;
+    
+    /* HAL首次传输前SPI可能尚未使能 */
+    if ((spi->CR1 & SPI_CR1_SPE) == 0)
+    {
+        spi->CR1 |= SPI_CR1_SPE;
+    }
+    
+    while ((spi->SR & SPI_SR_TXE) == 0)
+    {
+    }
+    *(__IO uint8_t *)&spi->DR = tx_data;
+    
+    while ((spi->SR & SPI_SR_RXNE) == 0)
+    {
+    }
+    
+    return *(__IO uint8_t *)&spi->DR;
+}
+
+/**
+ * @brief  主循环占用SPI总线
+ * @retval 无
+ */
+void BSP_SPI_Lock(void)
+{
+    spi_locked = 1;
+}
+
+/**
+ * @brief  主循环释放SPI总线
+ * @retval 无
+ */
+void BSP_SPI_Unlock(void)
+{
+    spi_locked = 0;
+    
+    /* 补发被延后的中断事务 */
+    if (spi_deferred)
+    {
+        spi_deferred = 0;
+        HAL_NVIC_SetPendingIRQ(spi_deferred_irq);
+    }
+}
+
+/**
+ * @brief  中断中申请使用SPI总线
+ * @param  irq: 调用者的中断号
+ * @retval 1=总线空闲可直接使用, 0=总线被主循环占用（已登记延后）
+ */
+RAMFUNC uint8_t BSP_SPI_ClaimFromISR(IRQn_Type irq)
+{
+    if (spi_locked)
+    {
+        spi_deferred_irq = irq;
+        spi_deferred = 1;
+        return 0;
+    }
+    
+    return 1;
+}
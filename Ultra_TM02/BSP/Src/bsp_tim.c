@@ -0,0 +1,113 @@
+/**
+ * @file    bsp_tim.c
+ * @brief   采样定时器板级支持包源文件
+ * @details 实现TIM2周期触发的寄存器级配置
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "bsp_tim.h"
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 初始化完成标志 */
+static uint8_t tim_initialized = 0;
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  获取APB1定时器时钟频率
+ * @note   APB1分频系数不为1时定时器时钟为PCLK1的2倍
+ * @retval 定时器时钟 (Hz)
+ */
+static uint32_t TIM_GetClock(void)
+{
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+    
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+    {
+        return pclk1 * 2U;
+    }
+    
+    return pclk1;
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  采样定时器初始化
+ * @param  period_us: 触发周期 (μs)
+ * @retval 无
+ */
+void BSP_TIM_Init(uint32_t period_us)
+{
+    TIM_TypeDef *tim = BSP_TIM_SAMPLE;
+    
+    if (tim_initialized)
+    {
+        return;
+    }
+    tim_initialized = 1;
+    
+    __HAL_RCC_TIM2_CLK_ENABLE();
+    
+    /* 向上计数，周期寄存器预装载 */
+    tim->CR1 = TIM_CR1_ARPE;
+    tim->PSC = TIM_GetClock() / BSP_TIM_TICK_HZ - 1U;
+    tim->ARR = period_us - 1U;
+    
+    /* 装载预分频和周期，清除由此产生的更新标志 */
+    tim->EGR = TIM_EGR_UG;
+    tim->SR = 0;
+    tim->DIER = TIM_DIER_UIE;
+    
+    HAL_NVIC_SetPriority(BSP_TIM_SAMPLE_IRQn, BSP_TIM_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(BSP_TIM_SAMPLE_IRQn);
+}
+
+/**
+ * @brief  启动采样定时器
+ * @retval 无
+ */
+void BSP_TIM_Start(void)
+{
+    TIM_TypeDef *tim = BSP_TIM_SAMPLE;
+    
+    /* 软件更新事件：计数器清零并立即进入一次更新中断 */
+    tim->EGR = TIM_EGR_UG;
+    tim->CR1 |= TIM_CR1_CEN;
+}
+
+/**
+ * @brief  停止采样定时器
+ * @retval 无
+ */
+void BSP_TIM_Stop(void)
+{
+    TIM_TypeDef *tim = BSP_TIM_SAMPLE;
+    
+    tim->CR1 &= ~TIM_CR1_CEN;
+    tim->SR = 0;
+    HAL_NVIC_ClearPendingIRQ(BSP_TIM_SAMPLE_IRQn);
+}
+
+/**
+ * @brief  设置触发周期
+ * @param  period_us: 触发周期 (μs)
+ * @retval 无
+ */
+void BSP_TIM_SetPeriod(uint32_t period_us)
+{
+    BSP_TIM_SAMPLE->ARR = period_us - 1U;
+}
+
+/**
+ * @brief  按当前APB1定时器时钟重新计算预分频
+ * @retval 无
+ */
+void BSP_TIM_UpdateClock(void)
+{
+    BSP_TIM_SAMPLE->PSC = TIM_GetClock() / BSP_TIM_TICK_HZ - 1U;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file    bsp_trace.c
+ * @brief   事件跟踪环形缓冲区板级支持包源文件
+ * @details 实现事件记录、停止、读出与重新开始
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "bsp_trace.h"
+
+#if TRACE_ENABLE
+
+#include "bsp_dwt.h"
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 记录缓冲区 */
+static TraceEntry_t trace_buf[TRACE_BUF_SIZE];
+
+/* 累计写入条数（下一条写入位置 = trace_head % TRACE_BUF_SIZE） */
+static volatile uint32_t trace_head = 0;
+
+/* 记录使能，上电即开始记录 */
+static volatile uint8_t trace_running = 1;
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  记录一个事件
+ * @param  event: 事件类型 | 事件编号
+ * @param  arg: 事件参数
+ * @retval 无
+ */
+RAMFUNC void BSP_Trace_Log(uint16_t event, uint16_t arg)
+{
+    TraceEntry_t *entry;
+    uint32_t primask;
+    
+    if (!trace_running)
+    {
+        return;
+    }
+    
+    /* 时间戳与占位在同一临界区内，保证缓冲区中时间单调 */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    entry = &trace_buf[trace_head & (TRACE_BUF_SIZE - 1)];
+    trace_head++;
+    entry->cycles = BSP_DWT_GetCycles();
+    entry->event = event;
+    entry->arg = arg;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  停止记录
+ * @param  count: 输出缓冲区中有效记录数
+ * @param  lost: 输出被覆盖的记录数
+ * @retval 无
+ */
+void BSP_Trace_Stop(uint16_t *count, uint32_t *lost)
+{
+    uint32_t head;
+    
+    trace_running = 0;
+    head = trace_head;
+    
+    *count = (head < TRACE_BUF_SIZE) ? (uint16_t)head : TRACE_BUF_SIZE;
+    *lost = head - *count;
+}
+
+/**
+ * @brief  读取记录
+ * @param  index: 起始序号，0为最旧的一条
+ * @param  entries: 输出记录数组
+ * @param  max: 最多读取条数
+ * @retval 实际读取条数
+ */
+uint16_t BSP_Trace_Read(uint16_t index, TraceEntry_t *entries, uint16_t max)
+{
+    uint32_t head = trace_head;
+    uint32_t count = (head < TRACE_BUF_SIZE) ? head : TRACE_BUF_SIZE;
+    uint32_t oldest = head - count;
+    uint16_t n;
+    
+    if (trace_running || index >= count)
+    {
+        return 0;
+    }
+    
+    for (n = 0; n < max && index + n < count; n++)
+    {
+        entries[n] = trace_buf[(oldest + index + n) & (TRACE_BUF_SIZE - 1)];
+    }
+    
+    return n;
+}
+
+/**
+ * @brief  清空缓冲区并开始记录
+ * @retval 无
+ */
+void BSP_Trace_Restart(void)
+{
+    trace_head = 0;
+    trace_running = 1;
+}
+
+#endif /* TRACE_ENABLE */
@@ -14,22 +14,66 @@
 
 /* 私有变量 ------------------------------------------------------------------*/
 
-/* 环形接收缓冲区 */
+/* 环形接收缓冲区（DMA循环模式直接写入，写入位置由接收事件回调更新） */
 static uint8_t rx_buffer[UART_RX_BUFFER_SIZE];
 static volatile uint16_t rx_head = 0;  /* 写入位置 */
 static volatile uint16_t rx_tail = 0;  /* 读取位置 */
+static volatile uint32_t rx_overrun = 0;  /* 接收溢出次数 */
 
-/* 单字节接收缓冲（用于中断接收） */
-static uint8_t rx_byte = 0;
+/* 环形发送队列 */
+static uint8_t tx_buffer[UART_TX_BUFFER_SIZE];
+static volatile uint16_t tx_head = 0;  /* 写入位置 */
+static volatile uint16_t tx_tail = 0;  /* 读取位置（DMA正在发送段的起点） */
+static volatile uint16_t tx_dma_len = 0;  /* DMA正在发送的长度，0表示空闲 */
 
 /* 私有函数 ------------------------------------------------------------------*/
 
+/**
+ * @brief  启动DMA循环接收
+ * @retval 无
+ */
+static void UART_StartRx(void)
+{
+    rx_head = 0;
+    rx_tail = 0;
+    HAL_UARTEx_ReceiveToIdle_DMA(&huart6, rx_buffer, UART_RX_BUFFER_SIZE);
+}
+
+/**
+ * @brief  启动下一段DMA发送
+ * @note   在中断中或关中断时调用；每次只发送一段连续内存，
+ *         队列回绕部分在本段发送完成后继续
+ * @retval 无
+ */
+static void UART_TxKick(void)
+{
+    uint16_t head = tx_head;
+    uint16_t tail = tx_tail;
+    uint16_t len;
+    
+    if (tx_dma_len != 0 || head == tail)
+    {
+        return;
+    }
+    
+    len = (head > tail) ? (head - tail) : (UART_TX_BUFFER_SIZE - tail);
+    tx_dma_len = len;
+    
+    if (HAL_UART_Transmit_DMA(&huart6, &tx_buffer[tail], len) != HAL_OK)
+    {
+        tx_dma_len = 0;  /* 外设忙，等待下一次发送完成或入队时重试 */
+    }
+}
+
 /* 公共函数 ------------------------------------------------------------------*/
 
 /**
  * @brief  UART初始化
- * @note   CubeIDE已在MX_USART6_UART_Init()中完成初始化
- *         此函数启用接收中断
+ * @note   CubeIDE已在MX_USART6_UART_Init()中完成初始化，
+ *         DMA通道在MX_DMA_Init()中配置：
+ *         - USART6_RX: DMA2 Stream1 Channel5, 循环模式
+ *         - USART6_TX: DMA2 Stream6 Channel5, 普通模式
+ *         此函数启动DMA循环接收（空闲线路中断）
  * @retval 无
  */
 void BSP_UART_Init(void)
@@ -42,34 +86,106 @@ void BSP_UART_Init(void)
      * - 硬件流控: None
      */
     
-    /* 清空接收缓冲区 */
-    rx_head = 0;
-    rx_tail = 0;
+    /* 清空发送队列 */
+    tx_head = 0;
+    tx_tail = 0;
+    tx_dma_len = 0;
+    rx_overrun = 0;
     
-    /* 启用接收中断 */
-    HAL_UART_Receive_IT(&huart6, &rx_byte, 1);
+    /* 启动DMA循环接收 */
+    UART_StartRx();
 }
 
 /**
- * @brief  UART发送数据
+ * @brief  UART发送数据（非阻塞）
  * @param  data: 数据缓冲区指针
  * @param  len: 数据长度
- * @retval HAL状态
+ * @retval HAL_OK: 已入队, HAL_BUSY: 队列剩余空间不足（整包丢弃）
  */
 HAL_StatusTypeDef BSP_UART_Transmit(uint8_t *data, uint16_t len)
 {
-    return HAL_UART_Transmit(&huart6, data, len, UART_TX_TIMEOUT);
+    uint16_t head = tx_head;
+    uint16_t first;
+    uint32_t primask;
+    
+    if (len == 0)
+    {
+        return HAL_OK;
+    }
+    
+    /* 整包入队，避免LCD指令被截断 */
+    if (len > BSP_UART_GetTxFree())
+    {
+        return HAL_BUSY;
+    }
+    
+    /* 复制到队列（可能分两段回绕） */
+    first = UART_TX_BUFFER_SIZE - head;
+    if (first > len)
+    {
+        first = len;
+    }
+    memcpy(&tx_buffer[head], data, first);
+    memcpy(&tx_buffer[0], data + first, len - first);
+    tx_head = (head + len) % UART_TX_BUFFER_SIZE;
+    
+    /* DMA空闲时启动发送 */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    UART_TxKick();
+    __set_PRIMASK(primask);
+    
+    return HAL_OK;
 }
 
 /**
- * @brief  UART发送字符串
+ * @brief  UART发送字符串（非阻塞）
  * @param  str: 字符串指针
  * @retval 无
  */
 void BSP_UART_SendString(const char *str)
 {
     uint16_t len = strlen(str);
-    HAL_UART_Transmit(&huart6, (uint8_t *)str, len, UART_TX_TIMEOUT);
+    BSP_UART_Transmit((uint8_t *)str, len);
+}
+
+/**
+ * @brief  获取发送队列剩余空间
+ * @retval 可入队的字节数
+ */
+uint16_t BSP_UART_GetTxFree(void)
+{
+    uint16_t used = (tx_head - tx_tail + UART_TX_BUFFER_SIZE) % UART_TX_BUFFER_SIZE;
+    return UART_TX_BUFFER_SIZE - 1 - used;
+}
+
+/**
+ * @brief  检查发送是否全部完成
+ * @retval 1: 队列为空且DMA空闲, 0: 正在发送
+ */
+uint8_t BSP_UART_IsTxIdle(void)
+{
+    return (tx_head == tx_tail && tx_dma_len == 0) ? 1 : 0;
+}
+
+/**
+ * @brief  等待发送队列排空
+ * @param  timeout: 超时时间 (ms)
+ * @retval HAL_OK: 已排空, HAL_TIMEOUT: 超时
+ */
+HAL_StatusTypeDef BSP_UART_FlushTx(uint32_t timeout)
+{
+    uint32_t start = HAL_GetTick();
+    
+    while (!BSP_UART_IsTxIdle())
+    {
+        if (HAL_GetTick() - start >= timeout)
+        {
+            return HAL_TIMEOUT;
+        }
+    }
+    
+    return HAL_OK;
 }
 
 /**
@@ -80,7 +196,7 @@ void BSP_UART_SendString(const char *str)
  */
 void BSP_UART_Printf(const char *fmt, ...)
 {
-    char buf[256];
+    char buf[UART_PRINTF_BUFFER_SIZE];
     va_list args;
     
     va_start(args, fmt);
@@ -148,44 +264,105 @@ uint16_t BSP_UART_ReadBuffer(uint8_t *data, uint16_t max_len)
  */
 void BSP_UART_FlushRxBuffer(void)
 {
-    rx_head = 0;
-    rx_tail = 0;
+    rx_tail = rx_head;
+}
+
+/**
+ * @brief  获取接收溢出次数
+ * @retval 溢出次数
+ */
+uint32_t BSP_UART_GetRxOverrun(void)
+{
+    return rx_overrun;
+}
+
+/**
+ * @brief  按当前APB2时钟重新计算波特率
+ * @retval 无
+ */
+void BSP_UART_UpdateClock(void)
+{
+    USART_TypeDef *uart = huart6.Instance;
+    
+    /* USART6挂在APB2上，改写BRR时暂停收发器，DMA请求随之暂停 */
+    uart->CR1 &= ~USART_CR1_UE;
+    uart->BRR = UART_BRR_SAMPLING16(HAL_RCC_GetPCLK2Freq(), huart6.Init.BaudRate);
+    uart->CR1 |= USART_CR1_UE;
 }
 
 /**
- * @brief  UART接收中断回调（在中断处理函数中调用）
- * @param  data: 接收到的数据
+ * @brief  UART接收事件回调（在中断中调用）
+ * @param  pos: DMA缓冲区当前写入位置 (1 ~ UART_RX_BUFFER_SIZE)
  * @retval 无
  */
-void BSP_UART_RxCallback(uint8_t data)
+void BSP_UART_RxEventCallback(uint16_t pos)
 {
-    /* 计算下一个写入位置 */
-    uint16_t next_head = (rx_head + 1) % UART_RX_BUFFER_SIZE;
+    uint16_t new_head = pos % UART_RX_BUFFER_SIZE;
+    uint16_t received = (new_head - rx_head + UART_RX_BUFFER_SIZE) % UART_RX_BUFFER_SIZE;
     
-    /* 检查缓冲区是否已满 */
-    if (next_head != rx_tail)
+    /* 未读数据被DMA覆盖：丢弃最旧的数据，保留最新的一个缓冲区 */
+    if (BSP_UART_Available() + received >= UART_RX_BUFFER_SIZE)
     {
-        /* 写入数据 */
-        rx_buffer[rx_head] = data;
-        rx_head = next_head;
+        rx_overrun++;
+        rx_tail = (new_head + 1) % UART_RX_BUFFER_SIZE;
     }
-    /* 如果缓冲区已满，丢弃数据 */
+    
+    rx_head = new_head;
 }
 
 /**
- * @brief  HAL UART接收完成回调函数
- * @note   此函数由HAL库调用，需要在stm32f4xx_it.c中启用
+ * @brief  HAL UART接收事件回调函数
+ * @note   DMA半满、全满或检测到空闲线路时由HAL库调用，
+ *         Size为循环缓冲区内的当前写入位置
  * @param  huart: UART句柄指针
+ * @param  Size: 当前写入位置
  * @retval 无
  */
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 {
     if (huart->Instance == USART6)
     {
-        /* 将接收到的字节存入缓冲区 */
-        BSP_UART_RxCallback(rx_byte);
+        BSP_UART_RxEventCallback(Size);
+    }
+}
+
+/**
+ * @brief  HAL UART发送完成回调函数
+ * @note   一段DMA发送完成，继续发送队列中剩余的数据
+ * @param  huart: UART句柄指针
+ * @retval 无
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART6)
+    {
+        tx_tail = (tx_tail + tx_dma_len) % UART_TX_BUFFER_SIZE;
+        tx_dma_len = 0;
+        UART_TxKick();
+    }
+}
+
+/**
+ * @brief  HAL UART错误回调函数
+ * @note   噪声/帧错误/溢出时HAL会中止DMA接收，此处重新启动；
+ *         若发送也被中止，丢弃当前段并继续发送后续数据
+ * @param  huart: UART句柄指针
+ * @retval 无
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART6)
+    {
+        if (huart->RxState == HAL_UART_STATE_READY)
+        {
+            UART_StartRx();
+        }
         
-        /* 继续接收下一个字节 */
-        HAL_UART_Receive_IT(&huart6, &rx_byte, 1);
+        if (huart->gState == HAL_UART_STATE_READY && tx_dma_len != 0)
+        {
+            tx_tail = (tx_tail + tx_dma_len) % UART_TX_BUFFER_SIZE;
+            tx_dma_len = 0;
+            UART_TxKick();
+        }
     }
 }
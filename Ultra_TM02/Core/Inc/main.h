@@ -39,6 +39,23 @@ extern "C" {
 
 /* Exported macro ------------------------------------------------------------*/
 /* USER CODE BEGIN EM */
+/* 在SRAM中执行的函数：放入.RamFunc段（链接脚本将其并入.data，启动时拷贝到SRAM）
+ * 用于Flash擦写期间仍需运行的中断与驱动代码，以及每个样本都要执行的热路径
+ * （滤波、查表），SRAM取指没有Flash等待周期 */
+#define RAMFUNC                 __attribute__((section(".RamFunc"), noinline, long_call))
+
+/* 在Flash中执行的函数：禁止内联，保证从Flash取指（自测基准中与RAMFUNC对照） */
+#define FLASHFUNC               __attribute__((noinline))
+
+/* 强制内联：计算内核在RAMFUNC/FLASHFUNC中展开，代码随调用者所在存储区 */
+#define ALWAYS_INLINE           __attribute__((always_inline))
+
+/* 固件映像在Flash中的结束地址：链接脚本把.data（含.RamFunc）的初始值放在代码与
+ * 只读数据之后，_sidata为其Flash地址，_sdata/_edata为其在SRAM中的范围 */
+extern uint32_t _sidata;
+extern uint32_t _sdata;
+extern uint32_t _edata;
+#define FIRMWARE_IMAGE_END      ((uint32_t)&_sidata + ((uint32_t)&_edata - (uint32_t)&_sdata))
 
 /* USER CODE END EM */
 
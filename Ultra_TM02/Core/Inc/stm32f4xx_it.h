@@ -32,6 +32,8 @@ void SysTick_Handler(void);
 void EXTI0_IRQHandler(void);        /* ADC_DRDY中断 */
 void SPI1_IRQHandler(void);         /* SPI1中断 */
 void USART6_IRQHandler(void);       /* USART6中断 (LCD) */
+void DMA2_Stream1_IRQHandler(void); /* USART6_RX DMA中断 */
+void DMA2_Stream6_IRQHandler(void); /* USART6_TX DMA中断 */
 void OTG_FS_IRQHandler(void);       /* USB OTG FS中断 */
 
 #ifdef __cplusplus
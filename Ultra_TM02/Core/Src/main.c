@@ -8,16 +8,17 @@
  * 
  * @attention
  * 系统配置:
- * - MCU: STM32F411RET6 (100MHz)
+ * - MCU: STM32F411RET6 (SYSCLK 96MHz，运行时可切换HCLK 96/48/24MHz，见bsp_power.h)
  * - HSE: 12MHz外部晶振
  * - USB: 48MHz (CDC虚拟串口)
- * - SPI1: 12.5MHz (ADC/DAC通讯)
- * - USART6: 115200 (LCD串口屏)
+ * - SPI1: APB2/8，全速档12MHz (ADC/DAC通讯)
+ * - USART6: 115200 (LCD串口屏, DMA收发)
  */
 /* USER CODE END Header */
 
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "dma.h"
 #include "spi.h"
 #include "usart.h"
 #include "usb_device.h"
@@ -30,6 +31,8 @@
 #include "bsp_spi.h"
 #include "bsp_uart.h"
 #include "bsp_flash.h"
+#include "bsp_dwt.h"
+#include "bsp_prof.h"
 
 /* Service层头文件 */
 #include "svc_adc.h"
@@ -42,6 +45,12 @@
 #include "app_param.h"
 #include "app_comm.h"
 #include "app_output.h"
+#include "app_sched.h"
+#include "app_boot.h"
+#include "app_power.h"
+#include "app_history.h"
+#include "app_datalog.h"
+#include "app_alarm.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -62,7 +71,7 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-static uint32_t led_tick = 0;       /* LED闪烁计时 */
+
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -76,61 +85,60 @@ static void App_Process(void);
 /* USER CODE BEGIN 0 */
 /**
  * @brief  应用层初始化
+ * @note   先让输出进入安全值并启动采集，串口屏和USB在后台完成启动，
+ *         初始化过程中不做任何毫秒级等待（ADC复位等待除外）；
+ *         各阶段时刻见app_boot.h
  */
 static void App_Init(void)
 {
     /* BSP层初始化 */
     BSP_GPIO_Init();        /* GPIO初始化 (片选、LED等) */
+    BSP_DWT_Init();         /* DWT周期计数器 (微秒延时) */
+    APP_Boot_Init();        /* 启动计时 (复位原因、各阶段时刻) */
+    BSP_Flash_Init();       /* 向量表重定位到SRAM (Flash擦写期间中断不停) */
     
-    /* Service层初始化 */
-    SVC_ADC_Init();         /* ADC服务初始化 */
-    SVC_DAC_Init();         /* DAC服务初始化 */
-    SVC_LCD_Init();         /* LCD服务初始化 */
-    SVC_USB_Init();         /* USB服务初始化 */
-    
-    /* 显示启动信息 */
-    SVC_LCD_SetStatus("Starting...");
-    HAL_Delay(500);
+    /* 输出通道：DAC初始化即输出4mA */
+    SVC_DAC_Init();
+    APP_Boot_Mark(BOOT_STAGE_OUTPUT_SAFE);
     
-    /* App层初始化 */
+    /* 测量通道 */
+    SVC_ADC_Init();         /* ADC服务初始化 */
     APP_Param_Init();       /* 参数管理初始化 (从Flash加载参数) */
-    APP_Temp_Init();        /* 温度测量初始化 */
+    APP_Power_Init();       /* 切换到参数中的时钟档位 */
     APP_Output_Init();      /* 4-20mA输出初始化 */
-    APP_Comm_Init();        /* 通讯协议初始化 */
+    APP_Temp_Init();        /* 温度测量初始化 */
+    APP_History_Init();     /* 测量历史记录 (参数中的抽取比) */
+    APP_DataLog_Init();     /* 长期数据日志 (扫描Flash日志区域) */
+    APP_Alarm_Init();       /* 温度报警 (全部关闭) */
     
-    /* 启动完成，更新显示 */
-    SVC_LCD_SetStatus("Ready");
+    /* 后台启动的外设：串口屏上电复位由LCD任务推进，USB枚举由中断完成 */
+    SVC_LCD_Init();         /* LCD服务初始化 */
     SVC_LCD_SetCurrentSource(APP_Param_GetCurrentSource());
+    SVC_USB_Init();         /* USB服务初始化 */
+    APP_Comm_Init();        /* 通讯协议初始化 */
     
     /* 自动开始测量 */
     APP_Temp_Start();
+    APP_Boot_Mark(BOOT_STAGE_ACQ_START);
+    
+    /* 任务调度器 (周期任务从此刻开始计时) */
+    APP_Sched_Init();
+    APP_Boot_Mark(BOOT_STAGE_INIT_DONE);
 }
 
 /**
  * @brief  应用层主循环处理
+ * @note   任务及其优先级、周期、执行预算见app_sched.c中的任务表
  */
 static void App_Process(void)
 {
-    /* 温度测量处理 */
-    APP_Temp_Process();
-    
-    /* 通讯协议处理 (USB接收) */
-    APP_Comm_Process();
-    
-    /* LCD显示更新 */
-    SVC_LCD_Update();
+    PROF_MARK(PROF_PROBE_LOOP);
+    APP_Boot_Poll();
     
-    /* LED闪烁 (1Hz) - 指示系统运行 */
-    if (HAL_GetTick() - led_tick >= 500)
+    /* 无就绪任务时睡眠到下一个中断 */
+    if (!APP_Sched_Run())
     {
-        led_tick = HAL_GetTick();
-        BSP_LED_Toggle();
-    }
-    
-    /* 4-20mA输出更新 (如果测量正在运行) */
-    if (APP_Temp_IsRunning())
-    {
-        APP_Output_UpdateCurrent(APP_Temp_GetValue());
+        APP_Power_Idle();
     }
 }
 /* USER CODE END 0 */
@@ -151,7 +159,8 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-
+  /* ART加速器：预取与指令/数据缓存按bsp_flash.h中的配置从复位状态开始 */
+  BSP_Flash_AccelInit();
   /* USER CODE END Init */
 
   /* Configure the system clock */
@@ -163,6 +172,7 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_SPI1_Init();
   MX_USART6_UART_Init();
   MX_USB_DEVICE_Init();
@@ -206,9 +216,9 @@ void SystemClock_Config(void)
   RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
   RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSE;
   RCC_OscInitStruct.PLL.PLLM = 6;
-  RCC_OscInitStruct.PLL.PLLN = 72;
+  RCC_OscInitStruct.PLL.PLLN = 96;
   RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV2;
-  RCC_OscInitStruct.PLL.PLLQ = 3;
+  RCC_OscInitStruct.PLL.PLLQ = 4;
   if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
   {
     Error_Handler();
@@ -223,7 +233,7 @@ void SystemClock_Config(void)
   RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;
   RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
 
-  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_3) != HAL_OK)
   {
     Error_Handler();
   }
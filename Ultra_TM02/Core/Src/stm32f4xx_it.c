@@ -8,14 +8,23 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm32f4xx_it.h"
 #include "main.h"
+#include "bsp_trace.h"
+#include "bsp_tim.h"
 
 /* External variables --------------------------------------------------------*/
 extern SPI_HandleTypeDef hspi1;
 extern UART_HandleTypeDef huart6;
+extern DMA_HandleTypeDef hdma_usart6_rx;
+extern DMA_HandleTypeDef hdma_usart6_tx;
 extern PCD_HandleTypeDef hpcd_USB_OTG_FS;
 
+/* HAL时基变量（stm32f4xx_hal.c） */
+extern __IO uint32_t uwTick;
+extern HAL_TickFreqTypeDef uwTickFreq;
+
 /* ADC服务回调声明 */
 extern void SVC_ADC_DRDY_Callback(void);
+extern void SVC_ADC_Trigger_Callback(void);
 
 /******************************************************************************/
 /*           Cortex-M4 处理器异常处理程序                                       */
@@ -95,10 +104,11 @@ void PendSV_Handler(void)
 /**
  * @brief  SysTick中断处理
  * @note   每1ms调用一次，为HAL库提供时基
+ *         位于RAM中，Flash擦除期间时基不停；内容与HAL_IncTick()相同
  */
-void SysTick_Handler(void)
+RAMFUNC void SysTick_Handler(void)
 {
-    HAL_IncTick();
+    uwTick += uwTickFreq;
 }
 
 /******************************************************************************/
@@ -107,25 +117,32 @@ void SysTick_Handler(void)
 
 /**
  * @brief  EXTI0中断处理 (ADC_DRDY)
- * @note   ADC数据就绪时触发
+ * @note   ADC数据就绪时触发；SPI总线释放时也会被软件重新挂起
+ *         位于RAM中，不经过HAL_GPIO_EXTI_IRQHandler，Flash擦除期间照常采样
  */
-void EXTI0_IRQHandler(void)
+RAMFUNC void EXTI0_IRQHandler(void)
 {
     /* 清除中断标志 */
-    HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
+    __HAL_GPIO_EXTI_CLEAR_IT(ADC_DRDY_Pin);
+    
+    /* ADC数据就绪回调 */
+    TRACE_BEGIN(TRACE_EVT_DRDY_IRQ, 0);
+    SVC_ADC_DRDY_Callback();
+    TRACE_END(TRACE_EVT_DRDY_IRQ, 0);
 }
 
 /**
- * @brief  GPIO外部中断回调
- * @param  GPIO_Pin: 触发中断的引脚
+ * @brief  TIM2中断处理 (ADC采样触发)
+ * @note   每个采样周期触发一次；位于RAM中，Flash擦除期间照常触发
  */
-void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+RAMFUNC void TIM2_IRQHandler(void)
 {
-    if (GPIO_Pin == GPIO_PIN_0)
-    {
-        /* ADC数据就绪回调 */
-        SVC_ADC_DRDY_Callback();
-    }
+    /* 清除更新中断标志 */
+    BSP_TIM_SAMPLE->SR = ~TIM_SR_UIF;
+    
+    TRACE_BEGIN(TRACE_EVT_TIM_IRQ, 0);
+    SVC_ADC_Trigger_Callback();
+    TRACE_END(TRACE_EVT_TIM_IRQ, 0);
 }
 
 /**
@@ -141,7 +158,29 @@ void SPI1_IRQHandler(void)
  */
 void USART6_IRQHandler(void)
 {
+    TRACE_BEGIN(TRACE_EVT_UART_IRQ, 0);
     HAL_UART_IRQHandler(&huart6);
+    TRACE_END(TRACE_EVT_UART_IRQ, 0);
+}
+
+/**
+ * @brief  DMA2 Stream1中断处理 (USART6_RX, 循环模式)
+ */
+void DMA2_Stream1_IRQHandler(void)
+{
+    TRACE_BEGIN(TRACE_EVT_UART_RX_DMA_IRQ, 0);
+    HAL_DMA_IRQHandler(&hdma_usart6_rx);
+    TRACE_END(TRACE_EVT_UART_RX_DMA_IRQ, 0);
+}
+
+/**
+ * @brief  DMA2 Stream6中断处理 (USART6_TX)
+ */
+void DMA2_Stream6_IRQHandler(void)
+{
+    TRACE_BEGIN(TRACE_EVT_UART_TX_DMA_IRQ, 0);
+    HAL_DMA_IRQHandler(&hdma_usart6_tx);
+    TRACE_END(TRACE_EVT_UART_TX_DMA_IRQ, 0);
 }
 
 /**
@@ -149,6 +188,8 @@ void USART6_IRQHandler(void)
  */
 void OTG_FS_IRQHandler(void)
 {
+    TRACE_BEGIN(TRACE_EVT_USB_IRQ, 0);
     HAL_PCD_IRQHandler(&hpcd_USB_OTG_FS);
+    TRACE_END(TRACE_EVT_USB_IRQ, 0);
 }
 
@@ -0,0 +1,118 @@
+/**
+ * @file    bsp_gpio.c
+ * @brief   GPIO板级支持包（主机模拟）
+ * @details 与BSP/Src/bsp_gpio.c接口相同：片选、LOAD引脚驱动器件模型，
+ *          DRDY由ADC模型给出，LED状态只记录
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "bsp_gpio.h"
+#include "sim_adc.h"
+#include "sim_dac.h"
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* LED状态（1=亮） */
+static uint8_t led_on = 0;
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  GPIO初始化
+ * @retval 无
+ */
+void BSP_GPIO_Init(void)
+{
+    /* 所有片选信号设为高电平（不选中） */
+    BSP_ADC_CS(1);
+    BSP_DAC1_CS(1);
+    BSP_DAC2_CS(1);
+    
+    /* 所有LOAD信号设为高电平（正常状态） */
+    BSP_DAC1_LOAD(1);
+    BSP_DAC2_LOAD(1);
+    
+    /* LED1熄灭 */
+    BSP_LED_Set(0);
+}
+
+/**
+ * @brief  设置ADC1片选信号
+ * @param  state: 0=选中(低电平), 1=不选中(高电平)
+ * @retval 无
+ */
+void BSP_ADC_CS(uint8_t state)
+{
+    SimADC_Select(state ? 0 : 1);
+}
+
+/**
+ * @brief  设置DAC1片选信号
+ * @param  state: 0=选中(低电平), 1=不选中(高电平)
+ * @retval 无
+ */
+void BSP_DAC1_CS(uint8_t state)
+{
+    SimDAC_Select(0, state ? 0 : 1);
+}
+
+/**
+ * @brief  设置DAC2片选信号
+ * @param  state: 0=选中(低电平), 1=不选中(高电平)
+ * @retval 无
+ */
+void BSP_DAC2_CS(uint8_t state)
+{
+    SimDAC_Select(1, state ? 0 : 1);
+}
+
+/**
+ * @brief  设置DAC1加载信号
+ * @param  state: 0=低电平(加载), 1=高电平(正常)
+ * @retval 无
+ */
+void BSP_DAC1_LOAD(uint8_t state)
+{
+    SimDAC_Load(0, state ? 1 : 0);
+}
+
+/**
+ * @brief  设置DAC2加载信号
+ * @param  state: 0=低电平(加载), 1=高电平(正常)
+ * @retval 无
+ */
+void BSP_DAC2_LOAD(uint8_t state)
+{
+    SimDAC_Load(1, state ? 1 : 0);
+}
+
+/**
+ * @brief  设置LED状态
+ * @param  state: 0=熄灭, 1=点亮
+ * @retval 无
+ */
+void BSP_LED_Set(uint8_t state)
+{
+    led_on = state ? 1 : 0;
+}
+
+/**
+ * @brief  翻转LED状态
+ * @retval 无
+ */
+void BSP_LED_Toggle(void)
+{
+    led_on = !led_on;
+}
+
+/**
+ * @brief  检查ADC数据是否就绪
+ * @retval 1=数据就绪(DRDY低电平), 0=未就绪
+ */
+uint8_t BSP_ADC_IsDataReady(void)
+{
+    return SimADC_IsDataReady();
+}
@@ -0,0 +1,83 @@
+/**
+ * @file    bsp_power.c
+ * @brief   时钟档位与睡眠板级支持包（主机模拟）
+ * @details 与BSP/Src/bsp_power.c接口相同：切换档位时更新SystemCoreClock和Flash等待周期，
+ *          睡眠由WFI模拟（阻塞到下一个中断），按实际睡眠时间折算HCLK周期
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "bsp_power.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* SYSCLK (Hz)，各档位由AHB分频得到HCLK */
+#define POWER_SYSCLK_HZ         96000000U
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/* 档位配置 */
+typedef struct {
+    uint32_t ahb_shift;         /* AHB分频 (2^n) */
+    uint32_t latency;           /* Flash等待周期 */
+} PowerProfileConfig_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 档位配置表（与BSP/Src/bsp_power.c一致） */
+static const PowerProfileConfig_t profile_table[POWER_PROFILE_COUNT] = {
+    [POWER_PROFILE_FULL]     = { 0, FLASH_LATENCY_3 },
+    [POWER_PROFILE_BALANCED] = { 1, FLASH_LATENCY_1 },
+    [POWER_PROFILE_LOW]      = { 2, FLASH_LATENCY_0 },
+};
+
+/* 当前档位 */
+static uint8_t current_profile = POWER_PROFILE_FULL;
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  切换时钟档位
+ * @param  profile: 时钟档位 (POWER_PROFILE_xxx)
+ * @retval 0=成功, -1=档位无效
+ */
+int BSP_Power_SetProfile(uint8_t profile)
+{
+    const PowerProfileConfig_t *cfg;
+    
+    if (profile >= POWER_PROFILE_COUNT)
+    {
+        return -1;
+    }
+    
+    cfg = &profile_table[profile];
+    SystemCoreClock = POWER_SYSCLK_HZ >> cfg->ahb_shift;
+    FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY) | cfg->latency;
+    current_profile = profile;
+    
+    return 0;
+}
+
+/**
+ * @brief  获取当前时钟档位
+ * @retval 时钟档位
+ */
+uint8_t BSP_Power_GetProfile(void)
+{
+    return current_profile;
+}
+
+/**
+ * @brief  进入睡眠直到有中断挂起
+ * @retval 睡眠时长 (HCLK周期)
+ */
+uint32_t BSP_Power_Sleep(void)
+{
+    uint64_t before = Stub_Nanos();
+    
+    __WFI();
+    
+    return (uint32_t)((Stub_Nanos() - before) * SystemCoreClock / 1000000000ULL);
+}
@@ -0,0 +1,151 @@
+/**
+ * @file    bsp_spi.c
+ * @brief   SPI板级支持包（主机模拟）
+ * @details 与BSP/Src/bsp_spi.c接口相同：字节经SimBoard_SpiTransfer()交给片选有效的器件模型，
+ *          总线仲裁（主循环占用、中断延后补发）与固件实现一致
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "bsp_spi.h"
+#include "sim_board.h"
+
+/* 外部变量 ------------------------------------------------------------------*/
+SPI_HandleTypeDef hspi1;
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 总线仲裁 */
+static volatile uint8_t spi_locked = 0;         /* 主循环占用中 */
+static volatile uint8_t spi_deferred = 0;       /* 有中断事务被延后 */
+static volatile IRQn_Type spi_deferred_irq;     /* 被延后的中断号 */
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  SPI1初始化
+ * @retval 无
+ */
+void BSP_SPI_Init(void)
+{
+}
+
+/**
+ * @brief  SPI收发一个字节
+ * @param  tx_data: 要发送的数据
+ * @retval 接收到的数据
+ */
+uint8_t BSP_SPI_TransmitReceive(uint8_t tx_data)
+{
+    return SimBoard_SpiTransfer(tx_data);
+}
+
+/**
+ * @brief  SPI发送多个字节
+ * @param  data: 数据缓冲区指针
+ * @param  len: 数据长度
+ * @retval HAL状态
+ */
+HAL_StatusTypeDef BSP_SPI_Transmit(uint8_t *data, uint16_t len)
+{
+    uint16_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        SimBoard_SpiTransfer(data[i]);
+    }
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief  SPI接收多个字节
+ * @param  data: 数据缓冲区指针
+ * @param  len: 数据长度
+ * @retval HAL状态
+ */
+HAL_StatusTypeDef BSP_SPI_Receive(uint8_t *data, uint16_t len)
+{
+    uint16_t i;
+    
+    /* 同HAL：接收时发送0xFF */
+    for (i = 0; i < len; i++)
+    {
+        data[i] = SimBoard_SpiTransfer(0xFF);
+    }
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief  SPI同时收发多个字节
+ * @param  tx_data: 发送数据缓冲区指针
+ * @param  rx_data: 接收数据缓冲区指针
+ * @param  len: 数据长度
+ * @retval HAL状态
+ */
+HAL_StatusTypeDef BSP_SPI_TransmitReceiveBuffer(uint8_t *tx_data, uint8_t *rx_data, uint16_t len)
+{
+    uint16_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        rx_data[i] = SimBoard_SpiTransfer(tx_data[i]);
+    }
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief  SPI收发一个字节（寄存器直接操作）
+ * @param  tx_data: 要发送的数据
+ * @retval 接收到的数据
+ */
+uint8_t BSP_SPI_TransferFast(uint8_t tx_data)
+{
+    return SimBoard_SpiTransfer(tx_data);
+}
+
+/**
+ * @brief  主循环占用SPI总线
+ * @retval 无
+ */
+void BSP_SPI_Lock(void)
+{
+    spi_locked = 1;
+}
+
+/**
+ * @brief  主循环释放SPI总线
+ * @retval 无
+ */
+void BSP_SPI_Unlock(void)
+{
+    spi_locked = 0;
+    
+    /* 补发被延后的中断事务 */
+    if (spi_deferred)
+    {
+        spi_deferred = 0;
+        HAL_NVIC_SetPendingIRQ(spi_deferred_irq);
+    }
+}
+
+/**
+ * @brief  中断中申请使用SPI总线
+ * @param  irq: 调用者的中断号
+ * @retval 1=总线空闲可直接使用, 0=总线被主循环占用（已登记延后）
+ */
+uint8_t BSP_SPI_ClaimFromISR(IRQn_Type irq)
+{
+    if (spi_locked)
+    {
+        spi_deferred_irq = irq;
+        spi_deferred = 1;
+        return 0;
+    }
+    
+    return 1;
+}
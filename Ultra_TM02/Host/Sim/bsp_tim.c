@@ -0,0 +1,81 @@
+/**
+ * @file    bsp_tim.c
+ * @brief   采样定时器板级支持包（主机模拟）
+ * @details 与BSP/Src/bsp_tim.c接口相同：计数由sim_board.c按单调时钟模拟，
+ *          更新事件挂起TIM2中断
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "bsp_tim.h"
+#include "sim_board.h"
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+static uint8_t tim_initialized = 0;
+static uint8_t tim_running = 0;
+static uint32_t tim_period_us = 0;
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  采样定时器初始化
+ * @param  period_us: 触发周期 (μs)
+ * @retval 无
+ */
+void BSP_TIM_Init(uint32_t period_us)
+{
+    if (tim_initialized)
+    {
+        return;
+    }
+    tim_initialized = 1;
+    
+    tim_period_us = period_us;
+    HAL_NVIC_SetPriority(BSP_TIM_SAMPLE_IRQn, BSP_TIM_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(BSP_TIM_SAMPLE_IRQn);
+}
+
+/**
+ * @brief  启动采样定时器
+ * @retval 无
+ */
+void BSP_TIM_Start(void)
+{
+    /* 软件更新事件：计数器清零并立即进入一次更新中断 */
+    tim_running = 1;
+    SimBoard_SetTimer(1, tim_period_us, 1);
+}
+
+/**
+ * @brief  停止采样定时器
+ * @retval 无
+ */
+void BSP_TIM_Stop(void)
+{
+    tim_running = 0;
+    SimBoard_SetTimer(0, tim_period_us, 0);
+    HAL_NVIC_ClearPendingIRQ(BSP_TIM_SAMPLE_IRQn);
+}
+
+/**
+ * @brief  设置触发周期
+ * @param  period_us: 触发周期 (μs)
+ * @retval 无
+ */
+void BSP_TIM_SetPeriod(uint32_t period_us)
+{
+    tim_period_us = period_us;
+    SimBoard_SetTimer(tim_running, tim_period_us, 0);
+}
+
+/**
+ * @brief  按当前APB1定时器时钟重新计算预分频
+ * @note   模拟计数与时钟档位无关
+ * @retval 无
+ */
+void BSP_TIM_UpdateClock(void)
+{
+}
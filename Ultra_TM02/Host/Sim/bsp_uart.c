@@ -0,0 +1,179 @@
+/**
+ * @file    bsp_uart.c
+ * @brief   UART板级支持包（主机模拟）
+ * @details 与BSP/Src/bsp_uart.c接口相同：发送立即完成，数据写入串口屏输出文件
+ *          （未设置时丢弃）；串口屏无应答，接收缓冲区始终为空
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "bsp_uart.h"
+#include "sim_board.h"
+#include <stdio.h>
+#include <stdarg.h>
+
+/* 外部变量 ------------------------------------------------------------------*/
+UART_HandleTypeDef huart6;
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 串口屏输出 */
+static FILE *uart_sink = NULL;
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  设置串口屏输出文件
+ * @param  sink: 输出文件，NULL=丢弃
+ * @retval 无
+ */
+void SimBoard_SetLcdSink(FILE *sink)
+{
+    uart_sink = sink;
+}
+
+/**
+ * @brief  UART初始化
+ * @retval 无
+ */
+void BSP_UART_Init(void)
+{
+}
+
+/**
+ * @brief  UART发送数据
+ * @param  data: 数据缓冲区指针
+ * @param  len: 数据长度
+ * @retval HAL_OK
+ */
+HAL_StatusTypeDef BSP_UART_Transmit(uint8_t *data, uint16_t len)
+{
+    if (uart_sink != NULL && len != 0)
+    {
+        fwrite(data, 1, len, uart_sink);
+        fflush(uart_sink);
+    }
+    
+    return HAL_OK;
+}
+
+/**
+ * @brief  UART发送字符串
+ * @param  str: 字符串指针
+ * @retval 无
+ */
+void BSP_UART_SendString(const char *str)
+{
+    BSP_UART_Transmit((uint8_t *)str, strlen(str));
+}
+
+/**
+ * @brief  获取发送队列剩余空间
+ * @retval 可入队的字节数
+ */
+uint16_t BSP_UART_GetTxFree(void)
+{
+    return UART_TX_BUFFER_SIZE - 1;
+}
+
+/**
+ * @brief  检查发送是否全部完成
+ * @retval 1
+ */
+uint8_t BSP_UART_IsTxIdle(void)
+{
+    return 1;
+}
+
+/**
+ * @brief  等待发送队列排空
+ * @param  timeout: 超时时间 (ms)
+ * @retval HAL_OK
+ */
+HAL_StatusTypeDef BSP_UART_FlushTx(uint32_t timeout)
+{
+    return HAL_OK;
+}
+
+/**
+ * @brief  UART发送格式化字符串
+ * @param  fmt: 格式化字符串
+ * @param  ...: 可变参数
+ * @retval 无
+ */
+void BSP_UART_Printf(const char *fmt, ...)
+{
+    char buf[UART_PRINTF_BUFFER_SIZE];
+    va_list args;
+    
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    
+    BSP_UART_SendString(buf);
+}
+
+/**
+ * @brief  检查接收缓冲区是否有数据
+ * @retval 0
+ */
+uint16_t BSP_UART_Available(void)
+{
+    return 0;
+}
+
+/**
+ * @brief  读取一个字节
+ * @retval -1（无数据）
+ */
+int BSP_UART_Read(void)
+{
+    return -1;
+}
+
+/**
+ * @brief  读取多个字节
+ * @param  data: 数据缓冲区指针
+ * @param  max_len: 最大读取长度
+ * @retval 0
+ */
+uint16_t BSP_UART_ReadBuffer(uint8_t *data, uint16_t max_len)
+{
+    return 0;
+}
+
+/**
+ * @brief  清空接收缓冲区
+ * @retval 无
+ */
+void BSP_UART_FlushRxBuffer(void)
+{
+}
+
+/**
+ * @brief  获取接收溢出次数
+ * @retval 0
+ */
+uint32_t BSP_UART_GetRxOverrun(void)
+{
+    return 0;
+}
+
+/**
+ * @brief  按当前APB2时钟重新计算波特率
+ * @retval 无
+ */
+void BSP_UART_UpdateClock(void)
+{
+}
+
+/**
+ * @brief  UART接收事件回调
+ * @param  pos: DMA缓冲区当前写入位置
+ * @retval 无
+ */
+void BSP_UART_RxEventCallback(uint16_t pos)
+{
+}
@@ -0,0 +1,489 @@
+/**
+ * @file    sim_adc.c
+ * @brief   ADC芯片与二极管传感器模型源文件
+ * @details 实现SPI寄存器协议、转换定时和二极管电压模型
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "sim_adc.h"
+#include "sim_dac.h"
+#include "svc_adc.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* 玻尔兹曼常数/电子电荷 (mV/K) */
+#define SIM_ADC_K_OVER_Q_MV     0.0861733f
+
+/* 曲线对应的激励电流 (μA) */
+#define SIM_ADC_CURVE_UA        10.0f
+
+/* 低于此激励电流视为电流源关闭，二极管无偏置 (μA) */
+#define SIM_ADC_MIN_UA          0.01f
+
+/* 复位命令 */
+#define SIM_ADC_CMD_RESET       0xFFU
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/* 曲线点（按温度递增排列） */
+typedef struct {
+    float temperature;          /* 温度 (K) */
+    float voltage;              /* 10μA激励下的电压 (mV) */
+} CurvePoint_t;
+
+/* SPI帧状态 */
+typedef enum {
+    SPI_STATE_IDLE = 0,         /* 等待命令字节 */
+    SPI_STATE_WRITE,            /* 等待写入数据 */
+    SPI_STATE_READ,             /* 输出读取数据 */
+    SPI_STATE_IGNORE            /* 本次片选内其余字节不处理 */
+} SpiState_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 默认曲线：硅二极管温度传感器的典型特性（10μA） */
+static const CurvePoint_t default_curve[] = {
+    {   1.4f, 1644.3f }, {   2.0f, 1612.0f }, {   4.2f, 1578.0f }, {  10.0f, 1420.0f },
+    {  20.0f, 1212.0f }, {  25.0f, 1123.0f }, {  30.0f, 1100.0f }, {  40.0f, 1086.0f },
+    {  50.0f, 1076.0f }, {  77.0f, 1024.0f }, { 100.0f,  971.0f }, { 150.0f,  860.0f },
+    { 200.0f,  745.0f }, { 250.0f,  628.0f }, { 300.0f,  520.0f }, { 350.0f,  410.0f },
+    { 400.0f,  300.0f }, { 450.0f,  195.0f }, { 500.0f,   90.0f },
+};
+
+/* 当前曲线 */
+static CurvePoint_t curve[SIM_ADC_CURVE_MAX];
+static int curve_count = 0;
+
+/* 模型配置 */
+static SimADC_Config_t adc_cfg;
+
+/* 寄存器 */
+static uint8_t reg_config = 0;
+
+/* SPI帧 */
+static uint8_t spi_selected = 0;
+static SpiState_t spi_state = SPI_STATE_IDLE;
+static uint8_t spi_reg = 0;
+static uint8_t spi_out[3];
+static uint8_t spi_out_len = 0;
+static uint8_t spi_out_pos = 0;
+
+/* 转换 */
+static uint8_t converting = 0;
+static uint64_t conv_done_ns = 0;
+static uint8_t data_ready = 0;
+static uint32_t data_raw = 0x800000U;
+
+/* 噪声随机数状态 (xorshift32) */
+static uint32_t rng_state = 1;
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  均匀分布随机数
+ * @retval (0, 1]
+ */
+static float Rand_Uniform(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    
+    return ((rng_state >> 8) + 1U) / 16777216.0f;
+}
+
+/**
+ * @brief  标准正态分布随机数（Box-Muller）
+ * @retval 随机数
+ */
+static float Rand_Gauss(void)
+{
+    float u1 = Rand_Uniform();
+    float u2 = Rand_Uniform();
+    
+    return sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+}
+
+/**
+ * @brief  曲线插值
+ * @param  temp_k: 温度 (K)
+ * @retval 10μA激励下的电压 (mV)，超出曲线范围时取端点值
+ */
+static float Curve_Voltage(float temp_k)
+{
+    int low = 0;
+    int high = curve_count - 1;
+    int mid;
+    
+    if (temp_k <= curve[0].temperature)
+    {
+        return curve[0].voltage;
+    }
+    if (temp_k >= curve[high].temperature)
+    {
+        return curve[high].voltage;
+    }
+    
+    while (high - low > 1)
+    {
+        mid = (low + high) / 2;
+        if (temp_k < curve[mid].temperature)
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid;
+        }
+    }
+    
+    return curve[low].voltage + (temp_k - curve[low].temperature) *
+           (curve[high].voltage - curve[low].voltage) /
+           (curve[high].temperature - curve[low].temperature);
+}
+
+/**
+ * @brief  按温度排序
+ */
+static int Curve_Compare(const void *a, const void *b)
+{
+    float ta = ((const CurvePoint_t *)a)->temperature;
+    float tb = ((const CurvePoint_t *)b)->temperature;
+    
+    return (ta > tb) - (ta < tb);
+}
+
+/**
+ * @brief  完成一次转换：采样输入电压并量化
+ * @param  now_ns: 转换完成时刻
+ * @retval 24位原始值
+ */
+static uint32_t ADC_Convert(uint64_t now_ns)
+{
+    float mv = SimADC_GetVoltage(now_ns) + Rand_Gauss() * adc_cfg.noise_uv / 1000.0f;
+    float gain = (float)(1U << ((reg_config >> 4) & 0x07U));
+    float code = mv / 1000.0f / (ADC_VREF / 2.0f) * gain * (ADC_FULLSCALE / 2.0f);
+    
+    if (code > ADC_FULLSCALE / 2.0f - 1.0f)
+    {
+        code = ADC_FULLSCALE / 2.0f - 1.0f;
+    }
+    if (code < -ADC_FULLSCALE / 2.0f)
+    {
+        code = -ADC_FULLSCALE / 2.0f;
+    }
+    
+    return ((uint32_t)(int32_t)lrintf(code) + 0x800000U) & 0xFFFFFFU;
+}
+
+/**
+ * @brief  处理命令字节
+ * @param  cmd: 命令
+ */
+static void ADC_Command(uint8_t cmd)
+{
+    if (cmd == SIM_ADC_CMD_RESET)
+    {
+        reg_config = 0;
+        converting = 0;
+        data_ready = 0;
+        spi_state = SPI_STATE_IGNORE;
+    }
+    else if (cmd == ADC_CMD_START)
+    {
+        /* 新的转换丢弃未读结果 */
+        converting = 1;
+        conv_done_ns = Stub_Nanos() + (uint64_t)adc_cfg.conv_us * 1000ULL;
+        data_ready = 0;
+        spi_state = SPI_STATE_IGNORE;
+    }
+    else if (cmd & ADC_CMD_READ)
+    {
+        spi_reg = cmd & 0x3FU;
+        spi_out_pos = 0;
+        spi_out_len = 1;
+        spi_out[0] = 0;
+        
+        switch (spi_reg)
+        {
+            case ADC_REG_STATUS:
+                spi_out[0] = data_ready ? 0x80U : 0x00U;
+                break;
+            
+            case ADC_REG_CONFIG:
+                spi_out[0] = reg_config;
+                break;
+            
+            case ADC_REG_DATA:
+                spi_out[0] = (uint8_t)(data_raw >> 16);
+                spi_out[1] = (uint8_t)(data_raw >> 8);
+                spi_out[2] = (uint8_t)data_raw;
+                spi_out_len = 3;
+                data_ready = 0;
+                break;
+            
+            default:
+                break;
+        }
+        spi_state = SPI_STATE_READ;
+    }
+    else
+    {
+        spi_reg = cmd & 0x3FU;
+        spi_state = SPI_STATE_WRITE;
+    }
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  初始化ADC模型
+ * @param  config: 模型配置
+ * @retval 无
+ */
+void SimADC_Init(const SimADC_Config_t *config)
+{
+    adc_cfg = *config;
+    if (adc_cfg.conv_us == 0)
+    {
+        adc_cfg.conv_us = SIM_ADC_CONV_US_DEFAULT;
+    }
+    if (adc_cfg.ideality <= 0.0f)
+    {
+        adc_cfg.ideality = 1.0f;
+    }
+    rng_state = adc_cfg.seed ? adc_cfg.seed : 1U;
+    
+    if (curve_count == 0)
+    {
+        curve_count = sizeof(default_curve) / sizeof(default_curve[0]);
+        memcpy(curve, default_curve, sizeof(default_curve));
+    }
+    
+    reg_config = 0;
+    converting = 0;
+    data_ready = 0;
+    spi_selected = 0;
+}
+
+/**
+ * @brief  从CSV文件加载传感器曲线
+ * @param  path: 文件路径
+ * @retval 加载的点数, -1=失败
+ */
+int SimADC_LoadCurve(const char *path)
+{
+    char line[128];
+    float voltage, temperature;
+    int count = 0;
+    FILE *fp = fopen(path, "r");
+    
+    if (fp == NULL)
+    {
+        return -1;
+    }
+    
+    /* 不能解析的行（标题、空行）跳过 */
+    while (fgets(line, sizeof(line), fp) != NULL && count < SIM_ADC_CURVE_MAX)
+    {
+        if (sscanf(line, "%f , %f", &voltage, &temperature) == 2)
+        {
+            curve[count].voltage = voltage;
+            curve[count].temperature = temperature;
+            count++;
+        }
+    }
+    fclose(fp);
+    
+    if (count < 2)
+    {
+        curve_count = 0;
+        return -1;
+    }
+    
+    qsort(curve, count, sizeof(curve[0]), Curve_Compare);
+    curve_count = count;
+    
+    return count;
+}
+
+/**
+ * @brief  片选变化
+ * @param  selected: 1=片选有效, 0=释放
+ * @retval 无
+ */
+void SimADC_Select(uint8_t selected)
+{
+    /* 每次片选开始一个新帧 */
+    if (selected && !spi_selected)
+    {
+        spi_state = SPI_STATE_IDLE;
+    }
+    spi_selected = selected;
+}
+
+/**
+ * @brief  SPI交换一个字节
+ * @param  tx: 主机发出的字节
+ * @retval 返回给主机的字节
+ */
+uint8_t SimADC_Transfer(uint8_t tx)
+{
+    uint8_t rx = 0;
+    
+    if (!spi_selected)
+    {
+        return 0xFF;
+    }
+    
+    switch (spi_state)
+    {
+        case SPI_STATE_IDLE:
+            ADC_Command(tx);
+            break;
+        
+        case SPI_STATE_WRITE:
+            if (spi_reg == ADC_REG_CONFIG)
+            {
+                reg_config = tx;
+            }
+            spi_state = SPI_STATE_IGNORE;
+            break;
+        
+        case SPI_STATE_READ:
+            if (spi_out_pos < spi_out_len)
+            {
+                rx = spi_out[spi_out_pos++];
+            }
+            break;
+        
+        default:
+            break;
+    }
+    
+    return rx;
+}
+
+/**
+ * @brief  DRDY状态
+ * @retval 1=有数据, 0=无
+ */
+uint8_t SimADC_IsDataReady(void)
+{
+    return data_ready;
+}
+
+/**
+ * @brief  推进模型时间
+ * @param  now_ns: 当前时刻
+ * @retval 1=转换在此期间完成, 0=无
+ */
+uint8_t SimADC_Poll(uint64_t now_ns)
+{
+    if (!converting || now_ns < conv_done_ns)
+    {
+        return 0;
+    }
+    
+    data_raw = ADC_Convert(now_ns);
+    data_ready = 1;
+    converting = 0;
+    
+    return 1;
+}
+
+/**
+ * @brief  下一次转换完成的时刻
+ * @retval 时刻 (ns)
+ */
+uint64_t SimADC_NextEvent(void)
+{
+    return converting ? conv_done_ns : UINT64_MAX;
+}
+
+/**
+ * @brief  传感器当前温度
+ * @param  now_ns: 当前时刻
+ * @retval 温度 (K)
+ */
+float SimADC_GetTemperature(uint64_t now_ns)
+{
+    float temp_k = adc_cfg.temp_k + adc_cfg.ramp_k_per_s * (float)(now_ns / 1000000ULL) / 1000.0f;
+    
+    return (temp_k > 0.1f) ? temp_k : 0.1f;
+}
+
+/**
+ * @brief  传感器当前端电压（不含噪声）
+ * @param  now_ns: 当前时刻
+ * @retval 电压 (mV)
+ */
+float SimADC_GetVoltage(uint64_t now_ns)
+{
+    float temp_k;
+    float current_ua;
+    float mv;
+    
+    if (adc_cfg.fault == SIM_FAULT_OPEN)
+    {
+        return SIM_ADC_OPEN_MV;
+    }
+    if (adc_cfg.fault == SIM_FAULT_SHORT)
+    {
+        return 0.0f;
+    }
+    
+    current_ua = SimDAC_GetExcitationUA();
+    if (current_ua < SIM_ADC_MIN_UA)
+    {
+        return 0.0f;
+    }
+    
+    /* 激励电流偏离曲线电流时按二极管方程修正 */
+    temp_k = SimADC_GetTemperature(now_ns);
+    mv = Curve_Voltage(temp_k) +
+         adc_cfg.ideality * SIM_ADC_K_OVER_Q_MV * temp_k * logf(current_ua / SIM_ADC_CURVE_UA);
+    
+    return (mv > 0.0f) ? mv : 0.0f;
+}
+
+/**
+ * @brief  直接给出一次转换结果
+ * @param  raw: 24位码值
+ * @retval 无
+ */
+void SimADC_InjectRaw(uint32_t raw)
+{
+    converting = 0;
+    data_raw = raw & 0xFFFFFFU;
+    data_ready = 1;
+}
+
+/**
+ * @brief  曲线插值（10μA激励，不含噪声与故障）
+ * @param  temp_k: 温度 (K)
+ * @retval 电压 (mV)
+ */
+float SimADC_CurveVoltage(float temp_k)
+{
+    return Curve_Voltage(temp_k);
+}
+
+/**
+ * @brief  曲线温度范围
+ * @param  t_min: 最低温度 (K)
+ * @param  t_max: 最高温度 (K)
+ * @retval 无
+ */
+void SimADC_GetCurveRange(float *t_min, float *t_max)
+{
+    *t_min = curve[0].temperature;
+    *t_max = curve[curve_count - 1].temperature;
+}
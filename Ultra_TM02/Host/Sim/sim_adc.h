@@ -0,0 +1,149 @@
+/**
+ * @file    sim_adc.h
+ * @brief   ADC芯片与二极管传感器模型头文件
+ * @details 按svc_adc.c使用的SPI协议模拟24位ADC：
+ *          - 0xFF: 复位
+ *          - ADC_CMD_START: 启动一次转换，转换时间到后DRDY拉低
+ *          - reg | ADC_CMD_READ: 读寄存器，DATA寄存器读出3字节（MSB first）并使DRDY回高
+ *          - reg: 写寄存器，后跟1字节数据（CONFIG的bit4-6为增益）
+ *          输入电压由二极管模型给出：
+ *          V = Curve(T) + n·kT/q·ln(I/10μA) + 高斯噪声
+ *          其中Curve为10μA激励下的电压-温度曲线，I为DAC1设定的激励电流
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __SIM_ADC_H
+#define __SIM_ADC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include <stdint.h>
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 曲线最大点数（与分度表TEMP_TABLE_MAX_POINTS相同） */
+#define SIM_ADC_CURVE_MAX       4871
+
+/* 默认转换时间 (μs) */
+#define SIM_ADC_CONV_US_DEFAULT 500U
+
+/* 探头开路时激励电流源的输出电压 (mV，未超过增益1满量程) */
+#define SIM_ADC_OPEN_MV         3240.0f
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 探头故障 */
+typedef enum {
+    SIM_FAULT_NONE = 0,         /* 正常 */
+    SIM_FAULT_OPEN,             /* 开路 */
+    SIM_FAULT_SHORT             /* 短路 */
+} SimFault_t;
+
+/* 模型配置 */
+typedef struct {
+    float temp_k;               /* 传感器温度 (K) */
+    float ramp_k_per_s;         /* 温度变化速率 (K/s)，0=恒温 */
+    float noise_uv;             /* 噪声标准差 (μV) */
+    float ideality;             /* 二极管理想因子n */
+    uint32_t conv_us;           /* 转换时间 (μs) */
+    uint32_t seed;              /* 噪声随机数种子 */
+    SimFault_t fault;           /* 探头故障 */
+} SimADC_Config_t;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  初始化ADC模型
+ * @param  config: 模型配置
+ * @retval 无
+ */
+void SimADC_Init(const SimADC_Config_t *config);
+
+/**
+ * @brief  从CSV文件加载传感器曲线
+ * @param  path: 文件路径，格式同上位机分度表CSV（标题行 + "电压mV,温度K"）
+ * @retval 加载的点数, -1=文件无法打开或有效点少于2个
+ */
+int SimADC_LoadCurve(const char *path);
+
+/**
+ * @brief  片选变化
+ * @param  selected: 1=片选有效（低电平）, 0=释放
+ * @retval 无
+ */
+void SimADC_Select(uint8_t selected);
+
+/**
+ * @brief  SPI交换一个字节
+ * @param  tx: 主机发出的字节
+ * @retval 返回给主机的字节
+ */
+uint8_t SimADC_Transfer(uint8_t tx);
+
+/**
+ * @brief  DRDY状态
+ * @retval 1=有数据（DRDY低电平）, 0=无
+ */
+uint8_t SimADC_IsDataReady(void);
+
+/**
+ * @brief  推进模型时间
+ * @param  now_ns: 当前时刻 (Stub_Nanos)
+ * @retval 1=转换在此期间完成（DRDY下降沿）, 0=无
+ */
+uint8_t SimADC_Poll(uint64_t now_ns);
+
+/**
+ * @brief  下一次转换完成的时刻
+ * @retval 时刻 (ns)，无进行中的转换时为UINT64_MAX
+ */
+uint64_t SimADC_NextEvent(void);
+
+/**
+ * @brief  传感器当前温度
+ * @param  now_ns: 当前时刻
+ * @retval 温度 (K)
+ */
+float SimADC_GetTemperature(uint64_t now_ns);
+
+/**
+ * @brief  传感器当前端电压（不含噪声）
+ * @param  now_ns: 当前时刻
+ * @retval 电压 (mV)
+ */
+float SimADC_GetVoltage(uint64_t now_ns);
+
+/**
+ * @brief  直接给出一次转换结果（回放记录的码值）
+ * @param  raw: 24位码值
+ * @note   取消进行中的转换，数据就绪（DRDY低电平），下次读DATA寄存器得到该码值
+ * @retval 无
+ */
+void SimADC_InjectRaw(uint32_t raw);
+
+/**
+ * @brief  曲线插值（10μA激励，不含噪声与故障）
+ * @param  temp_k: 温度 (K)
+ * @retval 电压 (mV)，超出曲线范围时取端点值
+ * @note   需先调用SimADC_Init()
+ */
+float SimADC_CurveVoltage(float temp_k);
+
+/**
+ * @brief  曲线温度范围
+ * @param  t_min: 最低温度 (K)
+ * @param  t_max: 最高温度 (K)
+ * @retval 无
+ */
+void SimADC_GetCurveRange(float *t_min, float *t_max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_ADC_H */
@@ -0,0 +1,186 @@
+/**
+ * @file    sim_board.c
+ * @brief   虚拟TM02板级连接源文件
+ * @details 实现SPI路由、采样定时器、中断处理函数以及Stub_Poll()/Stub_Wait()
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#define _GNU_SOURCE
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "sim_board.h"
+#include "sim_adc.h"
+#include "sim_dac.h"
+#include "sim_usb.h"
+#include "bsp_tim.h"
+#include "bsp_trace.h"
+#include <poll.h>
+#include <time.h>
+
+/* 外部函数 ------------------------------------------------------------------*/
+extern void SVC_ADC_DRDY_Callback(void);
+extern void SVC_ADC_Trigger_Callback(void);
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* SysTick周期 (ns) */
+#define SIM_SYSTICK_NS          1000000ULL
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 采样定时器 */
+static uint8_t tim_running = 0;
+static uint64_t tim_period_ns = 0;
+static uint64_t tim_next_ns = 0;
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  EXTI0中断处理 (ADC_DRDY)
+ * @note   同Core/Src/stm32f4xx_it.c
+ */
+static void Sim_EXTI0_IRQHandler(void)
+{
+    TRACE_BEGIN(TRACE_EVT_DRDY_IRQ, 0);
+    SVC_ADC_DRDY_Callback();
+    TRACE_END(TRACE_EVT_DRDY_IRQ, 0);
+}
+
+/**
+ * @brief  TIM2中断处理 (ADC采样触发)
+ * @note   同Core/Src/stm32f4xx_it.c
+ */
+static void Sim_TIM2_IRQHandler(void)
+{
+    TRACE_BEGIN(TRACE_EVT_TIM_IRQ, 0);
+    SVC_ADC_Trigger_Callback();
+    TRACE_END(TRACE_EVT_TIM_IRQ, 0);
+}
+
+/**
+ * @brief  较早的时刻
+ */
+static uint64_t Min_Ns(uint64_t a, uint64_t b)
+{
+    return (a < b) ? a : b;
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  登记中断处理函数并设置优先级
+ * @retval 无
+ */
+void SimBoard_Init(void)
+{
+    Stub_SetVector(EXTI0_IRQn, Sim_EXTI0_IRQHandler);
+    Stub_SetVector(TIM2_IRQn, Sim_TIM2_IRQHandler);
+    Stub_SetVector(OTG_FS_IRQn, SimUSB_IRQHandler);
+    
+    HAL_NVIC_SetPriority(EXTI0_IRQn, SIM_IRQ_PRIORITY_ADC, 0);
+    HAL_NVIC_SetPriority(OTG_FS_IRQn, SIM_IRQ_PRIORITY_USB, 0);
+    HAL_NVIC_EnableIRQ(EXTI0_IRQn);
+    HAL_NVIC_EnableIRQ(OTG_FS_IRQn);
+}
+
+/**
+ * @brief  SPI总线交换一个字节
+ * @param  tx: 发送字节
+ * @retval 接收字节
+ */
+uint8_t SimBoard_SpiTransfer(uint8_t tx)
+{
+    /* DAC只接收；MISO只由ADC驱动，未选中时为0xFF */
+    SimDAC_Transfer(tx);
+    
+    return SimADC_Transfer(tx);
+}
+
+/**
+ * @brief  采样定时器状态
+ * @param  running: 1=计数中, 0=停止
+ * @param  period_us: 触发周期 (μs)
+ * @param  restart: 1=计数器清零并立即产生一次更新事件
+ * @retval 无
+ */
+void SimBoard_SetTimer(uint8_t running, uint32_t period_us, uint8_t restart)
+{
+    uint64_t now = Stub_Nanos();
+    uint64_t period_ns = (uint64_t)period_us * 1000ULL;
+    
+    if (restart)
+    {
+        tim_next_ns = now + period_ns;
+        HAL_NVIC_SetPendingIRQ(TIM2_IRQn);
+    }
+    else if (running && !tim_running)
+    {
+        tim_next_ns = now + period_ns;
+    }
+    
+    tim_running = running;
+    tim_period_ns = period_ns;
+}
+
+/**
+ * @brief  外设模型轮询：把到期的事件挂起为中断
+ * @retval 无
+ */
+void Stub_Poll(void)
+{
+    uint64_t now = Stub_Nanos();
+    
+    /* 定时器更新：落后多个周期时只挂起一次，与硬件UIF相同 */
+    if (tim_running && tim_period_ns != 0 && now >= tim_next_ns)
+    {
+        tim_next_ns += ((now - tim_next_ns) / tim_period_ns + 1U) * tim_period_ns;
+        HAL_NVIC_SetPendingIRQ(TIM2_IRQn);
+    }
+    
+    /* DRDY下降沿 */
+    if (SimADC_Poll(now))
+    {
+        HAL_NVIC_SetPendingIRQ(EXTI0_IRQn);
+    }
+    
+    if (SimUSB_Poll(now))
+    {
+        HAL_NVIC_SetPendingIRQ(OTG_FS_IRQn);
+    }
+}
+
+/**
+ * @brief  WFI等待：阻塞到下一个模型事件、USB数据或下一个SysTick
+ * @param  now_ns: 当前时刻
+ * @retval 无
+ */
+void Stub_Wait(uint64_t now_ns)
+{
+    uint64_t deadline = now_ns + SIM_SYSTICK_NS - now_ns % SIM_SYSTICK_NS;
+    uint64_t wait_ns;
+    struct pollfd pfd;
+    struct timespec ts;
+    
+    if (tim_running)
+    {
+        deadline = Min_Ns(deadline, tim_next_ns);
+    }
+    deadline = Min_Ns(deadline, SimADC_NextEvent());
+    deadline = Min_Ns(deadline, SimUSB_NextEvent());
+    if (deadline <= now_ns)
+    {
+        return;
+    }
+    
+    wait_ns = deadline - now_ns;
+    ts.tv_sec = (time_t)(wait_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(wait_ns % 1000000000ULL);
+    
+    /* 上位机已连接时，收到数据也唤醒 */
+    pfd.fd = SimUSB_GetFd();
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    ppoll(&pfd, (pfd.fd >= 0) ? 1 : 0, &ts, NULL);
+}
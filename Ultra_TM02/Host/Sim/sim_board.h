@@ -0,0 +1,67 @@
+/**
+ * @file    sim_board.h
+ * @brief   虚拟TM02板级连接头文件
+ * @details 把模拟BSP（本目录下的bsp_*.c）与器件模型连接起来：
+ *          - SPI1总线按片选把字节交给ADC或DAC模型
+ *          - 采样定时器、ADC DRDY和USB接收挂起为TIM2/EXTI0/OTG_FS中断，
+ *            中断处理函数与Core/Src/stm32f4xx_it.c中的内容相同
+ *          - 实现stm32f4xx_hal.h中的Stub_Poll()/Stub_Wait()：
+ *            轮询各模型，WFI时阻塞到最近的模型事件、USB数据或下一个1ms SysTick
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __SIM_BOARD_H
+#define __SIM_BOARD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+#include <stdio.h>
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 中断优先级（与固件一致：EXTI0与TIM2相同） */
+#define SIM_IRQ_PRIORITY_ADC    5
+#define SIM_IRQ_PRIORITY_USB    5
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  登记中断处理函数并设置优先级
+ * @retval 无
+ */
+void SimBoard_Init(void);
+
+/**
+ * @brief  SPI总线交换一个字节（按当前片选路由）
+ * @param  tx: 发送字节
+ * @retval 接收字节，无片选有效时为0xFF（总线上拉）
+ */
+uint8_t SimBoard_SpiTransfer(uint8_t tx);
+
+/**
+ * @brief  采样定时器状态（模拟bsp_tim.c调用）
+ * @param  running: 1=计数中, 0=停止
+ * @param  period_us: 触发周期 (μs)
+ * @param  restart: 1=计数器清零并立即产生一次更新事件
+ * @retval 无
+ */
+void SimBoard_SetTimer(uint8_t running, uint32_t period_us, uint8_t restart);
+
+/**
+ * @brief  设置串口屏输出文件（模拟bsp_uart.c实现）
+ * @param  sink: 输出文件，NULL=丢弃
+ * @retval 无
+ */
+void SimBoard_SetLcdSink(FILE *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_BOARD_H */
@@ -0,0 +1,182 @@
+/**
+ * @file    sim_dac.c
+ * @brief   DAC芯片模型源文件
+ * @details 实现输入/输出寄存器、LOAD锁存和输出日志
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "sim_dac.h"
+#include "svc_dac.h"
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* 一帧字节数 */
+#define SIM_DAC_FRAME_SIZE      3
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/* 单个通道 */
+typedef struct {
+    uint8_t selected;           /* 片选有效 */
+    uint8_t load_level;         /* LOAD引脚电平 */
+    uint8_t frame[SIM_DAC_FRAME_SIZE];
+    uint8_t frame_len;          /* 本次片选已收字节数 */
+    uint16_t input;             /* 输入寄存器 */
+    uint16_t output;            /* 输出寄存器 */
+} DacChannel_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+static DacChannel_t dac[SIM_DAC_CHANNELS];
+
+/* 锁存日志 */
+static FILE *dac_log = NULL;
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  码值对应的输出电压
+ * @param  code: 码值
+ * @retval 电压 (V)
+ */
+static float DAC_Voltage(uint16_t code)
+{
+    return code / DAC_FULLSCALE * DAC_VREF;
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  初始化DAC模型
+ * @param  log: 锁存日志
+ * @retval 无
+ */
+void SimDAC_Init(FILE *log)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SIM_DAC_CHANNELS; i++)
+    {
+        dac[i] = (DacChannel_t){ .load_level = 1 };
+    }
+    dac_log = log;
+    
+    if (dac_log != NULL)
+    {
+        fprintf(dac_log, "time_ms,channel,code,value\n");
+        fflush(dac_log);
+    }
+}
+
+/**
+ * @brief  片选变化
+ * @param  channel: 通道
+ * @param  selected: 1=片选有效, 0=释放
+ * @retval 无
+ */
+void SimDAC_Select(uint8_t channel, uint8_t selected)
+{
+    DacChannel_t *ch;
+    
+    if (channel >= SIM_DAC_CHANNELS)
+    {
+        return;
+    }
+    ch = &dac[channel];
+    
+    if (selected && !ch->selected)
+    {
+        ch->frame_len = 0;
+    }
+    
+    /* 片选释放时收满一帧才写入输入寄存器 */
+    if (!selected && ch->selected && ch->frame_len == SIM_DAC_FRAME_SIZE)
+    {
+        ch->input = ((uint16_t)ch->frame[1] << 8) | ch->frame[2];
+    }
+    
+    ch->selected = selected;
+}
+
+/**
+ * @brief  SPI交换一个字节
+ * @param  tx: 主机发出的字节
+ * @retval 0
+ */
+uint8_t SimDAC_Transfer(uint8_t tx)
+{
+    uint8_t i;
+    
+    for (i = 0; i < SIM_DAC_CHANNELS; i++)
+    {
+        if (dac[i].selected && dac[i].frame_len < SIM_DAC_FRAME_SIZE)
+        {
+            dac[i].frame[dac[i].frame_len++] = tx;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  LOAD引脚变化
+ * @param  channel: 通道
+ * @param  level: 引脚电平
+ * @retval 无
+ */
+void SimDAC_Load(uint8_t channel, uint8_t level)
+{
+    DacChannel_t *ch;
+    float value;
+    
+    if (channel >= SIM_DAC_CHANNELS)
+    {
+        return;
+    }
+    ch = &dac[channel];
+    
+    if (ch->load_level && !level)
+    {
+        ch->output = ch->input;
+        
+        if (dac_log != NULL)
+        {
+            value = (channel == 0) ? SimDAC_GetExcitationUA() : SimDAC_GetLoopMA();
+            fprintf(dac_log, "%.3f,%u,%u,%.4f\n", Stub_Nanos() / 1e6, channel + 1U,
+                    ch->output, value);
+            fflush(dac_log);
+        }
+    }
+    ch->load_level = level;
+}
+
+/**
+ * @brief  获取输出码值
+ * @param  channel: 通道
+ * @retval 码值
+ */
+uint16_t SimDAC_GetCode(uint8_t channel)
+{
+    return (channel < SIM_DAC_CHANNELS) ? dac[channel].output : 0;
+}
+
+/**
+ * @brief  获取激励电流
+ * @retval 激励电流 (μA)
+ */
+float SimDAC_GetExcitationUA(void)
+{
+    return DAC_Voltage(dac[0].output) * 1000.0f;
+}
+
+/**
+ * @brief  获取环路电流
+ * @retval 环路电流 (mA)
+ */
+float SimDAC_GetLoopMA(void)
+{
+    return DAC_Voltage(dac[1].output) * VI_COEFFICIENT;
+}
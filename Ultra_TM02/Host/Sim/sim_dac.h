@@ -0,0 +1,85 @@
+/**
+ * @file    sim_dac.h
+ * @brief   DAC芯片模型头文件
+ * @details 两片16位DAC，片选有效期间接收3字节帧 [命令, 高8位, 低8位] 到输入寄存器，
+ *          LOAD下降沿把输入寄存器锁存到输出：
+ *          - DAC1: 激励电流源，I(μA) = V(V) × 1000
+ *          - DAC2: 4-20mA环路，I(mA) = V(V) × 2.5
+ *          每次锁存可写入CSV日志（"时刻ms,通道,码值,输出"），作为输出端的负载
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __SIM_DAC_H
+#define __SIM_DAC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 通道数 */
+#define SIM_DAC_CHANNELS        2
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  初始化DAC模型（输出为0）
+ * @param  log: 锁存日志，NULL=不记录
+ * @retval 无
+ */
+void SimDAC_Init(FILE *log);
+
+/**
+ * @brief  片选变化
+ * @param  channel: 通道 (0=DAC1, 1=DAC2)
+ * @param  selected: 1=片选有效（低电平）, 0=释放
+ * @retval 无
+ */
+void SimDAC_Select(uint8_t channel, uint8_t selected);
+
+/**
+ * @brief  SPI交换一个字节（写入片选有效的通道）
+ * @param  tx: 主机发出的字节
+ * @retval 返回给主机的字节（DAC无输出，恒为0）
+ */
+uint8_t SimDAC_Transfer(uint8_t tx);
+
+/**
+ * @brief  LOAD引脚变化
+ * @param  channel: 通道
+ * @param  level: 引脚电平，下降沿锁存
+ * @retval 无
+ */
+void SimDAC_Load(uint8_t channel, uint8_t level);
+
+/**
+ * @brief  获取输出码值
+ * @param  channel: 通道
+ * @retval 已锁存的码值
+ */
+uint16_t SimDAC_GetCode(uint8_t channel);
+
+/**
+ * @brief  获取激励电流
+ * @retval DAC1对应的激励电流 (μA)
+ */
+float SimDAC_GetExcitationUA(void);
+
+/**
+ * @brief  获取环路电流
+ * @retval DAC2对应的环路电流 (mA)
+ */
+float SimDAC_GetLoopMA(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_DAC_H */
@@ -0,0 +1,240 @@
+/**
+ * @file    sim_usb.c
+ * @brief   USB CDC端点模型源文件
+ * @details 实现伪终端的创建、连接检测、分包接收和发送
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#define _GNU_SOURCE
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "sim_usb.h"
+#include "svc_usb.h"
+#include "usbd_cdc_if.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* USB设备句柄（svc_usb.c通过dev_state判断是否已枚举） */
+USBD_HandleTypeDef hUsbDeviceFS = { .dev_state = USBD_STATE_DEFAULT };
+
+/* 伪终端 */
+static int pty_fd = -1;
+static char pty_path[64];
+static char link_path[256];
+
+/* 接收：待交给svc_usb的数据包 */
+static uint8_t rx_packet[SIM_USB_PACKET_SIZE];
+static uint16_t rx_len = 0;
+static uint64_t next_poll_ns = 0;
+static uint8_t rx_throttled = 0;
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  更新连接状态
+ * @param  revents: 主端poll结果
+ */
+static void USB_UpdateState(short revents)
+{
+    if (revents & POLLHUP)
+    {
+        /* 上位机关闭端口：相当于拔出 */
+        hUsbDeviceFS.dev_state = USBD_STATE_DEFAULT;
+        rx_len = 0;
+        rx_throttled = 0;
+    }
+    else if (hUsbDeviceFS.dev_state != USBD_STATE_CONFIGURED)
+    {
+        /* 上位机打开端口：相当于枚举完成，丢弃断开期间的残留数据 */
+        tcflush(pty_fd, TCIOFLUSH);
+        hUsbDeviceFS.dev_state = USBD_STATE_CONFIGURED;
+    }
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  创建伪终端
+ * @param  link: 符号链接路径
+ * @retval 0=成功, -1=失败
+ */
+int SimUSB_Open(const char *link)
+{
+    struct termios tio;
+    const char *name;
+    
+    pty_fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (pty_fd < 0 || grantpt(pty_fd) != 0 || unlockpt(pty_fd) != 0)
+    {
+        return -1;
+    }
+    
+    name = ptsname(pty_fd);
+    if (name == NULL)
+    {
+        return -1;
+    }
+    snprintf(pty_path, sizeof(pty_path), "%s", name);
+    
+    /* 从端从未打开过时主端不报POLLHUP，先开关一次，使初始状态为未连接 */
+    close(open(pty_path, O_RDWR | O_NOCTTY));
+    
+    /* 原始模式：不回显、不做行处理，与CDC虚拟串口一样透传字节 */
+    if (tcgetattr(pty_fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tcsetattr(pty_fd, TCSANOW, &tio);
+    }
+    
+    /* 替换旧的符号链接（上次运行残留） */
+    if (link != NULL)
+    {
+        snprintf(link_path, sizeof(link_path), "%s", link);
+        unlink(link_path);
+        if (symlink(pty_path, link_path) != 0)
+        {
+            link_path[0] = '\0';
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  关闭伪终端并删除符号链接
+ * @retval 无
+ */
+void SimUSB_Close(void)
+{
+    if (link_path[0] != '\0')
+    {
+        unlink(link_path);
+        link_path[0] = '\0';
+    }
+    if (pty_fd >= 0)
+    {
+        close(pty_fd);
+        pty_fd = -1;
+    }
+}
+
+/**
+ * @brief  从端设备路径
+ * @retval 路径字符串
+ */
+const char *SimUSB_GetPath(void)
+{
+    return pty_path;
+}
+
+/**
+ * @brief  主端文件描述符
+ * @retval 文件描述符
+ */
+int SimUSB_GetFd(void)
+{
+    return (hUsbDeviceFS.dev_state == USBD_STATE_CONFIGURED) ? pty_fd : -1;
+}
+
+/**
+ * @brief  推进模型时间
+ * @param  now_ns: 当前时刻
+ * @retval 1=收到数据包, 0=无
+ */
+uint8_t SimUSB_Poll(uint64_t now_ns)
+{
+    struct pollfd pfd;
+    ssize_t n;
+    
+    /* 上一包还没交给svc_usb，或未到下一次轮询 */
+    if (pty_fd < 0 || rx_len != 0 || now_ns < next_poll_ns)
+    {
+        return 0;
+    }
+    next_poll_ns = now_ns + SIM_USB_POLL_NS;
+    
+    pfd.fd = pty_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, 0) < 0)
+    {
+        return 0;
+    }
+    USB_UpdateState(pfd.revents);
+    
+    rx_throttled = 0;
+    if (hUsbDeviceFS.dev_state != USBD_STATE_CONFIGURED || !(pfd.revents & POLLIN))
+    {
+        return 0;
+    }
+    
+    n = read(pty_fd, rx_packet, sizeof(rx_packet));
+    if (n <= 0)
+    {
+        return 0;
+    }
+    rx_len = (uint16_t)n;
+    
+    /* 满包时可能还有数据，到下一次轮询时刻再读 */
+    rx_throttled = (n == (ssize_t)sizeof(rx_packet));
+    
+    return 1;
+}
+
+/**
+ * @brief  下一次接收轮询的时刻
+ * @retval 时刻 (ns)
+ */
+uint64_t SimUSB_NextEvent(void)
+{
+    return rx_throttled ? next_poll_ns : UINT64_MAX;
+}
+
+/**
+ * @brief  OTG_FS中断
+ * @retval 无
+ */
+void SimUSB_IRQHandler(void)
+{
+    if (rx_len != 0)
+    {
+        SVC_USB_RxCallback(rx_packet, rx_len);
+        rx_len = 0;
+    }
+}
+
+/**
+ * @brief  通过CDC端点发送数据
+ * @param  Buf: 数据缓冲区
+ * @param  Len: 数据长度
+ * @retval USBD_OK=成功, USBD_FAIL=失败
+ */
+uint8_t CDC_Transmit_FS(uint8_t *Buf, uint16_t Len)
+{
+    ssize_t n;
+    
+    if (hUsbDeviceFS.dev_state != USBD_STATE_CONFIGURED)
+    {
+        return USBD_FAIL;
+    }
+    
+    /* 上位机长时间不读取时伪终端缓冲区写满，与USB主机不再轮询IN端点一样丢弃 */
+    n = write(pty_fd, Buf, Len);
+    if (n < 0 && errno == EIO)
+    {
+        hUsbDeviceFS.dev_state = USBD_STATE_DEFAULT;
+    }
+    
+    return (n == (ssize_t)Len) ? USBD_OK : USBD_FAIL;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file    sim_usb.h
+ * @brief   USB CDC端点模型头文件
+ * @details 以伪终端(pty)代替USB虚拟串口：上位机打开从端即视为枚举完成，
+ *          关闭后视为断开并丢弃未读数据；主端按全速Bulk端点每包64字节、
+ *          每125μs最多一包送入svc_usb（OTG_FS中断），发送直接写入主端
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __SIM_USB_H
+#define __SIM_USB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include <stdint.h>
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* Bulk OUT包长 (字节) */
+#define SIM_USB_PACKET_SIZE     64
+
+/* 接收轮询间隔 (ns) */
+#define SIM_USB_POLL_NS         125000ULL
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  创建伪终端
+ * @param  link: 指向从端设备的符号链接路径，NULL=不创建
+ * @retval 0=成功, -1=失败
+ */
+int SimUSB_Open(const char *link);
+
+/**
+ * @brief  关闭伪终端并删除符号链接
+ * @retval 无
+ */
+void SimUSB_Close(void);
+
+/**
+ * @brief  从端设备路径
+ * @retval 路径字符串
+ */
+const char *SimUSB_GetPath(void);
+
+/**
+ * @brief  主端文件描述符（供等待时poll）
+ * @retval 文件描述符, -1=未打开
+ */
+int SimUSB_GetFd(void);
+
+/**
+ * @brief  推进模型时间：更新连接状态，接收一包数据
+ * @param  now_ns: 当前时刻
+ * @retval 1=收到数据包（应挂起OTG_FS中断）, 0=无
+ */
+uint8_t SimUSB_Poll(uint64_t now_ns);
+
+/**
+ * @brief  下一次接收轮询的时刻
+ * @retval 时刻 (ns)，上位机未连接时为UINT64_MAX（等待时改由poll唤醒）
+ */
+uint64_t SimUSB_NextEvent(void);
+
+/**
+ * @brief  OTG_FS中断：把收到的数据包交给svc_usb
+ * @retval 无
+ */
+void SimUSB_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_USB_H */
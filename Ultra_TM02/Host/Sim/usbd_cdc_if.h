@@ -0,0 +1,64 @@
+/**
+ * @file    usbd_cdc_if.h
+ * @brief   主机模拟用USB CDC接口头文件
+ * @details 代替USB_DEVICE/App/usbd_cdc_if.h，只提供svc_usb.c用到的部分；
+ *          CDC端点由sim_usb.c以伪终端(pty)实现
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __USBD_CDC_IF_H
+#define __USBD_CDC_IF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 设备状态（与USBD_def.h一致） */
+#define USBD_STATE_DEFAULT      0x01U
+#define USBD_STATE_ADDRESSED    0x02U
+#define USBD_STATE_CONFIGURED   0x03U
+#define USBD_STATE_SUSPENDED    0x04U
+
+/* 返回值 */
+#define USBD_OK                 0U
+#define USBD_BUSY               1U
+#define USBD_FAIL               3U
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/* 设备句柄（只模拟设备状态） */
+typedef struct {
+    __IO uint8_t dev_state;
+} USBD_HandleTypeDef;
+
+/* 外部变量 ------------------------------------------------------------------*/
+extern USBD_HandleTypeDef hUsbDeviceFS;
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  通过CDC端点发送数据
+ * @param  Buf: 数据缓冲区
+ * @param  Len: 数据长度
+ * @retval USBD_OK=成功, USBD_FAIL=上位机未打开端口或未及时读取
+ */
+uint8_t CDC_Transmit_FS(uint8_t *Buf, uint16_t Len);
+
+/**
+ * @brief  获取发送状态（svc_usb.c中的弱函数，伪终端写入立即完成）
+ * @retval 0=空闲
+ */
+uint8_t CDC_GetTxState(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBD_CDC_IF_H */
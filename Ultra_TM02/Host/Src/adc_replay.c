@@ -0,0 +1,478 @@
+/**
+ * @file    adc_replay.c
+ * @brief   原始采样回放：把现场录制的ADC码值送入固件测量流水线
+ * @details 与vtm02相同，App/、Service/按原样编译。录制文件（上位机通过CMD_CAPTURE
+ *          读出保存）中的每个码值按记录的时间戳注入ADC模型，经真实的DRDY中断处理
+ *          (svc_adc.c) 进入FIFO，再由app_temp.c完成中值/滑动平均滤波、探头检查和
+ *          查表，由app_output.c经svc_dac.c写DAC。时间使用虚拟时钟，不等待实际时间，
+ *          输出限速等依赖HAL_GetTick()的逻辑与现场一致。
+ *          每完成一次读数输出一行CSV：
+ *            time_s,voltage_mV,temp_K,temp_C,probe,current_mA,loop_mA
+ *          loop_mA为DAC模型按写入码值得到的环路电流（含量化）。
+ *          修改app_temp_calc.h中的滤波/查表内核或换用其他分度表(-T)后重新回放，
+ *          即可用现场数据比较效果。
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ *
+ * 用法:
+ *   ./adc_replay [选项] CAPTURE.tmc
+ *     -T, --table CSV       分度表（格式同上位机下载的CSV），覆盖Flash镜像中的分度表
+ *     -f, --flash PATH      Flash镜像文件（如vtm02的-f文件），使用其中已下载的分度表
+ *     -o, --out PATH        输出CSV，默认标准输出
+ *         --t4 C            覆盖录制时的4mA温度点 (℃)
+ *         --t20 C           覆盖录制时的20mA温度点 (℃)
+ *     -q, --quiet           不输出CSV，只打印统计
+ *
+ * 录制文件格式（小端）：
+ *   48字节文件头 [魔数"TMCP"][版本 u16][头长度 u16][采样周期μs u32][增益 f32]
+ *                [参考电压V f32][4mA温度℃ f32][20mA温度℃ f32][分度表点数 u16]
+ *                [电流源 u8][保留 u8][记录数 u32][丢弃数 u32][开始时间 u32][保留 u32]
+ *   随后每条记录6字节 [码值 u24][相对上一条的间隔μs u24]；记录数为0时按文件长度计算
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+#include "sim_adc.h"
+#include "sim_dac.h"
+
+/* BSP层头文件 */
+#include "bsp_gpio.h"
+#include "bsp_flash.h"
+#include "bsp_dwt.h"
+
+/* Service层头文件 */
+#include "svc_adc.h"
+#include "svc_dac.h"
+
+/* App层头文件 */
+#include "app_temp.h"
+#include "app_output.h"
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* 外部函数 ------------------------------------------------------------------*/
+extern void SVC_ADC_DRDY_Callback(void);
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* 录制文件 */
+#define CAPTURE_MAGIC           "TMCP"
+#define CAPTURE_VERSION         1
+#define CAPTURE_HEADER_SIZE     48
+#define CAPTURE_RECORD_SIZE     6
+
+/* 第一个样本的虚拟时刻：留出初始化中HAL_Delay()的时间 (ns) */
+#define REPLAY_START_NS         1000000000ULL
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/* 录制文件头 */
+typedef struct {
+    uint32_t sample_period_us;
+    float gain;
+    float vref;
+    float temp_4mA;
+    float temp_20mA;
+    uint16_t table_points;
+    uint8_t current_src;
+    uint32_t record_count;
+    uint32_t lost;
+    uint32_t start_time;
+} CaptureHeader_t;
+
+/* 命令行选项 */
+typedef struct {
+    const char *capture;
+    const char *table;
+    const char *flash;
+    const char *out;
+    float temp_4mA;
+    float temp_20mA;
+    uint8_t set_4mA;
+    uint8_t set_20mA;
+    uint8_t quiet;
+} Options_t;
+
+/* 回放统计 */
+typedef struct {
+    uint32_t samples;
+    uint32_t readings;
+    uint32_t probe_errors;
+    uint64_t duration_ns;
+    float temp_min;
+    float temp_max;
+} ReplayStats_t;
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  固件错误处理：回放中直接退出
+ */
+void Error_Handler(void)
+{
+    fprintf(stderr, "adc_replay: Error_Handler\n");
+    exit(1);
+}
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t get_u24(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+}
+
+/**
+ * @brief  读取录制文件
+ * @param  path: 文件路径
+ * @param  header: 输出文件头
+ * @param  count: 输出记录数
+ * @retval 记录数据（count×6字节），失败返回NULL
+ */
+static uint8_t *load_capture(const char *path, CaptureHeader_t *header, uint32_t *count)
+{
+    uint8_t head[CAPTURE_HEADER_SIZE];
+    uint8_t *records;
+    uint16_t version, header_size;
+    long size;
+    FILE *fp = fopen(path, "rb");
+    
+    if (fp == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+    
+    if (fread(head, 1, sizeof(head), fp) != sizeof(head) || memcmp(head, CAPTURE_MAGIC, 4) != 0)
+    {
+        fprintf(stderr, "%s: not a capture file\n", path);
+        fclose(fp);
+        return NULL;
+    }
+    
+    memcpy(&version, &head[4], 2);
+    memcpy(&header_size, &head[6], 2);
+    if (version != CAPTURE_VERSION || header_size < CAPTURE_HEADER_SIZE)
+    {
+        fprintf(stderr, "%s: unsupported version %u\n", path, version);
+        fclose(fp);
+        return NULL;
+    }
+    
+    memcpy(&header->sample_period_us, &head[8], 4);
+    memcpy(&header->gain, &head[12], 4);
+    memcpy(&header->vref, &head[16], 4);
+    memcpy(&header->temp_4mA, &head[20], 4);
+    memcpy(&header->temp_20mA, &head[24], 4);
+    memcpy(&header->table_points, &head[28], 2);
+    header->current_src = head[30];
+    memcpy(&header->record_count, &head[32], 4);
+    memcpy(&header->lost, &head[36], 4);
+    memcpy(&header->start_time, &head[40], 4);
+    
+    /* 未正常结束的录制：按文件长度计算记录数 */
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp) - header_size;
+    *count = (uint32_t)(size / CAPTURE_RECORD_SIZE);
+    if (header->record_count != 0 && header->record_count < *count)
+    {
+        *count = header->record_count;
+    }
+    
+    records = malloc((size_t)*count * CAPTURE_RECORD_SIZE + 1);
+    fseek(fp, header_size, SEEK_SET);
+    if (records == NULL ||
+        fread(records, CAPTURE_RECORD_SIZE, *count, fp) != *count)
+    {
+        fprintf(stderr, "%s: read error\n", path);
+        free(records);
+        fclose(fp);
+        return NULL;
+    }
+    fclose(fp);
+    
+    return records;
+}
+
+/**
+ * @brief  把分度表CSV按文件中的顺序写入模拟Flash（与上位机下载的结果相同）
+ * @retval 数据点数, -1=失败
+ */
+static int load_table(const char *path)
+{
+    TempTableHeader_t *header = (TempTableHeader_t *)(uintptr_t)TEMP_TABLE_FLASH_ADDR;
+    TempTablePoint_t *points = (TempTablePoint_t *)(uintptr_t)(TEMP_TABLE_FLASH_ADDR + sizeof(TempTableHeader_t));
+    char line[128];
+    float voltage, temperature;
+    int count = 0;
+    FILE *fp = fopen(path, "r");
+    
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    
+    /* 不能解析的行（标题、空行）跳过 */
+    while (fgets(line, sizeof(line), fp) != NULL && count < TEMP_TABLE_MAX_POINTS)
+    {
+        if (sscanf(line, "%f , %f", &voltage, &temperature) == 2)
+        {
+            points[count].voltage = voltage;
+            points[count].temperature = temperature;
+            count++;
+        }
+    }
+    fclose(fp);
+    
+    if (count == 0)
+    {
+        fprintf(stderr, "%s: no table points\n", path);
+        return -1;
+    }
+    
+    header->magic = TEMP_TABLE_MAGIC;
+    header->point_count = (uint16_t)count;
+    header->reserved = 0;
+    
+    return count;
+}
+
+/**
+ * @brief  增益系数转ADC_GAIN_x设置值
+ */
+static uint8_t gain_code(float gain)
+{
+    uint8_t code = 0;
+    
+    while (code < ADC_GAIN_128 && (float)(1U << (code + 1)) <= gain + 0.5f)
+    {
+        code++;
+    }
+    
+    return code;
+}
+
+/**
+ * @brief  按录制时的设置初始化测量流水线
+ * @note   初始化顺序与App_Init()相同，只保留测量与输出通道
+ */
+static void pipeline_init(const CaptureHeader_t *header, const Options_t *opt)
+{
+    BSP_GPIO_Init();
+    BSP_DWT_Init();
+    BSP_Flash_Init();
+    
+    SVC_DAC_Init();
+    SVC_ADC_Init();
+    SVC_ADC_SetGain(gain_code(header->gain));
+    if (header->vref > 0.0f)
+    {
+        SVC_ADC_SetVref(header->vref);
+    }
+    
+    APP_Output_Init();
+    APP_Output_Set4mATemp(opt->set_4mA ? opt->temp_4mA : header->temp_4mA);
+    APP_Output_Set20mATemp(opt->set_20mA ? opt->temp_20mA : header->temp_20mA);
+    
+    APP_Temp_Init();
+    APP_Temp_SetCurrentSource(header->current_src);
+    
+    /* 样本由回放注入：停止定时触发，只保留DRDY读取路径 */
+    APP_Temp_Start();
+    SVC_ADC_StopConversion();
+}
+
+/**
+ * @brief  注入一个样本并运行测量任务直到没有待处理的工作
+ */
+static void replay_sample(uint32_t raw, uint64_t t_ns)
+{
+    Stub_SetVirtualTime(t_ns);
+    
+    /* 被限速暂存的输出在样本时刻补发（现场在到期时刻补发） */
+    if (APP_Output_IsDue())
+    {
+        APP_Output_Process();
+    }
+    
+    SimADC_InjectRaw(raw);
+    SVC_ADC_DRDY_Callback();
+    
+    while (APP_Temp_HasWork())
+    {
+        APP_Temp_Process();
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [-T table.csv] [-f flash.bin] [-o out.csv] [--t4 C] [--t20 C] [-q]\n"
+            "          capture.tmc\n",
+            prog);
+}
+
+/* 主函数 --------------------------------------------------------------------*/
+
+int main(int argc, char **argv)
+{
+    static const struct option long_opts[] = {
+        { "table", required_argument, NULL, 'T' },
+        { "flash", required_argument, NULL, 'f' },
+        { "out",   required_argument, NULL, 'o' },
+        { "t4",    required_argument, NULL, '4' },
+        { "t20",   required_argument, NULL, '2' },
+        { "quiet", no_argument,       NULL, 'q' },
+        { NULL, 0, NULL, 0 }
+    };
+    Options_t opt = {0};
+    CaptureHeader_t header;
+    ReplayStats_t stats = {0};
+    SimADC_Config_t adc = { .temp_k = 77.0f, .ideality = 1.0f };
+    FILE *out = stdout;
+    uint8_t *records;
+    uint32_t count, i;
+    uint32_t last_count = 0;
+    uint64_t t_ns;
+    double wall;
+    float temp_k;
+    int c;
+    
+    while ((c = getopt_long(argc, argv, "T:f:o:q", long_opts, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 'T': opt.table = optarg; break;
+            case 'f': opt.flash = optarg; break;
+            case 'o': opt.out = optarg; break;
+            case '4': opt.temp_4mA = strtof(optarg, NULL); opt.set_4mA = 1; break;
+            case '2': opt.temp_20mA = strtof(optarg, NULL); opt.set_20mA = 1; break;
+            case 'q': opt.quiet = 1; break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    if (optind != argc - 1)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    opt.capture = argv[optind];
+    
+    records = load_capture(opt.capture, &header, &count);
+    if (records == NULL)
+    {
+        return 2;
+    }
+    
+    /* 初始化期间也使用虚拟时钟 */
+    Stub_SetVirtualTime(0);
+    if ((opt.flash != NULL) ? Stub_FlashMapFile(opt.flash) : Stub_FlashMap())
+    {
+        fprintf(stderr, "adc_replay: cannot map flash at 0x%08X\n", FLASH_BASE_ADDR);
+        return 2;
+    }
+    if (opt.table != NULL && load_table(opt.table) < 0)
+    {
+        return 2;
+    }
+    if (APP_Temp_TableVerify() != 0)
+    {
+        fprintf(stderr, "adc_replay: no valid table, use -T or -f\n");
+        return 2;
+    }
+    if (header.table_points != 0 && header.table_points != APP_Temp_GetTablePoints())
+    {
+        fprintf(stderr, "adc_replay: note: table has %u points, device had %u\n",
+                APP_Temp_GetTablePoints(), header.table_points);
+    }
+    
+    SimADC_Init(&adc);
+    SimDAC_Init(NULL);
+    pipeline_init(&header, &opt);
+    
+    if (opt.out != NULL)
+    {
+        out = fopen(opt.out, "w");
+        if (out == NULL)
+        {
+            perror(opt.out);
+            return 2;
+        }
+    }
+    if (!opt.quiet)
+    {
+        fprintf(out, "time_s,voltage_mV,temp_K,temp_C,probe,current_mA,loop_mA\n");
+    }
+    
+    wall = now_sec();
+    t_ns = REPLAY_START_NS;
+    for (i = 0; i < count; i++)
+    {
+        t_ns += (uint64_t)get_u24(&records[i * CAPTURE_RECORD_SIZE + 3]) * 1000ULL;
+        replay_sample(get_u24(&records[i * CAPTURE_RECORD_SIZE]), t_ns);
+        stats.samples++;
+        
+        /* 完成一次读数（输出阶段结束时计数加一） */
+        if (APP_Temp_GetSampleCount() == last_count)
+        {
+            continue;
+        }
+        last_count = APP_Temp_GetSampleCount();
+        stats.readings++;
+        
+        temp_k = APP_Temp_GetValueK();
+        if (APP_Temp_GetProbeStatus() != PROBE_STATUS_OK)
+        {
+            stats.probe_errors++;
+        }
+        else
+        {
+            if (stats.readings == stats.probe_errors + 1 || temp_k < stats.temp_min)
+            {
+                stats.temp_min = temp_k;
+            }
+            if (stats.readings == stats.probe_errors + 1 || temp_k > stats.temp_max)
+            {
+                stats.temp_max = temp_k;
+            }
+        }
+        
+        if (!opt.quiet)
+        {
+            fprintf(out, "%.6f,%.4f,%.4f,%.4f,%d,%.4f,%.4f\n",
+                    (t_ns - REPLAY_START_NS) / 1e9, APP_Temp_GetVoltage(), temp_k,
+                    APP_Temp_GetValue(), (int)APP_Temp_GetProbeStatus(),
+                    APP_Output_GetCurrent(), SimDAC_GetLoopMA());
+        }
+    }
+    wall = now_sec() - wall;
+    stats.duration_ns = t_ns - REPLAY_START_NS;
+    
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    free(records);
+    
+    fprintf(stderr, "%u samples (%u lost in capture), %u readings, %u probe errors, "
+            "T %.3f ~ %.3f K\n", stats.samples, header.lost, stats.readings,
+            stats.probe_errors, stats.temp_min, stats.temp_max);
+    fprintf(stderr, "%.1f s recorded, replayed in %.3f s (%.0fx real time)\n",
+            stats.duration_ns / 1e9, wall,
+            (wall > 0.0) ? stats.duration_ns / 1e9 / wall : 0.0);
+    
+    return 0;
+}
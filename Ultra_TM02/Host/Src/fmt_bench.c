@@ -0,0 +1,219 @@
+/**
+ * @file    fmt_bench.c
+ * @brief   svc_fmt主机基准与等价性检查程序
+ * @details 在PC上编译运行：
+ *          - check: 遍历显示范围内全部float位模式，逐字符比对SVC_FMT_Float与snprintf
+ *          - bench: 对比SVC_FMT_Float、SVC_FMT_Fixed与snprintf的单次耗时
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ *
+ * 用法:
+ *   ./fmt_bench check [stride]   stride=1为穷举（默认），>1为按位模式抽样
+ *   ./fmt_bench bench [count]    默认1000万次
+ */
+
+#include "svc_fmt.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* 显示范围定义 */
+typedef struct {
+    const char *name;       /* 名称 */
+    float max_abs;          /* 最大绝对值 */
+    uint8_t decimals;       /* 小数位数 */
+} FmtRange_t;
+
+static const FmtRange_t ranges[] = {
+    { "temperature_C", 500.0f,  3 },    /* 温度 (℃)，含负值 */
+    { "voltage_mV",    5000.0f, 3 },    /* 电压 (mV) */
+    { "current_mA",    25.0f,   2 },    /* 输出电流 (mA) */
+};
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t float_bits(float f)
+{
+    uint32_t b;
+    memcpy(&b, &f, sizeof(b));
+    return b;
+}
+
+static float bits_float(uint32_t b)
+{
+    float f;
+    memcpy(&f, &b, sizeof(f));
+    return f;
+}
+
+/**
+ * @brief  穷举比对一个范围（正负两侧）
+ * @retval 不一致数量
+ */
+static uint64_t check_range(const FmtRange_t *r, uint32_t stride)
+{
+    char ref[48], out[48];
+    uint32_t limit = float_bits(r->max_abs);
+    uint64_t checked = 0, mismatches = 0;
+    uint32_t b;
+    int sign;
+    double t0 = now_sec();
+    
+    for (b = 0; b <= limit; b += stride)
+    {
+        for (sign = 0; sign < 2; sign++)
+        {
+            float v = bits_float(b | (sign ? 0x80000000u : 0));
+            snprintf(ref, sizeof(ref), "%.*f", r->decimals, (double)v);
+            SVC_FMT_Float(out, sizeof(out), v, r->decimals);
+            checked++;
+            if (strcmp(ref, out) != 0)
+            {
+                if (mismatches < 10)
+                {
+                    printf("  MISMATCH %s bits=0x%08X ref=\"%s\" out=\"%s\"\n",
+                           r->name, b | (sign ? 0x80000000u : 0), ref, out);
+                }
+                mismatches++;
+            }
+        }
+        if (limit - b < stride)
+        {
+            break;
+        }
+    }
+    
+    printf("%-14s decimals=%u checked=%llu mismatches=%llu (%.1f s)\n",
+           r->name, r->decimals, (unsigned long long)checked,
+           (unsigned long long)mismatches, now_sec() - t0);
+    return mismatches;
+}
+
+/**
+ * @brief  检查特殊值与定点接口
+ * @retval 不一致数量
+ */
+static uint64_t check_special(void)
+{
+    static const struct { int32_t v; uint8_t d; const char *exp; } fixed[] = {
+        { 0, 3, "0.000" }, { 5, 3, "0.005" }, { -5, 3, "-0.005" },
+        { 12345, 3, "12.345" }, { -12345, 3, "-12.345" }, { 7, 0, "7" },
+        { 2147483647, 6, "2147.483647" }, { -2147483647 - 1, 2, "-21474836.48" },
+    };
+    const float specials[] = { 0.0f, -0.0f, 1.0f / 0.0f, -1.0f / 0.0f, 0.0005f, -0.0005f, 0.0025f };
+    char ref[48], out[48];
+    uint64_t bad = 0;
+    unsigned i;
+    uint8_t d;
+    
+    for (i = 0; i < sizeof(specials) / sizeof(specials[0]); i++)
+    {
+        for (d = 0; d <= FMT_MAX_DECIMALS; d++)
+        {
+            snprintf(ref, sizeof(ref), "%.*f", d, (double)specials[i]);
+            SVC_FMT_Float(out, sizeof(out), specials[i], d);
+            if (strcmp(ref, out) != 0)
+            {
+                printf("  MISMATCH special ref=\"%s\" out=\"%s\"\n", ref, out);
+                bad++;
+            }
+        }
+    }
+    
+    for (i = 0; i < sizeof(fixed) / sizeof(fixed[0]); i++)
+    {
+        SVC_FMT_Fixed(out, sizeof(out), fixed[i].v, fixed[i].d);
+        if (strcmp(out, fixed[i].exp) != 0)
+        {
+            printf("  MISMATCH fixed %d/%u exp=\"%s\" out=\"%s\"\n",
+                   fixed[i].v, fixed[i].d, fixed[i].exp, out);
+            bad++;
+        }
+    }
+    
+    /* 截断：结果必须是snprintf结果的前缀 */
+    SVC_FMT_Float(out, 4, -123.456f, 3);
+    if (strcmp(out, "-12") != 0)
+    {
+        printf("  MISMATCH truncation out=\"%s\"\n", out);
+        bad++;
+    }
+    
+    printf("special/fixed  mismatches=%llu\n", (unsigned long long)bad);
+    return bad;
+}
+
+static void bench(uint32_t count)
+{
+    char out[32];
+    volatile uint32_t sink = 0;
+    float v = -273.15f;
+    double t0, t_fmt, t_fixed, t_snp;
+    uint32_t i;
+    
+    t0 = now_sec();
+    for (i = 0; i < count; i++)
+    {
+        sink += SVC_FMT_Float(out, sizeof(out), v + (float)(i & 0xFFFF) * 0.0117f, 3);
+    }
+    t_fmt = now_sec() - t0;
+    
+    t0 = now_sec();
+    for (i = 0; i < count; i++)
+    {
+        sink += SVC_FMT_Fixed(out, sizeof(out), (int32_t)(i & 0xFFFFF) - 273150, 3);
+    }
+    t_fixed = now_sec() - t0;
+    
+    t0 = now_sec();
+    for (i = 0; i < count; i++)
+    {
+        sink += (uint32_t)snprintf(out, sizeof(out), "%.3f", (double)(v + (float)(i & 0xFFFF) * 0.0117f));
+    }
+    t_snp = now_sec() - t0;
+    
+    printf("SVC_FMT_Float    %8.1f ns/op\n", t_fmt * 1e9 / count);
+    printf("SVC_FMT_Fixed    %8.1f ns/op\n", t_fixed * 1e9 / count);
+    printf("snprintf(%%.3f)   %8.1f ns/op\n", t_snp * 1e9 / count);
+    printf("speedup (float)  %8.2fx\n", t_snp / t_fmt);
+    (void)sink;
+}
+
+int main(int argc, char **argv)
+{
+    const char *mode = (argc > 1) ? argv[1] : "check";
+    uint64_t bad = 0;
+    unsigned i;
+    
+    if (strcmp(mode, "bench") == 0)
+    {
+        bench(argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 0) : 10000000u);
+        return 0;
+    }
+    
+    if (strcmp(mode, "check") == 0)
+    {
+        uint32_t stride = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 0) : 1u;
+        if (stride == 0)
+        {
+            stride = 1;
+        }
+        bad += check_special();
+        for (i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++)
+        {
+            bad += check_range(&ranges[i], stride);
+        }
+        printf("%s\n", bad ? "FAIL" : "PASS");
+        return bad ? 1 : 0;
+    }
+    
+    fprintf(stderr, "usage: %s check [stride] | bench [count]\n", argv[0]);
+    return 2;
+}
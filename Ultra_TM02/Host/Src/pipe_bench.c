@@ -0,0 +1,719 @@
+/**
+ * @file    pipe_bench.c
+ * @brief   测量流水线热路径主机基准与正确性检查程序
+ * @details 与App/Service层源文件一起编译（与vtm02相同的模拟BSP），逐级测量每个样本/
+ *          每次读数都要执行的计算：
+ *          - adc_raw_to_mv  SVC_ADC_RawToVoltage()        每个样本
+ *          - median5        MedianFilter()（app_temp_calc.h内核）每次读数
+ *          - moving_avg16   MovingAvgFilter()（同上）      每次读数
+ *          - table_lookup   APP_Temp_TableLookup()         每次读数
+ *          - calc_current   APP_Output_CalcCurrent()       每次读数
+ *          - pipeline       以上全部 + K→℃，即一次读数的完整计算
+ *          分度表按传感器曲线（默认同vtm02内置硅二极管曲线）等温度间隔生成
+ *          TEMP_TABLE_MAX_POINTS点，写入模拟Flash中的分度表地址；样本为覆盖全温区
+ *          往返扫描的ADC码值（含噪声）。结果可写为JSON，并与记录的基线比较：
+ *          逐级给出耗时变化，输出摘要(digest)不同说明算法的计算结果变了
+ *          主机CPU上的耗时只用于前后对比，不代表Cortex-M4上的周期数（见CMD_BENCH）
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ *
+ * 用法:
+ *   ./pipe_bench check
+ *   ./pipe_bench bench [选项]
+ *     -n SAMPLES   每级处理的样本数，默认10000000（读数为其1/5）
+ *     -r REPEAT    每级重复次数，取最快一次，默认5
+ *     -c CSV       传感器曲线（格式同上位机分度表CSV）
+ *     -f IMAGE     使用Flash镜像文件（如vtm02的-f文件）中已下载的分度表
+ *     -j JSON      结果写入JSON文件，"-"为标准输出
+ *     -b JSON      与基线比较，某级变慢超过容差时返回1
+ *     -t PCT       容差 (%)，默认10
+ *
+ * 例：修改滤波/查表算法前后各运行一次
+ *   ./pipe_bench bench -j base.json
+ *   ./pipe_bench bench -b base.json
+ */
+
+#include "main.h"
+#include "sim_adc.h"
+#include "svc_adc.h"
+#include "app_temp.h"
+#include "app_temp_calc.h"
+#include "app_output.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* 样本缓冲区长度（读数的整数倍，约256KB） */
+#define SAMPLE_BUF_LEN      (TEMP_SAMPLE_COUNT * 13107)
+#define READING_BUF_LEN     (SAMPLE_BUF_LEN / TEMP_SAMPLE_COUNT)
+
+/* 样本噪声标准差 (mV) */
+#define SAMPLE_NOISE_MV     0.005f
+
+/* 滑动平均检查：读数个数与允许的累加和漂移 (mV) */
+#define MOVING_AVG_CHECK_COUNT      1000000U
+#define MOVING_AVG_MAX_DRIFT_MV     0.1
+
+/* 级数与名称长度 */
+#define STAGE_COUNT         6
+#define STAGE_NAME_LEN      32
+
+/* 一级的测量结果 */
+typedef struct {
+    const char *name;       /* 名称 */
+    const char *unit;       /* 每次操作的单位：sample或reading */
+    uint64_t ops;           /* 操作次数 */
+    double ns_per_op;       /* 最快一次的平均耗时 (ns) */
+} StageResult_t;
+
+/* 基线中的一级 */
+typedef struct {
+    char name[STAGE_NAME_LEN];
+    double ns_per_op;
+} BaselineStage_t;
+
+/* 输入数据 */
+static uint32_t raw_buf[SAMPLE_BUF_LEN];
+static float volt_buf[SAMPLE_BUF_LEN];
+static float median_buf[READING_BUF_LEN];
+static float avg_buf[READING_BUF_LEN];
+static float temp_c_buf[READING_BUF_LEN];
+
+/* 滑动平均滤波器（同app_temp.c） */
+static MovingAvg_t avg_filter;
+
+/* 防止计算被优化掉 */
+static volatile float sink;
+
+/* 基准选项 */
+static uint64_t opt_samples = 10000000ULL;
+static uint32_t opt_repeat = 5;
+static double opt_tolerance = 10.0;
+
+/* 噪声随机数状态 (xorshift32) */
+static uint32_t rng_state = 12345;
+
+/* 固件错误处理（App/Service层引用） */
+void Error_Handler(void)
+{
+    fprintf(stderr, "Error_Handler\n");
+    exit(3);
+}
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static float rand_gauss(void)
+{
+    float u[2];
+    int i;
+    
+    for (i = 0; i < 2; i++)
+    {
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 17;
+        rng_state ^= rng_state << 5;
+        u[i] = ((rng_state >> 8) + 1U) / 16777216.0f;
+    }
+    
+    return sqrtf(-2.0f * logf(u[0])) * cosf(6.2831853f * u[1]);
+}
+
+/**
+ * @brief  中值滤波（同app_temp.c中的RAMFUNC函数，主机上以普通函数调用）
+ */
+static FLASHFUNC float MedianFilter(float *data, uint8_t len)
+{
+    return TempCalc_Median(data, len);
+}
+
+/**
+ * @brief  滑动平均滤波（同app_temp.c）
+ */
+static FLASHFUNC float MovingAvgFilter(float value)
+{
+    return TempCalc_MovingAvg(&avg_filter, value);
+}
+
+/**
+ * @brief  电压 (mV) 转ADC码值（SVC_ADC_RawToVoltage的逆运算，增益1）
+ */
+static uint32_t voltage_to_raw(float mv)
+{
+    double lsb_mv = ADC_VREF * 1000.0 / ADC_FULLSCALE;
+    
+    return (uint32_t)(0x800000 + (int32_t)lround(mv / lsb_mv));
+}
+
+/**
+ * @brief  按传感器曲线生成分度表并写入模拟Flash
+ * @retval 数据点数
+ */
+static uint16_t build_table(void)
+{
+    TempTableHeader_t *header = (TempTableHeader_t *)(uintptr_t)TEMP_TABLE_FLASH_ADDR;
+    TempTablePoint_t *points = (TempTablePoint_t *)(uintptr_t)(TEMP_TABLE_FLASH_ADDR + sizeof(TempTableHeader_t));
+    float t_min, t_max;
+    uint16_t i;
+    
+    SimADC_GetCurveRange(&t_min, &t_max);
+    for (i = 0; i < TEMP_TABLE_MAX_POINTS; i++)
+    {
+        points[i].temperature = t_min + (t_max - t_min) * i / (TEMP_TABLE_MAX_POINTS - 1);
+        points[i].voltage = SimADC_CurveVoltage(points[i].temperature);
+    }
+    
+    header->magic = TEMP_TABLE_MAGIC;
+    header->point_count = TEMP_TABLE_MAX_POINTS;
+    header->reserved = 0;
+    
+    return TEMP_TABLE_MAX_POINTS;
+}
+
+/**
+ * @brief  生成样本：全温区往返扫描一次，加高斯噪声，量化为ADC码值
+ */
+static void build_samples(void)
+{
+    const TempTablePoint_t *points = (const TempTablePoint_t *)(uintptr_t)(TEMP_TABLE_FLASH_ADDR + sizeof(TempTableHeader_t));
+    uint16_t count = ((const TempTableHeader_t *)(uintptr_t)TEMP_TABLE_FLASH_ADDR)->point_count;
+    float v_hi = points[0].voltage;
+    float v_lo = points[count - 1].voltage;
+    float phase;
+    uint32_t i;
+    
+    /* 按电压扫描：每个分度表区间都会被查到 */
+    for (i = 0; i < SAMPLE_BUF_LEN; i++)
+    {
+        phase = 2.0f * i / SAMPLE_BUF_LEN;
+        if (phase > 1.0f)
+        {
+            phase = 2.0f - phase;
+        }
+        raw_buf[i] = voltage_to_raw(v_lo + (v_hi - v_lo) * phase + rand_gauss() * SAMPLE_NOISE_MV);
+        volt_buf[i] = SVC_ADC_RawToVoltage(raw_buf[i]);
+    }
+    
+    memset(&avg_filter, 0, sizeof(avg_filter));
+    for (i = 0; i < READING_BUF_LEN; i++)
+    {
+        median_buf[i] = MedianFilter(&volt_buf[i * TEMP_SAMPLE_COUNT], TEMP_SAMPLE_COUNT);
+        avg_buf[i] = MovingAvgFilter(median_buf[i]);
+        temp_c_buf[i] = APP_Temp_TableLookup(avg_buf[i]) - 273.15f;
+    }
+}
+
+/**
+ * @brief  一次读数的完整计算
+ * @param  raw: TEMP_SAMPLE_COUNT个ADC码值
+ * @retval 输出电流 (mA)
+ */
+static float pipeline_reading(const uint32_t *raw)
+{
+    float samples[TEMP_SAMPLE_COUNT];
+    float voltage;
+    float temp_k;
+    int i;
+    
+    for (i = 0; i < TEMP_SAMPLE_COUNT; i++)
+    {
+        samples[i] = SVC_ADC_RawToVoltage(raw[i]);
+    }
+    
+    voltage = MovingAvgFilter(MedianFilter(samples, TEMP_SAMPLE_COUNT));
+    temp_k = APP_Temp_TableLookup(voltage);
+    
+    return APP_Output_CalcCurrent(temp_k - 273.15f);
+}
+
+/**
+ * @brief  运行一级，返回本次总耗时 (s)
+ * @param  stage: 级号
+ * @param  ops: 操作次数
+ */
+static double run_stage(int stage, uint64_t ops)
+{
+    float acc = 0.0f;
+    uint32_t j = 0;
+    uint64_t n;
+    double t0;
+    
+    memset(&avg_filter, 0, sizeof(avg_filter));
+    t0 = now_sec();
+    
+    switch (stage)
+    {
+        case 0:
+            for (n = 0; n < ops; n++)
+            {
+                acc += SVC_ADC_RawToVoltage(raw_buf[j]);
+                j = (j + 1 < SAMPLE_BUF_LEN) ? j + 1 : 0;
+            }
+            break;
+        case 1:
+            for (n = 0; n < ops; n++)
+            {
+                acc += MedianFilter(&volt_buf[j * TEMP_SAMPLE_COUNT], TEMP_SAMPLE_COUNT);
+                j = (j + 1 < READING_BUF_LEN) ? j + 1 : 0;
+            }
+            break;
+        case 2:
+            for (n = 0; n < ops; n++)
+            {
+                acc += MovingAvgFilter(median_buf[j]);
+                j = (j + 1 < READING_BUF_LEN) ? j + 1 : 0;
+            }
+            break;
+        case 3:
+            for (n = 0; n < ops; n++)
+            {
+                acc += APP_Temp_TableLookup(avg_buf[j]);
+                j = (j + 1 < READING_BUF_LEN) ? j + 1 : 0;
+            }
+            break;
+        case 4:
+            for (n = 0; n < ops; n++)
+            {
+                acc += APP_Output_CalcCurrent(temp_c_buf[j]);
+                j = (j + 1 < READING_BUF_LEN) ? j + 1 : 0;
+            }
+            break;
+        default:
+            for (n = 0; n < ops; n++)
+            {
+                acc += pipeline_reading(&raw_buf[j * TEMP_SAMPLE_COUNT]);
+                j = (j + 1 < READING_BUF_LEN) ? j + 1 : 0;
+            }
+            break;
+    }
+    
+    t0 = now_sec() - t0;
+    sink = acc;
+    
+    return t0;
+}
+
+/**
+ * @brief  输出摘要：一遍样本缓冲区的中间结果与输出的位模式FNV-1a
+ * @note   耗时变化而摘要不变，说明只改了实现；摘要变化说明计算结果变了
+ */
+static uint32_t pipeline_digest(void)
+{
+    uint32_t hash = 2166136261u;
+    uint32_t words[2];
+    float voltage, current;
+    uint32_t i;
+    int k;
+    
+    memset(&avg_filter, 0, sizeof(avg_filter));
+    for (i = 0; i < READING_BUF_LEN; i++)
+    {
+        voltage = MovingAvgFilter(MedianFilter(&volt_buf[i * TEMP_SAMPLE_COUNT], TEMP_SAMPLE_COUNT));
+        current = APP_Output_CalcCurrent(APP_Temp_TableLookup(voltage) - 273.15f);
+        memcpy(&words[0], &voltage, 4);
+        memcpy(&words[1], &current, 4);
+        for (k = 0; k < 8; k++)
+        {
+            hash = (hash ^ ((words[k / 4] >> (8 * (k % 4))) & 0xFF)) * 16777619u;
+        }
+    }
+    
+    return hash;
+}
+
+static void write_json(FILE *fp, const StageResult_t *res, uint16_t points, uint32_t digest)
+{
+    int i;
+    
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"tool\": \"pipe_bench\",\n");
+    fprintf(fp, "  \"samples\": %llu,\n", (unsigned long long)opt_samples);
+    fprintf(fp, "  \"readings\": %llu,\n", (unsigned long long)(opt_samples / TEMP_SAMPLE_COUNT));
+    fprintf(fp, "  \"table_points\": %u,\n", points);
+    fprintf(fp, "  \"repeat\": %u,\n", opt_repeat);
+    fprintf(fp, "  \"digest\": \"%08x\",\n", digest);
+    fprintf(fp, "  \"stages\": [\n");
+    for (i = 0; i < STAGE_COUNT; i++)
+    {
+        /* 每级一行，便于基线比较时逐行解析 */
+        fprintf(fp, "    {\"name\": \"%s\", \"unit\": \"%s\", \"ops\": %llu, \"ns_per_op\": %.3f, \"mops_per_s\": %.3f}%s\n",
+                res[i].name, res[i].unit, (unsigned long long)res[i].ops, res[i].ns_per_op,
+                1e3 / res[i].ns_per_op, (i < STAGE_COUNT - 1) ? "," : "");
+    }
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+}
+
+/**
+ * @brief  读取基线JSON（本程序写出的格式）
+ * @retval 级数, -1=无法打开
+ */
+static int read_baseline(const char *path, BaselineStage_t *base, uint32_t *digest)
+{
+    char line[256];
+    const char *p;
+    int count = 0;
+    FILE *fp = fopen(path, "r");
+    
+    if (fp == NULL)
+    {
+        return -1;
+    }
+    
+    *digest = 0;
+    while (fgets(line, sizeof(line), fp) != NULL && count < STAGE_COUNT)
+    {
+        if ((p = strstr(line, "\"digest\": \"")) != NULL)
+        {
+            *digest = (uint32_t)strtoul(p + 11, NULL, 16);
+        }
+        else if ((p = strstr(line, "{\"name\": \"")) != NULL &&
+                 sscanf(p, "{\"name\": \"%31[^\"]\"", base[count].name) == 1 &&
+                 (p = strstr(p, "\"ns_per_op\": ")) != NULL &&
+                 sscanf(p + 13, "%lf", &base[count].ns_per_op) == 1)
+        {
+            count++;
+        }
+    }
+    fclose(fp);
+    
+    return count;
+}
+
+/**
+ * @brief  与基线比较
+ * @retval 变慢超过容差的级数, -1=基线无法读取
+ */
+static int compare_baseline(const char *path, const StageResult_t *res, uint32_t digest)
+{
+    BaselineStage_t base[STAGE_COUNT];
+    uint32_t base_digest;
+    double delta;
+    int count = read_baseline(path, base, &base_digest);
+    int slower = 0;
+    int i, k;
+    
+    if (count < 0)
+    {
+        fprintf(stderr, "cannot read baseline %s\n", path);
+        return -1;
+    }
+    
+    printf("\nvs %s (tolerance %.1f%%)\n", path, opt_tolerance);
+    for (i = 0; i < STAGE_COUNT; i++)
+    {
+        for (k = 0; k < count && strcmp(base[k].name, res[i].name) != 0; k++)
+        {
+        }
+        if (k == count || base[k].ns_per_op <= 0.0)
+        {
+            printf("%-14s %10s\n", res[i].name, "(new)");
+            continue;
+        }
+        
+        delta = (res[i].ns_per_op / base[k].ns_per_op - 1.0) * 100.0;
+        printf("%-14s %10.2f -> %8.2f ns  %+7.1f%%%s\n", res[i].name,
+               base[k].ns_per_op, res[i].ns_per_op, delta,
+               (delta > opt_tolerance) ? "  SLOWER" : "");
+        if (delta > opt_tolerance)
+        {
+            slower++;
+        }
+    }
+    
+    printf("digest %08x, baseline %08x: %s\n", digest, base_digest,
+           (digest == base_digest) ? "same results" : "RESULTS CHANGED");
+    
+    return slower;
+}
+
+static int bench(int argc, char **argv)
+{
+    static const char *const names[STAGE_COUNT] = {
+        "adc_raw_to_mv", "median5", "moving_avg16", "table_lookup", "calc_current", "pipeline"
+    };
+    StageResult_t res[STAGE_COUNT];
+    const char *json_path = NULL;
+    const char *base_path = NULL;
+    const char *image_path = NULL;
+    const char *curve_path = NULL;
+    SimADC_Config_t adc_cfg = { .temp_k = 77.0f, .ideality = 1.0f };
+    uint16_t points;
+    uint32_t digest;
+    uint64_t readings;
+    double best, t;
+    FILE *fp;
+    uint32_t r;
+    int opt;
+    int i;
+    int slower = 0;
+    
+    while ((opt = getopt(argc, argv, "n:r:c:f:j:b:t:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n': opt_samples = strtoull(optarg, NULL, 0); break;
+            case 'r': opt_repeat = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'c': curve_path = optarg; break;
+            case 'f': image_path = optarg; break;
+            case 'j': json_path = optarg; break;
+            case 'b': base_path = optarg; break;
+            case 't': opt_tolerance = strtod(optarg, NULL); break;
+            default: return 2;
+        }
+    }
+    readings = opt_samples / TEMP_SAMPLE_COUNT;
+    if (readings == 0 || opt_repeat == 0)
+    {
+        fprintf(stderr, "samples must be >= %d, repeat >= 1\n", TEMP_SAMPLE_COUNT);
+        return 2;
+    }
+    
+    if (curve_path != NULL && SimADC_LoadCurve(curve_path) < 0)
+    {
+        fprintf(stderr, "cannot load curve %s\n", curve_path);
+        return 2;
+    }
+    SimADC_Init(&adc_cfg);
+    
+    if ((image_path != NULL ? Stub_FlashMapFile(image_path) : Stub_FlashMap()) != 0)
+    {
+        fprintf(stderr, "cannot map simulated flash at 0x%08X\n", FLASH_BASE_ADDR);
+        return 2;
+    }
+    if (image_path != NULL)
+    {
+        if (APP_Temp_TableVerify() != 0)
+        {
+            fprintf(stderr, "no valid table in %s\n", image_path);
+            return 2;
+        }
+        points = ((const TempTableHeader_t *)(uintptr_t)TEMP_TABLE_FLASH_ADDR)->point_count;
+    }
+    else
+    {
+        points = build_table();
+    }
+    
+    /* 4-20mA映射系数（APP_Output_Init()还会写DAC，这里只需系数） */
+    APP_Output_Set4mATemp(OUTPUT_DEFAULT_TEMP_4MA);
+    
+    build_samples();
+    digest = pipeline_digest();
+    
+    printf("%llu samples (%llu readings), table %u points, best of %u\n",
+           (unsigned long long)opt_samples, (unsigned long long)readings, points, opt_repeat);
+    for (i = 0; i < STAGE_COUNT; i++)
+    {
+        res[i].name = names[i];
+        res[i].unit = (i == 0) ? "sample" : "reading";
+        res[i].ops = (i == 0) ? readings * TEMP_SAMPLE_COUNT : readings;
+        
+        best = 0.0;
+        for (r = 0; r < opt_repeat; r++)
+        {
+            t = run_stage(i, res[i].ops);
+            if (r == 0 || t < best)
+            {
+                best = t;
+            }
+        }
+        res[i].ns_per_op = best / res[i].ops * 1e9;
+        
+        printf("%-14s %8.2f ns/%-7s %9.2f M/s\n", res[i].name, res[i].ns_per_op,
+               res[i].unit, 1e3 / res[i].ns_per_op);
+    }
+    printf("pipeline: %.2f M samples/s, digest %08x\n",
+           1e3 * TEMP_SAMPLE_COUNT / res[STAGE_COUNT - 1].ns_per_op, digest);
+    
+    if (json_path != NULL)
+    {
+        fp = (strcmp(json_path, "-") == 0) ? stdout : fopen(json_path, "w");
+        if (fp == NULL)
+        {
+            fprintf(stderr, "cannot write %s\n", json_path);
+            return 2;
+        }
+        write_json(fp, res, points, digest);
+        if (fp != stdout)
+        {
+            fclose(fp);
+        }
+    }
+    
+    if (base_path != NULL)
+    {
+        slower = compare_baseline(base_path, res, digest);
+        if (slower < 0)
+        {
+            return 2;
+        }
+    }
+    
+    return slower ? 1 : 0;
+}
+
+/**
+ * @brief  逐级核对计算结果
+ * @retval 失败项数
+ */
+static uint32_t check(void)
+{
+    const TempTablePoint_t *points = (const TempTablePoint_t *)(uintptr_t)(TEMP_TABLE_FLASH_ADDR + sizeof(TempTableHeader_t));
+    SimADC_Config_t adc_cfg = { .temp_k = 77.0f, .ideality = 1.0f };
+    float window[TEMP_SAMPLE_COUNT];
+    float sorted[TEMP_SAMPLE_COUNT];
+    double ref_sum;
+    double drift;
+    float t, v, expect;
+    uint32_t bad = 0;
+    uint32_t i, k, m;
+    
+    SimADC_Init(&adc_cfg);
+    build_table();
+    APP_Output_Set4mATemp(OUTPUT_DEFAULT_TEMP_4MA);
+    
+    /* 码值换算：中点为0，1LSB往返 */
+    if (SVC_ADC_RawToVoltage(0x800000) != 0.0f)
+    {
+        printf("RawToVoltage(0x800000) != 0\n");
+        bad++;
+    }
+    for (i = 0; i < 1000; i++)
+    {
+        v = -3000.0f + 6.0f * i;
+        if (fabsf(SVC_ADC_RawToVoltage(voltage_to_raw(v)) - v) > ADC_VREF * 1000.0f / ADC_FULLSCALE)
+        {
+            printf("raw round trip %.3f mV FAIL\n", v);
+            bad++;
+            break;
+        }
+    }
+    
+    /* 查表：表点处取表值，区间中点取两端温度平均，两端外限幅 */
+    for (i = 0; i < TEMP_TABLE_MAX_POINTS; i++)
+    {
+        t = APP_Temp_TableLookup(points[i].voltage);
+        if (fabsf(t - points[i].temperature) > 1e-3f)
+        {
+            printf("lookup point %u: %.4f K, expect %.4f K\n", i, t, points[i].temperature);
+            bad++;
+            break;
+        }
+        if (i + 1 < TEMP_TABLE_MAX_POINTS && points[i + 1].voltage < points[i].voltage)
+        {
+            t = APP_Temp_TableLookup((points[i].voltage + points[i + 1].voltage) / 2.0f);
+            expect = (points[i].temperature + points[i + 1].temperature) / 2.0f;
+            if (fabsf(t - expect) > 1e-2f)
+            {
+                printf("lookup midpoint %u: %.4f K, expect %.4f K\n", i, t, expect);
+                bad++;
+                break;
+            }
+        }
+    }
+    if (APP_Temp_TableLookup(points[0].voltage + 100.0f) != points[0].temperature ||
+        APP_Temp_TableLookup(points[TEMP_TABLE_MAX_POINTS - 1].voltage - 100.0f) !=
+        points[TEMP_TABLE_MAX_POINTS - 1].temperature)
+    {
+        printf("lookup clamp FAIL\n");
+        bad++;
+    }
+    
+    /* 中值：与插入排序结果比对 */
+    for (i = 0; i < 100000; i++)
+    {
+        for (k = 0; k < TEMP_SAMPLE_COUNT; k++)
+        {
+            window[k] = rand_gauss();
+            for (m = k; m > 0 && sorted[m - 1] > window[k]; m--)
+            {
+                sorted[m] = sorted[m - 1];
+            }
+            sorted[m] = window[k];
+        }
+        if (MedianFilter(window, TEMP_SAMPLE_COUNT) != sorted[TEMP_SAMPLE_COUNT / 2])
+        {
+            printf("median FAIL at %u\n", i);
+            bad++;
+            break;
+        }
+    }
+    
+    /* 滑动平均：与双精度窗口求和比对。滤波器维护浮点累加和，长时间运行会随机漂移，
+       这里记录最大偏差，超过MOVING_AVG_MAX_DRIFT_MV才算失败 */
+    memset(&avg_filter, 0, sizeof(avg_filter));
+    drift = 0.0;
+    for (i = 0; i < MOVING_AVG_CHECK_COUNT; i++)
+    {
+        window[0] = 1000.0f + 50.0f * rand_gauss();
+        volt_buf[i % TEMP_FILTER_SIZE] = window[0];
+        v = MovingAvgFilter(window[0]);
+        
+        m = (i + 1 < TEMP_FILTER_SIZE) ? i + 1 : TEMP_FILTER_SIZE;
+        ref_sum = 0.0;
+        for (k = 0; k < m; k++)
+        {
+            ref_sum += volt_buf[k];
+        }
+        if (fabs(v - ref_sum / m) > drift)
+        {
+            drift = fabs(v - ref_sum / m);
+        }
+    }
+    printf("moving average: max drift %.4f mV over %u readings\n", drift, MOVING_AVG_CHECK_COUNT);
+    if (drift > MOVING_AVG_MAX_DRIFT_MV)
+    {
+        printf("moving average drift FAIL (limit %.3f mV)\n", MOVING_AVG_MAX_DRIFT_MV);
+        bad++;
+    }
+    
+    /* 4-20mA：端点与限幅 */
+    if (fabsf(APP_Output_CalcCurrent(OUTPUT_DEFAULT_TEMP_4MA) - OUTPUT_MIN_CURRENT) > 1e-4f ||
+        fabsf(APP_Output_CalcCurrent(OUTPUT_DEFAULT_TEMP_20MA) - OUTPUT_MAX_CURRENT) > 1e-4f ||
+        APP_Output_CalcCurrent(-1000.0f) != OUTPUT_MIN_CURRENT ||
+        APP_Output_CalcCurrent(1000.0f) != OUTPUT_MAX_CURRENT)
+    {
+        printf("calc current FAIL\n");
+        bad++;
+    }
+    
+    printf("%u failures\n", bad);
+    
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    const char *mode = (argc > 1) ? argv[1] : "check";
+    
+    if (strcmp(mode, "bench") == 0)
+    {
+        optind = 2;
+        return bench(argc, argv);
+    }
+    
+    if (strcmp(mode, "check") == 0)
+    {
+        if (Stub_FlashMap() != 0)
+        {
+            fprintf(stderr, "cannot map simulated flash at 0x%08X\n", FLASH_BASE_ADDR);
+            return 2;
+        }
+        uint32_t bad = check();
+        printf("%s\n", bad ? "FAIL" : "PASS");
+        return bad ? 1 : 0;
+    }
+    
+    fprintf(stderr, "usage: %s check | bench [-n samples] [-r repeat] [-c csv] [-f image] "
+            "[-j json] [-b baseline] [-t pct]\n", argv[0]);
+    return 2;
+}
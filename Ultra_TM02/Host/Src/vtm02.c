@@ -0,0 +1,447 @@
+/**
+ * @file    vtm02.c
+ * @brief   虚拟TM02：在Linux上运行固件App/Service层
+ * @details App/、Service/以及bsp_flash/bsp_dwt/bsp_prof/bsp_trace按原样编译，
+ *          其余BSP由Sim/下的模拟实现代替，器件由模型代替：
+ *          - ADC：二极管传感器模型（电压曲线、激励电流修正、噪声、开路/短路故障）
+ *          - DAC：激励电流源与4-20mA环路输出，锁存记录可写入CSV
+ *          - 内部Flash：映射到0x08000000的镜像文件，参数与分度表掉电保持
+ *          - USB CDC：伪终端，上位机打开从端即可按原协议通讯
+ *          每个进程是一台独立的模块，按实际时间运行，空闲时阻塞睡眠，
+ *          一台机器上可同时运行数十个实例
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ *
+ * 用法:
+ *   ./vtm02 [选项]
+ *     -l, --link PATH       在PATH创建指向伪终端从端的符号链接
+ *     -f, --flash PATH      Flash镜像文件（不存在时创建），默认不保存
+ *     -t, --temp K          传感器温度，默认77
+ *     -r, --ramp K/s        温度变化速率，默认0
+ *     -N, --noise UV        噪声标准差 (μV)，默认2
+ *     -c, --curve CSV       传感器曲线（格式同上位机分度表CSV），默认内置硅二极管曲线
+ *         --ideality N      二极管理想因子，默认1.0
+ *         --conv-us US      ADC转换时间，默认500
+ *         --fault open|short 探头故障
+ *     -d, --dac-log PATH    DAC锁存记录 (CSV)
+ *         --lcd PATH        串口屏数据输出文件
+ *     -s, --status SEC      每SEC秒在标准输出打印一行状态
+ *     -n, --instances N     启动N个实例（子进程），路径中的%d替换为实例号0..N-1
+ *         --temp-step K     多实例时第i个实例的温度为 temp + i×K
+ *
+ * 例：启动32个实例，上位机打开/tmp/vtm02-0 ~ /tmp/vtm02-31
+ *   ./vtm02 -n 32 -l /tmp/vtm02-%d -f /tmp/vtm02-%d.bin --temp-step 5
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "main.h"
+#include "sim_board.h"
+#include "sim_adc.h"
+#include "sim_dac.h"
+#include "sim_usb.h"
+
+/* BSP层头文件 */
+#include "bsp_gpio.h"
+#include "bsp_flash.h"
+#include "bsp_dwt.h"
+#include "bsp_prof.h"
+
+/* Service层头文件 */
+#include "svc_adc.h"
+#include "svc_dac.h"
+#include "svc_lcd.h"
+#include "svc_usb.h"
+
+/* App层头文件 */
+#include "app_temp.h"
+#include "app_param.h"
+#include "app_comm.h"
+#include "app_output.h"
+#include "app_sched.h"
+#include "app_boot.h"
+#include "app_power.h"
+#include "app_history.h"
+#include "app_datalog.h"
+#include "app_alarm.h"
+
+#include <errno.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* 私有宏定义 ----------------------------------------------------------------*/
+
+/* 实例数上限 */
+#define VTM02_MAX_INSTANCES     256
+
+/* 路径长度 */
+#define VTM02_PATH_SIZE         256
+
+/* 私有类型 ------------------------------------------------------------------*/
+
+/* 命令行选项 */
+typedef struct {
+    const char *link;
+    const char *flash;
+    const char *curve;
+    const char *dac_log;
+    const char *lcd;
+    float temp_step;
+    uint32_t status_s;
+    int instances;
+    SimADC_Config_t adc;
+} Options_t;
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 收到SIGINT/SIGTERM */
+static volatile sig_atomic_t stop_requested = 0;
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  应用层初始化
+ * @note   与Core/Src/main.c中的App_Init()相同
+ */
+static void App_Init(void)
+{
+    /* BSP层初始化 */
+    BSP_GPIO_Init();        /* GPIO初始化 (片选、LED等) */
+    BSP_DWT_Init();         /* DWT周期计数器 (微秒延时) */
+    APP_Boot_Init();        /* 启动计时 (复位原因、各阶段时刻) */
+    BSP_Flash_Init();       /* 向量表重定位到SRAM (Flash擦写期间中断不停) */
+    
+    /* 输出通道：DAC初始化即输出4mA */
+    SVC_DAC_Init();
+    APP_Boot_Mark(BOOT_STAGE_OUTPUT_SAFE);
+    
+    /* 测量通道 */
+    SVC_ADC_Init();         /* ADC服务初始化 */
+    APP_Param_Init();       /* 参数管理初始化 (从Flash加载参数) */
+    APP_Power_Init();       /* 切换到参数中的时钟档位 */
+    APP_Output_Init();      /* 4-20mA输出初始化 */
+    APP_Temp_Init();        /* 温度测量初始化 */
+    APP_History_Init();     /* 测量历史记录 (参数中的抽取比) */
+    APP_DataLog_Init();     /* 长期数据日志 (扫描Flash日志区域) */
+    APP_Alarm_Init();       /* 温度报警 (全部关闭) */
+    
+    /* 后台启动的外设：串口屏上电复位由LCD任务推进，USB枚举由中断完成 */
+    SVC_LCD_Init();         /* LCD服务初始化 */
+    SVC_LCD_SetCurrentSource(APP_Param_GetCurrentSource());
+    SVC_USB_Init();         /* USB服务初始化 */
+    APP_Comm_Init();        /* 通讯协议初始化 */
+    
+    /* 自动开始测量 */
+    APP_Temp_Start();
+    APP_Boot_Mark(BOOT_STAGE_ACQ_START);
+    
+    /* 任务调度器 (周期任务从此刻开始计时) */
+    APP_Sched_Init();
+    APP_Boot_Mark(BOOT_STAGE_INIT_DONE);
+}
+
+/**
+ * @brief  应用层主循环处理
+ * @note   与Core/Src/main.c中的App_Process()相同
+ */
+static void App_Process(void)
+{
+    PROF_MARK(PROF_PROBE_LOOP);
+    APP_Boot_Poll();
+    
+    /* 无就绪任务时睡眠到下一个中断 */
+    if (!APP_Sched_Run())
+    {
+        APP_Power_Idle();
+    }
+}
+
+/**
+ * @brief  固件错误处理：模拟中直接退出
+ */
+void Error_Handler(void)
+{
+    fprintf(stderr, "vtm02: Error_Handler\n");
+    exit(1);
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop_requested = 1;
+}
+
+/**
+ * @brief  把路径中的%d替换为实例号
+ */
+static const char *instance_path(char *buf, const char *pattern, int index)
+{
+    if (pattern == NULL)
+    {
+        return NULL;
+    }
+    if (strstr(pattern, "%d") == NULL)
+    {
+        return pattern;
+    }
+    
+    snprintf(buf, VTM02_PATH_SIZE, pattern, index);
+    return buf;
+}
+
+static FILE *open_output(const char *path)
+{
+    FILE *fp;
+    
+    if (path == NULL)
+    {
+        return NULL;
+    }
+    
+    fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        perror(path);
+        exit(2);
+    }
+    
+    return fp;
+}
+
+/**
+ * @brief  打印一行状态
+ */
+static void print_status(int index)
+{
+    uint64_t now = Stub_Nanos();
+    
+    printf("vtm02[%d] t=%.1fs T=%.3fK V=%.3fmV Iexc=%.3fuA loop=%.3fmA usb=%s\n",
+           index, now / 1e9, SimADC_GetTemperature(now), SimADC_GetVoltage(now),
+           SimDAC_GetExcitationUA(), SimDAC_GetLoopMA(),
+           SimUSB_GetFd() >= 0 ? "open" : "closed");
+    fflush(stdout);
+}
+
+/**
+ * @brief  运行一台虚拟模块直到收到停止信号
+ * @param  opt: 命令行选项
+ * @param  index: 实例号
+ * @retval 进程退出码
+ */
+static int run_instance(const Options_t *opt, int index)
+{
+    char link_buf[VTM02_PATH_SIZE];
+    char flash_buf[VTM02_PATH_SIZE];
+    char dac_buf[VTM02_PATH_SIZE];
+    char lcd_buf[VTM02_PATH_SIZE];
+    const char *link = instance_path(link_buf, opt->link, index);
+    const char *flash = instance_path(flash_buf, opt->flash, index);
+    SimADC_Config_t adc = opt->adc;
+    uint32_t next_status = 0;
+    
+    adc.temp_k += opt->temp_step * index;
+    adc.seed = adc.seed ? adc.seed : 0x9E3779B9U * (uint32_t)(index + 1);
+    
+    if ((flash != NULL) ? Stub_FlashMapFile(flash) : Stub_FlashMap())
+    {
+        fprintf(stderr, "vtm02[%d]: cannot map flash at 0x%08X%s%s\n", index, FLASH_BASE_ADDR,
+                flash ? " from " : "", flash ? flash : "");
+        return 2;
+    }
+    if (opt->curve != NULL && SimADC_LoadCurve(opt->curve) < 0)
+    {
+        fprintf(stderr, "vtm02[%d]: cannot load curve %s\n", index, opt->curve);
+        return 2;
+    }
+    if (SimUSB_Open(link) != 0)
+    {
+        fprintf(stderr, "vtm02[%d]: cannot create pty%s%s\n", index,
+                link ? " link " : "", link ? link : "");
+        return 2;
+    }
+    
+    SimADC_Init(&adc);
+    SimDAC_Init(open_output(instance_path(dac_buf, opt->dac_log, index)));
+    SimBoard_SetLcdSink(open_output(instance_path(lcd_buf, opt->lcd, index)));
+    SimBoard_Init();
+    
+    printf("vtm02[%d]: %s%s%s flash=%s T=%.2fK\n", index, SimUSB_GetPath(),
+           link ? " <- " : "", link ? link : "", flash ? flash : "(ram)", adc.temp_k);
+    fflush(stdout);
+    
+    App_Init();
+    
+    while (!stop_requested)
+    {
+        App_Process();
+        
+        if (opt->status_s != 0 && HAL_GetTick() >= next_status)
+        {
+            next_status = HAL_GetTick() + opt->status_s * 1000U;
+            print_status(index);
+        }
+    }
+    
+    SimUSB_Close();
+    
+    return 0;
+}
+
+/**
+ * @brief  启动多个实例并等待全部退出
+ */
+static int run_instances(const Options_t *opt)
+{
+    pid_t pids[VTM02_MAX_INSTANCES];
+    int started = 0;
+    int forwarded = 0;
+    int status;
+    int result = 0;
+    int i;
+    
+    for (i = 0; i < opt->instances; i++)
+    {
+        pids[i] = fork();
+        if (pids[i] == 0)
+        {
+            exit(run_instance(opt, i));
+        }
+        if (pids[i] < 0)
+        {
+            perror("fork");
+            stop_requested = 1;
+            break;
+        }
+        started++;
+    }
+    
+    /* 收到停止信号后转发给所有子进程 */
+    for (;;)
+    {
+        if (stop_requested && !forwarded)
+        {
+            for (i = 0; i < started; i++)
+            {
+                kill(pids[i], SIGTERM);
+            }
+            forwarded = 1;
+        }
+        
+        if (wait(&status) > 0)
+        {
+            if (WIFEXITED(status) && WEXITSTATUS(status) != 0)
+            {
+                result = WEXITSTATUS(status);
+            }
+        }
+        else if (errno != EINTR)
+        {
+            break;
+        }
+    }
+    
+    return result;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [-l link] [-f flash.bin] [-t K] [-r K/s] [-N uV] [-c curve.csv]\n"
+            "          [--ideality n] [--conv-us us] [--fault open|short]\n"
+            "          [-d dac.csv] [--lcd lcd.bin] [-s sec] [-n N] [--temp-step K]\n",
+            prog);
+}
+
+/* 主函数 --------------------------------------------------------------------*/
+
+int main(int argc, char **argv)
+{
+    static const struct option long_opts[] = {
+        { "link",      required_argument, NULL, 'l' },
+        { "flash",     required_argument, NULL, 'f' },
+        { "temp",      required_argument, NULL, 't' },
+        { "ramp",      required_argument, NULL, 'r' },
+        { "noise",     required_argument, NULL, 'N' },
+        { "curve",     required_argument, NULL, 'c' },
+        { "ideality",  required_argument, NULL, 'I' },
+        { "conv-us",   required_argument, NULL, 'C' },
+        { "fault",     required_argument, NULL, 'F' },
+        { "dac-log",   required_argument, NULL, 'd' },
+        { "lcd",       required_argument, NULL, 'L' },
+        { "status",    required_argument, NULL, 's' },
+        { "instances", required_argument, NULL, 'n' },
+        { "temp-step", required_argument, NULL, 'T' },
+        { NULL, 0, NULL, 0 }
+    };
+    Options_t opt = {
+        .instances = 1,
+        .adc = { .temp_k = 77.0f, .noise_uv = 2.0f, .ideality = 1.0f,
+                 .conv_us = SIM_ADC_CONV_US_DEFAULT },
+    };
+    struct sigaction sa;
+    int c;
+    
+    while ((c = getopt_long(argc, argv, "l:f:t:r:N:c:d:s:n:", long_opts, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 'l': opt.link = optarg; break;
+            case 'f': opt.flash = optarg; break;
+            case 't': opt.adc.temp_k = strtof(optarg, NULL); break;
+            case 'r': opt.adc.ramp_k_per_s = strtof(optarg, NULL); break;
+            case 'N': opt.adc.noise_uv = strtof(optarg, NULL); break;
+            case 'c': opt.curve = optarg; break;
+            case 'I': opt.adc.ideality = strtof(optarg, NULL); break;
+            case 'C': opt.adc.conv_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'd': opt.dac_log = optarg; break;
+            case 'L': opt.lcd = optarg; break;
+            case 's': opt.status_s = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'n': opt.instances = atoi(optarg); break;
+            case 'T': opt.temp_step = strtof(optarg, NULL); break;
+            case 'F':
+                if (strcmp(optarg, "open") == 0)
+                {
+                    opt.adc.fault = SIM_FAULT_OPEN;
+                }
+                else if (strcmp(optarg, "short") == 0)
+                {
+                    opt.adc.fault = SIM_FAULT_SHORT;
+                }
+                else
+                {
+                    usage(argv[0]);
+                    return 2;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    
+    if (optind != argc || opt.instances < 1 || opt.instances > VTM02_MAX_INSTANCES)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    
+    /* 多实例时每个实例需要各自的伪终端链接和Flash镜像 */
+    if (opt.instances > 1 &&
+        ((opt.link && !strstr(opt.link, "%d")) || (opt.flash && !strstr(opt.flash, "%d"))))
+    {
+        fprintf(stderr, "vtm02: --link/--flash need %%d with --instances\n");
+        return 2;
+    }
+    
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    
+    return (opt.instances == 1) ? run_instance(&opt, 0) : run_instances(&opt);
+}
@@ -0,0 +1,44 @@
+/**
+ * @file    main.h
+ * @brief   主机编译用main.h替身
+ * @details 固件模块通过main.h获取HAL定义，主机工具以本目录代替Core/Inc，
+ *          HAL外设寄存器与函数由stm32f4xx_hal.h/stub_hal.c模拟
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f4xx_hal.h"
+
+/* 版本信息（与Core/Inc/main.h一致） */
+#define FIRMWARE_VERSION        "V1.0"
+#define FIRMWARE_DATE           "2025-12-18"
+#define PRODUCT_NAME            "Ultra-TM02"
+
+/* 主机上没有.RamFunc段，函数按普通函数编译 */
+#define RAMFUNC
+#define FLASHFUNC               __attribute__((noinline))
+#define ALWAYS_INLINE           __attribute__((always_inline))
+
+/* 主机上没有链接脚本符号，固件映像按占满Sector 0~3计（可在编译时覆盖） */
+#ifndef FIRMWARE_IMAGE_END
+#define FIRMWARE_IMAGE_END      0x08010000U
+#endif
+
+/* ADC数据就绪外部中断 */
+#define ADC_DRDY_EXTI_IRQn      EXTI0_IRQn
+
+void Error_Handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAIN_H */
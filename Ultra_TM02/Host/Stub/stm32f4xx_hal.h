@@ -0,0 +1,280 @@
+/**
+ * @file    stm32f4xx_hal.h
+ * @brief   主机编译用HAL模拟头文件
+ * @details 仅提供主机工具所编译固件模块用到的最小子集：
+ *          - FLASH/DWT/SCB寄存器映射到普通内存中的模拟结构体
+ *          - 内部Flash区域(0x08000000, 512KB)由Stub_FlashMap()/Stub_FlashMapFile()
+ *            映射到同一地址，固件中按绝对地址访问Flash的代码无需修改
+ *          - 模拟Flash编程立即完成；扇区擦除(SER+STRT)按典型擦除时间置BSY，
+ *            到时填充0xFF；擦写语义（只能1写0）不做模拟
+ *          - SR中的标志写1清零，模拟中按位清除
+ *          - DWT->CYCCNT与HAL_GetTick()按单调时钟走时，CYCCNT按SystemCoreClock计数；
+ *            回放时可切换为虚拟时钟（Stub_SetVirtualTime）
+ *          - NVIC模拟：使能/挂起/优先级、PRIMASK与BASEPRI屏蔽；中断处理函数由
+ *            Stub_SetVector()登记，在HAL_GetTick()、开中断、挂起中断和WFI时
+ *            按优先级调用（单线程，不会打断正在执行的C语句）
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* 通用定义 ------------------------------------------------------------------*/
+
+#define __IO    volatile
+#define __weak  __attribute__((weak))
+
+typedef enum {
+    HAL_OK       = 0x00U,
+    HAL_ERROR    = 0x01U,
+    HAL_BUSY     = 0x02U,
+    HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+/* 内核寄存器与内联函数 ------------------------------------------------------*/
+
+#define __NVIC_PRIO_BITS    4U
+
+/* 中断号（与STM32F411一致，仅列出固件用到的） */
+typedef enum {
+    SysTick_IRQn        = -1,
+    EXTI0_IRQn          = 6,
+    TIM2_IRQn           = 28,
+    OTG_FS_IRQn         = 67,
+    USART6_IRQn         = 71,
+} IRQn_Type;
+
+/* 模拟NVIC支持的中断号范围 */
+#define STUB_IRQ_COUNT      96U
+
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    __IO uint32_t VTOR;
+} SCB_Type;
+
+typedef struct {
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern SCB_Type stub_scb;
+extern CoreDebug_Type stub_coredebug;
+
+#define DWT         (Stub_DWT())
+#define SCB         (&stub_scb)
+#define CoreDebug   (&stub_coredebug)
+
+#define DWT_CTRL_CYCCNTENA_Msk      0x00000001U
+#define CoreDebug_DEMCR_TRCENA_Msk  0x01000000U
+
+/* 内核时钟 (Hz) */
+extern uint32_t SystemCoreClock;
+
+DWT_Type *Stub_DWT(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+uint32_t __get_BASEPRI(void);
+void __set_BASEPRI(uint32_t basepri);
+void __WFI(void);
+
+static inline void __disable_irq(void) { __set_PRIMASK(1U); }
+static inline void __enable_irq(void) { __set_PRIMASK(0U); }
+static inline void __DSB(void) { }
+static inline uint32_t __CLZ(uint32_t value) { return value ? (uint32_t)__builtin_clz(value) : 32U; }
+
+/* Flash寄存器 ---------------------------------------------------------------*/
+
+typedef struct {
+    __IO uint32_t ACR;
+    __IO uint32_t KEYR;
+    __IO uint32_t OPTKEYR;
+    __IO uint32_t SR;
+    __IO uint32_t CR;
+    __IO uint32_t OPTCR;
+} FLASH_TypeDef;
+
+#define FLASH   (Stub_Flash())
+
+#define FLASH_BASE_ADDR         0x08000000U
+#define FLASH_TOTAL_SIZE        (512U * 1024U)
+
+#define FLASH_SR_EOP            0x00000001U
+#define FLASH_SR_OPERR          0x00000002U
+#define FLASH_SR_WRPERR         0x00000010U
+#define FLASH_SR_PGAERR         0x00000020U
+#define FLASH_SR_PGPERR         0x00000040U
+#define FLASH_SR_PGSERR         0x00000080U
+#define FLASH_SR_BSY            0x00010000U
+
+#define FLASH_CR_PG             0x00000001U
+#define FLASH_CR_SER            0x00000002U
+#define FLASH_CR_SNB_Pos        3U
+#define FLASH_CR_SNB            0x00000078U
+#define FLASH_CR_PSIZE          0x00000300U
+#define FLASH_CR_PSIZE_0        0x00000100U
+#define FLASH_CR_PSIZE_1        0x00000200U
+#define FLASH_CR_STRT           0x00010000U
+#define FLASH_CR_LOCK           0x80000000U
+
+#define FLASH_ACR_LATENCY       0x0000000FU
+#define FLASH_ACR_PRFTEN        0x00000100U
+#define FLASH_ACR_ICEN          0x00000200U
+#define FLASH_ACR_DCEN          0x00000400U
+#define FLASH_ACR_ICRST         0x00000800U
+#define FLASH_ACR_DCRST         0x00001000U
+
+#define FLASH_FLAG_EOP          FLASH_SR_EOP
+#define FLASH_FLAG_OPERR        FLASH_SR_OPERR
+#define FLASH_FLAG_WRPERR       FLASH_SR_WRPERR
+#define FLASH_FLAG_PGAERR       FLASH_SR_PGAERR
+#define FLASH_FLAG_PGPERR       FLASH_SR_PGPERR
+#define FLASH_FLAG_PGSERR       FLASH_SR_PGSERR
+
+#define FLASH_SECTOR_0          0U
+#define FLASH_SECTOR_1          1U
+#define FLASH_SECTOR_2          2U
+#define FLASH_SECTOR_3          3U
+#define FLASH_SECTOR_4          4U
+#define FLASH_SECTOR_5          5U
+#define FLASH_SECTOR_6          6U
+#define FLASH_SECTOR_7          7U
+
+#define FLASH_LATENCY_0         0U
+#define FLASH_LATENCY_1         1U
+#define FLASH_LATENCY_2         2U
+#define FLASH_LATENCY_3         3U
+
+#define FLASH_TYPEPROGRAM_BYTE      0x00U
+#define FLASH_TYPEPROGRAM_HALFWORD  0x01U
+#define FLASH_TYPEPROGRAM_WORD      0x02U
+
+#define __HAL_FLASH_GET_LATENCY()               (FLASH->ACR & FLASH_ACR_LATENCY)
+#define __HAL_FLASH_CLEAR_FLAG(flag)            (FLASH->SR &= ~(flag))
+#define __HAL_FLASH_INSTRUCTION_CACHE_DISABLE() (FLASH->ACR &= ~FLASH_ACR_ICEN)
+#define __HAL_FLASH_INSTRUCTION_CACHE_ENABLE()  (FLASH->ACR |= FLASH_ACR_ICEN)
+#define __HAL_FLASH_INSTRUCTION_CACHE_RESET()   ((void)0)
+#define __HAL_FLASH_DATA_CACHE_DISABLE()        (FLASH->ACR &= ~FLASH_ACR_DCEN)
+#define __HAL_FLASH_DATA_CACHE_ENABLE()         (FLASH->ACR |= FLASH_ACR_DCEN)
+#define __HAL_FLASH_DATA_CACHE_RESET()          ((void)0)
+
+/* 复位标志 ------------------------------------------------------------------*/
+
+extern uint32_t stub_rcc_csr;
+
+#define RCC_FLAG_BORRST         0x02000000U
+#define RCC_FLAG_PINRST         0x04000000U
+#define RCC_FLAG_PORRST         0x08000000U
+#define RCC_FLAG_SFTRST         0x10000000U
+#define RCC_FLAG_IWDGRST        0x20000000U
+#define RCC_FLAG_WWDGRST        0x40000000U
+#define RCC_FLAG_LPWRRST        0x80000000U
+
+#define __HAL_RCC_GET_FLAG(flag)        ((stub_rcc_csr & (flag)) ? 1U : 0U)
+#define __HAL_RCC_CLEAR_RESET_FLAGS()   (stub_rcc_csr = 0U)
+
+/* 外设句柄（模拟BSP不使用其内容） -------------------------------------------*/
+
+typedef struct {
+    uint32_t State;
+} SPI_HandleTypeDef;
+
+typedef struct {
+    uint32_t gState;
+} UART_HandleTypeDef;
+
+/* HAL函数 -------------------------------------------------------------------*/
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void HAL_NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+
+/* 模拟环境控制 --------------------------------------------------------------*/
+
+/**
+ * @brief  将模拟Flash映射到0x08000000并填充为擦除态(0xFF)
+ * @retval 0=成功, -1=地址已被占用或映射失败
+ */
+int Stub_FlashMap(void);
+
+/**
+ * @brief  将镜像文件映射到0x08000000（MAP_SHARED，写入即落盘）
+ * @param  path: 镜像文件路径，不存在时创建并填充为0xFF
+ * @retval 0=成功, -1=文件或映射失败
+ */
+int Stub_FlashMapFile(const char *path);
+
+/**
+ * @brief  访问FLASH寄存器（完成到时的扇区擦除）
+ * @retval 模拟寄存器指针
+ */
+FLASH_TypeDef *Stub_Flash(void);
+
+/**
+ * @brief  自启动以来的单调时间
+ * @retval 纳秒
+ */
+uint64_t Stub_Nanos(void);
+
+/**
+ * @brief  切换到虚拟时钟并设置当前时刻（按记录的时间戳回放时使用）
+ * @param  now_ns: 时刻 (ns)，早于当前虚拟时刻时忽略
+ * @note   此后Stub_Nanos()、HAL_GetTick()和DWT只随本函数前进，
+ *         WFI不再睡眠而是直接前进到下一个1ms SysTick，
+ *         每次读DWT前进100ns（按CYCCNT忙等的延时得以结束）
+ * @retval 无
+ */
+void Stub_SetVirtualTime(uint64_t now_ns);
+
+/**
+ * @brief  登记中断处理函数
+ * @param  irq: 中断号 (0 ~ STUB_IRQ_COUNT-1)
+ * @param  handler: 处理函数
+ * @retval 无
+ */
+void Stub_SetVector(IRQn_Type irq, void (*handler)(void));
+
+/**
+ * @brief  检查是否有已使能的挂起中断（不考虑PRIMASK/BASEPRI，同WFI唤醒条件）
+ * @retval 1=有, 0=无
+ */
+uint8_t Stub_IrqPending(void);
+
+/**
+ * @brief  外设模型轮询：把到期的外设事件挂起为中断
+ * @note   弱函数，由模拟器实现；调用时不会嵌套
+ * @retval 无
+ */
+void Stub_Poll(void);
+
+/**
+ * @brief  WFI等待：阻塞到下一个外设事件或下一个1ms SysTick
+ * @param  now_ns: 当前时刻 (Stub_Nanos)
+ * @note   弱函数，由模拟器实现；默认实现睡眠到下一个1ms边界
+ * @retval 无
+ */
+void Stub_Wait(uint64_t now_ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32F4xx_HAL_H */
@@ -0,0 +1,558 @@
+/**
+ * @file    stub_hal.c
+ * @brief   主机编译用HAL模拟实现
+ * @details HAL_FLASH_Program按HAL库的流程实现（等待上次操作、设置PSIZE/PG、
+ *          写入、再次等待、清PG），使基准测试中逐字调用HAL的开销与固件一致；
+ *          时基、DWT周期计数和NVIC按单调时钟与单线程调度模拟，见stm32f4xx_hal.h
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#include "stm32f4xx_hal.h"
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* HAL中Flash操作的等待超时 (ms) */
+#define STUB_FLASH_TIMEOUT      50000U
+
+#define STUB_FLASH_SR_ERRORS    (FLASH_SR_OPERR | FLASH_SR_WRPERR | FLASH_SR_PGAERR | \
+                                 FLASH_SR_PGPERR | FLASH_SR_PGSERR)
+
+/* 扇区擦除典型时间 (ms)，见STM32F411数据手册tERASE16KB/64KB/128KB */
+#define STUB_ERASE_16K_MS       250U
+#define STUB_ERASE_64K_MS       550U
+#define STUB_ERASE_128K_MS      1000U
+
+/* 虚拟时钟下每次读DWT前进的时间 (ns)，使按CYCCNT忙等的延时能够结束 */
+#define STUB_VIRTUAL_DWT_READ_NS    100U
+
+/* 未登记优先级的中断，以及线程模式的"优先级" */
+#define STUB_PRIO_THREAD        0x100U
+
+/* 模拟寄存器 */
+static DWT_Type stub_dwt;
+SCB_Type stub_scb = { .VTOR = FLASH_BASE_ADDR };
+CoreDebug_Type stub_coredebug;
+static FLASH_TypeDef stub_flash = { .CR = FLASH_CR_LOCK };
+uint32_t stub_rcc_csr = RCC_FLAG_PORRST | RCC_FLAG_PINRST;
+
+/* 内核时钟，与SystemClock_Config()一致 */
+uint32_t SystemCoreClock = 96000000U;
+
+/* HAL时基 */
+volatile uint32_t uwTick = 0;
+
+/* 单调时钟起点 */
+static struct timespec stub_epoch;
+static uint8_t stub_epoch_valid = 0;
+
+/* 虚拟时钟（回放用），启用后时间只由Stub_SetVirtualTime()、WFI和读DWT推进 */
+static uint8_t virtual_time = 0;
+static uint64_t virtual_ns = 0;
+
+/* DWT计数：起点时刻、起点计数值和计数频率；固件改写CYCCNT或切换时钟时重新取起点 */
+static uint64_t dwt_base_ns;
+static uint32_t dwt_base_value;
+static uint32_t dwt_rate;
+static uint32_t dwt_last_value;
+
+/* 正在进行的扇区擦除 */
+static uint8_t erase_active = 0;
+static uint64_t erase_done_ns;
+static uint32_t erase_addr;
+static uint32_t erase_size;
+
+/* NVIC */
+static void (*stub_vectors[STUB_IRQ_COUNT])(void);
+static uint8_t nvic_priority[STUB_IRQ_COUNT];
+static uint32_t nvic_enabled[(STUB_IRQ_COUNT + 31U) / 32U];
+static uint32_t nvic_pending[(STUB_IRQ_COUNT + 31U) / 32U];
+static uint32_t stub_primask = 0;
+static uint32_t stub_basepri = 0;
+static uint32_t active_priority = STUB_PRIO_THREAD;
+static uint8_t stub_polling = 0;
+
+/* HAL_FLASH_Program的进程锁 */
+static volatile uint8_t flash_locked = 0;
+
+static void Stub_PollDispatch(void);
+
+/* 时基 ----------------------------------------------------------------------*/
+
+uint64_t Stub_Nanos(void)
+{
+    struct timespec ts;
+    
+    if (virtual_time)
+    {
+        return virtual_ns;
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    if (!stub_epoch_valid)
+    {
+        stub_epoch = ts;
+        stub_epoch_valid = 1;
+    }
+    
+    return (uint64_t)(ts.tv_sec - stub_epoch.tv_sec) * 1000000000ULL +
+           (uint64_t)ts.tv_nsec - (uint64_t)stub_epoch.tv_nsec;
+}
+
+void Stub_SetVirtualTime(uint64_t now_ns)
+{
+    if (!virtual_time || now_ns > virtual_ns)
+    {
+        virtual_ns = now_ns;
+    }
+    virtual_time = 1;
+}
+
+DWT_Type *Stub_DWT(void)
+{
+    uint64_t now;
+    
+    if (virtual_time)
+    {
+        virtual_ns += STUB_VIRTUAL_DWT_READ_NS;
+    }
+    now = Stub_Nanos();
+    
+    if ((stub_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        return &stub_dwt;
+    }
+    
+    if (stub_dwt.CYCCNT != dwt_last_value || SystemCoreClock != dwt_rate)
+    {
+        dwt_base_ns = now;
+        dwt_base_value = stub_dwt.CYCCNT;
+        dwt_rate = SystemCoreClock;
+    }
+    
+    dwt_last_value = dwt_base_value +
+                     (uint32_t)((now - dwt_base_ns) * dwt_rate / 1000000000ULL);
+    stub_dwt.CYCCNT = dwt_last_value;
+    
+    return &stub_dwt;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    uint32_t tick = (uint32_t)(Stub_Nanos() / 1000000ULL);
+    
+    uwTick = tick;
+    
+    /* 固件在此轮询时，到期的中断在此得到执行 */
+    Stub_PollDispatch();
+    
+    return tick;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    uint32_t tickstart = HAL_GetTick();
+    
+    /* 同HAL：至少等待Delay+1个时基 */
+    if (Delay < 0xFFFFFFFFU)
+    {
+        Delay++;
+    }
+    
+    while (HAL_GetTick() - tickstart < Delay)
+    {
+        __WFI();
+    }
+}
+
+/* NVIC ----------------------------------------------------------------------*/
+
+/**
+ * @brief  按优先级执行已挂起且未被屏蔽的中断
+ */
+static void Stub_Dispatch(void)
+{
+    uint32_t irq;
+    uint32_t best;
+    uint32_t prio;
+    uint32_t mask;
+    uint32_t saved;
+    
+    /* 外设模型轮询期间只挂起，轮询结束后统一执行 */
+    while (!stub_primask && !stub_polling)
+    {
+        /* 只有比当前执行优先级高、且未被BASEPRI屏蔽的中断可以进入 */
+        mask = active_priority;
+        if (stub_basepri != 0 && (stub_basepri >> (8U - __NVIC_PRIO_BITS)) < mask)
+        {
+            mask = stub_basepri >> (8U - __NVIC_PRIO_BITS);
+        }
+        
+        best = STUB_IRQ_COUNT;
+        prio = mask;
+        for (irq = 0; irq < STUB_IRQ_COUNT; irq++)
+        {
+            if ((nvic_pending[irq / 32U] & nvic_enabled[irq / 32U] & (1U << (irq % 32U))) &&
+                nvic_priority[irq] < prio && stub_vectors[irq] != NULL)
+            {
+                best = irq;
+                prio = nvic_priority[irq];
+            }
+        }
+        if (best == STUB_IRQ_COUNT)
+        {
+            return;
+        }
+        
+        nvic_pending[best / 32U] &= ~(1U << (best % 32U));
+        saved = active_priority;
+        active_priority = prio;
+        stub_vectors[best]();
+        active_priority = saved;
+    }
+}
+
+/**
+ * @brief  轮询外设模型并执行由此挂起的中断
+ */
+static void Stub_PollDispatch(void)
+{
+    if (stub_polling)
+    {
+        return;
+    }
+    
+    stub_polling = 1;
+    Stub_Poll();
+    stub_polling = 0;
+    
+    /* 模拟SysTick：中断中直接读uwTick时为当前时刻 */
+    uwTick = (uint32_t)(Stub_Nanos() / 1000000ULL);
+    
+    Stub_Dispatch();
+}
+
+void Stub_SetVector(IRQn_Type irq, void (*handler)(void))
+{
+    if ((uint32_t)irq < STUB_IRQ_COUNT)
+    {
+        stub_vectors[irq] = handler;
+    }
+}
+
+uint8_t Stub_IrqPending(void)
+{
+    uint32_t i;
+    
+    for (i = 0; i < (STUB_IRQ_COUNT + 31U) / 32U; i++)
+    {
+        if (nvic_pending[i] & nvic_enabled[i])
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    if ((uint32_t)IRQn < STUB_IRQ_COUNT)
+    {
+        nvic_priority[IRQn] = (uint8_t)PreemptPriority;
+    }
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    if ((uint32_t)IRQn < STUB_IRQ_COUNT)
+    {
+        nvic_enabled[IRQn / 32U] |= 1U << (IRQn % 32U);
+        Stub_Dispatch();
+    }
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    if ((uint32_t)IRQn < STUB_IRQ_COUNT)
+    {
+        nvic_enabled[IRQn / 32U] &= ~(1U << (IRQn % 32U));
+    }
+}
+
+void HAL_NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+    if ((uint32_t)IRQn < STUB_IRQ_COUNT)
+    {
+        nvic_pending[IRQn / 32U] |= 1U << (IRQn % 32U);
+        Stub_Dispatch();
+    }
+}
+
+void HAL_NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    if ((uint32_t)IRQn < STUB_IRQ_COUNT)
+    {
+        nvic_pending[IRQn / 32U] &= ~(1U << (IRQn % 32U));
+    }
+}
+
+uint32_t __get_PRIMASK(void)
+{
+    return stub_primask;
+}
+
+void __set_PRIMASK(uint32_t primask)
+{
+    stub_primask = primask & 1U;
+    Stub_Dispatch();
+}
+
+uint32_t __get_BASEPRI(void)
+{
+    return stub_basepri;
+}
+
+void __set_BASEPRI(uint32_t basepri)
+{
+    stub_basepri = basepri & 0xFFU;
+    Stub_Dispatch();
+}
+
+void __WFI(void)
+{
+    /* 挂起的中断（即使被PRIMASK屏蔽）或SysTick唤醒 */
+    Stub_PollDispatch();
+    if (!Stub_IrqPending())
+    {
+        /* 虚拟时钟下不睡眠，直接前进到下一个SysTick */
+        if (virtual_time)
+        {
+            virtual_ns += 1000000ULL - virtual_ns % 1000000ULL;
+        }
+        else
+        {
+            Stub_Wait(Stub_Nanos());
+        }
+        Stub_PollDispatch();
+    }
+}
+
+/**
+ * @brief  外设模型轮询（默认无外设）
+ */
+__weak void Stub_Poll(void)
+{
+}
+
+/**
+ * @brief  WFI等待（默认睡眠到下一个1ms SysTick）
+ */
+__weak void Stub_Wait(uint64_t now_ns)
+{
+    uint64_t wait_ns = 1000000ULL - now_ns % 1000000ULL;
+    struct timespec ts = { 0, (long)wait_ns };
+    
+    nanosleep(&ts, NULL);
+}
+
+/* Flash ---------------------------------------------------------------------*/
+
+FLASH_TypeDef *Stub_Flash(void)
+{
+    uint32_t sector;
+    
+    /* STRT置位：开始擦除，SER选中的扇区在典型擦除时间后变为0xFF */
+    if ((stub_flash.CR & (FLASH_CR_STRT | FLASH_CR_SER)) == (FLASH_CR_STRT | FLASH_CR_SER))
+    {
+        stub_flash.CR &= ~FLASH_CR_STRT;
+        sector = (stub_flash.CR & FLASH_CR_SNB) >> FLASH_CR_SNB_Pos;
+        
+        if (stub_flash.CR & FLASH_CR_LOCK)
+        {
+            stub_flash.SR |= FLASH_SR_WRPERR;
+        }
+        else if (sector < 4U)
+        {
+            erase_addr = FLASH_BASE_ADDR + sector * 0x4000U;
+            erase_size = 0x4000U;
+            erase_done_ns = Stub_Nanos() + STUB_ERASE_16K_MS * 1000000ULL;
+            erase_active = 1;
+        }
+        else if (sector == 4U)
+        {
+            erase_addr = FLASH_BASE_ADDR + 0x10000U;
+            erase_size = 0x10000U;
+            erase_done_ns = Stub_Nanos() + STUB_ERASE_64K_MS * 1000000ULL;
+            erase_active = 1;
+        }
+        else if (sector < 8U)
+        {
+            erase_addr = FLASH_BASE_ADDR + 0x20000U * (sector - 4U);
+            erase_size = 0x20000U;
+            erase_done_ns = Stub_Nanos() + STUB_ERASE_128K_MS * 1000000ULL;
+            erase_active = 1;
+        }
+        else
+        {
+            stub_flash.SR |= FLASH_SR_PGSERR;
+        }
+        
+        if (erase_active)
+        {
+            stub_flash.SR |= FLASH_SR_BSY;
+        }
+    }
+    
+    if (erase_active && Stub_Nanos() >= erase_done_ns)
+    {
+        memset((void *)(uintptr_t)erase_addr, 0xFF, erase_size);
+        erase_active = 0;
+        stub_flash.SR &= ~FLASH_SR_BSY;
+        stub_flash.SR |= FLASH_SR_EOP;
+    }
+    
+    return &stub_flash;
+}
+
+/* HAL_FLASH -----------------------------------------------------------------*/
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    FLASH->CR &= ~FLASH_CR_LOCK;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    FLASH->CR |= FLASH_CR_LOCK;
+    return HAL_OK;
+}
+
+/**
+ * @brief  等待Flash操作完成（同FLASH_WaitForLastOperation）
+ */
+static HAL_StatusTypeDef Stub_FlashWait(uint32_t timeout)
+{
+    uint32_t tickstart = HAL_GetTick();
+    
+    while (FLASH->SR & FLASH_SR_BSY)
+    {
+        if (HAL_GetTick() - tickstart > timeout)
+        {
+            return HAL_TIMEOUT;
+        }
+    }
+    
+    if (FLASH->SR & FLASH_SR_EOP)
+    {
+        __HAL_FLASH_CLEAR_FLAG(FLASH_SR_EOP);
+    }
+    
+    if (FLASH->SR & STUB_FLASH_SR_ERRORS)
+    {
+        return HAL_ERROR;
+    }
+    
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+    HAL_StatusTypeDef status;
+    
+    if (flash_locked)
+    {
+        return HAL_BUSY;
+    }
+    flash_locked = 1;
+    
+    status = Stub_FlashWait(STUB_FLASH_TIMEOUT);
+    if (status == HAL_OK)
+    {
+        FLASH->CR &= ~FLASH_CR_PSIZE;
+        
+        switch (TypeProgram)
+        {
+            case FLASH_TYPEPROGRAM_BYTE:
+                FLASH->CR |= FLASH_CR_PG;
+                *(__IO uint8_t *)(uintptr_t)Address = (uint8_t)Data;
+                break;
+            
+            case FLASH_TYPEPROGRAM_HALFWORD:
+                FLASH->CR |= FLASH_CR_PSIZE_0 | FLASH_CR_PG;
+                *(__IO uint16_t *)(uintptr_t)Address = (uint16_t)Data;
+                break;
+            
+            default:
+                FLASH->CR |= FLASH_CR_PSIZE_1 | FLASH_CR_PG;
+                *(__IO uint32_t *)(uintptr_t)Address = (uint32_t)Data;
+                break;
+        }
+        
+        status = Stub_FlashWait(STUB_FLASH_TIMEOUT);
+        FLASH->CR &= ~FLASH_CR_PG;
+    }
+    
+    flash_locked = 0;
+    
+    return status;
+}
+
+int Stub_FlashMap(void)
+{
+    void *p = mmap((void *)(uintptr_t)FLASH_BASE_ADDR, FLASH_TOTAL_SIZE,
+                   PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                   -1, 0);
+    
+    if (p != (void *)(uintptr_t)FLASH_BASE_ADDR)
+    {
+        return -1;
+    }
+    
+    memset(p, 0xFF, FLASH_TOTAL_SIZE);
+    
+    return 0;
+}
+
+int Stub_FlashMapFile(const char *path)
+{
+    static const uint8_t erased[4096] = { [0 ... 4095] = 0xFF };
+    struct stat st;
+    uint32_t off;
+    void *p;
+    int fd;
+    
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    
+    /* 新文件（或不足512KB的文件）补齐为擦除态 */
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    for (off = (uint32_t)st.st_size & ~(sizeof(erased) - 1U); off < FLASH_TOTAL_SIZE;
+         off += sizeof(erased))
+    {
+        if (pwrite(fd, erased, sizeof(erased), off) != (ssize_t)sizeof(erased))
+        {
+            close(fd);
+            return -1;
+        }
+    }
+    
+    p = mmap((void *)(uintptr_t)FLASH_BASE_ADDR, FLASH_TOTAL_SIZE,
+             PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+    close(fd);
+    
+    return (p == (void *)(uintptr_t)FLASH_BASE_ADDR) ? 0 : -1;
+}
@@ -43,6 +43,29 @@ extern "C" {
 #define ADC_GAIN_64         0x06
 #define ADC_GAIN_128        0x07
 
+/* DRDY中断采样FIFO深度（2的幂），Flash擦除期间主循环停顿时缓存样本：
+ * 128KB扇区擦除最长约2s，10ms采样周期下需约200个样本 */
+#define ADC_FIFO_SIZE       256
+
+/* 定时器触发采样周期 (μs)，须大于ADC单次转换时间 */
+#define ADC_SAMPLE_PERIOD_DEFAULT_US    10000U
+#define ADC_SAMPLE_PERIOD_MIN_US        100U
+#define ADC_SAMPLE_PERIOD_MAX_US        10000000U
+
+/* 连续多次触发时转换仍未完成，视为DRDY丢失，强制重新启动转换 */
+#define ADC_OVERRUN_RESTART             4
+
+/* 突发采集缓冲区深度（样本数，2的幂），触发前与触发后样本数之和不超过此值 */
+#define ADC_BURST_SIZE                  4096
+
+/* 突发采集电平触发沿（码值为偏移二进制，大小与电压一致） */
+#define ADC_BURST_EDGE_RISING           0x01    /* 由低于阈值变为不低于阈值 */
+#define ADC_BURST_EDGE_FALLING          0x02    /* 由不低于阈值变为低于阈值 */
+
+/* ADC命令（根据实际ADC芯片修改） */
+#define ADC_CMD_START       0x08            /* 启动转换 */
+#define ADC_CMD_READ        0x40            /* 读寄存器标志 */
+
 /* 类型定义 ------------------------------------------------------------------*/
 
 /* ADC状态 */
@@ -60,38 +83,266 @@ typedef struct {
     float vref;             /* 参考电压 */
 } ADCConfig_t;
 
+/* DRDY中断采样统计 */
+typedef struct {
+    uint32_t sample_count;      /* 中断采集样本数 */
+    uint32_t overflow_count;    /* FIFO满丢弃的最旧样本数 */
+    uint32_t deferred_count;    /* 因SPI总线被主循环占用而延后的次数 */
+    uint32_t max_gap_us;        /* 相邻两次采集的最大间隔 (μs) */
+    uint32_t max_gap_flash_us;  /* Flash擦写期间相邻两次采集的最大间隔 (μs) */
+    uint32_t max_latency_us;    /* 延后采集的最大额外延迟 (μs) */
+} ADCStats_t;
+
+/* 定时器触发采样间隔统计（时间单位均为CPU周期）
+ * 间隔指相邻两次实际启动转换的时刻之差，抖动 = |间隔 - 设定周期| */
+typedef struct {
+    uint32_t period_us;             /* 设定采样周期 (μs) */
+    uint32_t interval_count;        /* 统计的间隔数 */
+    uint32_t min_interval_cycles;   /* 最小间隔（无样本时为0） */
+    uint32_t max_interval_cycles;   /* 最大间隔 */
+    uint32_t max_jitter_cycles;     /* 最大抖动 */
+    uint64_t sum_jitter_cycles;     /* 抖动累计 */
+    uint64_t sum_sq_jitter;         /* 抖动平方累计（饱和） */
+    uint32_t overrun_count;         /* 触发时上次转换未完成而跳过的次数 */
+    uint32_t deferred_count;        /* 触发时SPI总线被占用而延后启动的次数 */
+    uint32_t max_delay_cycles;      /* 触发到实际启动转换的最大延迟 */
+} ADCTiming_t;
+
+/* 突发采集状态 */
+typedef enum {
+    ADC_BURST_IDLE = 0,         /* 未布防 */
+    ADC_BURST_ARMED,            /* 连续转换写入触发前样本，等待触发 */
+    ADC_BURST_TRIGGERED,        /* 已触发，写入触发后样本 */
+    ADC_BURST_DONE              /* 采集完成，数据块可读出 */
+} ADCBurstState_t;
+
+/* 突发采集触发源 */
+typedef enum {
+    ADC_BURST_SRC_NONE = 0,     /* 未触发 */
+    ADC_BURST_SRC_LEVEL,        /* 码值越过阈值 */
+    ADC_BURST_SRC_RATE,         /* 温度变化率超限（应用层判断） */
+    ADC_BURST_SRC_COMMAND       /* 命令触发 */
+} ADCBurstSource_t;
+
+/* 突发采集配置 */
+typedef struct {
+    uint16_t pre_samples;       /* 触发前样本数 */
+    uint16_t post_samples;      /* 触发后样本数（含触发样本），至少1 */
+    uint8_t edge;               /* 电平触发沿 (ADC_BURST_EDGE_x)，0=不使用电平触发 */
+    uint32_t level_raw;         /* 电平触发阈值（24位码值） */
+} ADCBurstConfig_t;
+
+/* 突发采集状态 */
+typedef struct {
+    uint8_t state;              /* 状态 (ADCBurstState_t) */
+    uint8_t source;             /* 触发源 (ADCBurstSource_t) */
+    uint16_t pre_count;         /* 数据块中触发前的样本数（布防后采到的不足设定值时取实际数） */
+    uint16_t post_count;        /* 已写入的触发后样本数 */
+    uint32_t trigger_cycles;    /* 触发样本启动转换的CPU周期计数 */
+    uint32_t interval_ns;       /* 触发后样本的平均间隔 (ns)，不足2个时为0 */
+    uint32_t max_interval_ns;   /* 布防以来相邻两次启动转换的最大间隔 (ns) */
+} ADCBurstStatus_t;
+
 /* 函数声明 ------------------------------------------------------------------*/
 
 /**
  * @brief  ADC服务初始化
+ * @note   只在首次调用时执行，重复调用无副作用
  * @retval 无
  */
 void SVC_ADC_Init(void);
 
 /**
- * @brief  启动ADC转换
+ * @brief  启动定时采样
+ * @note   启动采样定时器并立即开始第一次转换，之后每个采样周期由定时器中断
+ *         启动一次转换，DRDY中断读取结果并连同启动时刻存入FIFO
  * @retval 无
  */
 void SVC_ADC_StartConversion(void);
 
+/**
+ * @brief  停止定时采样
+ * @note   当前转换完成后不再启动下一次
+ * @retval 无
+ */
+void SVC_ADC_StopConversion(void);
+
+/**
+ * @brief  设置采样周期
+ * @param  period_us: 采样周期 (μs)，限制在ADC_SAMPLE_PERIOD_MIN_US ~ MAX_US
+ * @note   运行中修改在下一次触发后生效，同时清零间隔统计
+ * @retval 实际设置的采样周期 (μs)
+ */
+uint32_t SVC_ADC_SetSamplePeriod(uint32_t period_us);
+
+/**
+ * @brief  获取采样周期
+ * @retval 采样周期 (μs)
+ */
+uint32_t SVC_ADC_GetSamplePeriod(void);
+
+/**
+ * @brief  系统时钟改变后重新同步采样定时
+ * @note   重新计算定时器预分频和周期对应的CPU周期数，清零间隔统计
+ * @retval 无
+ */
+void SVC_ADC_UpdateClock(void);
+
 /**
  * @brief  检查ADC数据是否就绪
- * @retval 1=就绪, 0=未就绪
+ * @retval 1=FIFO中有样本, 0=无
  */
 uint8_t SVC_ADC_IsReady(void);
 
 /**
- * @brief  读取ADC原始值
+ * @brief  直接读取ADC原始值
+ * @note   主循环中通过SPI读取数据寄存器，不经过FIFO
  * @retval 24位ADC原始值
  */
 uint32_t SVC_ADC_ReadRaw(void);
 
+/**
+ * @brief  从FIFO取出一个样本
+ * @param  raw: 输出24位原始值
+ * @retval 1=成功, 0=FIFO为空
+ */
+uint8_t SVC_ADC_PopRaw(uint32_t *raw);
+
+/**
+ * @brief  获取最近一次取出样本的采集时刻
+ * @note   即该样本启动转换时的CPU周期计数，相邻样本的时刻差为实际采样间隔
+ * @retval CPU周期计数
+ */
+uint32_t SVC_ADC_GetLastSampleCycles(void);
+
+/**
+ * @brief  获取最近一次取出样本的采集时刻（ms）
+ * @note   DWT周期计数在96MHz下约44.7s回绕且随时钟档位变化，
+ *         跨测量的时间间隔（如温度变化率）应使用此ms时基
+ * @retval 启动转换时的ms时基（与HAL_GetTick()同源）
+ */
+uint32_t SVC_ADC_GetLastSampleTick(void);
+
+/**
+ * @brief  获取最近一次ReadVoltage()换算的原始值
+ * @note   即测量流水线实际使用的码值，供原始数据录制
+ * @retval 24位ADC原始值
+ */
+uint32_t SVC_ADC_GetLastRaw(void);
+
+/**
+ * @brief  原始值转换为电压
+ * @param  raw: 24位原始值
+ * @retval 电压值 (mV)
+ */
+float SVC_ADC_RawToVoltage(uint32_t raw);
+
+/**
+ * @brief  电压转换为原始值
+ * @param  voltage: 电压值 (mV)
+ * @note   按当前增益与参考电压换算，超出量程时取端点
+ * @retval 24位原始值
+ */
+uint32_t SVC_ADC_VoltageToRaw(float voltage);
+
 /**
  * @brief  读取ADC电压值
+ * @note   优先取FIFO中最早的样本，FIFO为空时直接读取
  * @retval 电压值 (mV)
  */
 float SVC_ADC_ReadVoltage(void);
 
+/**
+ * @brief  ADC数据就绪中断回调
+ * @note   由EXTI0中断调用，位于RAM中；SPI总线被占用时延后到总线释放，
+ *         同时处理被延后的定时器触发
+ * @retval 无
+ */
+void SVC_ADC_DRDY_Callback(void);
+
+/**
+ * @brief  采样定时器触发回调
+ * @note   由TIM2中断调用，位于RAM中；SPI总线被占用时由EXTI0在总线释放后补发
+ * @retval 无
+ */
+void SVC_ADC_Trigger_Callback(void);
+
+/**
+ * @brief  获取DRDY中断采样统计
+ * @param  stats: 输出统计结构体指针
+ * @retval 无
+ */
+void SVC_ADC_GetStats(ADCStats_t *stats);
+
+/**
+ * @brief  清零DRDY中断采样统计
+ * @retval 无
+ */
+void SVC_ADC_ResetStats(void);
+
+/**
+ * @brief  获取定时器触发采样间隔统计
+ * @param  timing: 输出统计结构体指针
+ * @retval 无
+ */
+void SVC_ADC_GetTiming(ADCTiming_t *timing);
+
+/**
+ * @brief  清零定时器触发采样间隔统计
+ * @retval 无
+ */
+void SVC_ADC_ResetTiming(void);
+
+/**
+ * @brief  布防突发采集
+ * @param  config: 采集配置
+ * @note   布防后DRDY中断读出结果即启动下一次转换，以ADC最高速率把每个码值写入
+ *         RAM环形缓冲区；定时器触发仍按采样周期取其后完成的一个样本送入FIFO，
+ *         测量流水线的采样间隔不变。触发后写满触发后样本即恢复定时触发。
+ *         重新布防丢弃上一个数据块
+ * @retval 0=成功, -1=参数无效
+ */
+int SVC_ADC_BurstArm(const ADCBurstConfig_t *config);
+
+/**
+ * @brief  请求触发突发采集
+ * @param  source: 触发源 (ADCBurstSource_t)
+ * @note   在下一个写入的样本处触发
+ * @retval 1=已请求, 0=未处于布防状态
+ */
+uint8_t SVC_ADC_BurstTrigger(uint8_t source);
+
+/**
+ * @brief  取消突发采集
+ * @note   丢弃数据块，当前转换完成后恢复定时触发
+ * @retval 无
+ */
+void SVC_ADC_BurstAbort(void);
+
+/**
+ * @brief  获取突发采集状态
+ * @param  status: 输出状态结构体指针
+ * @retval 无
+ */
+void SVC_ADC_BurstGetStatus(ADCBurstStatus_t *status);
+
+/**
+ * @brief  获取突发采集配置
+ * @param  config: 输出配置结构体指针
+ * @retval 无
+ */
+void SVC_ADC_BurstGetConfig(ADCBurstConfig_t *config);
+
+/**
+ * @brief  读出突发采集数据块
+ * @param  offset: 起始位置（0=数据块中最早的触发前样本）
+ * @param  raw: 输出24位原始值数组
+ * @param  count: 最多读出个数
+ * @note   仅在ADC_BURST_DONE状态下有效，读出不移除数据
+ * @retval 实际读出个数
+ */
+uint16_t SVC_ADC_BurstRead(uint16_t offset, uint32_t *raw, uint16_t count);
+
 /**
  * @brief  设置ADC增益
  * @param  gain: 增益值 (ADC_GAIN_x)
@@ -113,6 +364,12 @@ float SVC_ADC_GetGain(void);
  */
 void SVC_ADC_SetVref(float vref);
 
+/**
+ * @brief  获取参考电压值
+ * @retval 参考电压 (V)
+ */
+float SVC_ADC_GetVref(void);
+
 /**
  * @brief  写入ADC寄存器
  * @param  reg: 寄存器地址
@@ -32,9 +32,16 @@ extern "C" {
 #define OUTPUT_CURRENT_MIN      4.0f        /* 最小输出电流 (mA) */
 #define OUTPUT_CURRENT_MAX      20.0f       /* 最大输出电流 (mA) */
 
+/* 故障电流范围（NAMUR NE43），报警时可超出4-20mA */
+#define OUTPUT_CURRENT_FAULT_MIN    3.6f    /* 下限故障电流 (mA) */
+#define OUTPUT_CURRENT_FAULT_MAX    21.0f   /* 上限故障电流 (mA) */
+
 /* V/I转换系数（根据实际电路确定） */
 #define VI_COEFFICIENT          2.5f        /* mA/V */
 
+/* LOAD低脉冲宽度 (μs)，DAC芯片要求的最小脉宽远小于1μs */
+#define DAC_LOAD_PULSE_US       1
+
 /* 类型定义 ------------------------------------------------------------------*/
 
 /* 电流源选择 */
@@ -53,6 +60,7 @@ typedef enum {
 
 /**
  * @brief  DAC服务初始化
+ * @note   只在首次调用时执行，重复调用无副作用
  * @retval 无
  */
 void SVC_DAC_Init(void);
@@ -80,11 +88,19 @@ void SVC_DAC_SetCurrentAdj(CurrentSource_e src, float adj_uA);
 
 /**
  * @brief  设置4-20mA输出电流
- * @param  current_mA: 输出电流值 (mA), 范围4.0-20.0
+ * @param  current_mA: 输出电流值 (mA), 正常范围4.0-20.0，故障电流3.6-21.0
+ * @note   只按故障电流范围限幅，正常输出由应用层限制在4.0-20.0
  * @retval 无
  */
 void SVC_DAC_Set420mA(float current_mA);
 
+/**
+ * @brief  计算4-20mA输出电流对应的DAC码值
+ * @param  current_mA: 输出电流值 (mA)，超出3.6-21.0时限幅
+ * @retval 16位DAC值
+ */
+uint16_t SVC_DAC_Calc420mACode(float current_mA);
+
 /**
  * @brief  获取当前4-20mA输出值
  * @retval 当前输出电流 (mA)
@@ -103,6 +119,7 @@ void SVC_DAC_SetVoltage(DACChannel_e channel, float voltage);
  * @brief  设置DAC原始值
  * @param  channel: DAC通道
  * @param  value: 16位DAC值 (0-65535)
+ * @note   无条件写入输入寄存器，不触发加载
  * @retval 无
  */
 void SVC_DAC_WriteRaw(DACChannel_e channel, uint16_t value);
@@ -110,10 +127,18 @@ void SVC_DAC_WriteRaw(DACChannel_e channel, uint16_t value);
 /**
  * @brief  触发DAC加载（更新输出）
  * @param  channel: DAC通道
+ * @note   LOAD低脉冲宽度为DAC_LOAD_PULSE_US，由DWT计时，不阻塞毫秒级
  * @retval 无
  */
 void SVC_DAC_Load(DACChannel_e channel);
 
+/**
+ * @brief  获取通道最近一次写入的DAC码值
+ * @param  channel: DAC通道
+ * @retval 16位DAC值
+ */
+uint16_t SVC_DAC_GetCode(DACChannel_e channel);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,59 @@
+/**
+ * @file    svc_fmt.h
+ * @brief   定点数字格式化服务头文件
+ * @details 提供固定小数位数的数字转字符串功能，替代snprintf("%.Nf")
+ *          纯软件模块，不依赖HAL、堆和locale，可在主机上编译
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+#ifndef __SVC_FMT_H
+#define __SVC_FMT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include <stdint.h>
+
+/* 宏定义 --------------------------------------------------------------------*/
+
+/* 支持的最大小数位数 */
+#define FMT_MAX_DECIMALS        6
+
+/* 浮点格式化支持的最大绝对值 (2^40)，超出输出"ovf" */
+#define FMT_FLOAT_LIMIT         1099511627776.0f
+
+/* 函数声明 ------------------------------------------------------------------*/
+
+/**
+ * @brief  浮点数格式化为固定小数位字符串
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小（含结束符）
+ * @param  value: 浮点数值
+ * @param  decimals: 小数位数 (0 - FMT_MAX_DECIMALS)
+ * @note   输出与snprintf(buf, size, "%.*f", decimals, value)逐字符一致：
+ *         按float精确值做四舍六入五成双，负数舍入为0时保留"-"，
+ *         支持nan/inf；缓冲区不足时截断
+ * @retval 写入的字符数（不含结束符）
+ */
+uint8_t SVC_FMT_Float(char *buf, uint8_t size, float value, uint8_t decimals);
+
+/**
+ * @brief  定点整数格式化为固定小数位字符串
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小（含结束符）
+ * @param  value: 定点数值（实际值 = value / 10^decimals）
+ * @param  decimals: 小数位数 (0 - FMT_MAX_DECIMALS)
+ * @note   例如 value=-12345, decimals=3 输出"-12.345"
+ * @retval 写入的字符数（不含结束符）
+ */
+uint8_t SVC_FMT_Fixed(char *buf, uint8_t size, int32_t value, uint8_t decimals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SVC_FMT_H */
@@ -19,8 +19,18 @@ extern "C" {
 
 /* 宏定义 --------------------------------------------------------------------*/
 
-/* LCD刷新间隔 (ms) */
-#define LCD_UPDATE_INTERVAL     1000
+/* LCD默认刷新间隔 (ms)，仅发送变化的控件，可用SVC_LCD_SetUpdateInterval()修改 */
+#define LCD_UPDATE_INTERVAL     200
+
+/* 串口屏上电稳定时间与复位指令后的等待时间 (ms) */
+#define LCD_POWERUP_MS          500
+#define LCD_RESET_MS            500
+
+/* 单次刷新合并发送缓冲区大小 */
+#define LCD_TX_BUFFER_SIZE      256
+
+/* 控件文本缓存长度 */
+#define LCD_TEXT_MAX_LEN        32
 
 /* 淘晶驰指令结束符 */
 #define LCD_CMD_END_1           0xFF
@@ -37,6 +47,16 @@ extern "C" {
 
 /* 类型定义 ------------------------------------------------------------------*/
 
+/* 刷新控件编号（脏标记按位对应） */
+typedef enum {
+    LCD_FIELD_TEMP = 0,     /* 温度 */
+    LCD_FIELD_VOLT,         /* 电压 */
+    LCD_FIELD_CURR,         /* 输出电流 */
+    LCD_FIELD_SRC,          /* 电流源 */
+    LCD_FIELD_STATUS,       /* 状态 */
+    LCD_FIELD_COUNT
+} LCDField_e;
+
 /* LCD显示数据结构 */
 typedef struct {
     float temperature;      /* 温度值 (℃) */
@@ -50,16 +70,25 @@ typedef struct {
 
 /**
  * @brief  LCD服务初始化
+ * @note   不阻塞：上电等待、复位和切换页面由SVC_LCD_Update()在后台依次完成，
+ *         期间设置的显示内容在屏幕就绪后一次发送；重复调用无副作用
  * @retval 无
  */
 void SVC_LCD_Init(void);
 
 /**
  * @brief  LCD周期更新（在主循环中调用）
+ * @note   只发送内容与上次发送不同的控件，多条指令合并为一次UART发送
  * @retval 无
  */
 void SVC_LCD_Update(void);
 
+/**
+ * @brief  检查串口屏是否已完成上电复位
+ * @retval 1=就绪, 0=启动中
+ */
+uint8_t SVC_LCD_IsReady(void);
+
 /**
  * @brief  设置温度显示值
  * @param  temp: 温度值 (℃)
@@ -127,10 +156,24 @@ void SVC_LCD_SetPage(uint8_t page);
 
 /**
  * @brief  强制立即刷新显示
+ * @note   清除发送缓存，全部控件重新发送
  * @retval 无
  */
 void SVC_LCD_Refresh(void);
 
+/**
+ * @brief  设置刷新间隔
+ * @param  interval_ms: 刷新间隔 (ms)
+ * @retval 无
+ */
+void SVC_LCD_SetUpdateInterval(uint32_t interval_ms);
+
+/**
+ * @brief  获取刷新间隔
+ * @retval 刷新间隔 (ms)
+ */
+uint32_t SVC_LCD_GetUpdateInterval(void);
+
 #ifdef __cplusplus
 }
 #endif
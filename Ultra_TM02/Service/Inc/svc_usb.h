@@ -38,6 +38,7 @@ typedef enum {
 
 /**
  * @brief  USB服务初始化
+ * @note   只在首次调用时执行，重复调用无副作用
  * @retval 无
  */
 void SVC_USB_Init(void);
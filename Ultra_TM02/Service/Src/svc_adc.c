@@ -11,6 +11,10 @@
 #include "svc_adc.h"
 #include "bsp_spi.h"
 #include "bsp_gpio.h"
+#include "bsp_dwt.h"
+#include "bsp_flash.h"
+#include "bsp_tim.h"
+#include <string.h>
 
 /* 私有变量 ------------------------------------------------------------------*/
 
@@ -24,6 +28,74 @@ static ADCConfig_t adc_config = {
 /* 当前增益系数 */
 static float gain_factor = 1.0f;
 
+/* DRDY中断采样FIFO */
+static uint32_t raw_fifo[ADC_FIFO_SIZE];
+static volatile uint16_t fifo_head = 0;     /* 写入位置（中断） */
+static volatile uint16_t fifo_tail = 0;     /* 读取位置（主循环） */
+
+/* 样本采集时刻（与raw_fifo同步，启动转换时的CPU周期计数） */
+static uint32_t stamp_fifo[ADC_FIFO_SIZE];
+static uint32_t last_pop_cycles = 0;
+
+/* 样本采集时刻的ms时基（与raw_fifo同步，不随时钟档位变化，长采样周期下不回绕） */
+static uint32_t tick_fifo[ADC_FIFO_SIZE];
+static uint32_t last_pop_tick = 0;
+
+/* 最近一次ReadVoltage()换算的原始值 */
+static uint32_t last_raw = 0;
+
+/* 初始化完成标志 */
+static uint8_t adc_initialized = 0;
+
+/* 连续转换使能 */
+static volatile uint8_t adc_continuous = 0;
+
+/* 定时触发状态（仅在TIM2/EXTI0中断中修改，两者优先级相同不会嵌套） */
+static uint32_t sample_period_us = ADC_SAMPLE_PERIOD_DEFAULT_US;
+static volatile uint32_t sample_period_cycles = 0;
+static volatile uint8_t trigger_pending = 0;    /* 有触发尚未启动转换 */
+static uint32_t trigger_cycles = 0;             /* 触发时刻 */
+static uint8_t conv_busy = 0;                   /* 转换进行中，结果未读 */
+static uint32_t conv_start_cycles = 0;          /* 当前转换的启动时刻 */
+static uint32_t conv_start_tick = 0;            /* 当前转换的启动时刻 (ms) */
+static uint8_t overrun_run = 0;                 /* 连续跳过的触发数 */
+
+/* 采样间隔统计 */
+static ADCTiming_t adc_timing = {0};
+static uint32_t last_start_cycles = 0;
+static uint8_t last_start_valid = 0;
+
+/* 中断采样统计（周期数，读取时换算为μs） */
+static ADCStats_t adc_stats = {0};
+static uint32_t max_gap_cycles = 0;
+static uint32_t max_gap_flash_cycles = 0;
+static uint32_t max_latency_cycles = 0;
+static uint32_t last_capture_cycles = 0;
+static uint8_t last_capture_valid = 0;
+static uint8_t capture_deferred = 0;
+static uint32_t deferred_cycles = 0;
+
+/* 突发采集（布防和触发期间背靠背连续转换，缓冲区只在中断中写入） */
+static uint32_t burst_buf[ADC_BURST_SIZE];
+static ADCBurstConfig_t burst_config = {0};
+static volatile uint8_t burst_state = ADC_BURST_IDLE;
+static volatile uint8_t burst_request = ADC_BURST_SRC_NONE;    /* 主循环请求的触发源 */
+static uint8_t burst_source = ADC_BURST_SRC_NONE;
+static uint16_t burst_head = 0;                 /* 下一个写入位置 */
+static uint16_t burst_filled = 0;               /* 触发前已写入的样本数（饱和） */
+static uint16_t burst_trigger_index = 0;        /* 触发样本位置 */
+static uint16_t burst_pre_count = 0;
+static uint16_t burst_post_count = 0;
+static uint32_t burst_prev_raw = 0;
+static uint8_t burst_prev_valid = 0;
+static uint32_t burst_trigger_cycles = 0;
+static uint32_t burst_end_cycles = 0;           /* 最后一个触发后样本的启动时刻 */
+static uint32_t burst_last_start = 0;
+static uint8_t burst_last_valid = 0;
+static uint32_t burst_max_interval = 0;
+static uint8_t conv_burst = 0;                  /* 当前转换由突发采集背靠背启动 */
+static uint8_t burst_take = 0;                  /* 定时触发已到，下一个完成的样本送入FIFO */
+
 /* 私有函数 ------------------------------------------------------------------*/
 
 /**
@@ -47,6 +119,318 @@ static float CalcGainFactor(uint8_t gain)
     }
 }
 
+/**
+ * @brief  读取ADC数据寄存器（寄存器级SPI）
+ * @note   位于RAM中，调用者需已占用SPI总线
+ * @retval 24位ADC原始值
+ */
+static RAMFUNC uint32_t ADC_ReadRawFast(void)
+{
+    uint8_t b0, b1, b2;
+    
+    BSP_ADC_CS(0);
+    
+    /* 发送读取数据命令 */
+    BSP_SPI_TransferFast(ADC_REG_DATA | ADC_CMD_READ);
+    
+    /* 读取3个字节（24位, MSB first） */
+    b0 = BSP_SPI_TransferFast(0x00);
+    b1 = BSP_SPI_TransferFast(0x00);
+    b2 = BSP_SPI_TransferFast(0x00);
+    
+    BSP_ADC_CS(1);
+    
+    return ((uint32_t)b0 << 16) | ((uint32_t)b1 << 8) | b2;
+}
+
+/**
+ * @brief  发送启动转换命令（寄存器级SPI）
+ * @note   位于RAM中，调用者需已占用SPI总线
+ * @retval 无
+ */
+static RAMFUNC void ADC_StartFast(void)
+{
+    BSP_ADC_CS(0);
+    BSP_SPI_TransferFast(ADC_CMD_START);
+    BSP_ADC_CS(1);
+}
+
+/**
+ * @brief  记录一次转换启动的间隔与抖动
+ * @param  now: 启动时刻
+ * @note   位于RAM中，只在中断中调用
+ * @retval 无
+ */
+static RAMFUNC void ADC_RecordInterval(uint32_t now)
+{
+    uint32_t interval;
+    uint32_t jitter;
+    uint64_t sq;
+    
+    if (last_start_valid)
+    {
+        interval = now - last_start_cycles;
+        jitter = (interval > sample_period_cycles) ? (interval - sample_period_cycles)
+                                                   : (sample_period_cycles - interval);
+        
+        if (adc_timing.interval_count == 0 || interval < adc_timing.min_interval_cycles)
+        {
+            adc_timing.min_interval_cycles = interval;
+        }
+        if (interval > adc_timing.max_interval_cycles)
+        {
+            adc_timing.max_interval_cycles = interval;
+        }
+        if (jitter > adc_timing.max_jitter_cycles)
+        {
+            adc_timing.max_jitter_cycles = jitter;
+        }
+        
+        adc_timing.sum_jitter_cycles += jitter;
+        sq = (uint64_t)jitter * jitter;
+        adc_timing.sum_sq_jitter = (adc_timing.sum_sq_jitter + sq < sq) ? UINT64_MAX
+                                 : adc_timing.sum_sq_jitter + sq;
+        adc_timing.interval_count++;
+    }
+    
+    last_start_cycles = now;
+    last_start_valid = 1;
+}
+
+/**
+ * @brief  CPU周期数换算为ns
+ * @param  cycles: CPU周期数
+ * @retval 时间 (ns)
+ */
+static uint32_t ADC_CyclesToNs(uint32_t cycles)
+{
+    return (uint32_t)((uint64_t)cycles * 1000U / (SystemCoreClock / 1000000U));
+}
+
+/**
+ * @brief  突发采集写入一个样本
+ * @param  raw: 24位原始值
+ * @param  stamp: 该样本启动转换的时刻
+ * @note   位于RAM中，只在中断中调用。触发前按环形覆盖，触发后写满设定数即完成；
+ *         触发前与触发后样本数之和不超过缓冲区深度，触发后写入不会覆盖触发前窗口
+ * @retval 无
+ */
+static RAMFUNC void ADC_BurstStore(uint32_t raw, uint32_t stamp)
+{
+    uint8_t source = burst_request;
+    
+    burst_buf[burst_head] = raw;
+    
+    if (burst_state == ADC_BURST_ARMED)
+    {
+        /* 电平触发：相邻两个样本跨过阈值 */
+        if (source == ADC_BURST_SRC_NONE && burst_prev_valid)
+        {
+            if (((burst_config.edge & ADC_BURST_EDGE_RISING) &&
+                 burst_prev_raw < burst_config.level_raw && raw >= burst_config.level_raw) ||
+                ((burst_config.edge & ADC_BURST_EDGE_FALLING) &&
+                 burst_prev_raw >= burst_config.level_raw && raw < burst_config.level_raw))
+            {
+                source = ADC_BURST_SRC_LEVEL;
+            }
+        }
+        burst_prev_raw = raw;
+        burst_prev_valid = 1;
+        
+        if (source == ADC_BURST_SRC_NONE)
+        {
+            burst_head = (burst_head + 1) & (ADC_BURST_SIZE - 1);
+            if (burst_filled < ADC_BURST_SIZE)
+            {
+                burst_filled++;
+            }
+            return;
+        }
+        
+        burst_request = ADC_BURST_SRC_NONE;
+        burst_source = source;
+        burst_trigger_index = burst_head;
+        burst_trigger_cycles = stamp;
+        burst_pre_count = (burst_filled < burst_config.pre_samples) ? burst_filled
+                                                                    : burst_config.pre_samples;
+        burst_post_count = 0;
+        burst_state = ADC_BURST_TRIGGERED;
+    }
+    
+    burst_head = (burst_head + 1) & (ADC_BURST_SIZE - 1);
+    burst_post_count++;
+    burst_end_cycles = stamp;
+    if (burst_post_count >= burst_config.post_samples)
+    {
+        burst_state = ADC_BURST_DONE;
+    }
+}
+
+/**
+ * @brief  读取完成的转换结果并处理定时触发
+ * @note   位于RAM中，由EXTI0和TIM2中断调用，只使用寄存器级SPI/GPIO和内联DWT计时，
+ *         Flash擦除期间照常采样；FIFO满时丢弃最旧样本
+ * @retval 无
+ */
+static RAMFUNC void ADC_Service(void)
+{
+    uint32_t now = BSP_DWT_GetCycles();
+    uint32_t gap;
+    uint32_t raw;
+    uint16_t head;
+    uint16_t next;
+    uint8_t to_fifo;
+    uint8_t data_ready = BSP_ADC_IsDataReady();
+    
+    /* 延后补发时数据可能已被读走、触发可能已被处理 */
+    if (!data_ready && !trigger_pending)
+    {
+        return;
+    }
+    
+    /* 主循环正在使用SPI总线，释放后由BSP_SPI_Unlock()重新挂起EXTI0 */
+    if (!BSP_SPI_ClaimFromISR(ADC_DRDY_EXTI_IRQn))
+    {
+        if (!capture_deferred)
+        {
+            capture_deferred = 1;
+            deferred_cycles = now;
+            adc_stats.deferred_count++;
+            if (trigger_pending)
+            {
+                adc_timing.deferred_count++;
+            }
+        }
+        return;
+    }
+    
+    if (capture_deferred)
+    {
+        capture_deferred = 0;
+        if (now - deferred_cycles > max_latency_cycles)
+        {
+            max_latency_cycles = now - deferred_cycles;
+        }
+    }
+    
+    /* 读取结果，样本时刻为该次转换的启动时刻 */
+    if (data_ready)
+    {
+        raw = ADC_ReadRawFast();
+        conv_busy = 0;
+        overrun_run = 0;
+        
+        /* 背靠背转换的样本只在定时触发到达后送一个进FIFO，测量流水线仍按采样周期取样 */
+        to_fifo = (!conv_burst || burst_take) ? 1 : 0;
+        if (to_fifo)
+        {
+            burst_take = 0;
+        }
+        if (burst_state == ADC_BURST_ARMED || burst_state == ADC_BURST_TRIGGERED)
+        {
+            ADC_BurstStore(raw, conv_start_cycles);
+        }
+        
+        /* 采样间隔统计 */
+        if (last_capture_valid)
+        {
+            gap = now - last_capture_cycles;
+            if (gap > max_gap_cycles)
+            {
+                max_gap_cycles = gap;
+            }
+            if (BSP_Flash_IsBusy() && gap > max_gap_flash_cycles)
+            {
+                max_gap_flash_cycles = gap;
+            }
+        }
+        last_capture_cycles = now;
+        last_capture_valid = 1;
+        
+        /* 存入FIFO，满时丢弃最旧样本 */
+        if (to_fifo)
+        {
+            head = fifo_head;
+            next = (head + 1) & (ADC_FIFO_SIZE - 1);
+            if (next == fifo_tail)
+            {
+                fifo_tail = (fifo_tail + 1) & (ADC_FIFO_SIZE - 1);
+                adc_stats.overflow_count++;
+            }
+            raw_fifo[head] = raw;
+            stamp_fifo[head] = conv_start_cycles;
+            tick_fifo[head] = conv_start_tick;
+            fifo_head = next;
+        }
+        
+        adc_stats.sample_count++;
+        
+        /* 突发采集：立即启动下一次转换 */
+        if (adc_continuous && (burst_state == ADC_BURST_ARMED || burst_state == ADC_BURST_TRIGGERED))
+        {
+            now = BSP_DWT_GetCycles();
+            ADC_StartFast();
+            conv_busy = 1;
+            conv_burst = 1;
+            conv_start_cycles = now;
+            conv_start_tick = BSP_DWT_GetTick();
+            
+            if (burst_last_valid && now - burst_last_start > burst_max_interval)
+            {
+                burst_max_interval = now - burst_last_start;
+            }
+            burst_last_start = now;
+            burst_last_valid = 1;
+        }
+    }
+    
+    /* 按定时器触发启动下一次转换 */
+    if (trigger_pending)
+    {
+        trigger_pending = 0;
+        
+        if (!adc_continuous)
+        {
+            return;
+        }
+        
+        /* 背靠背转换进行中：由它完成的样本代替本次触发，间隔统计从恢复定时触发后重新开始 */
+        if (conv_busy && conv_burst)
+        {
+            burst_take = 1;
+            last_start_valid = 0;
+            return;
+        }
+        
+        /* 上次转换未完成：跳过本次触发，连续多次则认为DRDY丢失而重新启动 */
+        if (conv_busy && ++overrun_run < ADC_OVERRUN_RESTART)
+        {
+            adc_timing.overrun_count++;
+            last_start_valid = 0;
+            return;
+        }
+        if (conv_busy)
+        {
+            adc_timing.overrun_count++;
+            last_start_valid = 0;
+        }
+        
+        now = BSP_DWT_GetCycles();
+        ADC_StartFast();
+        conv_busy = 1;
+        conv_burst = 0;
+        overrun_run = 0;
+        conv_start_cycles = now;
+        conv_start_tick = BSP_DWT_GetTick();
+        
+        if (now - trigger_cycles > adc_timing.max_delay_cycles)
+        {
+            adc_timing.max_delay_cycles = now - trigger_cycles;
+        }
+        ADC_RecordInterval(now);
+    }
+}
+
 /* 公共函数 ------------------------------------------------------------------*/
 
 /**
@@ -58,14 +442,27 @@ void SVC_ADC_Init(void)
 {
     uint8_t config_data;
     
+    if (adc_initialized)
+    {
+        return;
+    }
+    adc_initialized = 1;
+    
     /* 确保片选为高电平 */
     BSP_ADC_CS(1);
     HAL_Delay(1);
     
+    /* 停止连续转换并清空FIFO */
+    adc_continuous = 0;
+    fifo_head = 0;
+    fifo_tail = 0;
+    
     /* 复位ADC（根据实际ADC芯片协议） */
+    BSP_SPI_Lock();
     BSP_ADC_CS(0);
     BSP_SPI_TransmitReceive(0xFF);  /* 发送复位命令 */
     BSP_ADC_CS(1);
+    BSP_SPI_Unlock();
     HAL_Delay(10);
     
     /* 配置ADC参数 */
@@ -76,58 +473,150 @@ void SVC_ADC_Init(void)
     /* 更新配置 */
     adc_config.gain = ADC_GAIN_1;
     gain_factor = 1.0f;
+    
+    /* 采样定时器（启动采样时才开始计数） */
+    sample_period_cycles = sample_period_us * (SystemCoreClock / 1000000U);
+    BSP_TIM_Init(sample_period_us);
 }
 
 /**
- * @brief  启动ADC转换
+ * @brief  启动定时采样
  * @retval 无
  */
 void SVC_ADC_StartConversion(void)
 {
-    /* 发送启动转换命令（根据实际ADC芯片协议） */
-    BSP_ADC_CS(0);
-    BSP_SPI_TransmitReceive(0x08);  /* 启动命令示例 */
-    BSP_ADC_CS(1);
+    if (adc_continuous)
+    {
+        return;
+    }
+    
+    /* 停止期间的间隔不计入统计 */
+    HAL_NVIC_DisableIRQ(BSP_TIM_SAMPLE_IRQn);
+    last_start_valid = 0;
+    overrun_run = 0;
+    adc_continuous = 1;
+    HAL_NVIC_EnableIRQ(BSP_TIM_SAMPLE_IRQn);
+    
+    /* 立即触发第一次转换 */
+    BSP_TIM_Start();
+}
+
+/**
+ * @brief  停止定时采样
+ * @retval 无
+ */
+void SVC_ADC_StopConversion(void)
+{
+    adc_continuous = 0;
+    BSP_TIM_Stop();
+}
+
+/**
+ * @brief  设置采样周期
+ * @param  period_us: 采样周期 (μs)
+ * @retval 实际设置的采样周期 (μs)
+ */
+uint32_t SVC_ADC_SetSamplePeriod(uint32_t period_us)
+{
+    if (period_us < ADC_SAMPLE_PERIOD_MIN_US)
+    {
+        period_us = ADC_SAMPLE_PERIOD_MIN_US;
+    }
+    else if (period_us > ADC_SAMPLE_PERIOD_MAX_US)
+    {
+        period_us = ADC_SAMPLE_PERIOD_MAX_US;
+    }
+    
+    sample_period_us = period_us;
+    sample_period_cycles = period_us * (SystemCoreClock / 1000000U);
+    BSP_TIM_SetPeriod(period_us);
+    SVC_ADC_ResetTiming();
+    
+    return period_us;
+}
+
+/**
+ * @brief  获取采样周期
+ * @retval 采样周期 (μs)
+ */
+uint32_t SVC_ADC_GetSamplePeriod(void)
+{
+    return sample_period_us;
+}
+
+/**
+ * @brief  系统时钟改变后重新同步采样定时
+ * @retval 无
+ */
+void SVC_ADC_UpdateClock(void)
+{
+    BSP_TIM_UpdateClock();
+    sample_period_cycles = sample_period_us * (SystemCoreClock / 1000000U);
+    SVC_ADC_ResetTiming();
 }
 
 /**
  * @brief  检查ADC数据是否就绪
- * @retval 1=就绪, 0=未就绪
+ * @retval 1=FIFO中有样本, 0=无
  */
 uint8_t SVC_ADC_IsReady(void)
 {
-    /* 读取DRDY引脚状态 */
-    return BSP_ADC_IsDataReady();
+    return (fifo_head != fifo_tail) ? 1 : 0;
 }
 
 /**
- * @brief  读取ADC原始值
+ * @brief  直接读取ADC原始值
  * @retval 24位ADC原始值
  */
 uint32_t SVC_ADC_ReadRaw(void)
 {
-    uint8_t rx_buf[3];
     uint32_t raw_value;
     
-    /* 读取数据寄存器 */
-    BSP_ADC_CS(0);
+    BSP_SPI_Lock();
+    raw_value = ADC_ReadRawFast();
+    BSP_SPI_Unlock();
     
-    /* 发送读取数据命令 */
-    BSP_SPI_TransmitReceive(ADC_REG_DATA | 0x40);  /* 读命令 */
-    
-    /* 读取3个字节（24位） */
-    rx_buf[0] = BSP_SPI_TransmitReceive(0x00);  /* MSB */
-    rx_buf[1] = BSP_SPI_TransmitReceive(0x00);
-    rx_buf[2] = BSP_SPI_TransmitReceive(0x00);  /* LSB */
+    return raw_value;
+}
+
+/**
+ * @brief  从FIFO取出一个样本
+ * @param  raw: 输出24位原始值
+ * @retval 1=成功, 0=FIFO为空
+ */
+uint8_t SVC_ADC_PopRaw(uint32_t *raw)
+{
+    uint16_t tail = fifo_tail;
     
-    BSP_ADC_CS(1);
+    if (tail == fifo_head)
+    {
+        return 0;
+    }
     
-    /* 组合24位数据 (MSB first) */
-    raw_value = ((uint32_t)rx_buf[0] << 16) | 
-                ((uint32_t)rx_buf[1] << 8) | 
-                rx_buf[2];
+    *raw = raw_fifo[tail];
+    last_pop_cycles = stamp_fifo[tail];
+    last_pop_tick = tick_fifo[tail];
+    fifo_tail = (tail + 1) & (ADC_FIFO_SIZE - 1);
     
-    return raw_value;
+    return 1;
+}
+
+/**
+ * @brief  获取最近一次取出样本的采集时刻
+ * @retval 启动转换时的CPU周期计数
+ */
+uint32_t SVC_ADC_GetLastSampleCycles(void)
+{
+    return last_pop_cycles;
+}
+
+/**
+ * @brief  获取最近一次取出样本的采集时刻（ms）
+ * @retval 启动转换时的ms时基（BSP_DWT_GetTick）
+ */
+uint32_t SVC_ADC_GetLastSampleTick(void)
+{
+    return last_pop_tick;
 }
 
 /**
@@ -137,12 +626,36 @@ uint32_t SVC_ADC_ReadRaw(void)
 float SVC_ADC_ReadVoltage(void)
 {
     uint32_t raw;
+    
+    /* 优先取中断采集的样本 */
+    if (!SVC_ADC_PopRaw(&raw))
+    {
+        raw = SVC_ADC_ReadRaw();
+    }
+    last_raw = raw;
+    
+    return SVC_ADC_RawToVoltage(raw);
+}
+
+/**
+ * @brief  获取最近一次ReadVoltage()换算的原始值
+ * @retval 24位ADC原始值
+ */
+uint32_t SVC_ADC_GetLastRaw(void)
+{
+    return last_raw;
+}
+
+/**
+ * @brief  原始值转换为电压
+ * @param  raw: 24位原始值
+ * @retval 电压值 (mV)
+ */
+float SVC_ADC_RawToVoltage(uint32_t raw)
+{
     float voltage;
     int32_t signed_raw;
     
-    /* 读取原始值 */
-    raw = SVC_ADC_ReadRaw();
-    
     /* 转换为有符号值（假设差分输入，中点为Vref/2） */
     /* 24位ADC，中点值为0x800000 */
     signed_raw = (int32_t)(raw - 0x800000);
@@ -155,6 +668,30 @@ float SVC_ADC_ReadVoltage(void)
     return voltage;
 }
 
+/**
+ * @brief  电压转换为原始值
+ * @param  voltage: 电压值 (mV)
+ * @retval 24位原始值
+ */
+uint32_t SVC_ADC_VoltageToRaw(float voltage)
+{
+    float code;
+    
+    /* SVC_ADC_RawToVoltage()的逆运算 */
+    code = voltage * gain_factor / 1000.0f / (adc_config.vref / 2.0f) * (ADC_FULLSCALE / 2.0f);
+    code += (float)0x800000;
+    
+    if (code <= 0.0f)
+    {
+        return 0;
+    }
+    if (code >= ADC_FULLSCALE - 1.0f)
+    {
+        return 0xFFFFFF;
+    }
+    return (uint32_t)(code + 0.5f);
+}
+
 /**
  * @brief  设置ADC增益
  * @param  gain: 增益值 (ADC_GAIN_x)
@@ -207,6 +744,15 @@ void SVC_ADC_SetVref(float vref)
     }
 }
 
+/**
+ * @brief  获取参考电压值
+ * @retval 参考电压 (V)
+ */
+float SVC_ADC_GetVref(void)
+{
+    return adc_config.vref;
+}
+
 /**
  * @brief  写入ADC寄存器
  * @param  reg: 寄存器地址
@@ -215,6 +761,7 @@ void SVC_ADC_SetVref(float vref)
  */
 void SVC_ADC_WriteReg(uint8_t reg, uint8_t data)
 {
+    BSP_SPI_Lock();
     BSP_ADC_CS(0);
     
     /* 发送写命令 + 寄存器地址 */
@@ -224,6 +771,7 @@ void SVC_ADC_WriteReg(uint8_t reg, uint8_t data)
     BSP_SPI_TransmitReceive(data);
     
     BSP_ADC_CS(1);
+    BSP_SPI_Unlock();
 }
 
 /**
@@ -235,15 +783,243 @@ uint8_t SVC_ADC_ReadReg(uint8_t reg)
 {
     uint8_t data;
     
+    BSP_SPI_Lock();
     BSP_ADC_CS(0);
     
     /* 发送读命令 + 寄存器地址 */
-    BSP_SPI_TransmitReceive(reg | 0x40);  /* 读命令 */
+    BSP_SPI_TransmitReceive(reg | ADC_CMD_READ);  /* 读命令 */
     
     /* 读取数据 */
     data = BSP_SPI_TransmitReceive(0x00);
     
     BSP_ADC_CS(1);
+    BSP_SPI_Unlock();
     
     return data;
 }
+
+/**
+ * @brief  ADC数据就绪中断回调
+ * @note   位于RAM中
+ * @retval 无
+ */
+RAMFUNC void SVC_ADC_DRDY_Callback(void)
+{
+    ADC_Service();
+}
+
+/**
+ * @brief  采样定时器触发回调
+ * @note   位于RAM中
+ * @retval 无
+ */
+RAMFUNC void SVC_ADC_Trigger_Callback(void)
+{
+    trigger_cycles = BSP_DWT_GetCycles();
+    trigger_pending = 1;
+    ADC_Service();
+}
+
+/**
+ * @brief  获取DRDY中断采样统计
+ * @param  stats: 输出统计结构体指针
+ * @retval 无
+ */
+void SVC_ADC_GetStats(ADCStats_t *stats)
+{
+    *stats = adc_stats;
+    stats->max_gap_us = BSP_DWT_CyclesToUs(max_gap_cycles);
+    stats->max_gap_flash_us = BSP_DWT_CyclesToUs(max_gap_flash_cycles);
+    stats->max_latency_us = BSP_DWT_CyclesToUs(max_latency_cycles);
+}
+
+/**
+ * @brief  清零DRDY中断采样统计
+ * @retval 无
+ */
+void SVC_ADC_ResetStats(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    
+    __disable_irq();
+    memset(&adc_stats, 0, sizeof(adc_stats));
+    max_gap_cycles = 0;
+    max_gap_flash_cycles = 0;
+    max_latency_cycles = 0;
+    last_capture_valid = 0;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  获取定时器触发采样间隔统计
+ * @param  timing: 输出统计结构体指针
+ * @retval 无
+ */
+void SVC_ADC_GetTiming(ADCTiming_t *timing)
+{
+    uint32_t primask = __get_PRIMASK();
+    
+    __disable_irq();
+    *timing = adc_timing;
+    __set_PRIMASK(primask);
+    timing->period_us = sample_period_us;
+}
+
+/**
+ * @brief  清零定时器触发采样间隔统计
+ * @retval 无
+ */
+void SVC_ADC_ResetTiming(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    
+    __disable_irq();
+    memset(&adc_timing, 0, sizeof(adc_timing));
+    last_start_valid = 0;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  布防突发采集
+ * @param  config: 采集配置
+ * @retval 0=成功, -1=参数无效
+ */
+int SVC_ADC_BurstArm(const ADCBurstConfig_t *config)
+{
+    uint32_t primask;
+    
+    if (config->post_samples == 0 ||
+        (uint32_t)config->pre_samples + config->post_samples > ADC_BURST_SIZE)
+    {
+        return -1;
+    }
+    
+    primask = __get_PRIMASK();
+    __disable_irq();
+    burst_config = *config;
+    burst_request = ADC_BURST_SRC_NONE;
+    burst_source = ADC_BURST_SRC_NONE;
+    burst_head = 0;
+    burst_filled = 0;
+    burst_pre_count = 0;
+    burst_post_count = 0;
+    burst_prev_valid = 0;
+    burst_last_valid = 0;
+    burst_max_interval = 0;
+    burst_state = ADC_BURST_ARMED;
+    __set_PRIMASK(primask);
+    
+    return 0;
+}
+
+/**
+ * @brief  请求触发突发采集
+ * @param  source: 触发源 (ADCBurstSource_t)
+ * @retval 1=已请求, 0=未处于布防状态
+ */
+uint8_t SVC_ADC_BurstTrigger(uint8_t source)
+{
+    if (burst_state != ADC_BURST_ARMED)
+    {
+        return 0;
+    }
+    
+    /* 由中断在下一个样本处处理，不与写入竞争 */
+    if (burst_request == ADC_BURST_SRC_NONE)
+    {
+        burst_request = source;
+    }
+    return 1;
+}
+
+/**
+ * @brief  取消突发采集
+ * @retval 无
+ */
+void SVC_ADC_BurstAbort(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    
+    __disable_irq();
+    burst_state = ADC_BURST_IDLE;
+    burst_request = ADC_BURST_SRC_NONE;
+    burst_source = ADC_BURST_SRC_NONE;
+    burst_pre_count = 0;
+    burst_post_count = 0;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  获取突发采集状态
+ * @param  status: 输出状态结构体指针
+ * @retval 无
+ */
+void SVC_ADC_BurstGetStatus(ADCBurstStatus_t *status)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t span;
+    uint32_t max_interval;
+    
+    __disable_irq();
+    status->state = burst_state;
+    status->source = burst_source;
+    status->pre_count = burst_pre_count;
+    status->post_count = burst_post_count;
+    status->trigger_cycles = burst_trigger_cycles;
+    span = burst_end_cycles - burst_trigger_cycles;
+    max_interval = burst_max_interval;
+    __set_PRIMASK(primask);
+    
+    status->interval_ns = (status->post_count >= 2)
+                        ? ADC_CyclesToNs(span / (status->post_count - 1U)) : 0;
+    status->max_interval_ns = ADC_CyclesToNs(max_interval);
+}
+
+/**
+ * @brief  获取突发采集配置
+ * @param  config: 输出配置结构体指针
+ * @retval 无
+ */
+void SVC_ADC_BurstGetConfig(ADCBurstConfig_t *config)
+{
+    *config = burst_config;
+}
+
+/**
+ * @brief  读出突发采集数据块
+ * @param  offset: 起始位置（0=数据块中最早的触发前样本）
+ * @param  raw: 输出24位原始值数组
+ * @param  count: 最多读出个数
+ * @retval 实际读出个数
+ */
+uint16_t SVC_ADC_BurstRead(uint16_t offset, uint32_t *raw, uint16_t count)
+{
+    uint16_t total;
+    uint16_t index;
+    uint16_t i;
+    
+    /* 完成后中断不再写入缓冲区 */
+    if (burst_state != ADC_BURST_DONE)
+    {
+        return 0;
+    }
+    
+    total = burst_pre_count + burst_post_count;
+    if (offset >= total)
+    {
+        return 0;
+    }
+    if (count > total - offset)
+    {
+        count = total - offset;
+    }
+    
+    index = (burst_trigger_index - burst_pre_count + offset) & (ADC_BURST_SIZE - 1);
+    for (i = 0; i < count; i++)
+    {
+        raw[i] = burst_buf[index];
+        index = (index + 1) & (ADC_BURST_SIZE - 1);
+    }
+    
+    return count;
+}
@@ -11,9 +11,14 @@
 #include "svc_dac.h"
 #include "bsp_spi.h"
 #include "bsp_gpio.h"
+#include "bsp_dwt.h"
+#include "bsp_trace.h"
 
 /* 私有变量 ------------------------------------------------------------------*/
 
+/* 初始化完成标志 */
+static uint8_t dac_initialized = 0;
+
 /* 当前电流源选择 */
 static CurrentSource_e current_source = CURRENT_SRC_10UA;
 
@@ -24,6 +29,10 @@ static float current_adj_17uA = 0.0f;
 /* 当前4-20mA输出值 */
 static float output_current_mA = 4.0f;
 
+/* 各通道最近一次写入的DAC码值（下标0:DAC1, 1:DAC2），用于变化检测 */
+static uint16_t dac_code[2] = {0, 0};
+static uint8_t dac_code_valid[2] = {0, 0};
+
 /* 私有函数 ------------------------------------------------------------------*/
 
 /**
@@ -62,6 +71,9 @@ static void DAC_Write(DACChannel_e channel, uint16_t value)
     buf[1] = (value >> 8) & 0xFF;   /* 高8位 */
     buf[2] = value & 0xFF;          /* 低8位 */
     
+    /* 与DRDY中断共享SPI总线 */
+    BSP_SPI_Lock();
+    
     if (channel == DAC_CHANNEL_1)
     {
         /* DAC1 操作 */
@@ -76,6 +88,31 @@ static void DAC_Write(DACChannel_e channel, uint16_t value)
         BSP_SPI_Transmit(buf, 3);
         BSP_DAC2_CS(1);
     }
+    
+    BSP_SPI_Unlock();
+    
+    /* 记录已写入的码值，加载后才视为有效输出 */
+    dac_code[channel - 1] = value;
+    dac_code_valid[channel - 1] = 0;
+}
+
+/**
+ * @brief  更新DAC输出（码值未变化时跳过SPI传输和加载）
+ * @param  channel: DAC通道
+ * @param  value: 16位DAC值
+ * @retval 无
+ */
+static void DAC_Update(DACChannel_e channel, uint16_t value)
+{
+    if (dac_code_valid[channel - 1] && dac_code[channel - 1] == value)
+    {
+        return;
+    }
+    
+    DAC_Write(channel, value);
+    SVC_DAC_Load(channel);
+    
+    TRACE_EVENT((channel == DAC_CHANNEL_1) ? TRACE_EVT_DAC1_LOAD : TRACE_EVT_DAC2_LOAD, value);
 }
 
 /* 公共函数 ------------------------------------------------------------------*/
@@ -86,12 +123,22 @@ static void DAC_Write(DACChannel_e channel, uint16_t value)
  */
 void SVC_DAC_Init(void)
 {
+    if (dac_initialized)
+    {
+        return;
+    }
+    dac_initialized = 1;
+    
     /* 确保所有片选和LOAD信号为高电平 */
     BSP_DAC1_CS(1);
     BSP_DAC2_CS(1);
     BSP_DAC1_LOAD(1);
     BSP_DAC2_LOAD(1);
     
+    /* 清除码值缓存，保证上电后首次写入一定下发 */
+    dac_code_valid[0] = 0;
+    dac_code_valid[1] = 0;
+    
     HAL_Delay(1);
     
     /* 设置DAC1输出为0（电流源关闭） */
@@ -140,11 +187,8 @@ void SVC_DAC_SetCurrentSource(CurrentSource_e src)
     /* 转换为DAC值 */
     dac_value = VoltageToDAC(voltage);
     
-    /* 写入DAC1 */
-    DAC_Write(DAC_CHANNEL_1, dac_value);
-    
-    /* 触发加载 */
-    SVC_DAC_Load(DAC_CHANNEL_1);
+    /* 写入DAC1并加载（码值未变化时跳过） */
+    DAC_Update(DAC_CHANNEL_1, dac_value);
 }
 
 /**
@@ -186,33 +230,35 @@ void SVC_DAC_SetCurrentAdj(CurrentSource_e src, float adj_uA)
 
 /**
  * @brief  设置4-20mA输出电流
- * @param  current_mA: 输出电流值 (mA), 范围4.0-20.0
+ * @param  current_mA: 输出电流值 (mA), 正常范围4.0-20.0，故障电流3.6-21.0
  * @retval 无
  */
 void SVC_DAC_Set420mA(float current_mA)
 {
-    float voltage;
-    uint16_t dac_value;
-    
-    /* 限制电流范围 */
-    if (current_mA < OUTPUT_CURRENT_MIN) current_mA = OUTPUT_CURRENT_MIN;
-    if (current_mA > OUTPUT_CURRENT_MAX) current_mA = OUTPUT_CURRENT_MAX;
+    /* 限制电流范围（含故障电流） */
+    if (current_mA < OUTPUT_CURRENT_FAULT_MIN) current_mA = OUTPUT_CURRENT_FAULT_MIN;
+    if (current_mA > OUTPUT_CURRENT_FAULT_MAX) current_mA = OUTPUT_CURRENT_FAULT_MAX;
     
     /* 保存当前值 */
     output_current_mA = current_mA;
     
-    /* 计算DAC电压 */
-    /* 根据V/I转换电路：I_out = V_DAC * VI_COEFFICIENT */
-    voltage = current_mA / VI_COEFFICIENT;
-    
-    /* 转换为DAC值 */
-    dac_value = VoltageToDAC(voltage);
-    
-    /* 写入DAC2 */
-    DAC_Write(DAC_CHANNEL_2, dac_value);
+    /* 写入DAC2并加载（码值未变化时跳过） */
+    DAC_Update(DAC_CHANNEL_2, SVC_DAC_Calc420mACode(current_mA));
+}
+
+/**
+ * @brief  计算4-20mA输出电流对应的DAC码值
+ * @param  current_mA: 输出电流值 (mA)
+ * @retval 16位DAC值
+ */
+uint16_t SVC_DAC_Calc420mACode(float current_mA)
+{
+    /* 限制电流范围（含故障电流） */
+    if (current_mA < OUTPUT_CURRENT_FAULT_MIN) current_mA = OUTPUT_CURRENT_FAULT_MIN;
+    if (current_mA > OUTPUT_CURRENT_FAULT_MAX) current_mA = OUTPUT_CURRENT_FAULT_MAX;
     
-    /* 触发加载 */
-    SVC_DAC_Load(DAC_CHANNEL_2);
+    /* 根据V/I转换电路：I_out = V_DAC * VI_COEFFICIENT */
+    return VoltageToDAC(current_mA / VI_COEFFICIENT);
 }
 
 /**
@@ -237,11 +283,8 @@ void SVC_DAC_SetVoltage(DACChannel_e channel, float voltage)
     /* 转换为DAC值 */
     dac_value = VoltageToDAC(voltage);
     
-    /* 写入DAC */
-    DAC_Write(channel, dac_value);
-    
-    /* 触发加载 */
-    SVC_DAC_Load(channel);
+    /* 写入DAC并加载（码值未变化时跳过） */
+    DAC_Update(channel, dac_value);
 }
 
 /**
@@ -266,14 +309,27 @@ void SVC_DAC_Load(DACChannel_e channel)
     {
         /* DAC1 LOAD信号：低脉冲触发 */
         BSP_DAC1_LOAD(0);
-        HAL_Delay(1);
+        BSP_DWT_DelayUs(DAC_LOAD_PULSE_US);
         BSP_DAC1_LOAD(1);
     }
     else
     {
         /* DAC2 LOAD信号：低脉冲触发 */
         BSP_DAC2_LOAD(0);
-        HAL_Delay(1);
+        BSP_DWT_DelayUs(DAC_LOAD_PULSE_US);
         BSP_DAC2_LOAD(1);
     }
+    
+    /* 输入寄存器已锁存到输出 */
+    dac_code_valid[channel - 1] = 1;
+}
+
+/**
+ * @brief  获取通道最近一次写入的DAC码值
+ * @param  channel: DAC通道
+ * @retval 16位DAC值
+ */
+uint16_t SVC_DAC_GetCode(DACChannel_e channel)
+{
+    return dac_code[channel - 1];
 }
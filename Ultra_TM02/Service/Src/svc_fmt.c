@@ -0,0 +1,206 @@
+/**
+ * @file    svc_fmt.c
+ * @brief   定点数字格式化服务源文件
+ * @details 实现固定小数位数的数字转字符串功能，替代snprintf("%.Nf")
+ * @author  Ultra-TM02 开发团队
+ * @version V1.0
+ * @date    2026-10-16
+ */
+
+/* 包含头文件 ----------------------------------------------------------------*/
+#include "svc_fmt.h"
+#include <string.h>
+
+/* 私有变量 ------------------------------------------------------------------*/
+
+/* 10的幂 */
+static const uint32_t pow10_table[FMT_MAX_DECIMALS + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000
+};
+
+/* 私有函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  复制字符串到输出缓冲区（截断）
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小
+ * @param  str: 源字符串
+ * @retval 写入的字符数
+ */
+static uint8_t FMT_Copy(char *buf, uint8_t size, const char *str)
+{
+    uint8_t len = 0;
+    
+    if (size == 0)
+    {
+        return 0;
+    }
+    
+    while (str[len] != '\0' && len < size - 1)
+    {
+        buf[len] = str[len];
+        len++;
+    }
+    buf[len] = '\0';
+    
+    return len;
+}
+
+/**
+ * @brief  输出已缩放的无符号整数（插入小数点）
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小
+ * @param  negative: 是否输出负号
+ * @param  scaled: 缩放后的值（实际值 * 10^decimals）
+ * @param  decimals: 小数位数
+ * @retval 写入的字符数
+ */
+static uint8_t FMT_Emit(char *buf, uint8_t size, uint8_t negative,
+                        uint64_t scaled, uint8_t decimals)
+{
+    char tmp[24];
+    uint8_t n = 0;
+    uint8_t len = 0;
+    
+    /* 从低位向高位生成数字，至少保留一位整数 */
+    do
+    {
+        if (n == decimals && decimals > 0)
+        {
+            tmp[n++] = '.';
+        }
+        tmp[n++] = (char)('0' + (uint8_t)(scaled % 10));
+        scaled /= 10;
+    } while (scaled != 0 || n <= decimals);
+    
+    if (negative)
+    {
+        tmp[n++] = '-';
+    }
+    
+    if (size == 0)
+    {
+        return 0;
+    }
+    
+    /* 逆序写出 */
+    while (n > 0 && len < size - 1)
+    {
+        buf[len++] = tmp[--n];
+    }
+    buf[len] = '\0';
+    
+    return len;
+}
+
+/* 公共函数 ------------------------------------------------------------------*/
+
+/**
+ * @brief  浮点数格式化为固定小数位字符串
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小（含结束符）
+ * @param  value: 浮点数值
+ * @param  decimals: 小数位数
+ * @retval 写入的字符数（不含结束符）
+ */
+uint8_t SVC_FMT_Float(char *buf, uint8_t size, float value, uint8_t decimals)
+{
+    uint32_t bits;
+    uint32_t mantissa;
+    int32_t exponent;
+    uint8_t negative;
+    uint64_t product;
+    uint64_t scaled;
+    uint64_t remainder;
+    uint64_t half;
+    uint32_t shift;
+    
+    if (decimals > FMT_MAX_DECIMALS)
+    {
+        decimals = FMT_MAX_DECIMALS;
+    }
+    
+    /* 拆分IEEE754单精度：value = mantissa * 2^exponent */
+    memcpy(&bits, &value, sizeof(bits));
+    negative = (uint8_t)(bits >> 31);
+    exponent = (int32_t)((bits >> 23) & 0xFF);
+    mantissa = bits & 0x7FFFFF;
+    
+    if (exponent == 0xFF)
+    {
+        if (mantissa != 0)
+        {
+            return FMT_Copy(buf, size, negative ? "-nan" : "nan");
+        }
+        return FMT_Copy(buf, size, negative ? "-inf" : "inf");
+    }
+    
+    if (value >= FMT_FLOAT_LIMIT || value <= -FMT_FLOAT_LIMIT)
+    {
+        return FMT_Copy(buf, size, "ovf");
+    }
+    
+    if (exponent == 0)
+    {
+        /* 非规格化数 */
+        exponent = 1 - 127 - 23;
+    }
+    else
+    {
+        mantissa |= 0x800000;
+        exponent = exponent - 127 - 23;
+    }
+    
+    /* 精确计算 value * 10^decimals，整数部分 < 2^40 * 10^6 < 2^60 */
+    product = (uint64_t)mantissa * pow10_table[decimals];
+    
+    if (exponent >= 0)
+    {
+        scaled = product << exponent;
+    }
+    else
+    {
+        shift = (uint32_t)(-exponent);
+        if (shift >= 64)
+        {
+            /* 小于最小显示单位的一半，舍入为0 */
+            scaled = 0;
+        }
+        else
+        {
+            scaled = product >> shift;
+            remainder = product & (((uint64_t)1 << shift) - 1);
+            half = (uint64_t)1 << (shift - 1);
+            
+            /* 四舍六入五成双（与printf的精确舍入一致） */
+            if (remainder > half || (remainder == half && (scaled & 1)))
+            {
+                scaled++;
+            }
+        }
+    }
+    
+    return FMT_Emit(buf, size, negative, scaled, decimals);
+}
+
+/**
+ * @brief  定点整数格式化为固定小数位字符串
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小（含结束符）
+ * @param  value: 定点数值
+ * @param  decimals: 小数位数
+ * @retval 写入的字符数（不含结束符）
+ */
+uint8_t SVC_FMT_Fixed(char *buf, uint8_t size, int32_t value, uint8_t decimals)
+{
+    uint64_t magnitude;
+    
+    if (decimals > FMT_MAX_DECIMALS)
+    {
+        decimals = FMT_MAX_DECIMALS;
+    }
+    
+    magnitude = (value < 0) ? (uint64_t)(-(int64_t)value) : (uint64_t)value;
+    
+    return FMT_Emit(buf, size, value < 0, magnitude, decimals);
+}
@@ -10,6 +10,9 @@
 /* 包含头文件 ----------------------------------------------------------------*/
 #include "svc_lcd.h"
 #include "bsp_uart.h"
+#include "svc_fmt.h"
+#include "bsp_prof.h"
+#include "bsp_trace.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -27,8 +30,42 @@ static LCDDisplayData_t lcd_data = {
 /* 上次更新时间 */
 static uint32_t last_update_tick = 0;
 
-/* 数据更新标志 */
-static uint8_t data_changed = 0;
+/* 刷新间隔 (ms) */
+static uint32_t update_interval = LCD_UPDATE_INTERVAL;
+
+/* 待刷新控件标记（按LCDField_e位） */
+static uint8_t dirty_mask = 0;
+
+/* 上次发送的控件文本及有效标记 */
+static char sent_text[LCD_FIELD_COUNT][LCD_TEXT_MAX_LEN];
+static uint8_t sent_valid_mask = 0;
+
+/* 控件名称表（与LCDField_e顺序一致） */
+static const char * const field_obj[LCD_FIELD_COUNT] = {
+    LCD_OBJ_TEMP,
+    LCD_OBJ_VOLT,
+    LCD_OBJ_CURR,
+    LCD_OBJ_SRC,
+    LCD_OBJ_STATUS
+};
+
+/* 合并发送缓冲区 */
+static uint8_t tx_buf[LCD_TX_BUFFER_SIZE];
+static uint16_t tx_len = 0;
+
+/* 启动阶段 */
+typedef enum {
+    LCD_BOOT_POWERUP = 0,   /* 等待上电稳定 */
+    LCD_BOOT_RESET,         /* 已发送复位指令，等待屏幕重启 */
+    LCD_BOOT_DONE           /* 就绪 */
+} LCDBootState_e;
+
+static LCDBootState_e boot_state = LCD_BOOT_POWERUP;
+static uint32_t boot_tick = 0;
+static uint8_t lcd_initialized = 0;
+
+/* 所有控件位 */
+#define LCD_FIELD_ALL_MASK      ((uint8_t)((1U << LCD_FIELD_COUNT) - 1U))
 
 /* 私有函数 ------------------------------------------------------------------*/
 
@@ -42,6 +79,156 @@ static void LCD_SendEnd(void)
     BSP_UART_Transmit(end_bytes, 3);
 }
 
+/**
+ * @brief  生成控件显示文本
+ * @param  field: 控件编号
+ * @param  buf: 输出缓冲区
+ * @param  size: 缓冲区大小
+ * @retval 无
+ */
+static void LCD_FormatField(LCDField_e field, char *buf, uint16_t size)
+{
+    size_t len;
+    
+    switch (field)
+    {
+        case LCD_FIELD_TEMP:
+            /* 温度（保留3位小数） */
+            SVC_FMT_Float(buf, (uint8_t)size, lcd_data.temperature, 3);
+            break;
+            
+        case LCD_FIELD_VOLT:
+            /* 电压（保留3位小数） */
+            SVC_FMT_Float(buf, (uint8_t)size, lcd_data.voltage, 3);
+            break;
+            
+        case LCD_FIELD_CURR:
+            /* 输出电流（保留2位小数） */
+            SVC_FMT_Float(buf, (uint8_t)size, lcd_data.output_current, 2);
+            break;
+            
+        case LCD_FIELD_SRC:
+            strncpy(buf, lcd_data.current_src == 0 ? "10uA" : "17uA", size - 1);
+            buf[size - 1] = '\0';
+            break;
+            
+        case LCD_FIELD_STATUS:
+        default:
+            /* 按长度复制并显式结尾，截断时不产生未结尾的字符串 */
+            len = strlen(lcd_data.status);
+            if (len > (size_t)(size - 1))
+            {
+                len = size - 1;
+            }
+            memcpy(buf, lcd_data.status, len);
+            buf[len] = '\0';
+            break;
+    }
+}
+
+/**
+ * @brief  发送合并缓冲区中的全部指令
+ * @note   UART发送为非阻塞入队，队列空间不足时整包丢弃
+ * @retval 1=已入队, 0=发送队列已满
+ */
+static uint8_t LCD_Flush(void)
+{
+    HAL_StatusTypeDef status = HAL_OK;
+    
+    if (tx_len > 0)
+    {
+        status = BSP_UART_Transmit(tx_buf, tx_len);
+        tx_len = 0;
+    }
+    
+    return (status == HAL_OK) ? 1 : 0;
+}
+
+/**
+ * @brief  发送合并缓冲区，失败时恢复相关控件的脏标志
+ * @param  mask: 缓冲区中包含的控件位掩码
+ * @retval 无
+ */
+static void LCD_FlushBurst(uint8_t mask)
+{
+    if (!LCD_Flush())
+    {
+        /* 未能入队：视为未发送，下个周期重试 */
+        sent_valid_mask &= (uint8_t)~mask;
+        dirty_mask |= mask;
+    }
+}
+
+/**
+ * @brief  追加一条设置文本指令到合并缓冲区
+ * @param  obj_name: 控件名称
+ * @param  text: 文本内容
+ * @retval 1=成功, 0=缓冲区空间不足
+ */
+static uint8_t LCD_AppendText(const char *obj_name, const char *text)
+{
+    uint16_t obj_len = strlen(obj_name);
+    uint16_t text_len = strlen(text);
+    
+    /* 格式: obj_name.txt="text" + 3字节结束符 */
+    if (tx_len + obj_len + text_len + 7 + 3 > LCD_TX_BUFFER_SIZE)
+    {
+        return 0;
+    }
+    
+    memcpy(&tx_buf[tx_len], obj_name, obj_len);
+    tx_len += obj_len;
+    memcpy(&tx_buf[tx_len], ".txt=\"", 6);
+    tx_len += 6;
+    memcpy(&tx_buf[tx_len], text, text_len);
+    tx_len += text_len;
+    tx_buf[tx_len++] = '"';
+    tx_buf[tx_len++] = LCD_CMD_END_1;
+    tx_buf[tx_len++] = LCD_CMD_END_2;
+    tx_buf[tx_len++] = LCD_CMD_END_3;
+    
+    return 1;
+}
+
+/**
+ * @brief  推进启动阶段
+ * @param  tick: 当前时刻 (ms)
+ * @retval 1=已就绪, 0=启动中
+ */
+static uint8_t LCD_BootStep(uint32_t tick)
+{
+    switch (boot_state)
+    {
+        case LCD_BOOT_POWERUP:
+            if (tick - boot_tick >= LCD_POWERUP_MS)
+            {
+                /* 发送复位指令 */
+                SVC_LCD_SendCommand("rest");
+                boot_tick = tick;
+                boot_state = LCD_BOOT_RESET;
+            }
+            break;
+            
+        case LCD_BOOT_RESET:
+            if (tick - boot_tick >= LCD_RESET_MS)
+            {
+                /* 切换到主页面 */
+                SVC_LCD_SetPage(0);
+                
+                /* 复位后屏幕内容未知，全部控件需重新发送 */
+                sent_valid_mask = 0;
+                dirty_mask = LCD_FIELD_ALL_MASK;
+                boot_state = LCD_BOOT_DONE;
+            }
+            break;
+            
+        default:
+            break;
+    }
+    
+    return (boot_state == LCD_BOOT_DONE) ? 1 : 0;
+}
+
 /* 公共函数 ------------------------------------------------------------------*/
 
 /**
@@ -50,18 +237,18 @@ static void LCD_SendEnd(void)
  */
 void SVC_LCD_Init(void)
 {
+    if (lcd_initialized)
+    {
+        return;
+    }
+    lcd_initialized = 1;
+    
     /* 初始化UART */
     BSP_UART_Init();
     
-    /* 等待LCD上电稳定 */
-    HAL_Delay(500);
-    
-    /* 发送复位指令 */
-    SVC_LCD_SendCommand("rest");
-    HAL_Delay(500);
-    
-    /* 切换到主页面 */
-    SVC_LCD_SetPage(0);
+    /* 上电等待从此刻开始，由SVC_LCD_Update()推进 */
+    boot_state = LCD_BOOT_POWERUP;
+    boot_tick = HAL_GetTick();
     
     /* 设置初始显示 */
     SVC_LCD_SetStatus("Initializing...");
@@ -70,55 +257,94 @@ void SVC_LCD_Init(void)
     SVC_LCD_SetCurrent(4.0f);
     SVC_LCD_SetCurrentSource(0);
     
+    sent_valid_mask = 0;
+    dirty_mask = LCD_FIELD_ALL_MASK;
+    
     /* 更新时间戳 */
-    last_update_tick = HAL_GetTick();
+    last_update_tick = boot_tick;
 }
 
 /**
  * @brief  LCD周期更新（在主循环中调用）
- * @note   以LCD_UPDATE_INTERVAL间隔更新显示
+ * @note   以update_interval间隔检查，只发送文本变化的控件并合并为一次UART发送
  * @retval 无
  */
 void SVC_LCD_Update(void)
 {
     uint32_t current_tick = HAL_GetTick();
-    char buf[64];
+    char text[LCD_TEXT_MAX_LEN];
+    uint8_t burst_mask = 0;  /* 合并缓冲区中尚未发送的控件 */
+    uint8_t bit;
+    uint8_t i;
     
+    /* 屏幕就绪前只推进启动阶段，就绪时立即发送全部控件 */
+    if (boot_state != LCD_BOOT_DONE)
+    {
+        if (!LCD_BootStep(current_tick))
+        {
+            return;
+        }
+    }
     /* 检查更新间隔 */
-    if (current_tick - last_update_tick < LCD_UPDATE_INTERVAL)
+    else if (current_tick - last_update_tick < update_interval)
     {
         return;
     }
     
     last_update_tick = current_tick;
     
-    /* 更新温度显示（保留3位小数） */
-    snprintf(buf, sizeof(buf), "%.3f", lcd_data.temperature);
-    SVC_LCD_SetText(LCD_OBJ_TEMP, buf);
-    
-    /* 更新电压显示（保留3位小数） */
-    snprintf(buf, sizeof(buf), "%.3f", lcd_data.voltage);
-    SVC_LCD_SetText(LCD_OBJ_VOLT, buf);
-    
-    /* 更新输出电流显示（保留2位小数） */
-    snprintf(buf, sizeof(buf), "%.2f", lcd_data.output_current);
-    SVC_LCD_SetText(LCD_OBJ_CURR, buf);
-    
-    /* 更新电流源显示 */
-    if (lcd_data.current_src == 0)
+    /* 无变化的控件不产生任何通讯 */
+    if (dirty_mask == 0)
     {
-        SVC_LCD_SetText(LCD_OBJ_SRC, "10uA");
+        return;
     }
-    else
+    
+    PROF_BEGIN(PROF_PROBE_LCD_UPDATE);
+    TRACE_BEGIN(TRACE_EVT_LCD_UPDATE, dirty_mask);
+    
+    for (i = 0; i < LCD_FIELD_COUNT; i++)
     {
-        SVC_LCD_SetText(LCD_OBJ_SRC, "17uA");
+        bit = (uint8_t)(1U << i);
+        if ((dirty_mask & bit) == 0)
+        {
+            continue;
+        }
+        dirty_mask &= (uint8_t)~bit;
+        
+        /* 显示文本与上次发送相同则跳过 */
+        LCD_FormatField((LCDField_e)i, text, sizeof(text));
+        if ((sent_valid_mask & bit) && strcmp(text, sent_text[i]) == 0)
+        {
+            continue;
+        }
+        
+        /* 追加到合并缓冲区，满时先发送 */
+        if (!LCD_AppendText(field_obj[i], text))
+        {
+            LCD_FlushBurst(burst_mask);
+            burst_mask = 0;
+            LCD_AppendText(field_obj[i], text);
+        }
+        
+        strcpy(sent_text[i], text);
+        sent_valid_mask |= bit;
+        burst_mask |= bit;
     }
     
-    /* 更新状态显示 */
-    SVC_LCD_SetText(LCD_OBJ_STATUS, lcd_data.status);
+    /* 一次UART发送全部变化的控件 */
+    LCD_FlushBurst(burst_mask);
     
-    /* 清除更新标志 */
-    data_changed = 0;
+    TRACE_END(TRACE_EVT_LCD_UPDATE, 0);
+    PROF_END(PROF_PROBE_LCD_UPDATE);
+}
+
+/**
+ * @brief  检查串口屏是否已完成上电复位
+ * @retval 1=就绪, 0=启动中
+ */
+uint8_t SVC_LCD_IsReady(void)
+{
+    return (boot_state == LCD_BOOT_DONE) ? 1 : 0;
 }
 
 /**
@@ -129,7 +355,7 @@ void SVC_LCD_Update(void)
 void SVC_LCD_SetTemperature(float temp)
 {
     lcd_data.temperature = temp;
-    data_changed = 1;
+    dirty_mask |= (1U << LCD_FIELD_TEMP);
 }
 
 /**
@@ -140,7 +366,7 @@ void SVC_LCD_SetTemperature(float temp)
 void SVC_LCD_SetVoltage(float voltage)
 {
     lcd_data.voltage = voltage;
-    data_changed = 1;
+    dirty_mask |= (1U << LCD_FIELD_VOLT);
 }
 
 /**
@@ -151,7 +377,7 @@ void SVC_LCD_SetVoltage(float voltage)
 void SVC_LCD_SetCurrent(float current)
 {
     lcd_data.output_current = current;
-    data_changed = 1;
+    dirty_mask |= (1U << LCD_FIELD_CURR);
 }
 
 /**
@@ -163,7 +389,7 @@ void SVC_LCD_SetStatus(const char *status)
 {
     strncpy(lcd_data.status, status, sizeof(lcd_data.status) - 1);
     lcd_data.status[sizeof(lcd_data.status) - 1] = '\0';
-    data_changed = 1;
+    dirty_mask |= (1U << LCD_FIELD_STATUS);
 }
 
 /**
@@ -174,7 +400,7 @@ void SVC_LCD_SetStatus(const char *status)
 void SVC_LCD_SetCurrentSource(uint8_t src)
 {
     lcd_data.current_src = src;
-    data_changed = 1;
+    dirty_mask |= (1U << LCD_FIELD_SRC);
 }
 
 /**
@@ -238,7 +464,30 @@ void SVC_LCD_SetPage(uint8_t page)
  */
 void SVC_LCD_Refresh(void)
 {
-    /* 重置更新时间，强制下次Update时立即刷新 */
-    last_update_tick = HAL_GetTick() - LCD_UPDATE_INTERVAL;
+    /* 清除发送缓存，全部控件重新发送 */
+    sent_valid_mask = 0;
+    dirty_mask = LCD_FIELD_ALL_MASK;
+    
+    /* 重置更新时间，强制立即刷新 */
+    last_update_tick = HAL_GetTick() - update_interval;
     SVC_LCD_Update();
 }
+
+/**
+ * @brief  设置刷新间隔
+ * @param  interval_ms: 刷新间隔 (ms)
+ * @retval 无
+ */
+void SVC_LCD_SetUpdateInterval(uint32_t interval_ms)
+{
+    update_interval = interval_ms;
+}
+
+/**
+ * @brief  获取刷新间隔
+ * @retval 刷新间隔 (ms)
+ */
+uint32_t SVC_LCD_GetUpdateInterval(void)
+{
+    return update_interval;
+}
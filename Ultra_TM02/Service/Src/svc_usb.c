@@ -10,6 +10,7 @@
 /* 包含头文件 ----------------------------------------------------------------*/
 #include "svc_usb.h"
 #include "usbd_cdc_if.h"
+#include "bsp_prof.h"
 
 /* 私有变量 ------------------------------------------------------------------*/
 
@@ -18,6 +19,9 @@ static uint8_t rx_buffer[USB_RX_BUFFER_SIZE];
 static volatile uint16_t rx_head = 0;  /* 写入位置 */
 static volatile uint16_t rx_tail = 0;  /* 读取位置 */
 
+/* 初始化完成标志 */
+static uint8_t usb_initialized = 0;
+
 /* USB状态 */
 static USBState_t usb_state = USB_STATE_DISCONNECTED;
 
@@ -32,6 +36,12 @@ static USBState_t usb_state = USB_STATE_DISCONNECTED;
  */
 void SVC_USB_Init(void)
 {
+    if (usb_initialized)
+    {
+        return;
+    }
+    usb_initialized = 1;
+    
     /* 清空接收缓冲区 */
     rx_head = 0;
     rx_tail = 0;
@@ -78,6 +88,7 @@ uint8_t SVC_USB_Transmit(uint8_t *data, uint16_t len)
 {
     uint32_t timeout = HAL_GetTick() + USB_TX_TIMEOUT;
     uint8_t result;
+    PROF_BEGIN(PROF_PROBE_USB_TX);
     
     /* 检查USB是否就绪 */
     if (!SVC_USB_IsReady())
@@ -97,6 +108,8 @@ uint8_t SVC_USB_Transmit(uint8_t *data, uint16_t len)
     /* 发送数据 */
     result = CDC_Transmit_FS(data, len);
     
+    PROF_END(PROF_PROBE_USB_TX);
+    
     return result;
 }
 